@@ -1,9 +1,19 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 
+#include <book.hpp>
 #include <chess.hpp>
+#include <gamerecord.hpp>
+#include <policy.hpp>
+#include <search.hpp>
+#include <tablebase.hpp>
+#include <threadpool.hpp>
 
 #include <array>
+#include <cctype>
+#include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -12,24 +22,13 @@ namespace py = pybind11;
 
 namespace {
 
+// 기물 문자열은 모두 기물 특성 레지스트리(piecetraits.hpp)에서 읽는다
+// 받는 형식: 긴 이름("KNIGHTRIDER", "knightrider"), 코드("Kr"), 한 글자 기호("H"), 옛 이름 "PWAN"
 pieceType piece_type_from_str(const std::string &s) {
-	if (s == "KING" || s == "king" || s == "K") return pieceType::KING;
-	if (s == "QUEEN" || s == "queen" || s == "Q") return pieceType::QUEEN;
-	if (s == "BISHOP" || s == "bishop" || s == "B") return pieceType::BISHOP;
-	if (s == "KNIGHT" || s == "knight" || s == "N") return pieceType::KNIGHT;
-	if (s == "ROOK" || s == "rook" || s == "R") return pieceType::ROOK;
-	if (s == "PAWN" || s == "pawn" || s == "P" || s == "PWAN") return pieceType::PWAN;
-	if (s == "AMAZON" || s == "amazon" || s == "A") return pieceType::AMAZON;
-	if (s == "GRASSHOPPER" || s == "grasshopper" || s == "G") return pieceType::GRASSHOPPER;
-	if (s == "KNIGHTRIDER" || s == "knightrider" || s == "Kr" || s == "KR") return pieceType::KNIGHTRIDER;
-	if (s == "ARCHBISHOP" || s == "archbishop" || s == "W") return pieceType::ARCHBISHOP;
-	if (s == "DABBABA" || s == "dabbaba" || s == "D") return pieceType::DABBABA;
-	if (s == "ALFIL" || s == "alfil" || s == "L") return pieceType::ALFIL;
-	if (s == "FERZ" || s == "ferz" || s == "F") return pieceType::FERZ;
-	if (s == "CENTAUR" || s == "centaur" || s == "C") return pieceType::CENTAUR;
-	if (s == "TESTROOK" || s == "testrook" || s == "Tr" || s == "TR") return pieceType::TESTROOK;
-	if (s == "CAMEL" || s == "camel" || s == "Cl" || s == "CL") return pieceType::CAMEL;
-	throw std::invalid_argument("invalid piece type: " + s);
+	if (s == "PWAN") return pieceType::PWAN;
+	const pieceType t = pieceFromName(s);
+	if (t == pieceType::NONE) throw std::invalid_argument("invalid piece type: " + s);
+	return t;
 }
 
 colorType color_from_str(const std::string &s) {
@@ -46,26 +45,9 @@ std::string color_to_str(colorType c) {
 	}
 }
 
+// UI/포켓 키용 코드 (Kr/Tr/Cl만 기호와 다름)
 std::string piece_to_str(pieceType t) {
-	switch (t) {
-		case pieceType::KING: return "K";
-		case pieceType::QUEEN: return "Q";
-		case pieceType::BISHOP: return "B";
-		case pieceType::KNIGHT: return "N";
-		case pieceType::ROOK: return "R";
-		case pieceType::PWAN: return "P";
-		case pieceType::AMAZON: return "A";
-		case pieceType::GRASSHOPPER: return "G";
-		case pieceType::KNIGHTRIDER: return "Kr"; // KnightRider distinct code
-		case pieceType::ARCHBISHOP: return "W";  // (Bishop+Knight variant)
-		case pieceType::DABBABA: return "D";
-		case pieceType::ALFIL: return "L";
-		case pieceType::FERZ: return "F";
-		case pieceType::CENTAUR: return "C";
-		case pieceType::TESTROOK: return "Tr";
-		case pieceType::CAMEL: return "Cl";
-		default: return "?";
-	}
+	return pieceCode(t);
 }
 
 colorType str_to_color(const std::string& s) {
@@ -74,45 +56,17 @@ colorType str_to_color(const std::string& s) {
 	return colorType::NONE;
 }
 
+// 코드 또는 한 글자 기호, 모르면 NONE
 pieceType str_to_piece(const std::string& s) {
-	if (s == "K") return pieceType::KING;
-	if (s == "Q") return pieceType::QUEEN;
-	if (s == "B") return pieceType::BISHOP;
-	if (s == "N") return pieceType::KNIGHT;
-	if (s == "R") return pieceType::ROOK;
-	if (s == "P") return pieceType::PWAN;
-	if (s == "A") return pieceType::AMAZON;
-	if (s == "G") return pieceType::GRASSHOPPER;
-	if (s == "Kr") return pieceType::KNIGHTRIDER;
-	if (s == "W") return pieceType::ARCHBISHOP;
-	if (s == "D") return pieceType::DABBABA;
-	if (s == "L") return pieceType::ALFIL;
-	if (s == "F") return pieceType::FERZ;
-	if (s == "C") return pieceType::CENTAUR;
-	if (s == "Tr") return pieceType::TESTROOK;
-	if (s == "Cl") return pieceType::CAMEL;
-	return pieceType::NONE;
+	const pieceType t = pieceFromCode(s);
+	if (t != pieceType::NONE) return t;
+	return (s.size() == 1 && std::isupper(static_cast<unsigned char>(s[0]))) ? pieceFromSymbol(s[0]) : pieceType::NONE;
 }
 
 py::dict pocket_to_dict(const std::array<int, POCKET_SIZE> &p) {
 	py::dict d;
-	// Follow pocketIndex ordering from enum.hpp
-	d["K"] = p[0];
-	d["Q"] = p[1];
-	d["B"] = p[2];
-	d["N"] = p[3];
-	d["R"] = p[4];
-	d["P"] = p[5];
-	d["A"] = p[6];
-	d["G"] = p[7];
-	d["Kr"] = p[8];
-	d["W"] = p[9];
-	d["D"] = p[10];
-	d["L"] = p[11];
-	d["F"] = p[12];
-	d["C"] = p[13];
-	d["Tr"] = p[14];
-	d["Cl"] = p[15];
+	// 키 = 코드, 순서 = pocketIndex (레지스트리 순서)
+	for (const pieceTraits &traits : PIECE_TRAITS) d[traits.code] = p[static_cast<size_t>(traits.pocket)];
 	return d;
 }
 
@@ -136,27 +90,199 @@ py::dict piece_to_dict(const piece *p) {
 }
 
 std::array<int, POCKET_SIZE> dict_to_pocket(const py::dict &d) {
-	std::array<int, POCKET_SIZE> p{};
-	// Defaults align with standard starting set; specials default to 0
-	p[0] = d.contains("K") ? d["K"].cast<int>() : 1;
-	p[1] = d.contains("Q") ? d["Q"].cast<int>() : 1;
-	p[2] = d.contains("B") ? d["B"].cast<int>() : 2;
-	p[3] = d.contains("N") ? d["N"].cast<int>() : 2;
-	p[4] = d.contains("R") ? d["R"].cast<int>() : 2;
-	p[5] = d.contains("P") ? d["P"].cast<int>() : 8;
-	p[6] = d.contains("A") ? d["A"].cast<int>() : 0;
-	p[7] = d.contains("G") ? d["G"].cast<int>() : 0;
-	p[8] = d.contains("Kr") ? d["Kr"].cast<int>() : 0;
-	p[9] = d.contains("W") ? d["W"].cast<int>() : 0;
-	p[10] = d.contains("D") ? d["D"].cast<int>() : 0;
-	p[11] = d.contains("L") ? d["L"].cast<int>() : 0;
-	p[12] = d.contains("F") ? d["F"].cast<int>() : 0;
-	p[13] = d.contains("C") ? d["C"].cast<int>() : 0;
-	p[14] = d.contains("Tr") ? d["Tr"].cast<int>() : 0;
-	p[15] = d.contains("Cl") ? d["Cl"].cast<int>() : 0;
+	// 없는 키는 기본 보유량 (표준 기물 세트, 페어리 기물 0)
+	std::array<int, POCKET_SIZE> p = bc_board::defaultPocketStock();
+	for (const pieceTraits &traits : PIECE_TRAITS) {
+		if (d.contains(traits.code)) p[static_cast<size_t>(traits.pocket)] = d[traits.code].cast<int>();
+	}
 	return p;
 }
 
+// boardAction <-> dict ("kind", "piece", "from_file", "from_rank", "to_file", "to_rank", "take", "jumped_file", "jumped_rank", "delta")
+const char *action_kind_to_str(actionType t) {
+	switch (t) {
+		case actionType::DROP: return "drop";
+		case actionType::MOVE: return "move";
+		case actionType::STUN: return "stun";
+		case actionType::PROMOTE: return "promote";
+		case actionType::DISGUISE: return "disguise";
+		case actionType::SUCCESSION: return "succession";
+		default: return "end_turn";
+	}
+}
+
+actionType action_kind_from_str(const std::string &s) {
+	if (s == "drop") return actionType::DROP;
+	if (s == "move") return actionType::MOVE;
+	if (s == "stun") return actionType::STUN;
+	if (s == "promote") return actionType::PROMOTE;
+	if (s == "disguise") return actionType::DISGUISE;
+	if (s == "succession") return actionType::SUCCESSION;
+	if (s == "end_turn") return actionType::END_TURN;
+	throw std::invalid_argument("invalid action kind: " + s);
+}
+
+int square_from_dict(const py::dict &d, const char *fileKey, const char *rankKey) {
+	if (!d.contains(fileKey) || !d.contains(rankKey)) return -1;
+	const int file = d[fileKey].cast<int>();
+	const int rank = d[rankKey].cast<int>();
+	if (file < 0 || file >= 8 || rank < 0 || rank >= 8)
+		throw std::invalid_argument("square out of range");
+	return squareOf(file, rank);
+}
+
+boardAction dict_to_action(const py::dict &d) {
+	boardAction a;
+	a.type = action_kind_from_str(d["kind"].cast<std::string>());
+	if (d.contains("piece")) a.pT = piece_type_from_str(d["piece"].cast<std::string>());
+	const int from = square_from_dict(d, "from_file", "from_rank");
+	const int to = square_from_dict(d, "to_file", "to_rank");
+	const int jumped = square_from_dict(d, "jumped_file", "jumped_rank");
+	if (a.type == actionType::DROP) {
+		// DROP은 도착 칸만 쓰므로 file/rank 키도 허용
+		a.toSquare = static_cast<int8_t>(to >= 0 ? to : square_from_dict(d, "file", "rank"));
+	} else if (a.type == actionType::MOVE) {
+		a.fromSquare = static_cast<int8_t>(from);
+		a.toSquare = static_cast<int8_t>(to);
+	} else {
+		a.fromSquare = static_cast<int8_t>(from >= 0 ? from : square_from_dict(d, "file", "rank"));
+	}
+	a.jumpedSquare = static_cast<int8_t>(jumped);
+	if (d.contains("take")) a.take = d["take"].cast<bool>();
+	if (d.contains("delta")) a.stunDelta = static_cast<int8_t>(d["delta"].cast<int>());
+	return a;
+}
+
+py::dict action_to_dict(const boardAction &a) {
+	py::dict d;
+	d["kind"] = action_kind_to_str(a.type);
+	if (a.pT != pieceType::NONE) d["piece"] = piece_to_str(a.pT);
+	if (a.fromSquare >= 0) {
+		d["from_file"] = squareFile(a.fromSquare);
+		d["from_rank"] = squareRank(a.fromSquare);
+	}
+	if (a.toSquare >= 0) {
+		d["to_file"] = squareFile(a.toSquare);
+		d["to_rank"] = squareRank(a.toSquare);
+	}
+	if (a.type == actionType::MOVE) d["take"] = a.take;
+	if (a.jumpedSquare >= 0) {
+		d["jumped_file"] = squareFile(a.jumpedSquare);
+		d["jumped_rank"] = squareRank(a.jumpedSquare);
+	}
+	if (a.type == actionType::STUN) d["delta"] = int(a.stunDelta);
+	return d;
+}
+
+gameResult game_result_from_str(const std::string &s) {
+	if (s == "white") return gameResult::WHITE_WIN;
+	if (s == "black") return gameResult::BLACK_WIN;
+	if (s == "draw") return gameResult::DRAW;
+	if (s == "" || s == "unknown") return gameResult::UNKNOWN;
+	throw std::invalid_argument("invalid game result: " + s);
+}
+
+std::string game_result_to_str(gameResult r) {
+	switch (r) {
+		case gameResult::WHITE_WIN: return "white";
+		case gameResult::BLACK_WIN: return "black";
+		case gameResult::DRAW: return "draw";
+		default: return "unknown";
+	}
+}
+
+// 엔진 계측 카운터 (stats.hpp): 꺼진 빌드에서는 enabled=False, 값은 모두 0
+py::dict engine_stats() {
+	const engineStats s = readEngineStats();
+	py::dict d;
+	d["enabled"] = ENGINE_STATS_ENABLED;
+	d["legal_move_recomputes"] = s.legalMoveRecomputes;
+	d["pieces_regenerated"] = s.piecesRegenerated;
+	d["legal_move_lists"] = s.legalMoveLists;
+	d["actions"] = s.actions;
+	d["pieces_per_action"] = s.piecesPerAction();
+	d["allocations"] = s.allocations;
+	d["captures"] = s.captures;
+	d["stun_ticks"] = s.stunTicks;
+	py::dict patterns;
+	for (int i = 0; i < PATTERN_KIND_COUNT; ++i) patterns[patternKindName(i)] = s.movesByPattern[i];
+	d["moves_by_pattern"] = patterns;
+	py::dict methods;
+	for (int i = 0; i < BOARD_METHOD_COUNT; ++i) {
+		if (s.methodCalls[i] == 0) continue;
+		py::dict m;
+		m["calls"] = s.methodCalls[i];
+		m["seconds"] = static_cast<double>(s.methodNanos[i]) * 1e-9;
+		methods[boardMethodName(static_cast<boardMethod>(i))] = m;
+	}
+	d["methods"] = methods;
+	return d;
+}
+
+// 패킹된 레코드 배열을 평면 NumPy 배열들로 일괄 디코드 (memmap 대응, GIL 해제 후 처리)
+py::dict decode_packed_batch(py::array_t<packedPosition, py::array::c_style> records) {
+	const py::ssize_t n = records.size();
+	py::array_t<int8_t> types({n, py::ssize_t(64)});
+	py::array_t<int8_t> colors({n, py::ssize_t(64)});
+	py::array_t<uint8_t> royal({n, py::ssize_t(64)});
+	py::array_t<uint8_t> disguised({n, py::ssize_t(64)});
+	py::array_t<uint8_t> secret({n, py::ssize_t(64)});
+	py::array_t<uint8_t> candidate({n, py::ssize_t(64)});
+	py::array_t<uint8_t> stun({n, py::ssize_t(64)});
+	py::array_t<uint8_t> move({n, py::ssize_t(64)});
+	py::array_t<uint8_t> pockets({n, py::ssize_t(2), py::ssize_t(POCKET_SIZE)});
+	py::array_t<int8_t> turn(n);
+	py::array_t<uint8_t> performed(n);
+
+	const packedPosition *in = records.data();
+	int8_t *t = types.mutable_data();
+	int8_t *c = colors.mutable_data();
+	uint8_t *ry = royal.mutable_data();
+	uint8_t *dg = disguised.mutable_data();
+	uint8_t *sr = secret.mutable_data();
+	uint8_t *cd = candidate.mutable_data();
+	uint8_t *st = stun.mutable_data();
+	uint8_t *mv = move.mutable_data();
+	uint8_t *pk = pockets.mutable_data();
+	int8_t *tn = turn.mutable_data();
+	uint8_t *pf = performed.mutable_data();
+	{
+		py::gil_scoped_release release;
+		for (py::ssize_t i = 0; i < n; ++i) {
+			const packedPosition &rec = in[i];
+			for (int sq = 0; sq < 64; ++sq) {
+				const uint8_t code = rec.squares[sq];
+				const py::ssize_t o = i * 64 + sq;
+				t[o] = static_cast<int8_t>(int(code & PACKED_TYPE_MASK) - 1);
+				c[o] = code == 0 ? int8_t(-1) : ((code & PACKED_BLACK) ? int8_t(1) : int8_t(0));
+				ry[o] = (code & PACKED_ROYAL) ? 1 : 0;
+				dg[o] = (code & PACKED_DISGUISED) ? 1 : 0;
+				sr[o] = static_cast<uint8_t>((rec.secretRoyals >> sq) & 1);
+				cd[o] = static_cast<uint8_t>((rec.royalCandidates >> sq) & 1);
+			}
+			std::memcpy(st + i * 64, rec.stun, 64);
+			std::memcpy(mv + i * 64, rec.move, 64);
+			std::memcpy(pk + i * 2 * POCKET_SIZE, rec.pockets, 2 * POCKET_SIZE);
+			tn[i] = (rec.whiteMoveCount == rec.blackMoveCount) ? 0 : 1;
+			pf[i] = rec.flags & PACKED_FLAG_PERFORMED;
+		}
+	}
+
+	py::dict d;
+	d["type"] = types;       // pieceType 값, 빈 칸 -1
+	d["color"] = colors;     // 0 백, 1 흑, 빈 칸 -1
+	d["royal"] = royal;
+	d["disguised"] = disguised;
+	d["secret_royal"] = secret;       // 계승한 비밀 로얄 (royal도 1)
+	d["royal_candidate"] = candidate; // 상대가 보기에 비밀 로얄 후보
+	d["stun"] = stun;
+	d["move_stack"] = move;
+	d["pockets"] = pockets;  // [N, 2(백/흑), 16(pocketIndex)]
+	d["turn"] = turn;        // 0 백 차례, 1 흑 차례
+	d["performed"] = performed;
+	return d;
+}
+
 class PyBoard {
 public:
 	PyBoard() { board.initializeBoard(); }
@@ -169,19 +295,22 @@ public:
     void setupAllPieceMovePattern() { setupAllPieces(&board); }
 
 	bool place_piece(const std::string &type, const std::string &color, int file, int rank) {
-		return board.placePiece(piece_type_from_str(type), color_from_str(color), file, rank);
+		return record(board.placePiece(piece_type_from_str(type), color_from_str(color), file, rank));
 	}
 
 	bool move_piece(int from_file, int from_rank, int to_file, int to_rank) {
-		return board.movePiece(from_file, from_rank, to_file, to_rank);
+		return record(board.movePiece(from_file, from_rank, to_file, to_rank));
 	}
 
-	bool remove_piece(int file, int rank) { return board.removePiece(file, rank); }
+	bool remove_piece(int file, int rank) { return record(board.removePiece(file, rank)); }
+
+	// 마지막 액션의 결과 코드 이름 (예: "OK", "NOT_YOUR_TURN")
+	std::string last_result() const { return actionResultName(lastResult); }
 
 	void next_turn() { board.nextTurn(); }
 
 	std::string turn_color() const { 
-		return (board.getWhiteMoveCount() == board.getBlackMoveCount()) ? "white" : "black"; 
+		return (board.currentPlayerColor() == colorType::WHITE) ? "white" : "black";
 	}
 
 	py::dict pocket(const std::string &color) const {
@@ -199,6 +328,120 @@ public:
 		return out;
 	}
 
+	// 공격 맵: 비트 = rank*8+file
+	uint64_t attack_map(const std::string &color) const {
+		return board.getAttackMap(color_from_str(color));
+	}
+
+	bool is_square_attacked(int file, int rank, const std::string &by) const {
+		return board.isSquareAttacked(file, rank, color_from_str(by));
+	}
+
+	bool in_check(const std::string &color) const {
+		return board.isRoyalPieceInCheck(color_from_str(color));
+	}
+
+	bool royal_capture_threatened(const std::string &color) const {
+		return board.isRoyalCaptureThreatened(color_from_str(color));
+	}
+
+	bool is_checkmated(const std::string &color) const {
+		return board.isRoyalPieceCheckmated(color_from_str(color));
+	}
+
+	int static_exchange(int from_file, int from_rank, int to_file, int to_rank) const {
+		return board.staticExchange(from_file, from_rank, to_file, to_rank);
+	}
+
+	int evaluate(const std::string &perspective) const {
+		return board.evaluate(color_from_str(perspective));
+	}
+
+	py::dict eval_terms(const std::string &color) const {
+		const colorType c = color_from_str(color);
+		const evalTerms t = board.getEvalTerms(c);
+		py::dict d;
+		d["material"] = t.material;
+		d["pocket"] = t.pocket;
+		d["stun_debt"] = t.stunDebt;
+		d["move_stacks"] = t.moveStacks;
+		d["placement"] = t.placement;
+		d["mobility"] = t.mobility;
+		d["royal_safety"] = board.royalSafety(c);
+		return d;
+	}
+
+	void load_network(const std::string &path) {
+		auto loaded = std::make_shared<nnueNetwork>();
+		if (!loaded->load(path)) throw std::runtime_error("not a chesstack NNUE weights file: " + path);
+		network = loaded;
+		board.attachNetwork(network.get());
+	}
+
+	int evaluate_neural(const std::string &perspective) const {
+		return board.evaluateNeural(color_from_str(perspective));
+	}
+
+	std::vector<int> nnue_features(const std::string &perspective) const {
+		return board.getNeuralFeatures(color_from_str(perspective));
+	}
+
+	// viewer가 보는 포지션: 상대 비밀 로얄은 지우고 후보 칸/수만 알려 준다
+	py::dict observe(const std::string &viewer) const {
+		packedPosition seen;
+		royalObservation hidden;
+		board.observe(color_from_str(viewer), seen, hidden);
+		bc_board view;
+		view.decodePacked(seen);
+		py::dict d;
+		d["position"] = view.getPositionString();
+		d["candidates"] = hidden.candidates;       // 비트 = rank*8+file
+		d["hidden_royals"] = hidden.hiddenCount;
+		return d;
+	}
+
+	py::dict information_set_search(int iterations, int rollout_actions, uint64_t seed, unsigned threads) const {
+		ismctsConfig cfg;
+		cfg.iterations = iterations;
+		cfg.rolloutActions = rollout_actions;
+		cfg.seed = seed;
+		ismctsResult r;
+		{
+			py::gil_scoped_release release;
+			if (threads == 1) {
+				r = informationSetSearch(board, cfg);
+			} else {
+				threadPool pool(threads);
+				r = informationSetSearch(board, cfg, &pool);
+			}
+		}
+		py::dict d;
+		d["best"] = action_to_dict(r.best);
+		py::dict visits;
+		for (const auto &[index, count] : r.visits) visits[py::int_(index)] = count;
+		d["visits"] = visits;   // policy 번호 -> 방문 수
+		d["value"] = r.value;
+		return d;
+	}
+
+	// 오프닝 북 키 (book.hpp, 수 카운트 제외)
+	uint64_t position_hash() const { return positionHash(board); }
+
+	// 정책 헤드의 액션 번호 (policy.hpp, 둘 차례 관점)
+	std::vector<int> legal_action_indices() const {
+		std::vector<boardAction> actions;
+		board.collectLegalActions(actions);
+		std::vector<int> out;
+		out.reserve(actions.size());
+		for (const auto &a : actions) out.push_back(policyIndex(a, board.currentPlayerColor()));
+		return out;
+	}
+
+	bool apply_policy_action(int index) {
+		if (index < 0 || index >= POLICY_ACTIONS) throw std::out_of_range("policy action index out of range");
+		return record(board.applyAction(policyAction(index, board.currentPlayerColor())));
+	}
+
 	std::vector<py::dict> legal_moves(int file, int rank) const {
 		std::vector<py::dict> out;
 		piece *p = board.getPiece(file, rank);
@@ -220,34 +463,34 @@ public:
 	}
 
 	bool add_stun(int file, int rank, int delta = 1) {
-		return board.passAndAddStun(file, rank, delta);
+		return record(board.passAndAddStun(file, rank, delta));
 	}
 
 	bool promote(int file, int rank, const std::string &promoteTo) {
-		return board.promote(file, rank, piece_type_from_str(promoteTo));
+		return record(board.promote(file, rank, piece_type_from_str(promoteTo)));
 	}
 
 	bool succeed_royal_piece(int file, int rank) {
 		// file, rank에 있는 기물이 새 로얄 피스가 됨
-		colorType currentColor = (board.getWhiteMoveCount() == board.getBlackMoveCount()) ? colorType::WHITE : colorType::BLACK;
+		colorType currentColor = board.currentPlayerColor();
 		if (!board.hasRoyalPiece(currentColor)) {
-			return false; // 현재 로얄 피스가 없으면 불가능
+			return record(actionResult::NOT_ROYAL); // 현재 로얄 피스가 없으면 불가능
 		}
 		piece* successor = board.getPiece(file, rank);
 		if (!successor || successor->getColor() != currentColor || successor->getPieceType() == pieceType::KING) {
-			return false; // 기물이 없거나 왕이면 불가능
+			return record(actionResult::NOT_OWN_PIECE); // 기물이 없거나 왕이면 불가능
 		}
-		return board.succeedRoyalPiece(file, rank, currentColor);
+		return record(board.succeedRoyalPiece(file, rank, currentColor));
 	}
 
 	bool disguise_piece(int file, int rank, const std::string &disguise_as) {
 		// file, rank에 있는 왕(로얄 피스)이 disguise_as로 변장
-		colorType currentColor = (board.getWhiteMoveCount() == board.getBlackMoveCount()) ? colorType::WHITE : colorType::BLACK;
+		colorType currentColor = board.currentPlayerColor();
 		piece* royal = board.getPiece(file, rank);
 		if (!royal || !royal->isRoyal() || royal->getColor() != currentColor) {
-			return false; // 기물이 없거나 왕이 아니면 불가능
+			return record(actionResult::NOT_ROYAL); // 기물이 없거나 왕이 아니면 불가능
 		}
-		return board.disguisePiece(file, rank, piece_type_from_str(disguise_as));
+		return record(board.disguisePiece(file, rank, piece_type_from_str(disguise_as)));
 	}
 
 	int white_move_count() const { return board.getWhiteMoveCount(); }
@@ -255,8 +498,42 @@ public:
 
 	void print_board() const { board.printBoard(); }
 	
-	// 포지션 설정: 리스트 그대로 또는 {"turn": "white/black", "pieces": [...], "pockets": {"white": {...}, "black": {...}}}
+	// 전체 상태 포지션 문자열 (형식은 src/position.cpp 참고)
+	std::string position_string() const { return board.getPositionString(); }
+
+	void load_position_string(const std::string &text) {
+		if (!board.loadPositionString(text)) {
+			throw std::invalid_argument("invalid position string: " + text);
+		}
+	}
+
+	// 고정 크기 바이너리 레코드 (src/packed.hpp), 길이 1의 구조체 배열로 반환
+	py::array_t<packedPosition> to_packed() const {
+		py::array_t<packedPosition> out(1);
+		board.encodePacked(*out.mutable_data(0));
+		return out;
+	}
+
+	// 레코드 하나(구조체 배열 원소/배열, bytes 등 버퍼 프로토콜 객체)를 로드
+	void load_packed(const py::buffer &record) {
+		py::buffer_info info = record.request();
+		if (info.size * info.itemsize != static_cast<py::ssize_t>(sizeof(packedPosition))) {
+			throw std::invalid_argument("packed record must be exactly " + std::to_string(sizeof(packedPosition)) + " bytes");
+		}
+		packedPosition pos;
+		std::memcpy(&pos, info.ptr, sizeof(pos));
+		if (!board.decodePacked(pos)) {
+			throw std::invalid_argument("invalid packed record");
+		}
+	}
+
+	// 포지션 설정: 포지션 문자열, 리스트 그대로 또는 {"turn": "white/black", "pieces": [...], "pockets": {"white": {...}, "black": {...}}}
 	void setup_position(const py::object& position_obj) {
+		if (py::isinstance<py::str>(position_obj)) {
+			load_position_string(position_obj.cast<std::string>());
+			return;
+		}
+
 		py::list piece_list;
 		colorType turn = colorType::WHITE;
 		std::array<int, POCKET_SIZE> whitePocketOverride{};
@@ -311,8 +588,285 @@ public:
 		}
 	}
 
+	bool apply_action(const py::dict &action) {
+		return record(board.applyAction(dict_to_action(action)));
+	}
+
+	// 액션 dict 목록을 applyActions 한 번으로 적용 (합법수 재계산은 끝에서 한 번)
+	py::dict apply_actions(const py::list &actions) {
+		std::vector<boardAction> batch;
+		batch.reserve(actions.size());
+		for (auto item : actions) batch.push_back(dict_to_action(item.cast<py::dict>()));
+		actionBatchReport report;
+		{
+			py::gil_scoped_release release;
+			report = board.applyActions(batch);
+		}
+		lastResult = report.result;
+		py::dict d;
+		d["result"] = actionResultName(report.result);
+		d["applied"] = report.firstInvalid;                                                   // 적용된 액션 수
+		d["first_invalid"] = report.result == actionResult::OK ? py::object(py::none()) : py::cast(report.firstInvalid);
+		return d;
+	}
+
+	bool apply_notation(const std::string &token) {
+		return record(board.applyNotation(token));
+	}
+
+	py::dict replay_notation(const std::string &text) {
+		replayReport report;
+		{
+			py::gil_scoped_release release;
+			report = board.replayNotation(text);
+		}
+		lastResult = report.result;
+		py::dict d;
+		d["result"] = actionResultName(report.result);
+		d["actions"] = report.actionsApplied;
+		d["error_offset"] = report.errorOffset;   // 실패한 토큰 위치 (성공 시 0)
+		d["error_length"] = report.errorLength;
+		return d;
+	}
+
+	const bc_board &native() const { return board; }
+
 private:
+	bool record(actionResult result) {
+		lastResult = result;
+		return result == actionResult::OK;
+	}
+
 	bc_board board;
+	actionResult lastResult = actionResult::OK;
+	std::shared_ptr<nnueNetwork> network; // board가 가리키는 NNUE 가중치
+};
+
+// 정책/가치 네트워크: 보드 리스트를 한 번에 추론 (GIL 해제)
+class PyPolicyNetwork {
+public:
+	explicit PyPolicyNetwork(const std::string &path) {
+		if (!net.load(path)) throw std::runtime_error("not a chesstack policy weights file: " + path);
+	}
+
+	py::tuple evaluate(const std::vector<const PyBoard *> &boards) {
+		batch.clear();
+		for (const PyBoard *b : boards) batch.add(b->native());
+		{
+			py::gil_scoped_release release;
+			net.forward(batch, work);
+		}
+		const py::ssize_t n = static_cast<py::ssize_t>(boards.size());
+		py::array_t<float> logits({n, py::ssize_t(POLICY_ACTIONS)});
+		py::array_t<float> values(n);
+		float *lg = logits.mutable_data();
+		for (py::ssize_t i = 0; i < n; ++i) {
+			std::memcpy(lg + i * POLICY_ACTIONS, work.logitsOf(static_cast<size_t>(i)), sizeof(float) * POLICY_ACTIONS);
+		}
+		if (n > 0) std::memcpy(values.mutable_data(), work.values.data(), sizeof(float) * static_cast<size_t>(n));
+		return py::make_tuple(logits, values);
+	}
+
+	int hidden_size() const { return net.hiddenSize(); }
+	int block_count() const { return net.blockCount(); }
+
+private:
+	policyNetwork net;
+	policyBatch batch;
+	policyWorkspace work;
+};
+
+// 리프 배치 탐색: 배치마다 Python 콜백을 한 번 호출
+//   callback(features: uint8[B, NNUE_FEATURES]) -> (logits[B, POLICY_ACTIONS], values[B])
+// 콜백이 도는 동안(GIL 보유) 다른 트리 그룹은 워커 스레드에서 선택/역전파를 진행한다.
+class PyBatchedSearch {
+public:
+	PyBatchedSearch(int simulations, int leaves_per_tree, float c_puct, unsigned threads)
+		: search(make_config(simulations, leaves_per_tree, c_puct, threads)) {}
+
+	std::vector<py::dict> run(const std::vector<const PyBoard *> &boards, py::function callback) {
+		std::vector<const bc_board *> roots;
+		roots.reserve(boards.size());
+		for (const PyBoard *b : boards) roots.push_back(&b->native());
+
+		auto evaluate = [&callback](const policyBatch &batch, policyWorkspace &out) {
+			const py::ssize_t n = static_cast<py::ssize_t>(batch.size());
+			py::array_t<uint8_t> features({n, py::ssize_t(NNUE_FEATURES)});
+			uint8_t *f = features.mutable_data();
+			std::memset(f, 0, static_cast<size_t>(n) * NNUE_FEATURES);
+			for (py::ssize_t i = 0; i < n; ++i) {
+				const int *active = batch.featuresOf(static_cast<size_t>(i));
+				for (size_t k = 0; k < batch.featureCount(static_cast<size_t>(i)); ++k) f[i * NNUE_FEATURES + active[k]] = 1;
+			}
+			py::tuple result = callback(features).cast<py::tuple>();
+			if (result.size() != 2) throw std::runtime_error("search callback must return (logits, values)");
+			auto logits = result[0].cast<py::array_t<float, py::array::c_style | py::array::forcecast>>();
+			auto values = result[1].cast<py::array_t<float, py::array::c_style | py::array::forcecast>>();
+			if (logits.ndim() != 2 || logits.shape(0) != n || logits.shape(1) != POLICY_ACTIONS || values.size() != n) {
+				throw std::runtime_error("search callback returned arrays of the wrong shape");
+			}
+			out.logitStride = POLICY_ACTIONS;
+			out.logits.assign(logits.data(), logits.data() + logits.size());
+			out.values.assign(values.data(), values.data() + n);
+		};
+		search.run(roots, evaluate);
+
+		std::vector<py::dict> out;
+		for (size_t t = 0; t < search.treeCount(); ++t) {
+			const searchResult r = search.result(t);
+			py::array_t<int32_t> indices(static_cast<py::ssize_t>(r.visits.size()));
+			py::array_t<int32_t> counts(static_cast<py::ssize_t>(r.visits.size()));
+			for (size_t k = 0; k < r.visits.size(); ++k) {
+				indices.mutable_data()[k] = r.visits[k].first;
+				counts.mutable_data()[k] = r.visits[k].second;
+			}
+			py::dict d;
+			d["best"] = action_to_dict(r.best);
+			d["indices"] = indices;   // 루트 합법 액션의 policy 번호
+			d["visits"] = counts;
+			d["value"] = r.value;
+			out.push_back(d);
+		}
+		return out;
+	}
+
+	py::dict stats() const {
+		const searchStats &s = search.stats();
+		py::dict d;
+		d["batches"] = s.batches;
+		d["leaves"] = s.leaves;
+		d["terminal_leaves"] = s.terminalLeaves;
+		d["largest_batch"] = s.largestBatch;
+		d["evaluator_seconds"] = s.evaluatorSeconds;
+		d["total_seconds"] = s.totalSeconds;
+		return d;
+	}
+
+private:
+	static searchConfig make_config(int simulations, int leaves_per_tree, float c_puct, unsigned threads) {
+		searchConfig cfg;
+		cfg.simulations = simulations;
+		cfg.leavesPerTree = leaves_per_tree;
+		cfg.cPuct = c_puct;
+		cfg.threads = threads;
+		return cfg;
+	}
+
+	batchedSearch search;
+};
+
+// 착수 단계 오프닝 북 (bc_book으로 만든 .bcob를 mmap)
+class PyOpeningBook {
+public:
+	explicit PyOpeningBook(const std::string &path) {
+		if (!book.open(path)) throw std::runtime_error("not an opening book file: " + path);
+	}
+
+	// 후보 액션 리스트 (가중치 내림차순), 없으면 빈 리스트
+	py::list probe(const PyBoard &b) const {
+		std::vector<bookMove> moves;
+		py::list out;
+		if (!book.probe(b.native(), moves)) return out;
+		const colorType mover = b.native().currentPlayerColor();
+		for (const auto &m : moves) {
+			py::dict d;
+			d["action"] = action_to_dict(policyAction(m.policyIndex, mover));
+			d["index"] = m.policyIndex;
+			d["weight"] = m.weight;
+			out.append(d);
+		}
+		return out;
+	}
+
+	// 가중치 비례 선택, 없으면 None
+	py::object pick(const PyBoard &b, uint64_t seed) const {
+		// splitmix64로 시드를 섞어 연속된 시드도 고르게
+		uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		boardAction a;
+		if (!book.pick(b.native(), z ^ (z >> 31), a)) return py::none();
+		return action_to_dict(a);
+	}
+
+	size_t size() const { return book.size(); }
+
+private:
+	openingBook book;
+};
+
+// 엔드게임 테이블베이스 (bc_tablebase로 만든 .bctb를 mmap)
+class PyTablebase {
+public:
+	explicit PyTablebase(const std::string &path) {
+		if (!table.open(path)) throw std::runtime_error("not a tablebase file: " + path);
+	}
+
+	// 표 밖이면 None, 아니면 {"result": "win"/"loss"/"draw", "turns": n} (둘 차례 기준, draw는 증명되지 않음 포함)
+	py::object probe(const PyBoard &b) const {
+		int value = 0;
+		if (!table.probe(b.native(), value)) return py::none();
+		py::dict d;
+		d["result"] = value > 0 ? "win" : (value < 0 ? "loss" : "draw");
+		d["turns"] = value > 0 ? value : -value;
+		return d;
+	}
+
+	std::string signature() const { return table.signature().name(); }
+	uint64_t size() const { return table.size(); }
+
+private:
+	tablebase table;
+};
+
+// 게임 기록 파일 기록기 (with 문 지원)
+class PyGameRecordWriter {
+public:
+	explicit PyGameRecordWriter(const std::string &path) {
+		if (!writer.open(path)) throw std::runtime_error("cannot open game record: " + path);
+	}
+
+	void begin_game(const PyBoard &initial) { writer.beginGame(initial.native()); }
+	void add_action(const py::dict &action) { writer.addAction(dict_to_action(action)); }
+	bool end_game(const std::string &result) { return writer.endGame(game_result_from_str(result)); }
+	void close() { writer.close(); }
+
+private:
+	gameRecordWriter writer;
+};
+
+// 게임 기록 파일 리더: 게임마다 {"result", "initial", "actions"} dict를 돌려주는 이터레이터
+class PyGameRecordReader {
+public:
+	explicit PyGameRecordReader(const std::string &path) {
+		if (!reader.open(path)) throw std::runtime_error("not a game record file: " + path);
+	}
+
+	py::dict next() {
+		gameRecordView view;
+		if (!reader.nextGame(view)) {
+			if (reader.isCorrupt()) throw std::runtime_error("corrupt game record");
+			throw py::stop_iteration();
+		}
+		bc_board initial;
+		if (!view.loadInitial(initial)) throw std::runtime_error("corrupt initial position");
+
+		py::list actions;
+		boardAction a;
+		while (view.nextAction(a)) actions.append(action_to_dict(a));
+		if (actions.size() != view.actionCount()) throw std::runtime_error("corrupt action stream");
+
+		py::dict d;
+		d["result"] = game_result_to_str(view.result());
+		d["initial"] = initial.getPositionString();
+		d["actions"] = actions;
+		return d;
+	}
+
+	void rewind() { reader.rewind(); }
+
+private:
+	gameRecordReader reader;
 };
 
 } // namespace
@@ -320,6 +874,28 @@ private:
 PYBIND11_MODULE(chess_python, m) {
 	m.doc() = "Python bindings for the 변형체스 engine";
 
+	PYBIND11_NUMPY_DTYPE(packedPosition, squares, stun, move, pockets,
+		whiteMoveCount, blackMoveCount, flags, activeSquare, reserved, secretRoyals, royalCandidates);
+	m.attr("PACKED_POSITION_DTYPE") = py::dtype::of<packedPosition>();
+	m.def("decode_packed_batch", &decode_packed_batch, py::arg("records"),
+		"Decode an array of PACKED_POSITION_DTYPE records (e.g. np.memmap) into per-field NumPy arrays");
+	m.attr("ENGINE_STATS_ENABLED") = ENGINE_STATS_ENABLED;
+	m.def("engine_stats", &engine_stats, "Engine counters and per-method timers summed over all boards (zeros unless built with BC_ENABLE_STATS)");
+	m.def("reset_engine_stats", &resetEngineStats, "Zero the engine counters and timers");
+	m.attr("ENGINE_TRACE_ENABLED") = ENGINE_TRACE_ENABLED;
+	m.def("start_trace", &startTrace, py::arg("events_per_thread") = size_t(1) << 16,
+		"Start recording engine scopes into per-thread ring buffers (no-op unless built with BC_ENABLE_TRACE)");
+	m.def("stop_trace", &stopTrace);
+	m.def("write_trace", &writeTrace, py::arg("path"), "Stop recording and write Chrome trace-event JSON (open in ui.perfetto.dev)");
+	m.def("trace_summary", [] {
+		const traceSummary t = summarizeTrace();
+		py::dict d;
+		d["events"] = t.events;
+		d["dropped"] = t.dropped;
+		d["threads"] = t.threads;
+		return d;
+	}, "Events kept/overwritten in the current trace");
+
 	py::class_<PyBoard>(m, "Board")
 		.def(py::init<>())
 		.def(py::init<const py::dict &, const py::dict &>(), 
@@ -331,16 +907,85 @@ PYBIND11_MODULE(chess_python, m) {
 		.def("move_piece", &PyBoard::move_piece, py::arg("from_file"), py::arg("from_rank"), py::arg("to_file"), py::arg("to_rank"))
 		.def("remove_piece", &PyBoard::remove_piece, py::arg("file"), py::arg("rank"))
 		.def("next_turn", &PyBoard::next_turn)
+		.def("last_result", &PyBoard::last_result, "Result code name of the last action (e.g. \"OK\", \"NOT_YOUR_TURN\")")
 		.def("turn_color", &PyBoard::turn_color)
 		.def("pocket", &PyBoard::pocket, py::arg("color"), "Get pocket counts as dict")
 		.def("board_state", &PyBoard::board_state, "List of pieces with positions and stacks")
-		.def("legal_moves", &PyBoard::legal_moves, py::arg("file"), py::arg("rank"), "Legal moves for a square")
+		.def("legal_moves", &PyBoard::legal_moves, py::arg("file"), py::arg("rank"), "Legal moves for a square (computed on first query after the position changes, then cached)")
+		.def("attack_map", &PyBoard::attack_map, py::arg("color"), "Bitmask of squares the color attacks, stunned pieces included (bit = rank*8+file)")
+		.def("is_square_attacked", &PyBoard::is_square_attacked, py::arg("file"), py::arg("rank"), py::arg("by"))
+		.def("in_check", &PyBoard::in_check, py::arg("color"), "True if any royal piece of the color is attacked")
+		.def("royal_capture_threatened", &PyBoard::royal_capture_threatened, py::arg("color"), "True if a ready enemy piece can capture a royal piece next turn")
+		.def("is_checkmated", &PyBoard::is_checkmated, py::arg("color"), "True if no action this turn prevents a royal capture (succession allowed)")
+		.def("static_exchange", &PyBoard::static_exchange, py::arg("from_file"), py::arg("from_rank"), py::arg("to_file"), py::arg("to_rank"), "Expected exchange gain on the target square for the moving side (pawn = 100)")
+		.def("evaluate", &PyBoard::evaluate, py::arg("perspective"), "Static evaluation from the perspective color (pawn = 100), maintained incrementally per action")
+		.def("eval_terms", &PyBoard::eval_terms, py::arg("color"), "Unweighted evaluation terms for one color")
+		.def("load_network", &PyBoard::load_network, py::arg("path"), "Load NNUE weights (.bcnn) and attach them to this board")
+		.def("evaluate_neural", &PyBoard::evaluate_neural, py::arg("perspective"), "NNUE evaluation (falls back to evaluate() without a network)")
+		.def("nnue_features", &PyBoard::nnue_features, py::arg("perspective"), "Active NNUE input feature indices for training data")
+		.def("observe", &PyBoard::observe, py::arg("viewer"), "Position as seen by viewer: opponent's secret royals hidden, with candidate mask and count")
+		.def("information_set_search", &PyBoard::information_set_search, py::arg("iterations") = 4000, py::arg("rollout_actions") = 48,
+			py::arg("seed") = 1, py::arg("threads") = 0, "ISMCTS from the side to move's observation (never reads the opponent's secret royal)")
+		.def("position_hash", &PyBoard::position_hash, "Opening book key of the current position (move counts excluded)")
+		.def("legal_action_indices", &PyBoard::legal_action_indices, "Policy head indices of every action the side to move can take now")
+		.def("apply_policy_action", &PyBoard::apply_policy_action, py::arg("index"), "Apply the action with the given policy head index")
 		.def("add_stun", &PyBoard::add_stun, py::arg("file"), py::arg("rank"), py::arg("delta") = 1, "Pass turn and add stun to a non-king piece")
 		.def("promote", &PyBoard::promote, py::arg("file"), py::arg("rank"), py::arg("promoteTo"), "Promote pawn to another piece")
 		.def("succeed_royal_piece", &PyBoard::succeed_royal_piece, py::arg("file"), py::arg("rank"), "Make a piece the new royal piece")
 		.def("disguise_piece", &PyBoard::disguise_piece, py::arg("file"), py::arg("rank"), py::arg("disguise_as"), "Disguise royal piece as another piece type")
 		.def("white_move_count", &PyBoard::white_move_count, "Get white's move count")
 		.def("black_move_count", &PyBoard::black_move_count, "Get black's move count")
-		.def("setup_position", &PyBoard::setup_position, py::arg("piece_list"), "Setup custom position from list of pieces")
+		.def("setup_position", &PyBoard::setup_position, py::arg("piece_list"), "Setup custom position from list of pieces or a position string")
+		.def("position_string", &PyBoard::position_string, "Full-state position string (placement, stacks, royal/disguise, pockets, turn state)")
+		.def("load_position_string", &PyBoard::load_position_string, py::arg("text"), "Load a full-state position string")
+		.def("to_packed", &PyBoard::to_packed, "Encode as a 1-element PACKED_POSITION_DTYPE array")
+		.def("load_packed", &PyBoard::load_packed, py::arg("record"), "Load a PACKED_POSITION_DTYPE record or 248-byte buffer")
+		.def("apply_notation", &PyBoard::apply_notation, py::arg("token"), "Resolve one notation token (e.g. \"Nbd7\", \"H@c3\", \"f1=Q\", \"suc e5\") against legal moves and apply it")
+		.def("replay_notation", &PyBoard::replay_notation, py::arg("text"), "Replay a whole game text; returns result name, applied action count and first failing token span")
+		.def("apply_action", &PyBoard::apply_action, py::arg("action"), "Apply one action dict (kind: drop/move/stun/promote/disguise/succession/end_turn)")
+		.def("apply_actions", &PyBoard::apply_actions, py::arg("actions"), "Apply a list of action dicts in one call, recomputing legal moves once at the end; returns result name, applied count and first_invalid index (None if all applied)")
 		.def("print_board", &PyBoard::print_board);
+
+	m.attr("NNUE_FEATURES") = NNUE_FEATURES;
+	m.attr("POLICY_ACTIONS") = POLICY_ACTIONS;
+	py::class_<PyPolicyNetwork>(m, "PolicyNetwork")
+		.def(py::init<const std::string &>(), py::arg("path"), "Load policy/value weights (.bcpv)")
+		.def("evaluate", &PyPolicyNetwork::evaluate, py::arg("boards"),
+			"Batched inference; returns (logits float32[B, POLICY_ACTIONS], values float32[B]) from each side to move")
+		.def("hidden_size", &PyPolicyNetwork::hidden_size)
+		.def("block_count", &PyPolicyNetwork::block_count);
+
+	py::class_<PyBatchedSearch>(m, "BatchedSearch")
+		.def(py::init<int, int, float, unsigned>(), py::arg("simulations") = 256, py::arg("leaves_per_tree") = 8,
+			py::arg("c_puct") = 1.5f, py::arg("threads") = 0)
+		.def("run", &PyBatchedSearch::run, py::arg("boards"), py::arg("callback"),
+			"Search every board; callback(features uint8[B, NNUE_FEATURES]) -> (logits[B, POLICY_ACTIONS], values[B]) is called once per leaf batch")
+		.def("stats", &PyBatchedSearch::stats, "Batch count/size and evaluator time of the last run");
+
+	py::class_<PyOpeningBook>(m, "OpeningBook")
+		.def(py::init<const std::string &>(), py::arg("path"), "Memory-map an opening book file (.bcob)")
+		.def("probe", &PyOpeningBook::probe, py::arg("board"), "Book actions for the board as [{action, index, weight}], best first")
+		.def("pick", &PyOpeningBook::pick, py::arg("board"), py::arg("seed") = 0, "Weighted random book action, or None when out of book")
+		.def("__len__", &PyOpeningBook::size);
+
+	py::class_<PyTablebase>(m, "Tablebase")
+		.def(py::init<const std::string &>(), py::arg("path"), "Memory-map an endgame tablebase file (.bctb)")
+		.def("probe", &PyTablebase::probe, py::arg("board"), "None outside the table, else {result: win/loss/draw, turns} for the side to move")
+		.def("signature", &PyTablebase::signature, "Royal types, extra pieces and stack horizons (e.g. \"K:R s2m2\")")
+		.def("__len__", &PyTablebase::size);
+
+	py::class_<PyGameRecordWriter>(m, "GameRecordWriter")
+		.def(py::init<const std::string &>(), py::arg("path"), "Open (append) a binary game record file")
+		.def("begin_game", &PyGameRecordWriter::begin_game, py::arg("board"), "Start a game from the board's current state")
+		.def("add_action", &PyGameRecordWriter::add_action, py::arg("action"))
+		.def("end_game", &PyGameRecordWriter::end_game, py::arg("result") = "unknown", "Finish the game (result: white/black/draw/unknown)")
+		.def("close", &PyGameRecordWriter::close)
+		.def("__enter__", [](PyGameRecordWriter &w) -> PyGameRecordWriter & { return w; })
+		.def("__exit__", [](PyGameRecordWriter &w, py::args) { w.close(); });
+
+	py::class_<PyGameRecordReader>(m, "GameRecordReader")
+		.def(py::init<const std::string &>(), py::arg("path"), "Memory-map a binary game record file")
+		.def("__iter__", [](PyGameRecordReader &r) -> PyGameRecordReader & { return r; })
+		.def("__next__", &PyGameRecordReader::next)
+		.def("rewind", &PyGameRecordReader::rewind);
 }
\ No newline at end of file
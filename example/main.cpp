@@ -40,7 +40,7 @@ int main() {
     piece* king = board.getPiece(3, 3);
     if (king) {
         king->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, KING_DIRECTIONS, 1));
-        king->calculateAndUpdateLegalMoves(&board);
+        board.updatePieceLegalMoves(king);
         std::cout << "\nKing at d4 legal moves:" << std::endl;
         for (const auto& m : king->getLegalMoves()) {
             std::cout << " - " << char('a' + m.startFile) << (m.startRank + 1)
@@ -53,7 +53,7 @@ int main() {
     piece* queen = board.getPiece(4, 4);
     if (queen) {
         queen->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_INFINITE, QUEEN_DIRECTIONS));
-        queen->calculateAndUpdateLegalMoves(&board);
+        board.updatePieceLegalMoves(queen);
         std::cout << "\nQueen at e5 legal moves:" << std::endl;
         for (const auto& m : queen->getLegalMoves()) {
             std::cout << " - " << char('a' + m.startFile) << (m.startRank + 1)
@@ -63,7 +63,7 @@ int main() {
     }
 
     // 합법 이동 계산
-    kn->calculateAndUpdateLegalMoves(&board);
+    board.updatePieceLegalMoves(kn);
 
     // 결과 출력
     const auto& moves = kn->getLegalMoves();
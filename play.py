@@ -53,6 +53,7 @@ DARK = (118, 150, 86)
 SELECTED = (186, 202, 68)
 TARGET = (244, 247, 116)
 LAST = (246, 246, 105)
+CHECK = (220, 90, 80)
 TEXT = (20, 20, 20)
 PANEL_BG = (32, 32, 32)
 PANEL_TEXT = (235, 235, 235)
@@ -134,8 +135,20 @@ class EngineState:
             "white": self.engine.pocket("white"),
             "black": self.engine.pocket("black"),
         }
+        # 공격 맵(비트 = rank*8+file): 상대에게 공격받는 로얄 피스 칸을 강조
+        self.attacks = {
+            "white": self.engine.attack_map("white"),
+            "black": self.engine.attack_map("black"),
+        }
         self._check_royal_elimination()
 
+    def royal_in_check(self, x: int, y: int) -> bool:
+        p = self.pieces.get((x, y))
+        if not p or not p.get("royal"):
+            return False
+        enemy = "black" if p["color"] == "white" else "white"
+        return bool((self.attacks[enemy] >> (y * 8 + x)) & 1)
+
     def _check_royal_elimination(self) -> None:
         """If a side has no royal piece after the opening turn, end the game."""
         total_moves = self.engine.white_move_count() + self.engine.black_move_count()
@@ -298,6 +311,8 @@ def draw(gs: EngineState, screen, font, info_font) -> None:
             base = LIGHT if (file + rank) % 2 == 0 else DARK
             if (file, rank) in gs.last_move:
                 base = LAST
+            if gs.royal_in_check(file, rank):
+                base = CHECK
             if gs.selected == (file, rank):
                 base = SELECTED
             elif (file, rank) in gs.targets:
@@ -567,7 +582,7 @@ def handle_click(gs: EngineState, pos: Tuple[int, int]) -> None:
                     gs.selected = None
                     gs.targets = []
                 else:
-                    gs.status = "Succession failed"
+                    gs.status = f"Succession failed ({gs.engine.last_result()})"
             else:
                 gs.status = "Cannot use king as successor"
         else:
@@ -627,7 +642,10 @@ def main() -> None:
                     gs.status = "Stun mode"
                 elif event.key == pygame.K_u:
                     gs.mode = "succession"
-                    gs.status = "Succession mode (선택할 기물 클릭)"
+                    if gs.engine.is_checkmated(gs.turn):
+                        gs.status = "Succession mode (선택할 기물 클릭)"
+                    else:
+                        gs.status = "Succession mode: 체크메이트일 때만 가능"
                 elif event.key == pygame.K_v:
                     gs.mode = "disguise"
                     gs.status = "Disguise mode (변장할 킹 선택)"
@@ -0,0 +1,102 @@
+#include <gameboard.hpp>
+
+// 단일 액션 적용: 각 공개 액션 함수로 위임한다
+actionResult bc_board::applyAction(const boardAction& action) {
+    BC_STAT_TIMER(APPLY_ACTION);
+    BC_TRACE_METHOD(APPLY_ACTION);
+    const int fromFile = action.fromSquare >= 0 ? squareFile(action.fromSquare) : -1;
+    const int fromRank = action.fromSquare >= 0 ? squareRank(action.fromSquare) : -1;
+    const int toFile = action.toSquare >= 0 ? squareFile(action.toSquare) : -1;
+    const int toRank = action.toSquare >= 0 ? squareRank(action.toSquare) : -1;
+
+    switch(action.type) {
+        case actionType::DROP:
+            return placePiece(action.pT, currentPlayerColor(), toFile, toRank);
+        case actionType::MOVE:
+            return movePiece(fromFile, fromRank, toFile, toRank);
+        case actionType::STUN:
+            return passAndAddStun(fromFile, fromRank, action.stunDelta);
+        case actionType::PROMOTE:
+            return promote(fromFile, fromRank, action.pT);
+        case actionType::DISGUISE:
+            return disguisePiece(fromFile, fromRank, action.pT);
+        case actionType::SUCCESSION:
+            return succeedRoyalPiece(fromFile, fromRank, currentPlayerColor());
+        case actionType::END_TURN:
+            nextTurn();
+            return actionResult::OK;
+    }
+    return actionResult::ILLEGAL_MOVE;
+}
+
+// 액션 묶음 적용: 각 액션은 applyAction과 같은 검사를 거치지만 합법수 재계산은 끝에서 한 번만 한다
+// (이동은 움직이는 기물만, 계승은 체크메이트 판정 전에 미뤄 둔 재계산을 먼저 처리)
+actionBatchReport bc_board::applyActions(const boardAction* actions, size_t count) {
+    BC_STAT_TIMER(APPLY_ACTIONS);
+    BC_TRACE_METHOD(APPLY_ACTIONS);
+    actionBatchReport report;
+    refreshDeferred = true;
+    for(; report.firstInvalid < count; ++report.firstInvalid) {
+        const boardAction& action = actions[report.firstInvalid];
+        if(action.type == actionType::SUCCESSION) {
+            flushDeferredRefresh();
+            refreshDeferred = true;
+        }
+        report.result = applyAction(action);
+        if(report.result != actionResult::OK) break;
+    }
+    flushDeferredRefresh();
+    return report;
+}
+
+// 현재 차례가 지금 할 수 있는 액션 목록 (각 공개 액션 함수의 거절 조건을 그대로 따른다)
+void bc_board::collectLegalActions(std::vector<boardAction>& out) const {
+    BC_STAT_TIMER(COLLECT_LEGAL_ACTIONS);
+    BC_TRACE_METHOD(COLLECT_LEGAL_ACTIONS);
+    out.clear();
+    const colorType color = currentPlayerColor();
+
+    if(!performedActionThisTurn) {
+        // 착수: 포켓에 남은 기물 x 빈 칸 (폰은 상대 진영 최종 랭크 제외)
+        const auto& pocket = fullPocketForColor(color);
+        const int pawnFinalRank = (color == colorType::WHITE) ? BOARD_SIZE - 1 : 0;
+        for(int kind = 0; kind < POCKET_SIZE; ++kind) {
+            if(pocket[kind] <= 0) continue;
+            const pieceType type = static_cast<pieceType>(kind); // 포켓 인덱스는 pieceType 순서
+            for(int sq = 0; sq < BOARD_SIZE * BOARD_SIZE; ++sq) {
+                if(board[squareFile(sq)][squareRank(sq)] != nullptr) continue;
+                if(type == pieceType::PWAN && squareRank(sq) == pawnFinalRank) continue;
+                out.push_back(boardAction::drop(type, sq));
+            }
+        }
+        // 스턴: 보드 위 아무 기물
+        for(const auto& p : pieces) out.push_back(boardAction::stun(squareOf(p.getFile(), p.getRank())));
+    }
+
+    // 이동: 스턴이 아니고 이동 스택이 있는 자기 기물 (이미 액션했으면 그 기물만)
+    for(const auto& p : pieces) {
+        if(p.getColor() != color || p.isStunned() || p.getMoveStack() <= 0) continue;
+        if(performedActionThisTurn && activePieceThisTurn != &p) continue;
+        const int from = squareOf(p.getFile(), p.getRank());
+        for(const PGN& m : p.getLegalMoves()) out.push_back(boardAction::move(from, squareOf(m.endFile, m.endRank)));
+    }
+
+    const int promotionRank = (color == colorType::WHITE) ? BOARD_SIZE - 1 : 0;
+    const bool mated = isRoyalPieceCheckmated(color);
+    for(const auto& p : pieces) {
+        if(p.getColor() != color) continue;
+        const int sq = squareOf(p.getFile(), p.getRank());
+        // 프로모션/변장: 킹, 폰이 아닌 모든 기물 종류
+        const bool promotable = p.getPieceType() == pieceType::PWAN && p.getRank() == promotionRank;
+        for(int kind = 0; kind < POCKET_SIZE && (promotable || p.isRoyal()); ++kind) {
+            const pieceType type = static_cast<pieceType>(kind);
+            if(type == pieceType::KING || type == pieceType::PWAN) continue;
+            if(promotable) out.push_back(boardAction::promote(sq, type));
+            if(p.isRoyal()) out.push_back(boardAction::disguise(sq, type));
+        }
+        // 계승: 체크메이트일 때 로얄이 아닌 자기 기물
+        if(mated && !p.isRoyal()) out.push_back(boardAction::succession(sq));
+    }
+
+    out.push_back(boardAction::endTurn());
+}
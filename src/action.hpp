@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <enum.hpp>
+
+// 보드 액션 종류 (한 턴 = 0개 이상의 액션 + END_TURN)
+enum class actionType : uint8_t {
+    DROP,        // 포켓에서 착수
+    MOVE,        // 기물 이동 (같은 기물의 연속 이동은 MOVE 여러 개)
+    STUN,        // 기물에 스턴 추가
+    PROMOTE,     // 폰 프로모션
+    DISGUISE,    // 로얄 피스 변장
+    SUCCESSION,  // 로얄 피스 계승
+    END_TURN     // 턴 종료 (nextTurn)
+};
+
+// 색상 정보 없이 현재 차례 기준으로 해석되는 단일 액션.
+// 칸 인덱스 = rank * 8 + file, 해당 없는 칸은 -1
+struct boardAction {
+    actionType type = actionType::END_TURN;
+    pieceType pT = pieceType::NONE; // DROP: 착수 기물, PROMOTE: 승격 기물, DISGUISE: 변장 기물
+    int8_t fromSquare = -1;         // MOVE 출발 칸, STUN/PROMOTE/DISGUISE/SUCCESSION 대상 칸
+    int8_t toSquare = -1;           // DROP/MOVE 도착 칸
+    int8_t jumpedSquare = -1;       // MOVE: TAKEJUMP로 함께 잡힌 칸 (정보용)
+    bool take = false;              // MOVE: 도착 칸 캡처 여부 (정보용)
+    int8_t stunDelta = 1;           // STUN: 추가할 스턴 양
+
+    static boardAction drop(pieceType type, int square) {
+        boardAction a; a.type = actionType::DROP; a.pT = type; a.toSquare = static_cast<int8_t>(square); return a;
+    }
+    static boardAction move(int from, int to) {
+        boardAction a; a.type = actionType::MOVE; a.fromSquare = static_cast<int8_t>(from); a.toSquare = static_cast<int8_t>(to); return a;
+    }
+    static boardAction stun(int square, int delta = 1) {
+        boardAction a; a.type = actionType::STUN; a.fromSquare = static_cast<int8_t>(square); a.stunDelta = static_cast<int8_t>(delta); return a;
+    }
+    static boardAction promote(int square, pieceType type) {
+        boardAction a; a.type = actionType::PROMOTE; a.fromSquare = static_cast<int8_t>(square); a.pT = type; return a;
+    }
+    static boardAction disguise(int square, pieceType type) {
+        boardAction a; a.type = actionType::DISGUISE; a.fromSquare = static_cast<int8_t>(square); a.pT = type; return a;
+    }
+    static boardAction succession(int square) {
+        boardAction a; a.type = actionType::SUCCESSION; a.fromSquare = static_cast<int8_t>(square); return a;
+    }
+    static boardAction endTurn() { return boardAction(); }
+};
+
+// applyActions 결과: firstInvalid 앞의 액션은 모두 적용된 상태
+struct actionBatchReport {
+    actionResult result = actionResult::OK; // 처음 거절된 액션의 사유 (전부 성공하면 OK)
+    size_t firstInvalid = 0;                // 처음 거절된 액션 인덱스 (전부 성공하면 액션 개수)
+};
+
+inline int squareOf(int file, int rank) { return rank * 8 + file; }
+inline int squareFile(int square) { return square % 8; }
+inline int squareRank(int square) { return square / 8; }
+
+// 비트보드에서 가장 낮은 칸 인덱스 (bits != 0)
+inline int lowestSquare(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+// 비트보드의 칸 개수
+inline int squareCount(uint64_t bits) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(bits));
+#else
+    return __builtin_popcountll(bits);
+#endif
+}
@@ -0,0 +1,252 @@
+#include <book.hpp>
+#include <byteio.hpp>
+#include <gameboard.hpp>
+#include <policy.hpp>
+#include <threadpool.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+
+constexpr char MAGIC[4] = {'B', 'C', 'O', 'B'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t ENTRY_SIZE = 16;
+constexpr size_t MOVE_SIZE = 4;
+constexpr int MAX_FORCED_ACTIONS = 64;
+
+inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// 합법 액션이 하나뿐이면 (착수 뒤 END_TURN 등) 분석 없이 진행
+void advanceForced(bc_board& board, std::vector<boardAction>& actions) {
+    for(int i = 0; i < MAX_FORCED_ACTIONS; ++i) {
+        board.collectLegalActions(actions);
+        if(actions.size() != 1) return;
+        board.applyAction(actions[0]);
+    }
+}
+
+} // namespace
+
+uint64_t positionHash(const packedPosition& position) {
+    packedPosition key = position;
+    const bool white = key.whiteMoveCount == key.blackMoveCount;
+    const bool firstTurn = key.whiteMoveCount + key.blackMoveCount < 2;
+    key.whiteMoveCount = 0;
+    key.blackMoveCount = 0;
+    key.reserved[0] = white ? 0 : 1;
+    key.reserved[1] = firstTurn ? 1 : 0;
+
+    // 비밀 로얄 마스크 앞까지는 예전 232바이트 레코드와 같은 방식으로 섞고, 마스크는 있을 때만 섞는다
+    // (계승이 없는 포지션의 해시가 그대로라 기존 북 파일을 계속 쓸 수 있다)
+    constexpr size_t PREFIX = offsetof(packedPosition, secretRoyals);
+    static_assert(PREFIX % 8 == 0, "hash prefix must be whole words");
+    uint8_t bytes[PREFIX];
+    std::memcpy(bytes, &key, sizeof(bytes));
+    uint64_t h = 0x243F6A8885A308D3ull;
+    for(size_t i = 0; i < sizeof(bytes); i += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + i, 8);
+        h = mix64(h ^ word) + 0x9E3779B97F4A7C15ull;
+    }
+    if((key.secretRoyals | key.royalCandidates) != 0) {
+        h = mix64(h ^ key.secretRoyals) + 0x9E3779B97F4A7C15ull;
+        h = mix64(h ^ key.royalCandidates) + 0x9E3779B97F4A7C15ull;
+    }
+    return h;
+}
+
+uint64_t positionHash(const bc_board& board) {
+    packedPosition packed;
+    board.encodePacked(packed);
+    return positionHash(packed);
+}
+
+// ---------------------------------------------------------------- 읽기
+
+bool openingBook::open(const std::string& path) {
+    close();
+    if(!file.open(path) || file.size() < HEADER_SIZE) {
+        file.close();
+        return false;
+    }
+    const uint8_t* p = file.data();
+    const size_t entryTotal = readU32(p + 8);
+    const size_t moveTotal = readU32(p + 12);
+    if(std::memcmp(p, MAGIC, 4) != 0 || readU32(p + 4) != FORMAT_VERSION ||
+       file.size() != HEADER_SIZE + entryTotal * ENTRY_SIZE + moveTotal * MOVE_SIZE) {
+        file.close();
+        return false;
+    }
+    entryCount = entryTotal;
+    moveCount = moveTotal;
+    entries = p + HEADER_SIZE;
+    moves = entries + entryCount * ENTRY_SIZE;
+    return true;
+}
+
+void openingBook::close() {
+    file.close();
+    entries = nullptr;
+    moves = nullptr;
+    entryCount = 0;
+    moveCount = 0;
+}
+
+bool openingBook::probe(uint64_t hash, std::vector<bookMove>& out) const {
+    out.clear();
+    size_t lo = 0, hi = entryCount;
+    while(lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if(readU64(entries + mid * ENTRY_SIZE) < hash) lo = mid + 1;
+        else hi = mid;
+    }
+    if(lo >= entryCount) return false;
+    const uint8_t* e = entries + lo * ENTRY_SIZE;
+    if(readU64(e) != hash) return false;
+    const size_t first = readU32(e + 8);
+    const size_t count = readU16(e + 12);
+    if(first + count > moveCount) return false;
+    for(size_t i = 0; i < count; ++i) {
+        const uint8_t* m = moves + (first + i) * MOVE_SIZE;
+        out.push_back({readU16(m), readU16(m + 2)});
+    }
+    return !out.empty();
+}
+
+bool openingBook::probe(const bc_board& board, std::vector<bookMove>& out) const {
+    return probe(positionHash(board), out);
+}
+
+bool openingBook::pick(const bc_board& board, uint64_t random, boardAction& out) const {
+    std::vector<bookMove> candidates;
+    if(!probe(board, candidates)) return false;
+    uint64_t total = 0;
+    for(const auto& m : candidates) total += static_cast<uint64_t>(m.weight);
+    if(total == 0) return false;
+    uint64_t r = random % total;
+    for(const auto& m : candidates) {
+        if(r < static_cast<uint64_t>(m.weight)) {
+            out = policyAction(m.policyIndex, board.currentPlayerColor());
+            return true;
+        }
+        r -= static_cast<uint64_t>(m.weight);
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------- 쓰기
+
+void openingBookWriter::add(uint64_t hash, std::vector<bookMove> moves) {
+    entries.push_back({hash, std::move(moves)});
+}
+
+bool openingBookWriter::save(const std::string& path) {
+    // 해시 순 정렬, 같은 해시는 마지막에 넣은 것
+    std::stable_sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) { return a.hash < b.hash; });
+    std::vector<entry> unique;
+    for(auto& e : entries) {
+        if(!unique.empty() && unique.back().hash == e.hash) unique.back() = std::move(e);
+        else unique.push_back(std::move(e));
+    }
+    entries = std::move(unique);
+
+    std::vector<uint8_t> out;
+    size_t totalMoves = 0;
+    for(const auto& e : entries) totalMoves += std::min<size_t>(e.moves.size(), 0xFFFF);
+    out.reserve(HEADER_SIZE + entries.size() * ENTRY_SIZE + totalMoves * MOVE_SIZE);
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    putU32(out, FORMAT_VERSION);
+    putU32(out, static_cast<uint32_t>(entries.size()));
+    putU32(out, static_cast<uint32_t>(totalMoves));
+    size_t next = 0;
+    for(const auto& e : entries) {
+        const size_t count = std::min<size_t>(e.moves.size(), 0xFFFF);
+        putU64(out, e.hash);
+        putU32(out, static_cast<uint32_t>(next));
+        putU16(out, static_cast<uint16_t>(count));
+        putU16(out, 0);
+        next += count;
+    }
+    for(const auto& e : entries) {
+        const size_t count = std::min<size_t>(e.moves.size(), 0xFFFF);
+        for(size_t i = 0; i < count; ++i) {
+            putU16(out, static_cast<uint16_t>(e.moves[i].policyIndex));
+            putU16(out, static_cast<uint16_t>(std::clamp(e.moves[i].weight, 0, 0xFFFF)));
+        }
+    }
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if(f == nullptr) return false;
+    const bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+// ---------------------------------------------------------------- 빌더
+
+bookBuildStats buildOpeningBook(const bc_board& start, const bookBuildConfig& config, threadPool& pool, openingBookWriter& writer) {
+    const auto started = std::chrono::steady_clock::now();
+    bookBuildStats stats;
+    std::vector<boardAction> actions;
+    std::unordered_set<uint64_t> seen;
+
+    std::vector<packedPosition> frontier(1);
+    {
+        packedPosition root;
+        start.encodePacked(root);
+        bc_board board;
+        board.decodePacked(root);
+        advanceForced(board, actions);
+        board.encodePacked(frontier[0]);
+        seen.insert(positionHash(frontier[0]));
+    }
+
+    for(int level = 0; level < config.depth && !frontier.empty(); ++level) {
+        // 단계 안의 포지션은 서로 독립: 포지션마다 단일 스레드 탐색을 병렬로
+        std::vector<std::vector<bookMove>> analysed(frontier.size());
+        pool.parallelFor(0, frontier.size(), 1, [&](size_t begin, size_t end) {
+            bc_board board;
+            for(size_t i = begin; i < end; ++i) {
+                board.decodePacked(frontier[i]);
+                ismctsConfig cfg = config.analysis;
+                cfg.seed ^= positionHash(frontier[i]);
+                const ismctsResult r = informationSetSearch(board, cfg);
+                std::vector<bookMove>& out = analysed[i];
+                for(const auto& [index, count] : r.visits) {
+                    if(count > 0) out.push_back({index, count});
+                }
+                std::stable_sort(out.begin(), out.end(), [](const bookMove& a, const bookMove& b) { return a.weight > b.weight; });
+                if(out.size() > static_cast<size_t>(config.movesPerEntry)) out.resize(static_cast<size_t>(config.movesPerEntry));
+            }
+        });
+        stats.positions += frontier.size();
+        stats.iterations += frontier.size() * static_cast<size_t>(std::max(0, config.analysis.iterations));
+
+        std::vector<packedPosition> next;
+        bc_board board;
+        for(size_t i = 0; i < frontier.size(); ++i) {
+            if(analysed[i].empty()) continue;
+            writer.add(positionHash(frontier[i]), analysed[i]);
+            const size_t expand = std::min(analysed[i].size(), static_cast<size_t>(std::max(0, config.width)));
+            for(size_t k = 0; k < expand && next.size() < static_cast<size_t>(config.maxPositions); ++k) {
+                board.decodePacked(frontier[i]);
+                if(board.applyAction(policyAction(analysed[i][k].policyIndex, board.currentPlayerColor())) != actionResult::OK) continue;
+                advanceForced(board, actions);
+                packedPosition child;
+                board.encodePacked(child);
+                if(seen.insert(positionHash(child)).second) next.push_back(child);
+            }
+        }
+        frontier = std::move(next);
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return stats;
+}
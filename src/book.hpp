@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <action.hpp>
+#include <ismcts.hpp>
+#include <mappedfile.hpp>
+#include <packed.hpp>
+
+class bc_board;
+class threadPool;
+
+/* 착수 단계 오프닝 북 (book.cpp)
+   오프라인 빌더(bc_book)가 시작 포지션에서 착수 순서를 넓이 우선으로 분석해 포지션 해시 -> 후보 액션/가중치 표를 만들고,
+   엔진은 파일을 mmap해 정렬된 항목을 이진 탐색한다 (불러오기 비용 없음).
+
+   포지션 해시: packed 레코드(배치, 스턴/이동 스택, 포켓, 턴 내 상태) + 둘 차례 + 첫 턴 여부.
+   수 카운트 자체는 넣지 않는다 (같은 배치/스택이면 몇 번째 턴이든 같은 항목).
+   액션은 policyIndex (둘 차례 관점 번호, policy.hpp)로 저장한다.
+
+   파일 (리틀 엔디언)
+     "BCOB" + u32 버전(1) + u32 항목 수 + u32 액션 수
+     항목 [항목 수]: u64 해시 + u32 첫 액션 위치 + u16 액션 수 + u16 예약   (해시 오름차순)
+     액션 [액션 수]: u16 policyIndex + u16 가중치                          (항목 안에서 가중치 내림차순)
+*/
+uint64_t positionHash(const packedPosition& position);
+uint64_t positionHash(const bc_board& board);
+
+struct bookMove {
+    int policyIndex = 0;
+    int weight = 0;
+};
+
+class openingBook {
+    private:
+        mappedFile file;
+        const uint8_t* entries = nullptr;
+        const uint8_t* moves = nullptr;
+        size_t entryCount = 0;
+        size_t moveCount = 0;
+
+    public:
+        bool open(const std::string& path); // 형식이 맞지 않으면 false
+        void close();
+        bool isOpen() const { return entries != nullptr; }
+        size_t size() const { return entryCount; }
+
+        bool probe(uint64_t hash, std::vector<bookMove>& out) const; // 없으면 false
+        bool probe(const bc_board& board, std::vector<bookMove>& out) const;
+        // 가중치에 비례해 하나 고른다 (random은 균등 난수), 없으면 false
+        bool pick(const bc_board& board, uint64_t random, boardAction& out) const;
+};
+
+// 항목을 모아 정렬된 파일로 쓴다 (같은 해시는 마지막 것을 쓴다)
+class openingBookWriter {
+    private:
+        struct entry {
+            uint64_t hash;
+            std::vector<bookMove> moves;
+        };
+        std::vector<entry> entries;
+
+    public:
+        void add(uint64_t hash, std::vector<bookMove> moves);
+        size_t size() const { return entries.size(); }
+        bool save(const std::string& path);
+};
+
+struct bookBuildConfig {
+    int depth = 12;              // 분석할 액션 수 (한 가지 합법 액션뿐인 포지션은 세지 않고 지나감)
+    int width = 4;               // 포지션마다 다음 단계로 펼칠 상위 액션 수
+    int movesPerEntry = 8;       // 포지션마다 저장할 최대 액션 수
+    int maxPositions = 100000;   // 한 단계 포지션 수 상한
+    ismctsConfig analysis;       // 포지션마다 정보 집합 탐색 설정
+};
+
+struct bookBuildStats {
+    size_t positions = 0;        // 분석한 포지션 수
+    size_t iterations = 0;
+    double seconds = 0.0;
+};
+
+// start에서 depth 단계까지 단계마다 포지션을 병렬 분석해 writer에 채운다
+bookBuildStats buildOpeningBook(const bc_board& start, const bookBuildConfig& config, threadPool& pool, openingBookWriter& writer);
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/* 파일 포맷 공용 바이트 입출력 (기보/오프닝 북/테이블베이스/NNUE/정책망)
+   고정 폭 정수는 리틀 엔디언, 가변 길이 정수는 LEB128 (7비트씩, 상위 비트 = 이어짐), 부호 있는 값은 지그재그.
+   읽기 함수는 길이를 확인하지 않으므로 호출하는 쪽이 남은 바이트 수를 먼저 확인한다 (getVarint만 end까지 확인).
+*/
+
+inline uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+inline void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+inline void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for(int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+inline void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    putU32(out, static_cast<uint32_t>(v));
+    putU32(out, static_cast<uint32_t>(v >> 32));
+}
+
+inline uint32_t zigzag(int v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int unzigzag(uint32_t v) {
+    return static_cast<int>(v >> 1) ^ -static_cast<int>(v & 1);
+}
+
+inline void putVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while(v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+inline void putZigzag(std::vector<uint8_t>& out, int v) { putVarint(out, zigzag(v)); }
+
+// end를 넘거나 5바이트 안에 끝나지 않으면 false
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& out) {
+    out = 0;
+    for(int shift = 0; shift < 35 && p < end; shift += 7) {
+        const uint8_t b = *p++;
+        out |= static_cast<uint32_t>(b & 0x7F) << shift;
+        if((b & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+inline bool getZigzag(const uint8_t*& p, const uint8_t* end, int& out) {
+    uint32_t v;
+    if(!getVarint(p, end, v)) return false;
+    out = unzigzag(v);
+    return true;
+}
@@ -0,0 +1,205 @@
+#include <gameboard.hpp>
+
+/* 체크메이트 판정 (rule.md 12: 로얄 피스가 잡히는 것을 막을 수 없을 때만 계승 가능)
+
+   위협: 상대 편에서 스턴이 아니고 이동 스택이 있는 기물이 다음 턴에 로얄 피스를 잡을 수 있음.
+         이동 스택이 2 이상이면 빈 칸을 거쳐 가는 연속 이동까지 본다 (잡은 뒤 이어지는 이동은 보지 않음).
+   방어: 이번 턴에 남은 행동 중 하나로 위협이 사라지면 체크메이트가 아니다.
+         - 착수: 빈 칸에 기물을 놓아 경로/착지 칸을 막음 (폰은 끝 랭크 불가)
+         - 스턴: 위협하는 기물이 하나뿐이면 그 기물에 스턴
+         - 이동: 한 기물이 이동 스택만큼 연속 이동 (잡은 기물의 이동 스택을 이어받고, 스턴을 받으면 멈춤).
+                 상대 로얄 피스를 잡으면 상대 기물 전체가 스턴되므로 위협이 사라진다.
+   공격 기물마다 "잡을 수 있는 칸"과 "확인한 칸"을 한 번 계산해 두고, 가정한 배치에서 확인한 칸이
+   바뀐 공격 기물만 다시 계산한다. 이동 스택 1인 기물은 보드가 유지하는 공격/확인 마스크를 그대로 쓴다.
+*/
+
+namespace {
+
+inline uint64_t bitOf(int square) { return uint64_t(1) << square; }
+
+struct attackerInfo {
+    const piece* p;
+    int square;
+    uint64_t reach;    // 다음 턴에 잡을 수 있는 칸
+    uint64_t scanned;  // 계산 중 점유를 확인한 칸
+};
+
+// own = 공격 기물 편, enemy = 상대 편 점유. 이동 스택만큼 빈 칸을 거쳐 가며 잡을 수 있는 칸을 모은다
+void computeReach(const piece& p, uint64_t own, uint64_t enemy, attackerInfo& out) {
+    const int origin = squareOf(p.getFile(), p.getRank());
+    own &= ~bitOf(origin); // 움직이기 시작하면 출발 칸은 빈다
+    out.reach = 0;
+    out.scanned = 0;
+    uint64_t frontier = bitOf(origin);
+    uint64_t seen = frontier;
+    for(int left = p.getMoveStack(); left > 0 && frontier != 0; --left) {
+        uint64_t next = 0;
+        for(uint64_t rest = frontier; rest != 0; rest &= rest - 1) {
+            const int sq = lowestSquare(rest);
+            for(const auto& pattern : p.getMovePatterns()) {
+                out.reach |= pattern.attackMask(squareFile(sq), squareRank(sq), own, enemy, out.scanned);
+                if(left > 1) {
+                    pattern.forEachTarget(squareFile(sq), squareRank(sq), own, enemy, [&next](int to, uint64_t captured) {
+                        if(captured == 0) next |= bitOf(to);
+                    });
+                }
+            }
+        }
+        next &= ~seen;
+        seen |= next;
+        frontier = next;
+    }
+}
+
+class royalDefense {
+    public:
+        uint64_t own = 0;          // 방어 편 점유
+        uint64_t enemy = 0;        // 공격 편 점유
+        uint64_t royals = 0;       // 방어 편 로얄 칸
+        uint64_t enemyRoyals = 0;  // 공격 편 로얄 칸
+        std::array<const piece*, 64> at{};
+        std::vector<attackerInfo> attackers; // 다음 턴에 움직일 수 있는 공격 기물
+
+        royalDefense(const std::list<piece>& pieces, colorType defender) {
+            for(const auto& p : pieces) {
+                const int sq = squareOf(p.getFile(), p.getRank());
+                at[sq] = &p;
+                const bool mine = (p.getColor() == defender);
+                (mine ? own : enemy) |= bitOf(sq);
+                if(p.isRoyal()) (mine ? royals : enemyRoyals) |= bitOf(sq);
+            }
+            for(const auto& p : pieces) {
+                if(p.getColor() == defender || p.isStunned() || p.getMoveStack() <= 0) continue;
+                attackerInfo info{&p, squareOf(p.getFile(), p.getRank()), 0, 0};
+                if(p.getMoveStack() == 1) {
+                    info.reach = p.getAttackMask();
+                    info.scanned = p.getScanMask();
+                } else {
+                    computeReach(p, enemy, own, info);
+                }
+                attackers.push_back(info);
+            }
+        }
+
+        // 가정한 배치에서 로얄 피스가 잡힐 수 있는지 (changed: 기준 배치와 점유가 다른 칸, removed: 잡힌 공격 기물 칸)
+        bool threatened(uint64_t ownNow, uint64_t enemyNow, uint64_t royalsNow, uint64_t changed, uint64_t removed) const {
+            for(const auto& a : attackers) {
+                if(removed & bitOf(a.square)) continue;
+                uint64_t reach = a.reach;
+                if(a.scanned & changed) {
+                    attackerInfo fresh{a.p, a.square, 0, 0};
+                    computeReach(*a.p, enemyNow, ownNow, fresh);
+                    reach = fresh.reach;
+                }
+                if(reach & royalsNow) return true;
+            }
+            return false;
+        }
+
+        bool threatenedNow() const { return threatened(own, enemy, royals, 0, 0); }
+
+        // 한 기물의 연속 이동으로 위협을 없앨 수 있는지
+        bool escapesByMoving(const piece& mover) const {
+            struct node { int square; uint64_t captured; int stack; };
+            const int origin = squareOf(mover.getFile(), mover.getRank());
+            const uint64_t ownBase = own & ~bitOf(origin);
+            std::vector<node> work{{origin, 0, mover.getMoveStack()}};
+            std::vector<node> visited;
+            bool found = false;
+
+            while(!work.empty() && !found) {
+                const node n = work.back();
+                work.pop_back();
+                const uint64_t enemyNow = enemy & ~n.captured;
+                for(const auto& pattern : mover.getMovePatterns()) {
+                    pattern.forEachTarget(squareFile(n.square), squareRank(n.square), ownBase, enemyNow,
+                                          [&](int to, uint64_t captured) {
+                        if(found) return;
+                        const uint64_t capturedAll = n.captured | captured;
+                        if(capturedAll & enemyRoyals) { found = true; return; } // 상대 기물 전체 스턴 +3
+                        const uint64_t royalsAfter = mover.isRoyal() ? ((royals & ~bitOf(origin)) | bitOf(to)) : royals;
+                        const uint64_t changed = bitOf(origin) | bitOf(to) | capturedAll;
+                        if(!threatened(ownBase | bitOf(to), enemyNow & ~captured, royalsAfter, changed, capturedAll)) {
+                            found = true;
+                            return;
+                        }
+
+                        // 연속 이동: 스택 1 소비, 잡은 기물의 스택은 이어받고 스턴을 받으면 멈춘다
+                        int stack = n.stack - 1;
+                        for(uint64_t rest = captured; rest != 0; rest &= rest - 1) {
+                            const piece* c = at[lowestSquare(rest)];
+                            if(c->getStunStack() > 0) return;
+                            stack += c->getMoveStack();
+                        }
+                        if(stack <= 0) return;
+                        for(const node& v : visited) {
+                            if(v.square == to && v.captured == capturedAll && v.stack >= stack) return;
+                        }
+                        visited.push_back({to, capturedAll, stack});
+                        work.push_back({to, capturedAll, stack});
+                    });
+                }
+            }
+            return found;
+        }
+};
+
+} // namespace
+
+// 상대가 다음 턴에 color의 로얄 피스를 잡을 수 있는지
+bool bc_board::isRoyalCaptureThreatened(colorType color) const {
+    if(getRoyalMask(color) == 0) return false;
+    return royalDefense(pieces, color).threatenedNow();
+}
+
+// color가 이번 턴 안에 로얄 피스가 잡히는 것을 막을 수 있는지 (color의 차례가 아니면 새 턴으로 가정)
+bool bc_board::canPreventRoyalCapture(colorType color) const {
+    const royalDefense defense(pieces, color);
+    if(!defense.threatenedNow()) return true;
+
+    const bool midTurn = (color == currentPlayerColor()) && performedActionThisTurn;
+
+    // 1) 스턴: 위협하는 기물이 하나뿐이면 그 기물을 멈춘다
+    uint64_t blockable = ~uint64_t(0); // 모든 위협 기물이 확인하는 칸
+    int threateners = 0;
+    for(const auto& a : defense.attackers) {
+        if(a.reach & defense.royals) {
+            threateners++;
+            blockable &= a.scanned;
+        }
+    }
+    if(!midTurn && threateners == 1) return true;
+
+    // 2) 착수: 모든 위협 기물이 확인하는 빈 칸에 놓아 본다 (기물 종류와 관계없이 점유만 바뀜)
+    if(!midTurn) {
+        const auto& pocket = fullPocketForColor(color);
+        bool anyPiece = false;
+        for(int i = 0; i < POCKET_SIZE; ++i) {
+            if(i != static_cast<int>(pocketIndex::PAWN) && pocket[i] > 0) anyPiece = true;
+        }
+        const bool pawn = pocket[static_cast<int>(pocketIndex::PAWN)] > 0;
+        const int pawnFinalRank = (color == colorType::WHITE) ? BOARD_SIZE - 1 : 0;
+        if(anyPiece || pawn) {
+            for(uint64_t rest = blockable & ~(defense.own | defense.enemy); rest != 0; rest &= rest - 1) {
+                const int sq = lowestSquare(rest);
+                if(!anyPiece && squareRank(sq) == pawnFinalRank) continue;
+                if(!defense.threatened(defense.own | bitOf(sq), defense.enemy, defense.royals, bitOf(sq), 0)) return true;
+            }
+        }
+    }
+
+    // 3) 이동: 이번 턴에 움직일 수 있는 기물의 연속 이동
+    for(const auto& p : pieces) {
+        if(p.getColor() != color || p.isStunned() || p.getMoveStack() <= 0) continue;
+        if(midTurn && &p != activePieceThisTurn) continue;
+        if(defense.escapesByMoving(p)) return true;
+    }
+    return false;
+}
+
+// canPreventRoyalCapture는 위협이 없으면 true이므로 로얄 피스가 있을 때 그 부정이 곧 체크메이트
+bool bc_board::isRoyalPieceCheckmated(colorType color) const {
+    BC_STAT_TIMER(IS_ROYAL_PIECE_CHECKMATED);
+    BC_TRACE_METHOD(IS_ROYAL_PIECE_CHECKMATED);
+    return getRoyalMask(color) != 0 && !canPreventRoyalCapture(color);
+}
@@ -78,3 +78,31 @@ enum class threatType{
     MOVEJUMP
 };
 
+
+/*이 클래스는 보드 액션(착수/이동/제거/승격/변장/계승 등)의 처리 결과를 의미한다.
+OK를 제외한 값은 모두 거절 사유이며, 거절된 액션은 보드 상태를 바꾸지 않는다.
+*/
+enum class actionResult{
+    OK,
+    INVALID_POSITION,          // 보드 밖 좌표
+    ACTION_ALREADY_PERFORMED,  // 이번 턴에 이미 액션을 수행함
+    ANOTHER_PIECE_ACTED,       // 이번 턴에 다른 기물이 이미 움직임
+    NOT_YOUR_TURN,             // 현재 차례가 아닌 색
+    NO_PIECE,                  // 해당 칸에 기물이 없음
+    NOT_OWN_PIECE,             // 자신의 기물이 아님
+    OCCUPIED,                  // 착수할 칸이 이미 차 있음
+    POCKET_EMPTY,              // 포켓에 해당 기물이 없음
+    PAWN_ON_FINAL_RANK,        // 폰을 맨 끝 랭크에 착수
+    PIECE_STUNNED,             // 스턴 상태라 이동 불가
+    NO_MOVE_STACK,             // 이동 스택 없음
+    ILLEGAL_MOVE,              // 합법수가 아닌 목적지
+    NOT_A_PAWN,                // 프로모션 대상이 폰이 아님
+    NOT_PROMOTION_RANK,        // 프로모션 랭크가 아님
+    INVALID_PROMOTION,         // 킹/폰으로는 프로모션 불가
+    NOT_ROYAL,                 // 로얄 피스가 아님
+    ALREADY_ROYAL,             // 이미 로얄 피스임
+    INVALID_DISGUISE,          // 킹/폰/NONE으로는 변장 불가
+    INVALID_NOTATION,          // 해석할 수 없는 기보 표기
+    AMBIGUOUS_NOTATION,        // 표기에 맞는 기물이 둘 이상
+    NOT_CHECKMATED             // 로얄 피스가 체크메이트가 아니라 계승 불가
+};
@@ -0,0 +1,139 @@
+#include <gameboard.hpp>
+#include <algorithm>
+
+namespace {
+
+constexpr uint64_t NOT_FILE_A = 0xfefefefefefefefeULL;
+constexpr uint64_t NOT_FILE_H = 0x7f7f7f7f7f7f7f7fULL;
+constexpr int CENTER[8] = {0, 1, 2, 3, 3, 2, 1, 0};
+
+inline int sideOf(colorType c) { return (c == colorType::WHITE) ? 0 : 1; }
+
+// 로얄 칸 주변 8칸 (로얄 칸 자신 제외)
+uint64_t ringOf(uint64_t royals) {
+    const uint64_t row = royals | ((royals << 1) & NOT_FILE_A) | ((royals >> 1) & NOT_FILE_H);
+    return (row | (row << 8) | (row >> 8)) & ~royals;
+}
+
+int placementOf(const piece& p) {
+    if(p.isRoyal()) return 0;
+    if(p.getPieceType() == pieceType::PWAN) {
+        return (p.getColor() == colorType::WHITE) ? p.getRank() : 7 - p.getRank();
+    }
+    return CENTER[p.getFile()] + CENTER[p.getRank()];
+}
+
+// 기물 하나가 색상 합계에 더하는 항목 (스턴/스택/위치/공격 마스크가 바뀌기 전에 빼고 바뀐 뒤 더한다)
+evalTerms termsOf(const piece& p) {
+    evalTerms t;
+    const int value = materialValue(p.getPieceType());
+    t.material = value;
+    t.stunDebt = p.getStunStack() * value;
+    t.moveStacks = p.getMoveStack();
+    t.placement = placementOf(p);
+    t.mobility = squareCount(p.getAttackMask());
+    return t;
+}
+
+int pocketValue(const std::array<int, POCKET_SIZE>& pocket) {
+    int total = 0;
+    for(int i = 0; i < POCKET_SIZE; ++i) total += pocket[i] * materialValue(static_cast<pieceType>(i)); // 포켓 인덱스는 pieceType 순서
+    return total;
+}
+
+} // namespace
+
+void bc_board::evalWithdraw(const piece& p) {
+    evalAcc[sideOf(p.getColor())] -= termsOf(p);
+    neural.pieceChanged(p, -1);
+}
+
+void bc_board::evalDeposit(const piece& p) {
+    evalAcc[sideOf(p.getColor())] += termsOf(p);
+    neural.pieceChanged(p, +1);
+}
+
+void bc_board::notePocketChange(colorType color, pieceType type, int delta) {
+    evalAcc[sideOf(color)].pocket += delta * materialValue(type);
+    const int index = static_cast<int>(type); // 포켓 인덱스는 pieceType 순서
+    neural.pocketChanged(color, index, fullPocketForColor(color)[index]);
+}
+
+void bc_board::syncPocketEval() {
+    evalAcc[0].pocket = pocketValue(whitePocket);
+    evalAcc[1].pocket = pocketValue(blackPocket);
+    for(int i = 0; i < POCKET_SIZE; ++i) {
+        neural.pocketChanged(colorType::WHITE, i, whitePocket[i]);
+        neural.pocketChanged(colorType::BLACK, i, blackPocket[i]);
+    }
+}
+
+// 전체 재계산 (포지션을 통째로 바꾼 뒤에만 사용)
+void bc_board::rebuildEvaluation() {
+    evalAcc = {};
+    for(const auto& p : pieces) evalAcc[sideOf(p.getColor())] += termsOf(p);
+    evalAcc[0].pocket = pocketValue(whitePocket);
+    evalAcc[1].pocket = pocketValue(blackPocket);
+    neural.refresh(pieces, whitePocket, blackPocket);
+}
+
+evalTerms bc_board::getEvalTerms(colorType color) const {
+    return evalAcc[sideOf(color)];
+}
+
+// 로얄 안전도 감점 (color 기준, 0 이하)
+int bc_board::royalSafety(colorType color) const {
+    const int side = sideOf(color);
+    const uint64_t royals = lanes.royals[side];
+    const uint64_t enemyAttacks = attackMaps[1 - side];
+    return -EVAL_ROYAL_ATTACKED * squareCount(royals & enemyAttacks)
+           - EVAL_ROYAL_RING * squareCount(ringOf(royals) & enemyAttacks);
+}
+
+// perspective 편 기준 점수 (양수면 perspective가 유리)
+int bc_board::evaluate(colorType perspective) const {
+    BC_STAT_TIMER(EVALUATE);
+    BC_TRACE_METHOD(EVALUATE);
+    auto scoreOf = [this](colorType color) {
+        const evalTerms& t = evalAcc[sideOf(color)];
+        return EVAL_PIECE_SCALE * t.material
+             + EVAL_PIECE_SCALE * EVAL_POCKET_PERCENT / 100 * t.pocket
+             - EVAL_STUN_DEBT * t.stunDebt
+             + EVAL_MOVE_STACK * t.moveStacks
+             + EVAL_PLACEMENT * t.placement
+             + EVAL_MOBILITY * t.mobility
+             + royalSafety(color);
+    };
+    const colorType other = (perspective == colorType::WHITE) ? colorType::BLACK : colorType::WHITE;
+    return scoreOf(perspective) - scoreOf(other);
+}
+
+// ---------------------------------------------------------------- NNUE
+
+static_assert(NNUE_POCKET_KINDS == POCKET_SIZE, "NNUE pocket features follow the pocket layout");
+
+void bc_board::attachNetwork(const nnueNetwork* network) {
+    neural.attach(network);
+    neural.refresh(pieces, whitePocket, blackPocket);
+}
+
+int bc_board::evaluateNeural(colorType perspective) const {
+    BC_STAT_TIMER(EVALUATE_NEURAL);
+    BC_TRACE_METHOD(EVALUATE_NEURAL);
+    if(!neural.active()) return evaluate(perspective);
+    neural.flush();
+    return neural.evaluate(perspective);
+}
+
+const nnueAccumulator& bc_board::getNeuralAccumulator() const {
+    neural.flush();
+    return neural;
+}
+
+std::vector<int> bc_board::getNeuralFeatures(colorType perspective) const {
+    std::vector<int> features;
+    for(const auto& p : pieces) nnueActiveFeatures(p, perspective, features);
+    nnueActivePocketFeatures(fullPocketForColor(perspective), 0, features);
+    nnueActivePocketFeatures(fullPocketForColor(perspective == colorType::WHITE ? colorType::BLACK : colorType::WHITE), 1, features);
+    return features;
+}
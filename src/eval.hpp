@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+/* 정적 평가 (eval.cpp)
+   보드가 색상별 항목 합계(evalTerms)를 액션마다 증분 갱신하고 evaluate()는 가중합만 계산한다.
+     - material:   보드 위 기물 가치 합 (materialValue)
+     - pocket:     포켓에 남은 기물 가치 합
+     - stunDebt:   스턴 스택 x 기물 가치 (기물이 다시 움직일 수 있을 때까지 묶인 가치)
+     - moveStacks: 이동 스택 합 (연속 이동 템포)
+     - placement:  칸 보너스 (폰은 전진, 나머지 비로얄 기물은 중앙)
+     - mobility:   공격 마스크 칸 수 합 (스턴 기물 포함)
+   로얄 안전도는 공격 맵과 로얄 마스크로 평가 시점에 계산한다 (비트 연산 몇 번).
+   값 단위는 see.hpp와 같다 (기물 가치 1 = EVAL_PIECE_SCALE).
+*/
+inline constexpr int EVAL_PIECE_SCALE = 100;
+inline constexpr int EVAL_POCKET_PERCENT = 80;     // 포켓 기물은 착수 스턴이 있으므로 보드 위 가치의 80%
+inline constexpr int EVAL_STUN_DEBT = 8;           // 스턴 스택 1 x 기물 가치 1
+inline constexpr int EVAL_MOVE_STACK = 10;         // 이동 스택 1 (SEE_MOVE_STACK_VALUE와 같음)
+inline constexpr int EVAL_PLACEMENT = 4;           // 칸 보너스 1
+inline constexpr int EVAL_MOBILITY = 3;            // 공격 칸 1
+inline constexpr int EVAL_ROYAL_ATTACKED = 60;     // 공격받는 로얄 피스 1
+inline constexpr int EVAL_ROYAL_RING = 8;          // 공격받는 로얄 주변 칸 1
+
+// 색상별 평가 항목 합계 (가중치 적용 전)
+struct evalTerms {
+    int material = 0;
+    int pocket = 0;
+    int stunDebt = 0;
+    int moveStacks = 0;
+    int placement = 0;
+    int mobility = 0;
+
+    evalTerms& operator+=(const evalTerms& o) {
+        material += o.material; pocket += o.pocket; stunDebt += o.stunDebt;
+        moveStacks += o.moveStacks; placement += o.placement; mobility += o.mobility;
+        return *this;
+    }
+    evalTerms& operator-=(const evalTerms& o) {
+        material -= o.material; pocket -= o.pocket; stunDebt -= o.stunDebt;
+        moveStacks -= o.moveStacks; placement -= o.placement; mobility -= o.mobility;
+        return *this;
+    }
+    bool operator==(const evalTerms& o) const {
+        return material == o.material && pocket == o.pocket && stunDebt == o.stunDebt &&
+               moveStacks == o.moveStacks && placement == o.placement && mobility == o.mobility;
+    }
+    bool operator!=(const evalTerms& o) const { return !(*this == o); }
+};
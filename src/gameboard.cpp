@@ -26,6 +26,7 @@ bc_board::bc_board(const std::array<int, POCKET_SIZE>& whiteStock, const std::ar
     // 로얄 피스 벡터는 자동 초기화됨
     whitePocket = whiteStock;
     blackPocket = blackStock;
+    syncPocketEval();
 }
 
 // 소멸자
@@ -38,6 +39,10 @@ void bc_board::initializeBoard() {
     whiteMoveCount = 0;
     blackMoveCount = 0;
     pieces.clear();
+    log.clear();
+    attackMaps = {};
+    lanes = {};
+    evalAcc = {};
     activePieceThisTurn = nullptr;
     performedActionThisTurn = false;
     resetPockets();
@@ -55,30 +60,10 @@ bool bc_board::isValidPosition(int file, int rank) const {
 }
 
 // 현재 턴의 플레이어 색상 (백과 흑의 수 개수를 비교하여 결정)
-colorType bc_board::currentPlayerColor() const {
-    return (whiteMoveCount == blackMoveCount) ? colorType::WHITE : colorType::BLACK;
-}
-
 // pieceType -> 포켓 인덱스
 pocketIndex bc_board::pieceTypeToPocketIndex(pieceType type) const {
-    switch(type) {
-        case pieceType::KING:         return pocketIndex::KING;
-        case pieceType::QUEEN:        return pocketIndex::QUEEN;
-        case pieceType::BISHOP:       return pocketIndex::BISHOP;
-        case pieceType::KNIGHT:       return pocketIndex::KNIGHT;
-        case pieceType::ROOK:         return pocketIndex::ROOK;
-        case pieceType::PWAN:         return pocketIndex::PAWN;
-        case pieceType::AMAZON:       return pocketIndex::AMAZON;
-        case pieceType::GRASSHOPPER:  return pocketIndex::GRASSHOPPER;
-        case pieceType::KNIGHTRIDER:  return pocketIndex::KNIGHTRIDER;
-        case pieceType::ARCHBISHOP:   return pocketIndex::ARCHBISHOP;
-        case pieceType::DABBABA:      return pocketIndex::DABBABA;
-        case pieceType::ALFIL:        return pocketIndex::ALFIL;
-        case pieceType::FERZ:         return pocketIndex::FERZ;
-        case pieceType::CENTAUR:      return pocketIndex::CENTAUR;
-        case pieceType::TESTROOK:   return pocketIndex::TESTROOK;
-        default: return pocketIndex::NONE; // fallback (shouldn't happen)
-    }
+    const pieceTraits* traits = findPieceTraits(type);
+    return traits ? traits->pocket : pocketIndex::NONE;
 }
 
 // 포켓 참조 반환 (일반 기물만, 하위 호환성용)
@@ -122,17 +107,20 @@ int bc_board::getPocketCount(colorType color, pocketIndex idx) const {
 void bc_board::resetPockets() {
     whitePocket = DEFAULT_POCKET_STOCK;
     blackPocket = DEFAULT_POCKET_STOCK;
+    syncPocketEval();
 }
 
 // 포켓 보유량 수동 설정 (색상별)
 void bc_board::setPocketStock(colorType color, const std::array<int, POCKET_SIZE>& stock) {
     fullPocketForColor(color) = stock;
+    syncPocketEval();
 }
 
 // 포켓 보유량 수동 설정 (양쪽 한 번에)
 void bc_board::setPocketStockBoth(const std::array<int, POCKET_SIZE>& whiteStock, const std::array<int, POCKET_SIZE>& blackStock) {
     whitePocket = whiteStock;
     blackPocket = blackStock;
+    syncPocketEval();
 }
 
 // 특정 위치의 기물 가져오기
@@ -169,56 +157,115 @@ void bc_board::resetTurnState() {
 // 특정 기물의 합법 이동 업데이트
 void bc_board::updatePieceLegalMoves(piece* p) {
     if(p == nullptr) return;
-    p->calculateAndUpdateLegalMoves(this);
+    auto& mobility = evalAcc[(p->getColor() == colorType::WHITE) ? 0 : 1].mobility; // 이동성 항목은 공격 마스크를 따른다
+    mobility -= squareCount(p->getAttackMask());
+    BC_STAT_ADD(PIECES_REGENERATED, 1);
+    p->refreshAttacks(positionEpoch);
+    mobility += squareCount(p->getAttackMask());
 }
 
 // 모든 기물의 합법 이동 업데이트
 void bc_board::updateAllLegalMoves() {
+    BC_STAT_TIMER(UPDATE_ALL_LEGAL_MOVES);
+    BC_TRACE_METHOD(UPDATE_ALL_LEGAL_MOVES);
+    BC_STAT_ADD(LEGAL_MOVE_RECOMPUTES, 1);
+    ++positionEpoch;
     for(auto& p : pieces) {
         updatePieceLegalMoves(&p);
     }
+    rebuildAttackMaps();
+    rebuildEvaluation();
 }
 
-// 특정 색상 기물들의 스턴 스택 감소 (해당 플레이어가 수를 둘 때 호출)
-void bc_board::applyStunTickAll() {
+// 증분 재계산: 기물의 이동은 자기 위치/패턴/스턴과 확인했던 칸(scan mask)의 점유에만 의존하므로
+// 바뀐 칸을 확인한 적 없는 기물은 이전 결과를 그대로 쓴다
+void bc_board::refreshLegalMoves(uint64_t changedSquares, piece* touched) {
+    BC_TRACE_SCOPE("refreshLegalMoves", "moves");
+    ++positionEpoch;
+    if(refreshDeferred) {
+        refreshPending = true;
+        return;
+    }
+    BC_STAT_ADD(LEGAL_MOVE_RECOMPUTES, 1);
     for(auto& p : pieces) {
-        p.applyStunTick();
+        if(&p == touched || (p.getScanMask() & changedSquares) != 0 || p.isStunned() != p.isGeneratedStunned()) {
+            updatePieceLegalMoves(&p);
+        }
     }
+    rebuildAttackMaps();
 }
 
-// 특정 색상의 기물들만 스턴 틱 적용
-void bc_board::applyStunTickForColor(colorType color) {
-    for(auto& p : pieces) {
-        if(p.getColor() == color) {
-            p.applyStunTick();
-        }
+// applyActions 끝: 미뤄 둔 재계산을 전체 재계산 한 번으로 처리
+void bc_board::flushDeferredRefresh() {
+    refreshDeferred = false;
+    if(!refreshPending) return;
+    refreshPending = false;
+    updateAllLegalMoves();
+}
+
+void bc_board::rebuildAttackMaps() {
+    attackMaps = {};
+    for(const auto& p : pieces) {
+        const int side = (p.getColor() == colorType::WHITE) ? 0 : 1;
+        attackMaps[side] |= p.getAttackMask();
     }
 }
 
+// 스턴 틱: 각 플레이어가 수를 둘 때마다 스턴 스택 1 감소, 그러면 이동 스택 1 증가
+// 대상 칸은 레인에서 한 번에 고르고, 평가 누적기는 그 칸의 기물만 맞춘다
+void bc_board::tickStunLanes(uint64_t mask) {
+    const uint64_t due = laneStunned(lanes, mask);
+    if(due == 0) return;
+    for(uint64_t rest = due; rest != 0; rest &= rest - 1) {
+        const int sq = lowestSquare(rest);
+        evalWithdraw(*board[squareFile(sq)][squareRank(sq)]);
+    }
+    laneStunTick(lanes, due);
+    for(uint64_t rest = due; rest != 0; rest &= rest - 1) {
+        const int sq = lowestSquare(rest);
+        evalDeposit(*board[squareFile(sq)][squareRank(sq)]);
+    }
+    BC_STAT_ADD(STUN_TICKS, squareCount(due));
+}
+
+// 모든 기물의 스턴 스택 감소
+void bc_board::applyStunTickAll() {
+    tickStunLanes(lanes.colors[0] | lanes.colors[1]);
+    refreshLegalMoves(0); // 스턴이 풀린 기물만 다시 계산
+}
+
+// 특정 색상의 기물들만 스턴 틱 적용 (해당 플레이어가 수를 둘 때 호출)
+void bc_board::applyStunTickForColor(colorType color) {
+    tickStunLanes(lanes.occupied(color));
+    refreshLegalMoves(0);
+}
+
 // 기물 착수
-bool bc_board::placePiece(pieceType type, colorType color, int file, int rank) {
+actionResult bc_board::placePiece(pieceType type, colorType color, int file, int rank) {
+    BC_STAT_TIMER(PLACE_PIECE);
+    BC_TRACE_METHOD(PLACE_PIECE);
     if(!isValidPosition(file, rank)) {
-        std::cerr << "Invalid position: (" << file << ", " << rank << ")" << std::endl;
-        return false;
+        BC_LOG(actionResult::INVALID_POSITION, "Invalid position: (%d, %d)", file, rank);
+        return actionResult::INVALID_POSITION;
     }
 
     if(performedActionThisTurn) {
-        std::cerr << "Action already performed this turn" << std::endl;
-        return false;
+        BC_LOG(actionResult::ACTION_ALREADY_PERFORMED, "Action already performed this turn");
+        return actionResult::ACTION_ALREADY_PERFORMED;
     }
     
     if(type == pieceType::PWAN) {
         // 폰은 상대 진영 최종 랭크에 착수 불가
         if((color == colorType::WHITE && rank == BOARD_SIZE - 1) ||
            (color == colorType::BLACK && rank == 0)) {
-            std::cerr << "Pawn cannot be placed on final rank" << std::endl;
-            return false;
+            BC_LOG(actionResult::PAWN_ON_FINAL_RANK, "Pawn cannot be placed on final rank");
+            return actionResult::PAWN_ON_FINAL_RANK;
         }
     }
 
     if(color != currentPlayerColor()) {
-        std::cerr << "Not your turn" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_YOUR_TURN, "Not your turn");
+        return actionResult::NOT_YOUR_TURN;
     }
 
     // 포켓 인덱스 확인
@@ -226,19 +273,20 @@ bool bc_board::placePiece(pieceType type, colorType color, int file, int rank) {
     auto& pocket = fullPocketForColor(color);
     int idx = static_cast<int>(pIdx);
     
-    if (pocket[idx] <= 0) {
-        std::cerr << "No remaining pieces of this type to drop" << std::endl;
-        return false;
+    if (pIdx == pocketIndex::NONE || pocket[idx] <= 0) {
+        BC_LOG(actionResult::POCKET_EMPTY, "No remaining pieces of this type to drop");
+        return actionResult::POCKET_EMPTY;
     }
     
     if(board[file][rank] != nullptr) {
-        std::cerr << "Position already occupied: (" << file << ", " << rank << ")" << std::endl;
-        return false;
+        BC_LOG(actionResult::OCCUPIED, "Position already occupied: (%d, %d)", file, rank);
+        return actionResult::OCCUPIED;
     }
     
     // pieces 컨테이너에 새로운 기물 추가
-    pieces.emplace_back(type, color, file, rank, pieces.size());
+    pieces.emplace_back(type, color, file, rank, pieces.size(), *this, lanes);
     piece* placed = &pieces.back();
+    setupPiecePatterns(placed); // 패턴은 타입이 바뀔 때만 다시 만든다
 
     // 초기 스턴 설정
     int initStun = computeInitialStun(type, color, rank);
@@ -248,92 +296,99 @@ bool bc_board::placePiece(pieceType type, colorType color, int file, int rank) {
     // 보드에 포인터 저장
     board[file][rank] = placed;
     pocket[idx] -= 1;
+    notePocketChange(color, type, -1);
     
     activePieceThisTurn = placed;
     performedActionThisTurn = true;
     
     // 착수 로그: @<좌표> 형식으로 기록 (0,0에서 목표로 이동으로 표현)
-    log.push_back(PGN(0, 0, file, rank, type, color, false));
+    PGN dropLog(0, 0, file, rank, type, color, false);
+    dropLog.isDrop = true;
+    log.push_back(dropLog);
     
     // 킹 착수 시 자동으로 로얄 피스 설정
     if(type == pieceType::KING) {
-        pieces.back().setRoyal(true);
+        placed->setRoyal(true);
     }
+    evalDeposit(*placed);
     
-    std::cout << "Piece placed at (" << file << ", " << rank << ")" << std::endl;
-    // 합법수 재계산
-    for (auto& p : pieces) {
-        p.clearMovePatterns();
-        setupPiecePatterns(&p);
-    }
-    updateAllLegalMoves();
-    return true;
+    BC_LOG(actionResult::OK, "Piece placed at (%d, %d)", file, rank);
+    // 합법수 재계산 (착수 칸을 확인하던 기물과 새 기물만)
+    refreshLegalMoves(uint64_t(1) << squareOf(file, rank), placed);
+    BC_STAT_ADD(ACTIONS, 1);
+    return actionResult::OK;
 }
 
 // 기물 이동
-bool bc_board::movePiece(int fromFile, int fromRank, int toFile, int toRank) {
+actionResult bc_board::movePiece(int fromFile, int fromRank, int toFile, int toRank) {
+    BC_STAT_TIMER(MOVE_PIECE);
+    BC_TRACE_METHOD(MOVE_PIECE);
     // 1) 입력 좌표 유효성 검사
     if(!isValidPosition(fromFile, fromRank) || !isValidPosition(toFile, toRank)) {
-        std::cerr << "Invalid position" << std::endl;
-        return false;
+        BC_LOG(actionResult::INVALID_POSITION, "Invalid position");
+        return actionResult::INVALID_POSITION;
     }
     
     // 2) 출발지에 기물이 있는지 확인
     piece* movingPiece = getPieceAt(fromFile, fromRank);
     if(movingPiece == nullptr) {
-        std::cerr << "No piece at source position" << std::endl;
-        return false;
+        BC_LOG(actionResult::NO_PIECE, "No piece at source position");
+        return actionResult::NO_PIECE;
     }
 
     // 3) 턴 소유 확인
     if(movingPiece->getColor() != currentPlayerColor()) {
-        std::cerr << "Not your turn" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_YOUR_TURN, "Not your turn");
+        return actionResult::NOT_YOUR_TURN;
     }
 
     // 4) 한 턴 한 액션 제한
     if(performedActionThisTurn && activePieceThisTurn != movingPiece) {
-        std::cerr << "Another piece already acted this turn" << std::endl;
-        return false;
+        BC_LOG(actionResult::ANOTHER_PIECE_ACTED, "Another piece already acted this turn");
+        return actionResult::ANOTHER_PIECE_ACTED;
     }
 
     // 스턴 확인: 스턴 상태이면 이 턴에서 움직일 수 없음
     // 5) 스턴 상태면 이동 불가
     if(movingPiece->isStunned()) {
-        std::cerr << "Piece is stunned" << std::endl;
-        return false;
+        BC_LOG(actionResult::PIECE_STUNNED, "Piece is stunned");
+        return actionResult::PIECE_STUNNED;
     }
     
-    // 이동 스택 확인: 이동 스택이 있어야 이동 가능
-    // 6) 이동 스택 소비 (없으면 이동 불가)
-    if(!movingPiece->consumeMoveStack(1)) {
-        std::cerr << "No move stack available" << std::endl;
-        return false;
+    // 6) 이동 스택 확인 (없으면 이동 불가)
+    if(movingPiece->getMoveStack() < 1) {
+        BC_LOG(actionResult::NO_MOVE_STACK, "No move stack available");
+        return actionResult::NO_MOVE_STACK;
     }
     
-    // 7) 요청된 목적지가 합법수인지 확인
-    const auto& legalMoves = movingPiece->getLegalMoves();
-    const PGN* selectedMove = nullptr;
-    
-    for(const auto& moveData : legalMoves) {
-        if(moveData.endFile == toFile && moveData.endRank == toRank) {
-            selectedMove = &moveData;
-            break;
-        }
+    // 7) 도착 칸 마스크 비트 검사 (아래부터 상태를 바꾸므로 거절은 여기까지 끝낸다)
+    //    applyActions 도중에는 재계산이 미뤄져 있으므로 이 기물만 현재 점유로 다시 계산해 검사한다
+    if(refreshDeferred) updatePieceLegalMoves(movingPiece);
+    const int toSquare = squareOf(toFile, toRank);
+    if((movingPiece->getDestinationMask() & (uint64_t(1) << toSquare)) == 0) {
+        BC_LOG(actionResult::ILLEGAL_MOVE, "Illegal move");
+        return actionResult::ILLEGAL_MOVE;
     }
     
-    if(!selectedMove) {
-        std::cerr << "Illegal move" << std::endl;
-        return false;
-    }
-    
-    // 8) 이동 전에 해당 색상의 모든 기물 스턴 틱 감소
+    // 같은 도착 칸에 이동이 여럿이면 합법수 목록의 첫 이동을 따른다
+    const int jumpedSquare = movingPiece->getJumpedSquare(toSquare);
+    const bool captureJumped = jumpedSquare >= 0;
+    const int jumpedFile = captureJumped ? squareFile(jumpedSquare) : -1;
+    const int jumpedRank = captureJumped ? squareRank(jumpedSquare) : -1;
+
+    // 이동 스택 소비
+    evalWithdraw(*movingPiece);
+    movingPiece->consumeMoveStack(1);
+    evalDeposit(*movingPiece);
+
+    // 8) 이동 전에 해당 색상의 모든 기물 스턴 틱 감소 (합법수는 이동을 마친 뒤 한 번에 재계산)
     colorType movingColor = movingPiece->getColor();
-    applyStunTickForColor(movingColor);
+    tickStunLanes(lanes.occupied(movingColor));
+    evalWithdraw(*movingPiece); // 스택 이전/위치 변경 뒤 다시 더한다
     
     // 9) TAKEJUMP: 중간 기물도 캡처
-    if(selectedMove->captureJumped && selectedMove->jumpedFile >=0 && selectedMove->jumpedRank >=0) {
-        piece* midPiece = getPieceAt(selectedMove->jumpedFile, selectedMove->jumpedRank);
+    if(captureJumped && jumpedFile >= 0 && jumpedRank >= 0) {
+        piece* midPiece = getPieceAt(jumpedFile, jumpedRank);
         if(midPiece != nullptr) {
             movingPiece->addStun(midPiece->getStunStack());
             movingPiece->addMoveStack(midPiece->getMoveStack()); // 이동 스택도 전가
@@ -342,23 +397,30 @@ bool bc_board::movePiece(int fromFile, int fromRank, int toFile, int toRank) {
             auto& pocketCaptured = fullPocketForColor(movingColor);
             int capturedIdx = static_cast<int>(capturedPIdx);
             pocketCaptured[capturedIdx] += 1;
-            removePiece(selectedMove->jumpedFile, selectedMove->jumpedRank);
+            notePocketChange(movingColor, capturedType, +1);
+            erasePiece(midPiece);
+            BC_STAT_ADD(CAPTURES, 1);
         }
     }
 
     // 10) 도착지에 기물이 있으면 스턴 이전 후 포켓 적립
     piece* targetPiece = getPieceAt(toFile, toRank);
+    const bool captured = (targetPiece != nullptr);
     if(targetPiece != nullptr) {
         const int capturedStun = targetPiece->getStunStack(); // 로얄 스턴 분배 전에 캡처 피스 스턴을 저장
         const int capturedMove = targetPiece->getMoveStack(); // 이동 스택도 함께 이전
 
         // 로얄 피스 캡처 시: 같은 색 모든 기물에 스턴 +3 (로얄 피스 자신 포함)
         if(targetPiece->isRoyal()) {
-            colorType targetColor = targetPiece->getColor();
-            for(auto& p : pieces) {
-                if(p.getColor() == targetColor) {
-                    p.addStun(3);
-                }
+            const uint64_t penalized = lanes.occupied(targetPiece->getColor());
+            for(uint64_t rest = penalized; rest != 0; rest &= rest - 1) {
+                const int sq = lowestSquare(rest);
+                evalWithdraw(*board[squareFile(sq)][squareRank(sq)]);
+            }
+            laneAddStun(lanes, penalized, 3);
+            for(uint64_t rest = penalized; rest != 0; rest &= rest - 1) {
+                const int sq = lowestSquare(rest);
+                evalDeposit(*board[squareFile(sq)][squareRank(sq)]);
             }
         }
 
@@ -372,156 +434,153 @@ bool bc_board::movePiece(int fromFile, int fromRank, int toFile, int toRank) {
         auto& pocketCaptured = fullPocketForColor(movingColor);
         int capturedIdx = static_cast<int>(capturedPIdx);
         pocketCaptured[capturedIdx] += 1;
+        notePocketChange(movingColor, capturedType, +1);
         
-        removePiece(toFile, toRank);
+        erasePiece(targetPiece);
+        BC_STAT_ADD(CAPTURES, 1);
     }
     
     // 11) 기물 위치 갱신 및 턴 상태 플래그 업데이트
     board[fromFile][fromRank] = nullptr;
     board[toFile][toRank] = movingPiece;
-    movingPiece->setFile(toFile);
-    movingPiece->setRank(toRank);
+    movingPiece->moveTo(toFile, toRank);
+    evalDeposit(*movingPiece);
     activePieceThisTurn = movingPiece;
     performedActionThisTurn = true;
     
-    std::cout << "Piece moved from (" << fromFile << ", " << fromRank << ") to (" 
-              << toFile << ", " << toRank << ")" << std::endl;
+    BC_LOG(actionResult::OK, "Piece moved from (%d, %d) to (%d, %d)", fromFile, fromRank, toFile, toRank);
     
     // 12) 이동 로그 저장
-    log.push_back(PGN(fromFile, fromRank, toFile, toRank, movingPiece->getPieceType(), movingPiece->getColor(), (targetPiece != nullptr)));
-
-    // 합법수 재계산
-    for (auto& p : pieces) {
-        p.clearMovePatterns();
-        setupPiecePatterns(&p);
+    log.push_back(PGN(fromFile, fromRank, toFile, toRank, movingPiece->getPieceType(), movingPiece->getColor(), captured));
+
+    // 합법수 재계산 (출발/도착/뛰어넘은 칸을 확인하던 기물, 이동한 기물, 스턴 상태가 바뀐 기물)
+    uint64_t changed = (uint64_t(1) << squareOf(fromFile, fromRank)) | (uint64_t(1) << squareOf(toFile, toRank));
+    if(captureJumped && jumpedFile >= 0 && jumpedRank >= 0) changed |= uint64_t(1) << squareOf(jumpedFile, jumpedRank);
+    refreshLegalMoves(changed, movingPiece);
+    BC_STAT_ADD(ACTIONS, 1);
+    return actionResult::OK;
+}
+
+// 보드와 pieces 컨테이너에서 기물을 빼낸다 (합법수 재계산은 호출자 책임)
+void bc_board::erasePiece(piece* target) {
+    if(target == nullptr) return;
+    if(activePieceThisTurn == target) activePieceThisTurn = nullptr;
+    board[target->getFile()][target->getRank()] = nullptr;
+    evalWithdraw(*target);
+    lanes.erase(squareOf(target->getFile(), target->getRank()));
+    for(auto it = pieces.begin(); it != pieces.end(); ++it) {
+        if(&(*it) == target) {
+            pieces.erase(it);
+            break;
+        }
     }
-    updateAllLegalMoves();
-    return true;
 }
 
 // 기물 제거
-bool bc_board::removePiece(int file, int rank) {
+actionResult bc_board::removePiece(int file, int rank) {
+    BC_STAT_TIMER(REMOVE_PIECE);
+    BC_TRACE_METHOD(REMOVE_PIECE);
     if(!isValidPosition(file, rank)) {
-        std::cerr << "Invalid position" << std::endl;
-        return false;
+        BC_LOG(actionResult::INVALID_POSITION, "Invalid position");
+        return actionResult::INVALID_POSITION;
     }
     
     piece* targetPiece = getPieceAt(file, rank);
     if(targetPiece == nullptr) {
-        std::cerr << "No piece at position" << std::endl;
-        return false;
+        BC_LOG(actionResult::NO_PIECE, "No piece at position");
+        return actionResult::NO_PIECE;
     }
     
-    board[file][rank] = nullptr;
+    erasePiece(targetPiece);
     
-    // pieces 벡터에서도 제거
-    for(auto it = pieces.begin(); it != pieces.end(); ++it) {
-        if(&(*it) == targetPiece) {
-            pieces.erase(it);
-            break;
-        }
-    }
-    
-    std::cout << "Piece removed from (" << file << ", " << rank << ")" << std::endl;
+    BC_LOG(actionResult::OK, "Piece removed from (%d, %d)", file, rank);
     // 합법수 재계산
-    for (auto& p : pieces) {
-        p.clearMovePatterns();
-        setupPiecePatterns(&p);
-    }
-    updateAllLegalMoves();
-    return true;
+    refreshLegalMoves(uint64_t(1) << squareOf(file, rank));
+    return actionResult::OK;
 }
 
 
 // 폰 프로모션: 특정 기물을 다른 기물로 변환
-bool bc_board::promote(int file, int rank, pieceType promoteTo) {
+actionResult bc_board::promote(int file, int rank, pieceType promoteTo) {
+    BC_STAT_TIMER(PROMOTE);
+    BC_TRACE_METHOD(PROMOTE);
     if(!isValidPosition(file, rank)) {
-        std::cerr << "Invalid position" << std::endl;
-        return false;
+        BC_LOG(actionResult::INVALID_POSITION, "Invalid position");
+        return actionResult::INVALID_POSITION;
     }
     
     piece* pawn = getPieceAt(file, rank);
     if(pawn == nullptr) {
-        std::cerr << "No piece at position" << std::endl;
-        return false;
+        BC_LOG(actionResult::NO_PIECE, "No piece at position");
+        return actionResult::NO_PIECE;
     }
     
     if(pawn->getPieceType() != pieceType::PWAN) {
-        std::cerr << "Piece is not a pawn" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_A_PAWN, "Piece is not a pawn");
+        return actionResult::NOT_A_PAWN;
     }
     
     // 폰이 프로모션 가능한 위치에 있는지 확인
     if(!((pawn->getColor() == colorType::WHITE && rank == BOARD_SIZE - 1) ||
          (pawn->getColor() == colorType::BLACK && rank == 0))) {
-        std::cerr << "Pawn is not at promotion rank" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_PROMOTION_RANK, "Pawn is not at promotion rank");
+        return actionResult::NOT_PROMOTION_RANK;
     }
     
     // 변환할 기물이 킹이나 폰이면 안 됨
-    if(promoteTo == pieceType::KING || promoteTo == pieceType::PWAN) {
-        std::cerr << "Cannot promote to king or pawn" << std::endl;
-        return false;
+    if(promoteTo == pieceType::KING || promoteTo == pieceType::PWAN || pieceTypeToPocketIndex(promoteTo) == pocketIndex::NONE) {
+        BC_LOG(actionResult::INVALID_PROMOTION, "Cannot promote to king or pawn");
+        return actionResult::INVALID_PROMOTION;
     }
     
-    // 폰의 스턴을 새 기물에게 이전
-    int pawnStun = pawn->getStunStack();
-    int pawnMoveStack = pawn->getMoveStack(); // 이동 스택도 함께 이전
-    bool pawnStunned = pawn->isStunned();
-    
-    // 새 기물 타입으로 변환
+    // 새 기물 타입으로 변환 (스턴/이동 스택은 같은 객체에 그대로 남아 이전된다)
+    evalWithdraw(*pawn);
     pawn->setPieceType(promoteTo);
-    pawn->setStun(pawnStun);
-    pawn->setMoveStack(pawnMoveStack); // 이동 스택도 설정
-    if(pawnStunned) {
-        pawn->setStun(pawnStun);  // 스턴 상태는 setStun에서 자동 처리
-    }
-    
-    std::cout << "Pawn promoted at (" << file << ", " << rank << ")" << std::endl;
-    // 합법수 재계산
-    for (auto& p : pieces) {
-        p.clearMovePatterns();
-        setupPiecePatterns(&p);
-    }
-    updateAllLegalMoves();
-
+    setupPiecePatterns(pawn);
+    evalDeposit(*pawn);
     
-
-    return true;
+    BC_LOG(actionResult::OK, "Pawn promoted at (%d, %d)", file, rank);
+    // 합법수 재계산 (점유는 그대로이므로 프로모션한 기물만)
+    refreshLegalMoves(0, pawn);
+    BC_STAT_ADD(ACTIONS, 1);
+    return actionResult::OK;
 }
 
 // 턴을 넘기며 특정 기물의 스턴 스택을 추가 (킹 제외)
-bool bc_board::passAndAddStun(int file, int rank, int delta) {
+actionResult bc_board::passAndAddStun(int file, int rank, int delta) {
+    BC_STAT_TIMER(PASS_AND_ADD_STUN);
+    BC_TRACE_METHOD(PASS_AND_ADD_STUN);
     if(!isValidPosition(file, rank)) {
-        std::cerr << "Invalid position" << std::endl;
-        return false;
+        BC_LOG(actionResult::INVALID_POSITION, "Invalid position");
+        return actionResult::INVALID_POSITION;
     }
 
     if(performedActionThisTurn) {
-        std::cerr << "Action already performed this turn" << std::endl;
-        return false;
+        BC_LOG(actionResult::ACTION_ALREADY_PERFORMED, "Action already performed this turn");
+        return actionResult::ACTION_ALREADY_PERFORMED;
     }
 
     piece* target = getPieceAt(file, rank);
     if(target == nullptr) {
-        std::cerr << "No piece at position" << std::endl;
-        return false;
+        BC_LOG(actionResult::NO_PIECE, "No piece at position");
+        return actionResult::NO_PIECE;
     }
     
+    evalWithdraw(*target);
     target->addStun(delta);
+    evalDeposit(*target);
     activePieceThisTurn = target;
     performedActionThisTurn = true;
-    // 합법수 재계산
-    for (auto& p : pieces) {
-        p.clearMovePatterns();
-        setupPiecePatterns(&p);
-    }
-    updateAllLegalMoves();
-    return true;
+    // 합법수 재계산 (스턴 상태가 바뀐 기물만)
+    refreshLegalMoves(0);
+    BC_STAT_ADD(ACTIONS, 1);
+    return actionResult::OK;
 }
 
 // 다음 턴
 void bc_board::nextTurn() {
+    BC_STAT_TIMER(NEXT_TURN);
+    BC_TRACE_METHOD(NEXT_TURN);
     // 현재 플레이어의 수를 마무리하며 턴을 넘긴다
     colorType current = currentPlayerColor();
     if(current == colorType::WHITE) {
@@ -533,6 +592,7 @@ void bc_board::nextTurn() {
     applyStunTickForColor(current);
 
     resetTurnState();
+    BC_STAT_ADD(ACTIONS, 1);
 }
 
 // 특정 위치의 기물 포인터 가져오기 (public)
@@ -561,16 +621,7 @@ void bc_board::printBoard() const {
                 std::cout << "   |";
             } else {
                 // 색상 표시: 백=대문자, 흑=소문자
-                char symbol = ' ';
-                switch(p->getPieceType()) {
-                    case pieceType::KING:   symbol = 'K'; break;
-                    case pieceType::QUEEN:  symbol = 'Q'; break;
-                    case pieceType::ROOK:   symbol = 'R'; break;
-                    case pieceType::BISHOP: symbol = 'B'; break;
-                    case pieceType::KNIGHT: symbol = 'N'; break;
-                    case pieceType::PWAN:   symbol = 'P'; break;
-                    default: symbol = '?'; break;
-                }
+                char symbol = pieceSymbol(p->getPieceType());
                 
                 if(p->getColor() == colorType::BLACK) {
                     symbol = tolower(symbol);
@@ -612,26 +663,8 @@ void bc_board::printGameLog() const {
         // 변장과 승격은 별도 처리
         if(move.isDisguise) {
             // 변장: f1=Q 형식
-            char disguiseSymbol = ' ';
-            switch(move.disguiseAs) {
-                case pieceType::QUEEN:      disguiseSymbol = 'Q'; break;
-                case pieceType::ROOK:       disguiseSymbol = 'R'; break;
-                case pieceType::BISHOP:     disguiseSymbol = 'B'; break;
-                case pieceType::KNIGHT:     disguiseSymbol = 'N'; break;
-                case pieceType::AMAZON:     disguiseSymbol = 'A'; break;
-                case pieceType::GRASSHOPPER: disguiseSymbol = 'G'; break;
-                case pieceType::KNIGHTRIDER: disguiseSymbol = 'H'; break;
-                case pieceType::ARCHBISHOP: disguiseSymbol = 'W'; break;
-                case pieceType::DABBABA:    disguiseSymbol = 'D'; break;
-                case pieceType::ALFIL:      disguiseSymbol = 'L'; break;
-                case pieceType::FERZ:       disguiseSymbol = 'F'; break;
-                case pieceType::CENTAUR:    disguiseSymbol = 'C'; break;
-                case pieceType::TESTROOK:   disguiseSymbol = 'T'; break;
-                case pieceType::CAMEL:      disguiseSymbol = 'M'; break;
-                default: disguiseSymbol = '?'; break;
-            }
             std::cout << char('a' + move.startFile) << (move.startRank + 1) 
-                      << "=" << disguiseSymbol;
+                      << "=" << pieceSymbol(move.disguiseAs);
             isSpecialMove = true;
         } else if(move.isSuccession) {
             // 로얄 피스 승격: suc e5 형식
@@ -645,22 +678,10 @@ void bc_board::printGameLog() const {
                 std::cout << moveNumber << ". ";
             }
             
-            // 기물 표시
-            char pieceName = ' ';
-            switch(move.pT) {
-                case pieceType::KING:   pieceName = 'K'; break;
-                case pieceType::QUEEN:  pieceName = 'Q'; break;
-                case pieceType::ROOK:   pieceName = 'R'; break;
-                case pieceType::BISHOP: pieceName = 'B'; break;
-                case pieceType::KNIGHT: pieceName = 'N'; break;
-                case pieceType::PWAN:   pieceName = 'P'; break;
-                default: pieceName = ' '; break;
-            }
+            // 기물 표시 (페어리 기물 포함, replayNotation으로 다시 읽을 수 있는 글자)
+            std::cout << pieceSymbol(move.pT);
             
-            std::cout << pieceName;
-            
-            // 착수 체크 (startFile == 0 && startRank == 0)
-            if(move.startFile == 0 && move.startRank == 0) {
+            if(move.isDrop) {
                 // 착수: @<목표좌표> 형식
                 std::cout << "@" << char('a' + move.endFile) << (move.endRank + 1);
             } else {
@@ -690,6 +711,11 @@ void bc_board::printGameLog() const {
 // 보드 클리어 (기물만 제거, 포켓/턴 유지)
 void bc_board::clearBoard() {
     pieces.clear();
+    log.clear(); // 새 포지션에서 기보를 다시 시작
+    attackMaps = {};
+    lanes = {};
+    evalAcc = {};
+    syncPocketEval();
     activePieceThisTurn = nullptr;
     performedActionThisTurn = false;
     
@@ -707,6 +733,8 @@ void bc_board::setupPosition(
     const std::array<int, POCKET_SIZE>* whitePocketOverride,
     const std::array<int, POCKET_SIZE>* blackPocketOverride
 ) {
+    BC_STAT_TIMER(SETUP_POSITION);
+    BC_TRACE_METHOD(SETUP_POSITION);
     clearBoard();
 
     // 포켓 설정: 기본값으로 초기화 후 오버라이드가 있으면 적용
@@ -723,7 +751,7 @@ void bc_board::setupPosition(
         if(board[file][rank] != nullptr) continue; // 이미 기물이 있으면 스킵
         
         // 새 기물 추가
-        pieces.emplace_back(type, color, file, rank, pieces.size());
+        pieces.emplace_back(type, color, file, rank, pieces.size(), *this, lanes);
         piece* p = &pieces.back();
         
         // 스턴과 이동 스택 설정
@@ -760,6 +788,8 @@ void bc_board::setTurn(colorType turn) {
 
 // 보드 상태를 간단한 FEN 형식으로 변환 (기물 배치만, 캐슬링/앙파상 표기 제외)
 std::string bc_board::getBoardAsFEN() const {
+    BC_STAT_TIMER(GET_BOARD_AS_FEN);
+    BC_TRACE_METHOD(GET_BOARD_AS_FEN);
     std::string fen;
     
     // 보드를 rank 7부터 0까지 순회 (위에서 아래로)
@@ -781,26 +811,7 @@ std::string bc_board::getBoardAsFEN() const {
                 }
                 
                 // 기물 표기
-                char symbol = ' ';
-                switch(p->getPieceType()) {
-                    case pieceType::KING:       symbol = 'K'; break;
-                    case pieceType::QUEEN:      symbol = 'Q'; break;
-                    case pieceType::ROOK:       symbol = 'R'; break;
-                    case pieceType::BISHOP:     symbol = 'B'; break;
-                    case pieceType::KNIGHT:     symbol = 'N'; break;
-                    case pieceType::PWAN:       symbol = 'P'; break;
-                    case pieceType::AMAZON:     symbol = 'A'; break;
-                    case pieceType::GRASSHOPPER: symbol = 'G'; break;
-                    case pieceType::KNIGHTRIDER: symbol = 'H'; break;
-                    case pieceType::ARCHBISHOP: symbol = 'W'; break;
-                    case pieceType::DABBABA:    symbol = 'D'; break;
-                    case pieceType::ALFIL:      symbol = 'L'; break;
-                    case pieceType::FERZ:       symbol = 'F'; break;
-                    case pieceType::CENTAUR:    symbol = 'C'; break;
-                    case pieceType::TESTROOK:   symbol = 'T'; break;
-                    case pieceType::CAMEL:      symbol = 'M'; break;
-                    default: symbol = '?'; break;
-                }
+                char symbol = pieceSymbol(p->getPieceType());
                 
                 // 백 = 대문자, 흑 = 소문자
                 if(p->getColor() == colorType::WHITE) {
@@ -825,102 +836,83 @@ std::string bc_board::getBoardAsFEN() const {
     return fen;
 }
 
+// 공격 맵 조회
+uint64_t bc_board::getAttackMap(colorType color) const {
+    if(color == colorType::WHITE) return attackMaps[0];
+    if(color == colorType::BLACK) return attackMaps[1];
+    return 0;
+}
+
+uint64_t bc_board::getRoyalMask(colorType color) const {
+    if(color == colorType::WHITE) return lanes.royals[0];
+    if(color == colorType::BLACK) return lanes.royals[1];
+    return 0;
+}
+
+bool bc_board::isSquareAttacked(int file, int rank, colorType by) const {
+    if(!isValidPosition(file, rank)) return false;
+    return (getAttackMap(by) >> squareOf(file, rank)) & 1;
+}
+
 // 로얄 피스 존재 여부
 bool bc_board::hasRoyalPiece(colorType color) const {
-    for (const auto& p : pieces) {
-        if (p.getColor() == color && p.isRoyal()) return true;
-    }
-    return false;
+    return getRoyalMask(color) != 0;
 }
 
 // 로얄 피스가 체크 상태인지 확인 (로얄 피스 중 하나라도 체크되면 true)
+// 스턴 중인 적 기물도 공격 맵에 들어가므로 체크를 준다
 bool bc_board::isRoyalPieceInCheck(colorType color) const {
     colorType enemyColor = (color == colorType::WHITE) ? colorType::BLACK : colorType::WHITE;
-
-    // 적 기물이 공격하는 모든 칸을 미리 마킹
-    std::array<std::array<bool, BOARD_SIZE>, BOARD_SIZE> attacked{};
-    for (auto& col : attacked) col.fill(false);
-
-    for (const auto& p : pieces) {
-        if (p.getColor() != enemyColor) continue;
-        for (const auto& mv : p.getLegalMoves()) {
-            int ef = mv.endFile;
-            int er = mv.endRank;
-            if (isValidPosition(ef, er)) {
-                attacked[ef][er] = true;
-            }
-        }
-    }
-
-    // 로얄 피스 중 하나라도 공격받으면 체크
-    for (const auto& r : pieces) {
-        if (!r.isRoyal() || r.getColor() != color) continue;
-        int f = r.getFile();
-        int rk = r.getRank();
-        if (isValidPosition(f, rk) && attacked[f][rk]) return true;
-    }
-
-    return false;
+    return (getRoyalMask(color) & getAttackMap(enemyColor)) != 0;
 }
 
 // 로얄 피스 변장 (다른 기물로 위장)
-bool bc_board::disguisePiece(int file, int rank, pieceType disguiseAs) {
+actionResult bc_board::disguisePiece(int file, int rank, pieceType disguiseAs) {
+    BC_STAT_TIMER(DISGUISE_PIECE);
+    BC_TRACE_METHOD(DISGUISE_PIECE);
     if(!isValidPosition(file, rank)) {
-        std::cerr << "Invalid position" << std::endl;
-        return false;
+        BC_LOG(actionResult::INVALID_POSITION, "Invalid position");
+        return actionResult::INVALID_POSITION;
     }
 
     // 참고: disguisePiece는 독립적인 로얄 피스 액션이므로 performedActionThisTurn 체크 안 함
 
     piece* p = getPieceAt(file, rank);
     if(p == nullptr) {
-        std::cerr << "No piece at position" << std::endl;
-        return false;
+        BC_LOG(actionResult::NO_PIECE, "No piece at position");
+        return actionResult::NO_PIECE;
     }
 
     if(!p->isRoyal()) {
-        std::cerr << "Piece is not a royal piece" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_ROYAL, "Piece is not a royal piece");
+        return actionResult::NOT_ROYAL;
     }
 
     if(p->getColor() != currentPlayerColor()) {
-        std::cerr << "Not your turn" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_YOUR_TURN, "Not your turn");
+        return actionResult::NOT_YOUR_TURN;
     }
 
-    if(disguiseAs == pieceType::KING || disguiseAs == pieceType::PWAN || disguiseAs == pieceType::NONE) {
-        std::cerr << "Cannot disguise as king, pawn, or none" << std::endl;
-        return false;
+    if(disguiseAs == pieceType::KING || disguiseAs == pieceType::PWAN || pieceTypeToPocketIndex(disguiseAs) == pocketIndex::NONE) {
+        BC_LOG(actionResult::INVALID_DISGUISE, "Cannot disguise as king, pawn, or none");
+        return actionResult::INVALID_DISGUISE;
     }
 
     // 변장 설정: 실제 피스타입도 변장 타입으로 교체해 이동/표기 모두 변함
+    // 변장은 로얄만 할 수 있으므로 비밀 로얄도 이 시점에 공개된다
+    p->setSecretRoyal(false);
+    p->setRoyalCandidate(false);
+    evalWithdraw(*p);
     p->setDisguisedAs(disguiseAs);
     p->setPieceType(disguiseAs);
+    setupPiecePatterns(p);
+    evalDeposit(*p);
     activePieceThisTurn = p;
     performedActionThisTurn = true;
     // 참고: disguisePiece는 특수 행마이므로 performedActionThisTurn 플래그를 설정하지 않음
     // (move/drop과는 별개의 로얄 피스 액션)
 
     // 노테이션: f1=Q (파일f 랭크1에서 퀸으로 변장)
-    char pieceName = ' ';
-    switch(disguiseAs) {
-        case pieceType::QUEEN:      pieceName = 'Q'; break;
-        case pieceType::ROOK:       pieceName = 'R'; break;
-        case pieceType::BISHOP:     pieceName = 'B'; break;
-        case pieceType::KNIGHT:     pieceName = 'N'; break;
-        case pieceType::AMAZON:     pieceName = 'A'; break;
-        case pieceType::GRASSHOPPER: pieceName = 'G'; break;
-        case pieceType::KNIGHTRIDER: pieceName = 'H'; break;
-        case pieceType::ARCHBISHOP: pieceName = 'W'; break;
-        case pieceType::DABBABA:    pieceName = 'D'; break;
-        case pieceType::ALFIL:      pieceName = 'L'; break;
-        case pieceType::FERZ:       pieceName = 'F'; break;
-        case pieceType::CENTAUR:    pieceName = 'C'; break;
-        case pieceType::TESTROOK:   pieceName = 'T'; break;
-        case pieceType::CAMEL:      pieceName = 'M'; break;
-        default: pieceName = '?'; break;
-    }
-
     PGN disguiseLog;
     disguiseLog.startFile = file;
     disguiseLog.startRank = rank;
@@ -930,53 +922,64 @@ bool bc_board::disguisePiece(int file, int rank, pieceType disguiseAs) {
     disguiseLog.disguiseAs = disguiseAs;
     log.push_back(disguiseLog);
 
-    std::cout << "Piece disguised at (" << file << ", " << rank << ") as " << pieceName << std::endl;
+    BC_LOG(actionResult::OK, "Piece disguised at (%d, %d) as type %d", file, rank, static_cast<int>(disguiseAs));
 
-    // 합법수 재계산
-    for (auto& piece : pieces) {
-        piece.clearMovePatterns();
-        setupPiecePatterns(&piece);
-    }
-    updateAllLegalMoves();
-    return true;
+    // 합법수 재계산 (점유는 그대로이므로 변장한 기물만)
+    refreshLegalMoves(0, p);
+    BC_STAT_ADD(ACTIONS, 1);
+    return actionResult::OK;
 }
 
 // 로얄 피스 승격 (다른 기물을 새 로얄 피스로 승격)
-bool bc_board::succeedRoyalPiece(int file, int rank, colorType color) {
+actionResult bc_board::succeedRoyalPiece(int file, int rank, colorType color) {
+    BC_STAT_TIMER(SUCCEED_ROYAL_PIECE);
+    BC_TRACE_METHOD(SUCCEED_ROYAL_PIECE);
     if(!isValidPosition(file, rank)) {
-        std::cerr << "Invalid position" << std::endl;
-        return false;
+        BC_LOG(actionResult::INVALID_POSITION, "Invalid position");
+        return actionResult::INVALID_POSITION;
     }
 
     // 참고: succeedRoyalPiece는 독립적인 로얄 피스 액션이므로 performedActionThisTurn 체크 안 함
 
     if(color != currentPlayerColor()) {
-        std::cerr << "Not your turn" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_YOUR_TURN, "Not your turn");
+        return actionResult::NOT_YOUR_TURN;
     }
 
     piece* targetPiece = getPieceAt(file, rank);
     if(targetPiece == nullptr) {
-        std::cerr << "No piece at position" << std::endl;
-        return false;
+        BC_LOG(actionResult::NO_PIECE, "No piece at position");
+        return actionResult::NO_PIECE;
     }
 
     if(targetPiece->getColor() != color) {
-        std::cerr << "Piece is not your color" << std::endl;
-        return false;
+        BC_LOG(actionResult::NOT_OWN_PIECE, "Piece is not your color");
+        return actionResult::NOT_OWN_PIECE;
     }
 
     if(targetPiece->isRoyal()) {
-        std::cerr << "Piece is already royal" << std::endl;
-        return false;
+        BC_LOG(actionResult::ALREADY_ROYAL, "Piece is already royal");
+        return actionResult::ALREADY_ROYAL;
+    }
+
+    // 계승은 로얄 피스가 잡히는 것을 막을 수 없을 때만 허용 (rule.md 12)
+    if(!isRoyalPieceCheckmated(color)) {
+        BC_LOG(actionResult::NOT_CHECKMATED, "Royal piece is not checkmated");
+        return actionResult::NOT_CHECKMATED;
+    }
+
+    // 상대는 계승이 있었다는 것만 안다: 공개 로얄이 아닌 자기 기물이 모두 후보
+    for(auto& p : pieces) {
+        if(p.getColor() == color && (!p.isRoyal() || p.isSecretRoyal())) p.setRoyalCandidate(true);
     }
 
     // 새로운 로얄 피스로 지정 (기존 로얄 유지)
+    evalWithdraw(*targetPiece); // 로얄 피스는 칸 보너스 없음
     targetPiece->setRoyal(true);
+    targetPiece->setSecretRoyal(true);
+    evalDeposit(*targetPiece);
     activePieceThisTurn = targetPiece;
     performedActionThisTurn = true;
-    // 참고: succeedRoyalPiece는 특수 행마이므로 performedActionThisTurn 플래그를 설정하지 않음
-    // (move/drop과는 별개의 로얄 피스 액션)
 
     // 노테이션: suc e5 (e5의 기물을 로얄 피스로 승격)
     PGN successionLog;
@@ -987,13 +990,9 @@ bool bc_board::succeedRoyalPiece(int file, int rank, colorType color) {
     successionLog.isSuccession = true;
     log.push_back(successionLog);
 
-    std::cout << "Piece succeeded as royal at (" << file << ", " << rank << ")" << std::endl;
+    BC_LOG(actionResult::OK, "Piece succeeded as royal at (%d, %d)", file, rank);
 
-    // 합법수 재계산
-    for (auto& piece : pieces) {
-        piece.clearMovePatterns();
-        setupPiecePatterns(&piece);
-    }
-    updateAllLegalMoves();
-    return true;
+    // 로얄 여부는 이동 패턴에 영향 없으므로 공격 맵은 그대로 둔다 (로얄 마스크는 setRoyal이 갱신)
+    BC_STAT_ADD(ACTIONS, 1);
+    return actionResult::OK;
 }
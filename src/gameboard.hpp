@@ -3,10 +3,25 @@
 #include <vector>
 #include <list>
 #include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <moves.hpp>
 #include <piece.hpp>
+#include <log.hpp>
+#include <stats.hpp>
+#include <trace.hpp>
+#include <packed.hpp>
+#include <action.hpp>
+#include <notation.hpp>
+#include <see.hpp>
+#include <eval.hpp>
+#include <nnue.hpp>
+#include <ismcts.hpp>
 
 inline static constexpr int POCKET_SIZE = 16;
+static_assert(POCKET_SIZE == PIECE_TYPE_COUNT, "포켓 칸은 기물 종류마다 하나 (pocketIndex = pieceType)");
 
 class bc_board{
     private:
@@ -45,35 +60,80 @@ class bc_board{
         const std::array<int, 6>& pocketForColor(colorType color) const;
         std::array<int, POCKET_SIZE>& fullPocketForColor(colorType color);
         const std::array<int, POCKET_SIZE>& fullPocketForColor(colorType color) const;
-        colorType currentPlayerColor() const;
+        void erasePiece(piece* target); // 보드/컨테이너에서 제거만 수행 (합법수 재계산 없음)
+        // packedPosition/widePosition 공통 변환 (packed.cpp, 필드 폭만 다르다)
+        template <typename Encoded> void encodeState(Encoded& out) const;
+        template <typename Encoded> bool decodeState(const Encoded& in);
+
+        // 색상별 공격 비트보드 (칸 비트 = rank*8+file, 인덱스 0 = 백, 1 = 흑)
+        std::array<uint64_t, 2> attackMaps{};
+        // 칸별 스턴/이동 스택, 색상별 점유/로얄 비트보드 (lanes.hpp): 기물 객체의 스택/로얄 getter가 읽는 저장소
+        pieceLanes lanes;
+        void tickStunLanes(uint64_t mask); // mask 칸 기물의 스턴 틱 (레인 + 평가)
+        // changedSquares를 확인했던 기물, touched, 스턴 상태가 바뀐 기물만 다시 계산한 뒤 공격 맵을 갱신
+        // 재계산마다 1 증가: 다시 계산한 기물은 이 값을 기록하고, 합법 이동 목록은 조회할 때 이 값 기준으로 지연 생성한다
+        // (첫 조회가 캐시를 채우므로 한 보드를 여러 스레드가 동시에 읽으면 안 된다)
+        uint64_t positionEpoch = 1;
+        // applyActions 도중: 재계산은 에포크만 올리고 끝에서 한 번 몰아서 한다 (이동하는 기물만 그 자리에서 계산)
+        bool refreshDeferred = false;
+        bool refreshPending = false;
+        void flushDeferredRefresh();
+        void refreshLegalMoves(uint64_t changedSquares, piece* touched = nullptr);
+        void rebuildAttackMaps();
+
+        // 평가 항목 색상별 합계 (eval.hpp): 기물 상태를 바꾸는 곳마다 바꾸기 전 Withdraw, 바꾼 뒤 Deposit
+        std::array<evalTerms, 2> evalAcc{};
+        void evalWithdraw(const piece& p);
+        void evalDeposit(const piece& p);
+        void syncPocketEval();
+        void rebuildEvaluation();
+        void notePocketChange(colorType color, pieceType type, int delta); // 포켓 수를 바꾼 뒤 호출
+        // NNUE 누적기 (nnue.hpp): 연결된 네트워크가 있을 때만 Withdraw/Deposit에서 함께 갱신, 평가 시 몰아서 적용
+        mutable nnueAccumulator neural;
 
     public:
         // 생성자/소멸자
         bc_board();
         bc_board(const std::array<int, POCKET_SIZE>& whiteStock, const std::array<int, POCKET_SIZE>& blackStock);
         ~bc_board();
+        // 기물이 보드의 레인/소유 보드를 포인터로 가리키므로 복사하면 상태를 공유한다: 복사는 encodePacked/decodePacked로
+        bc_board(const bc_board&) = delete;
+        bc_board& operator=(const bc_board&) = delete;
         
         // 보드 초기화
         void initializeBoard();
         
-        // 모든 기물의 합법 이동 업데이트
+        // 모든 기물의 합법 이동 업데이트 (공격 맵도 다시 만든다)
         void updateAllLegalMoves();
         void updatePieceLegalMoves(piece* p);
         void applyStunTickAll();
         void applyStunTickForColor(colorType color);
         
-        // 기물 착수 관련 함수
-        bool placePiece(pieceType type, colorType color, int file, int rank);
-        bool movePiece(int fromFile, int fromRank, int toFile, int toRank);
-        bool removePiece(int file, int rank);
-        bool passAndAddStun(int file, int rank, int delta = 1); // 킹 제외 스턴 +1
-        bool promote(int file, int rank, pieceType promoteTo); // 폰 프로모션
+        // 기물 착수 관련 함수 (actionResult::OK가 아니면 거절 사유, 상태 변화 없음)
+        actionResult placePiece(pieceType type, colorType color, int file, int rank);
+        actionResult movePiece(int fromFile, int fromRank, int toFile, int toRank);
+        actionResult removePiece(int file, int rank);
+        actionResult passAndAddStun(int file, int rank, int delta = 1); // 킹 제외 스턴 +1
+        actionResult promote(int file, int rank, pieceType promoteTo); // 폰 프로모션
+        
+        // boardAction 하나를 현재 차례 기준으로 적용 (END_TURN은 nextTurn)
+        actionResult applyAction(const boardAction& action);
+        // 액션 여러 개를 순서대로 적용하고 합법수/공격 맵/평가는 끝에서 한 번만 다시 계산한다.
+        // 거절된 액션에서 멈추며 그 앞까지는 적용된 상태로 남는다
+        actionBatchReport applyActions(const boardAction* actions, size_t count);
+        actionBatchReport applyActions(const std::vector<boardAction>& actions) { return applyActions(actions.data(), actions.size()); }
+        void collectLegalActions(std::vector<boardAction>& out) const; // 현재 차례가 지금 할 수 있는 액션 (END_TURN 포함)
+
+        // 기보 표기 (notation.hpp): 현재 차례의 합법수로 해석해 적용
+        actionResult resolveNotation(std::string_view token, resolvedNotation& out) const; // 보드는 변경하지 않음
+        actionResult applyNotation(std::string_view token);
+        replayReport replayNotation(std::string_view text); // 수 번호/결과/주석을 건너뛰며 턴 경계는 자동 판단
         
         // 턴 진행용 함수.
         void nextTurn(); // 턴을 종료했을 때 호출하는 함수로 이 타이밍에 스턴-이동 스택에 대한 연산을 수행한다.
         
         // 포지션 설정/불러오기
-        void clearBoard(); // 보드 초기화 (기물만 제거, 포켓/턴 유지)
+        void clearBoard(); // 보드 초기화 (기물/기보만 제거, 포켓/턴 유지)
         void setupPosition(
             const std::vector<std::tuple<pieceType, colorType, int, int, int, int>>& pieces,
             colorType turn = colorType::WHITE,
@@ -85,12 +145,18 @@ class bc_board{
         // 포켓 조회
         std::array<int, POCKET_SIZE> getPocketStock(colorType color) const;
         int getPocketCount(colorType color, pocketIndex idx) const;
+        static const std::array<int, POCKET_SIZE>& defaultPocketStock() { return DEFAULT_POCKET_STOCK; }
         
         // getter (move 클래스에서 접근 가능하도록 public으로)
         bool isValidPosition(int file, int rank) const;
         piece* getPiece(int file, int rank) const;
         int getWhiteMoveCount() const { return whiteMoveCount; }
         int getBlackMoveCount() const { return blackMoveCount; }
+        // 둘 차례: 양쪽 수가 같으면 백 (packedPosition처럼 보드 없이 수만 있을 때는 정적 버전)
+        colorType currentPlayerColor() const { return playerToMove(whiteMoveCount, blackMoveCount); }
+        static colorType playerToMove(int whiteMoves, int blackMoves) {
+            return (whiteMoves == blackMoves) ? colorType::WHITE : colorType::BLACK;
+        }
         
         // 보드 출력
         void printBoard() const;
@@ -100,89 +166,74 @@ class bc_board{
         
         // FEN 변환
         std::string getBoardAsFEN() const;
+
+        // 전체 상태 포지션 문자열 (배치 + 스턴/이동 스택 + 로얄/변장 + 포켓 + 턴/턴 내 상태)
+        // 형식은 position.cpp 상단 주석 참고
+        std::string getPositionString() const;
+        bool loadPositionString(std::string_view text); // 실패 시 false, 보드는 변경되지 않음
+
+        // 고정 크기 바이너리 레코드 (packed.hpp), 스택/포켓은 255로 클램프
+        void encodePacked(packedPosition& out) const;
+        bool decodePacked(const packedPosition& in); // 실패 시 false, 보드는 변경되지 않음
+        // 같은 코드의 전체 폭 상태 (범위 밖 스택/음수 포켓·수 카운트는 false)
+        void encodeWide(widePosition& out) const;
+        bool decodeWide(const widePosition& in);
+        // viewer가 보는 포지션 (ismcts.hpp): 상대 비밀 로얄은 로얄 표시를 지우고 후보/수만 남긴다
+        void observe(colorType viewer, packedPosition& out, royalObservation& hidden) const;
         
+        // 공격 맵: color 기물들이 잡을 수 있는 칸 (스턴 기물 포함)
+        uint64_t getAttackMap(colorType color) const;
+        uint64_t getRoyalMask(colorType color) const;
+        bool isSquareAttacked(int file, int rank, colorType by) const;
+        const pieceLanes& getLanes() const { return lanes; } // 칸별 스턴/이동 스택과 점유/로얄 비트보드
+
+        // 정적 교환 평가 (see.hpp): from -> to 뒤 to에서의 잡고 되잡기 결과, 이동하는 편 기준
+        int staticExchange(int fromFile, int fromRank, int toFile, int toRank) const;
+        bool staticExchangeAtLeast(int fromFile, int fromRank, int toFile, int toRank, int threshold) const;
+
+        // 정적 평가 (eval.hpp): 증분 유지되는 항목 합계의 가중합, perspective 기준
+        int evaluate(colorType perspective) const;
+        evalTerms getEvalTerms(colorType color) const;
+        int royalSafety(colorType color) const;
+
+        // NNUE 평가 (nnue.hpp): network는 호출자가 보드보다 오래 유지, nullptr이면 해제
+        void attachNetwork(const nnueNetwork* network);
+        bool hasNetwork() const { return neural.active(); }
+        int evaluateNeural(colorType perspective) const; // 네트워크가 없으면 evaluate()
+        const nnueAccumulator& getNeuralAccumulator() const; // 미뤄 둔 변화를 적용한 뒤 반환
+        std::vector<int> getNeuralFeatures(colorType perspective) const; // 활성 특징 번호 (학습 데이터용)
+
         // 로얄 피스 관련
         bool hasRoyalPiece(colorType color) const;
-        bool isRoyalPieceInCheck(colorType color) const;
-        bool disguisePiece(int file, int rank, pieceType disguiseAs); // 로얄 피스 변장
-        bool succeedRoyalPiece(int file, int rank, colorType color); // 로얄 피스 승격
+        bool isRoyalPieceInCheck(colorType color) const; // 공격 맵 & 로얄 마스크
+        // 체크메이트 판정 (checkmate.cpp): 상대가 다음 턴에 로얄 피스를 잡을 수 있는지, 이번 턴 안에 막을 수 있는지
+        bool isRoyalCaptureThreatened(colorType color) const;
+        bool canPreventRoyalCapture(colorType color) const;
+        bool isRoyalPieceCheckmated(colorType color) const; // 위협받고 막을 수 없음 (계승 조건, rule.md 12)
+        actionResult disguisePiece(int file, int rank, pieceType disguiseAs); // 로얄 피스 변장
+        actionResult succeedRoyalPiece(int file, int rank, colorType color); // 로얄 피스 승격
 };
 
 // 기물 패턴 설정 함수
-// 주어진 기물에 적절한 이동 패턴을 추가합니다.
+// 주어진 기물의 이동 패턴을 기물 특성 레지스트리(piecetraits.hpp)대로 다시 설정합니다. (기존 패턴은 지우므로 여러 번 호출해도 안전)
 inline void setupPiecePatterns(piece* p) {
     if (!p) return;
-    
-    pieceType type = p->getPieceType();
-    
-    switch(type) {
-        case pieceType::KNIGHT:
-            // RAY_FINITE로 구현: 최대 2칸까지 나이트 방향으로 이동 (경로상 기물에 영향)
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, KNIGHT_DIRECTIONS, 1));
-            break;
-        case pieceType::BISHOP:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_INFINITE, BISHOP_DIRECTIONS));
-            break;
-        case pieceType::ROOK:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_INFINITE, ROOK_DIRECTIONS));
-            break;
-        case pieceType::QUEEN:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_INFINITE, QUEEN_DIRECTIONS));
-            break;
-        case pieceType::KING:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, KING_DIRECTIONS, 1));
-            break;
-        case pieceType::PWAN:
-            // 폰: 전진 + 대각선 캡처 (색상에 따라 방향 달라짐)
-            if(p->getColor() == colorType::WHITE) {
-                // 백: +1 방향 (상향)
-                std::vector<std::pair<int, int>> pawnForward = {{0, 1}};
-                p->addMovePattern(legalMoveChunk(threatType::MOVE, moveType::RAY_FINITE, pawnForward, 1));
-                std::vector<std::pair<int, int>> pawnCapture = {{-1, 1}, {1, 1}};
-                p->addMovePattern(legalMoveChunk(threatType::TAKE, moveType::RAY_FINITE, pawnCapture, 1));
-            } else {
-                // 흑: -1 방향 (하향)
-                std::vector<std::pair<int, int>> pawnForward = {{0, -1}};
-                p->addMovePattern(legalMoveChunk(threatType::MOVE, moveType::RAY_FINITE, pawnForward, 1));
-                std::vector<std::pair<int, int>> pawnCapture = {{-1, -1}, {1, -1}};
-                p->addMovePattern(legalMoveChunk(threatType::TAKE, moveType::RAY_FINITE, pawnCapture, 1));
-            }
-            break;
-        case pieceType::AMAZON:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, KNIGHT_DIRECTIONS, 1));
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_INFINITE, QUEEN_DIRECTIONS));
-            break;
-        case pieceType::GRASSHOPPER:
-            p->addMovePattern(legalMoveChunk(threatType::MOVEJUMP, moveType::RAY_INFINITE, QUEEN_DIRECTIONS));
-            break;
-        case pieceType::KNIGHTRIDER:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_INFINITE, KNIGHT_DIRECTIONS));
-            break;
-        case pieceType::ARCHBISHOP:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, KNIGHT_DIRECTIONS, 1));
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_INFINITE, BISHOP_DIRECTIONS));
-            break;
-        case pieceType::DABBABA:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, DABBABA_DIRECTIONS, 1));
-            break;
-        case pieceType::ALFIL:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, ALFIL_DIRECTIONS, 1));
-            break;
-        case pieceType::FERZ:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, BISHOP_DIRECTIONS, 1));
-            break;
-        case pieceType::CENTAUR:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, KING_DIRECTIONS, 1));
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, KNIGHT_DIRECTIONS, 1));
-            break;
-        case pieceType::TESTROOK:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEJUMP, moveType::RAY_INFINITE, ROOK_DIRECTIONS));
-            break;
-        case pieceType::CAMEL:
-            p->addMovePattern(legalMoveChunk(threatType::TAKEMOVE, moveType::RAY_FINITE, CAMEL_DIRECTIONS, 1));
-            break;
-        default:
-            break;
+    p->clearMovePatterns();
+
+    const pieceTraits* traits = findPieceTraits(p->getPieceType());
+    if (!traits) return;
+    const bool mirrored = traits->blackMirrored && p->getColor() == colorType::BLACK; // 폰: 흑은 하향
+    for (int i = 0; i < traits->patternCount; ++i) {
+        const patternTraits& pattern = traits->patterns[static_cast<size_t>(i)];
+        std::vector<std::pair<int, int>> dirs = stepVector(pattern.steps, pattern.stepCount);
+        if (mirrored) {
+            for (auto& d : dirs) d.second = -d.second;
+        }
+        if (pattern.move == moveType::RAY_FINITE) {
+            p->addMovePattern(legalMoveChunk(pattern.threat, pattern.move, dirs, pattern.maxDistance));
+        } else {
+            p->addMovePattern(legalMoveChunk(pattern.threat, pattern.move, dirs));
+        }
     }
 }
 
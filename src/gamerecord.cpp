@@ -0,0 +1,356 @@
+#include <gamerecord.hpp>
+#include <byteio.hpp>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[4] = {'B', 'C', 'G', 'R'};
+constexpr uint8_t FORMAT_VERSION = 1;
+constexpr size_t FILE_HEADER_SIZE = 8;
+
+constexpr uint8_t HEADER_POCKETS = 0x01;
+constexpr uint8_t HEADER_COUNTS = 0x02;
+constexpr uint8_t HEADER_TURN_STATE = 0x04;
+constexpr uint8_t HEADER_HIDDEN_ROYALS = 0x08;
+constexpr uint8_t HEADER_KNOWN = HEADER_POCKETS | HEADER_COUNTS | HEADER_TURN_STATE | HEADER_HIDDEN_ROYALS;
+
+constexpr uint8_t OP_TYPE_MASK = 0x07;
+constexpr uint8_t OP_TAKE = 0x08;
+constexpr uint8_t OP_JUMP = 0x10;
+constexpr uint8_t OP_CONTINUE = 0x20;
+constexpr uint8_t OP_STUN_DELTA = 0x40;
+
+bool getByte(const uint8_t*& p, const uint8_t* end, uint8_t& out) {
+    if(p >= end) return false;
+    out = *p++;
+    return true;
+}
+
+bool validSquare(int sq) { return sq >= 0 && sq < 64; }
+bool validPieceType(uint32_t type) { return type < static_cast<uint32_t>(PIECE_TYPE_COUNT); }
+bool validCount(uint32_t v) { return v <= static_cast<uint32_t>(INT32_MAX); }
+
+} // namespace
+
+// ---------------------------------------------------------------- writer
+
+bool gameRecordWriter::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "ab");
+    if(file == nullptr) return false;
+    std::fseek(file, 0, SEEK_END);
+    if(std::ftell(file) == 0) {
+        uint8_t fileHeader[FILE_HEADER_SIZE] = {
+            static_cast<uint8_t>(MAGIC[0]), static_cast<uint8_t>(MAGIC[1]),
+            static_cast<uint8_t>(MAGIC[2]), static_cast<uint8_t>(MAGIC[3]),
+            FORMAT_VERSION, 0, 0, 0
+        };
+        std::fwrite(fileHeader, 1, sizeof(fileHeader), file);
+    }
+    return true;
+}
+
+void gameRecordWriter::close() {
+    if(file != nullptr) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    inGame = false;
+}
+
+// 초기 상태를 헤더로 기록 (기본 포켓/카운트 0/턴 상태 없음이면 해당 필드 생략)
+// 스택/포켓/수 카운트는 packedPosition처럼 자르지 않고 보드 값 그대로 쓴다
+void gameRecordWriter::beginGame(const bc_board& initial) {
+    widePosition pos;
+    initial.encodeWide(pos);
+
+    header.clear();
+    actions.clear();
+    actionCount = 0;
+    lastMoveTo = -1;
+    inGame = true;
+
+    const auto& defaults = bc_board::defaultPocketStock();
+    uint8_t flags = 0;
+    for(int i = 0; i < POCKET_SIZE; ++i) {
+        if(pos.pockets[i] != defaults[i] || pos.pockets[POCKET_SIZE + i] != defaults[i]) {
+            flags |= HEADER_POCKETS;
+            break;
+        }
+    }
+    if(pos.whiteMoveCount != 0 || pos.blackMoveCount != 0) flags |= HEADER_COUNTS;
+    if(pos.flags != 0 || pos.activeSquare != PACKED_NO_SQUARE) flags |= HEADER_TURN_STATE;
+    if(pos.secretRoyals != 0 || pos.royalCandidates != 0) flags |= HEADER_HIDDEN_ROYALS;
+
+    header.push_back(flags);
+    if(flags & HEADER_POCKETS) {
+        for(int i = 0; i < 2 * POCKET_SIZE; ++i) putVarint(header, static_cast<uint32_t>(pos.pockets[i]));
+    }
+    uint32_t pieceCount = 0;
+    for(int sq = 0; sq < 64; ++sq) pieceCount += (pos.squares[sq] != 0);
+    putVarint(header, pieceCount);
+    for(int sq = 0; sq < 64; ++sq) {
+        if(pos.squares[sq] == 0) continue;
+        header.push_back(static_cast<uint8_t>(sq));
+        header.push_back(pos.squares[sq]);
+        putVarint(header, static_cast<uint32_t>(pos.stun[sq]));
+        putVarint(header, static_cast<uint32_t>(pos.move[sq]));
+    }
+    if(flags & HEADER_COUNTS) {
+        putVarint(header, static_cast<uint32_t>(pos.whiteMoveCount));
+        putVarint(header, static_cast<uint32_t>(pos.blackMoveCount));
+    }
+    if(flags & HEADER_TURN_STATE) {
+        header.push_back(pos.flags);
+        header.push_back(pos.activeSquare);
+    }
+    if(flags & HEADER_HIDDEN_ROYALS) {
+        putU64(header, pos.secretRoyals);
+        putU64(header, pos.royalCandidates);
+    }
+}
+
+void gameRecordWriter::addAction(const boardAction& action) {
+    if(!inGame) return;
+    uint8_t op = static_cast<uint8_t>(action.type) & OP_TYPE_MASK;
+
+    switch(action.type) {
+        case actionType::DROP:
+            actions.push_back(op);
+            putVarint(actions, (static_cast<uint32_t>(action.pT) << 6) | static_cast<uint32_t>(action.toSquare & 63));
+            break;
+        case actionType::MOVE: {
+            if(action.take) op |= OP_TAKE;
+            if(action.jumpedSquare >= 0) op |= OP_JUMP;
+            const bool continues = (action.fromSquare == lastMoveTo);
+            if(continues) op |= OP_CONTINUE;
+            actions.push_back(op);
+            if(!continues) actions.push_back(static_cast<uint8_t>(action.fromSquare));
+            putZigzag(actions, action.toSquare - action.fromSquare);
+            if(action.jumpedSquare >= 0) putZigzag(actions, action.jumpedSquare - action.toSquare);
+            break;
+        }
+        case actionType::STUN:
+            if(action.stunDelta != 1) op |= OP_STUN_DELTA;
+            actions.push_back(op);
+            actions.push_back(static_cast<uint8_t>(action.fromSquare));
+            if(action.stunDelta != 1) putZigzag(actions, action.stunDelta);
+            break;
+        case actionType::PROMOTE:
+        case actionType::DISGUISE:
+            actions.push_back(op);
+            actions.push_back(static_cast<uint8_t>(action.fromSquare));
+            actions.push_back(static_cast<uint8_t>(action.pT));
+            break;
+        case actionType::SUCCESSION:
+            actions.push_back(op);
+            actions.push_back(static_cast<uint8_t>(action.fromSquare));
+            break;
+        case actionType::END_TURN:
+            actions.push_back(op);
+            break;
+    }
+
+    lastMoveTo = (action.type == actionType::MOVE) ? action.toSquare : -1;
+    actionCount++;
+}
+
+bool gameRecordWriter::endGame(gameResult result) {
+    if(!inGame || file == nullptr) return false;
+    inGame = false;
+
+    scratch.clear();
+    scratch.push_back(static_cast<uint8_t>(result));
+    putVarint(scratch, actionCount);
+    scratch.insert(scratch.end(), header.begin(), header.end());
+    scratch.insert(scratch.end(), actions.begin(), actions.end());
+
+    std::vector<uint8_t> lengthPrefix;
+    putVarint(lengthPrefix, static_cast<uint32_t>(scratch.size()));
+    bool ok = std::fwrite(lengthPrefix.data(), 1, lengthPrefix.size(), file) == lengthPrefix.size();
+    ok = ok && std::fwrite(scratch.data(), 1, scratch.size(), file) == scratch.size();
+    return ok;
+}
+
+// ---------------------------------------------------------------- reader
+
+bool gameRecordReader::open(const std::string& path) {
+    corrupt = false;
+    offset = FILE_HEADER_SIZE;
+    if(!file.open(path)) return false;
+    if(file.size() < FILE_HEADER_SIZE) return false;
+    const uint8_t* d = file.data();
+    if(std::memcmp(d, MAGIC, sizeof(MAGIC)) != 0 || d[4] != FORMAT_VERSION) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+void gameRecordReader::rewind() {
+    offset = FILE_HEADER_SIZE;
+    corrupt = false;
+}
+
+bool gameRecordReader::nextGame(gameRecordView& game) {
+    if(!file.isOpen() || offset >= file.size()) return false;
+    size_t next = offset;
+    if(!readGameAt(offset, game, &next)) {
+        corrupt = true;
+        return false;
+    }
+    offset = next;
+    return true;
+}
+
+bool gameRecordReader::readGameAt(size_t at, gameRecordView& game, size_t* next) const {
+    if(!file.isOpen() || at < FILE_HEADER_SIZE || at >= file.size()) return false;
+
+    const uint8_t* p = file.data() + at;
+    const uint8_t* fileEnd = file.data() + file.size();
+    uint32_t bodyLength;
+    if(!getVarint(p, fileEnd, bodyLength) || static_cast<size_t>(fileEnd - p) < bodyLength) return false;
+    const uint8_t* bodyEnd = p + bodyLength;
+    if(next != nullptr) *next = static_cast<size_t>(bodyEnd - file.data());
+
+    uint8_t result, flags;
+    uint32_t count, pieceCount;
+    if(!getByte(p, bodyEnd, result) || !getVarint(p, bodyEnd, count) || !getByte(p, bodyEnd, flags)) return false;
+    if(flags & ~HEADER_KNOWN) return false;
+
+    widePosition& pos = game.initial;
+    std::memset(&pos, 0, sizeof(pos));
+    pos.activeSquare = PACKED_NO_SQUARE;
+    const auto& defaults = bc_board::defaultPocketStock();
+    for(int i = 0; i < POCKET_SIZE; ++i) {
+        pos.pockets[i] = defaults[i];
+        pos.pockets[POCKET_SIZE + i] = defaults[i];
+    }
+
+    // 값은 int 범위만 확인하고, 스택 상한 같은 보드 규칙은 loadInitial(decodeWide)이 확인한다
+    bool ok = true;
+    if(flags & HEADER_POCKETS) {
+        for(int i = 0; i < 2 * POCKET_SIZE && ok; ++i) {
+            uint32_t v = 0;
+            ok = getVarint(p, bodyEnd, v) && validCount(v);
+            pos.pockets[i] = static_cast<int>(v);
+        }
+    }
+    ok = ok && getVarint(p, bodyEnd, pieceCount) && pieceCount <= 64;
+    for(uint32_t i = 0; i < pieceCount && ok; ++i) {
+        uint8_t sq = 0, code = 0;
+        uint32_t stun = 0, move = 0;
+        ok = getByte(p, bodyEnd, sq) && getByte(p, bodyEnd, code) &&
+             getVarint(p, bodyEnd, stun) && getVarint(p, bodyEnd, move) && validSquare(sq) &&
+             validCount(stun) && validCount(move);
+        if(ok) {
+            pos.squares[sq] = code;
+            pos.stun[sq] = static_cast<int>(stun);
+            pos.move[sq] = static_cast<int>(move);
+        }
+    }
+    if(ok && (flags & HEADER_COUNTS)) {
+        uint32_t w = 0, b = 0;
+        ok = getVarint(p, bodyEnd, w) && getVarint(p, bodyEnd, b) && validCount(w) && validCount(b);
+        pos.whiteMoveCount = static_cast<int>(w);
+        pos.blackMoveCount = static_cast<int>(b);
+    }
+    if(ok && (flags & HEADER_TURN_STATE)) {
+        ok = getByte(p, bodyEnd, pos.flags) && getByte(p, bodyEnd, pos.activeSquare);
+    }
+    if(ok && (flags & HEADER_HIDDEN_ROYALS)) {
+        ok = bodyEnd - p >= 16;
+        if(ok) {
+            pos.secretRoyals = readU64(p);
+            pos.royalCandidates = readU64(p + 8);
+            p += 16;
+        }
+    }
+    if(!ok) return false;
+
+    game.res = static_cast<gameResult>(result);
+    game.count = count;
+    game.remaining = count;
+    game.cursor = p;
+    game.end = bodyEnd;
+    game.lastMoveTo = -1;
+    return true;
+}
+
+bool gameRecordView::nextAction(boardAction& out) {
+    if(remaining == 0) return false;
+    const uint8_t* p = cursor;
+    uint8_t op;
+    if(!getByte(p, end, op)) return false;
+
+    out = boardAction();
+    out.type = static_cast<actionType>(op & OP_TYPE_MASK);
+    bool ok = true;
+    switch(out.type) {
+        case actionType::DROP: {
+            uint32_t v = 0;
+            ok = getVarint(p, end, v) && validPieceType(v >> 6);
+            out.pT = static_cast<pieceType>(v >> 6);
+            out.toSquare = static_cast<int8_t>(v & 63);
+            break;
+        }
+        case actionType::MOVE: {
+            int from = lastMoveTo;
+            if(!(op & OP_CONTINUE)) {
+                uint8_t b = 0;
+                ok = getByte(p, end, b);
+                from = b;
+            }
+            int delta = 0;
+            ok = ok && getZigzag(p, end, delta) && validSquare(from) && validSquare(from + delta);
+            out.fromSquare = static_cast<int8_t>(from);
+            out.toSquare = static_cast<int8_t>(from + delta);
+            out.take = (op & OP_TAKE) != 0;
+            if(ok && (op & OP_JUMP)) {
+                int jumpDelta = 0;
+                ok = getZigzag(p, end, jumpDelta) && validSquare(out.toSquare + jumpDelta);
+                out.jumpedSquare = static_cast<int8_t>(out.toSquare + jumpDelta);
+            }
+            break;
+        }
+        case actionType::STUN: {
+            uint8_t sq = 0;
+            ok = getByte(p, end, sq) && validSquare(sq);
+            out.fromSquare = static_cast<int8_t>(sq);
+            if(ok && (op & OP_STUN_DELTA)) {
+                int delta = 1;
+                ok = getZigzag(p, end, delta);
+                out.stunDelta = static_cast<int8_t>(delta);
+            }
+            break;
+        }
+        case actionType::PROMOTE:
+        case actionType::DISGUISE: {
+            uint8_t sq = 0, type = 0;
+            ok = getByte(p, end, sq) && getByte(p, end, type) && validSquare(sq) && validPieceType(type);
+            out.fromSquare = static_cast<int8_t>(sq);
+            out.pT = static_cast<pieceType>(type);
+            break;
+        }
+        case actionType::SUCCESSION: {
+            uint8_t sq = 0;
+            ok = getByte(p, end, sq) && validSquare(sq);
+            out.fromSquare = static_cast<int8_t>(sq);
+            break;
+        }
+        case actionType::END_TURN:
+            break;
+        default:
+            ok = false;
+            break;
+    }
+    if(!ok) {
+        remaining = 0;
+        return false;
+    }
+
+    cursor = p;
+    remaining--;
+    lastMoveTo = (out.type == actionType::MOVE) ? out.toSquare : -1;
+    return true;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <gameboard.hpp>
+#include <mappedfile.hpp>
+
+/* 다중 게임 기록 파일 (.bcgr)
+   파일 헤더: "BCGR" + 버전(1바이트) + 예약(3바이트)
+   게임:     varint(본문 길이) + 본문
+   본문:     결과(1바이트) + varint(액션 수) + 초기 상태 + 액션 스트림
+
+   초기 상태: 플래그(1바이트: 비트0 포켓 지정, 비트1 수 카운트 지정, 비트2 턴 상태 지정, 비트3 비밀 로얄 지정)
+             [포켓 32개 varint] + varint(기물 수) + 기물마다 (칸, packed 코드, varint 스턴, varint 이동)
+             [varint 백 수, varint 흑 수] [플래그, 활성 칸] [u64 비밀 로얄 칸, u64 후보 칸]
+             (값은 packedPosition처럼 자르지 않는다, 모르는 플래그 비트가 있으면 손상으로 본다)
+   액션:     opcode(1바이트: 비트0-2 actionType, 비트3 캡처, 비트4 점프 캡처,
+             비트5 직전 MOVE 도착 칸에서 이어지는 이동, 비트6 스턴 양 지정) + 피연산자
+             DROP: varint(pieceType << 6 | 칸)
+             MOVE: [출발 칸] + zigzag varint(도착 - 출발) [+ zigzag varint(점프 칸 - 도착)]
+             STUN: 칸 [+ zigzag varint(스턴 양)]
+             PROMOTE/DISGUISE: 칸 + pieceType
+             SUCCESSION: 칸
+             END_TURN: 없음
+   텍스트 파싱 없이 mmap 위에서 바로 순회할 수 있다.
+*/
+
+enum class gameResult : uint8_t {
+    UNKNOWN,
+    WHITE_WIN,
+    BLACK_WIN,
+    DRAW
+};
+
+// 추가 전용 기록기: beginGame -> addAction... -> endGame 순으로 게임 하나를 기록
+class gameRecordWriter {
+    private:
+        std::FILE* file = nullptr;
+        std::vector<uint8_t> header;
+        std::vector<uint8_t> actions;
+        std::vector<uint8_t> scratch;
+        uint32_t actionCount = 0;
+        int lastMoveTo = -1;
+        bool inGame = false;
+
+    public:
+        gameRecordWriter() = default;
+        ~gameRecordWriter() { close(); }
+        gameRecordWriter(const gameRecordWriter&) = delete;
+        gameRecordWriter& operator=(const gameRecordWriter&) = delete;
+
+        bool open(const std::string& path); // 없으면 생성, 있으면 뒤에 덧붙임
+        void close();
+        bool isOpen() const { return file != nullptr; }
+
+        void beginGame(const bc_board& initial);
+        void addAction(const boardAction& action);
+        bool endGame(gameResult result = gameResult::UNKNOWN);
+};
+
+// 게임 하나에 대한 뷰: 매핑된 메모리 위에서 액션을 하나씩 디코드한다
+class gameRecordView {
+    private:
+        const uint8_t* cursor = nullptr;
+        const uint8_t* end = nullptr;
+        uint32_t remaining = 0;
+        uint32_t count = 0;
+        int lastMoveTo = -1;
+        gameResult res = gameResult::UNKNOWN;
+        widePosition initial{};
+        friend class gameRecordReader;
+
+    public:
+        gameResult result() const { return res; }
+        uint32_t actionCount() const { return count; }
+        const widePosition& initialPosition() const { return initial; }
+        bool loadInitial(bc_board& board) const { return board.decodeWide(initial); }
+        bool nextAction(boardAction& out); // 끝이거나 손상되면 false
+};
+
+// 읽기 전용 mmap 리더
+class gameRecordReader {
+    private:
+        mappedFile file;
+        size_t offset = 0;
+        bool corrupt = false;
+
+    public:
+        bool open(const std::string& path); // 매직/버전이 맞지 않으면 false
+        void rewind();
+        bool nextGame(gameRecordView& game); // 다음 게임, 끝이거나 손상되면 false
+        size_t position() const { return offset; } // 다음 게임의 파일 내 위치
+
+        // 임의 위치의 게임 하나를 읽는다 (커서 불변, 여러 스레드에서 동시에 호출 가능)
+        bool readGameAt(size_t at, gameRecordView& game, size_t* next = nullptr) const;
+        bool isCorrupt() const { return corrupt; }
+        size_t fileSize() const { return file.size(); }
+};
@@ -0,0 +1,236 @@
+#include <ismcts.hpp>
+#include <gameboard.hpp>
+#include <policy.hpp>
+#include <tablebase.hpp>
+#include <threadpool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace {
+
+inline uint64_t bitOf(int square) { return uint64_t(1) << square; }
+
+inline colorType opponentOf(colorType c) {
+    return (c == colorType::WHITE) ? colorType::BLACK : colorType::WHITE;
+}
+
+// splitmix64
+inline uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline size_t randomBelow(uint64_t& state, size_t bound) {
+    return static_cast<size_t>(nextRandom(state) % bound);
+}
+
+// 백 기준 값: 첫 턴 이후 로얄이 없는 편이 패배
+bool terminalWhiteValue(const bc_board& board, float& value) {
+    if(board.getWhiteMoveCount() + board.getBlackMoveCount() < 2) return false;
+    const bool white = board.hasRoyalPiece(colorType::WHITE);
+    const bool black = board.hasRoyalPiece(colorType::BLACK);
+    if(white && black) return false;
+    value = (white == black) ? 0.0f : (white ? 1.0f : -1.0f);
+    return true;
+}
+
+// 테이블베이스에서 승패가 증명된 포지션 (백 기준 값)
+bool tableWhiteValue(const bc_board& board, const tablebaseSet* tables, float& value) {
+    int proven = 0;
+    if(tables == nullptr || !tables->probe(board, proven) || proven == 0) return false;
+    const bool moverWins = proven > 0;
+    value = ((board.currentPlayerColor() == colorType::WHITE) == moverWins) ? 1.0f : -1.0f;
+    return true;
+}
+
+// 무작위 롤아웃 (백 기준 값), 한도를 넘으면 정적 평가를 -1..1로 눌러 쓴다
+float rollout(bc_board& board, int limit, const tablebaseSet* tables, uint64_t& rng, std::vector<boardAction>& actions) {
+    float value = 0.0f;
+    for(int step = 0; step < limit; ++step) {
+        if(terminalWhiteValue(board, value) || tableWhiteValue(board, tables, value)) return value;
+        board.collectLegalActions(actions);
+        board.applyAction(actions[randomBelow(rng, actions.size())]);
+    }
+    if(terminalWhiteValue(board, value)) return value;
+    return std::tanh(static_cast<float>(board.evaluate(colorType::WHITE)) / 600.0f);
+}
+
+struct infoNode {
+    int action = -1;                 // policyIndex (부모의 둘 차례 관점)
+    int parent = -1;
+    std::vector<int> children;
+    int visits = 0;
+    int availability = 0;            // 부모에서 이 액션이 가능했던 결정화 수
+    float valueSum = 0.0f;           // 부모의 둘 차례 기준
+    colorType mover = colorType::WHITE; // 이 노드에서 둘 차례
+};
+
+// 한 스레드의 트리: 관찰에서 결정화를 뽑아 반복
+void searchInformationSet(const packedPosition& observed, const royalObservation& hidden, const ismctsConfig& config,
+                          int iterations, uint64_t seed, std::map<int, int>& rootVisits, double& rootValue) {
+    std::vector<infoNode> nodes(1);
+    std::vector<boardAction> actions;
+    std::vector<int> indices;
+    std::vector<int> untried;
+    packedPosition world;
+    bc_board board;
+    uint64_t rng = seed;
+
+    for(int it = 0; it < iterations; ++it) {
+        BC_TRACE_SCOPE("ismcts iteration", "search");
+        sampleRoyalAssignment(observed, hidden, rng, world);
+        board.decodePacked(world);
+        int cur = 0;
+        nodes[0].mover = board.currentPlayerColor();
+        float whiteValue = 0.0f;
+        bool done = false;
+
+        while(!done) {
+            if(terminalWhiteValue(board, whiteValue)) break;
+            const colorType mover = board.currentPlayerColor();
+            nodes[cur].mover = mover;
+            board.collectLegalActions(actions);
+            indices.clear();
+            for(const auto& a : actions) indices.push_back(policyIndex(a, mover));
+
+            // 이 결정화에서 가능한 자식: 가용 횟수 증가, 아직 없는 액션은 확장 후보
+            untried.clear();
+            for(size_t i = 0; i < indices.size(); ++i) {
+                bool found = false;
+                for(int c : nodes[cur].children) {
+                    if(nodes[c].action == indices[i]) {
+                        nodes[c].availability++;
+                        found = true;
+                        break;
+                    }
+                }
+                if(!found) untried.push_back(static_cast<int>(i));
+            }
+
+            if(!untried.empty()) {
+                const int pick = untried[randomBelow(rng, untried.size())];
+                infoNode child;
+                child.action = indices[pick];
+                child.parent = cur;
+                child.availability = 1;
+                nodes.push_back(std::move(child));
+                const int index = static_cast<int>(nodes.size()) - 1;
+                nodes[cur].children.push_back(index);
+                board.applyAction(actions[pick]);
+                cur = index;
+                nodes[cur].mover = board.currentPlayerColor();
+                whiteValue = rollout(board, config.rolloutActions, config.tables, rng, actions);
+                done = true;
+                break;
+            }
+
+            // UCB: 이 결정화에서 가능한 자식만
+            int best = -1;
+            float bestScore = -1e30f;
+            size_t bestAction = 0;
+            for(size_t i = 0; i < indices.size(); ++i) {
+                for(int c : nodes[cur].children) {
+                    const infoNode& child = nodes[c];
+                    if(child.action != indices[i]) continue;
+                    const float score = child.valueSum / static_cast<float>(child.visits) +
+                                        config.exploration * std::sqrt(std::log(static_cast<float>(child.availability)) / static_cast<float>(child.visits));
+                    if(score > bestScore) {
+                        bestScore = score;
+                        best = c;
+                        bestAction = i;
+                    }
+                    break;
+                }
+            }
+            board.applyAction(actions[bestAction]);
+            cur = best;
+        }
+
+        for(int n = cur; n >= 0; n = nodes[n].parent) {
+            infoNode& node = nodes[n];
+            const colorType chooser = (node.parent >= 0) ? nodes[node.parent].mover : node.mover;
+            node.visits++;
+            node.valueSum += (chooser == colorType::WHITE) ? whiteValue : -whiteValue;
+        }
+    }
+
+    for(int c : nodes[0].children) rootVisits[nodes[c].action] += nodes[c].visits;
+    rootValue += nodes[0].valueSum;
+}
+
+} // namespace
+
+void bc_board::observe(colorType viewer, packedPosition& out, royalObservation& hidden) const {
+    BC_STAT_TIMER(OBSERVE);
+    BC_TRACE_METHOD(OBSERVE);
+    encodePacked(out);
+    hidden = royalObservation{};
+    for(const auto& p : pieces) {
+        if(p.getColor() == viewer) continue;
+        const int sq = squareOf(p.getFile(), p.getRank());
+        if(p.isSecretRoyal()) {
+            out.squares[sq] &= static_cast<uint8_t>(~PACKED_ROYAL);
+            out.secretRoyals &= ~bitOf(sq);
+            hidden.hiddenCount++;
+        }
+        if(p.isRoyalCandidate() && (!p.isRoyal() || p.isSecretRoyal())) hidden.candidates |= bitOf(sq);
+    }
+}
+
+void sampleRoyalAssignment(const packedPosition& observed, const royalObservation& hidden, uint64_t& rng, packedPosition& out) {
+    out = observed;
+    uint64_t pool = hidden.candidates;
+    for(int k = 0; k < hidden.hiddenCount && pool != 0; ++k) {
+        // pool의 r번째 비트
+        size_t r = randomBelow(rng, static_cast<size_t>(squareCount(pool)));
+        uint64_t bits = pool;
+        while(r-- > 0) bits &= bits - 1;
+        const int sq = lowestSquare(bits);
+        out.squares[sq] |= PACKED_ROYAL;
+        out.secretRoyals |= bitOf(sq);
+        pool &= ~bitOf(sq);
+    }
+}
+
+ismctsResult informationSetSearch(const bc_board& board, const ismctsConfig& config, threadPool* pool) {
+    ismctsResult result;
+    const colorType mover = board.currentPlayerColor();
+    packedPosition observed;
+    royalObservation hidden;
+    board.observe(mover, observed, hidden);
+
+    const size_t workers = (pool != nullptr) ? std::max<size_t>(1, pool->size()) : 1;
+    const int total = std::max(0, config.iterations);
+    std::vector<std::map<int, int>> visits(workers);
+    std::vector<double> values(workers, 0.0);
+    auto work = [&](size_t begin, size_t end) {
+        for(size_t w = begin; w < end; ++w) {
+            const int share = total / static_cast<int>(workers) + (static_cast<int>(w) < total % static_cast<int>(workers) ? 1 : 0);
+            searchInformationSet(observed, hidden, config, share, config.seed + 0x1000193ull * (w + 1), visits[w], values[w]);
+        }
+    };
+    if(pool != nullptr) pool->parallelFor(0, workers, 1, work);
+    else work(0, 1);
+
+    std::map<int, int> merged;
+    double valueSum = 0.0;
+    for(size_t w = 0; w < workers; ++w) {
+        for(const auto& [index, count] : visits[w]) merged[index] += count;
+        valueSum += values[w];
+    }
+    int bestIndex = -1, bestVisits = -1;
+    for(const auto& [index, count] : merged) {
+        result.visits.emplace_back(index, count);
+        if(count > bestVisits) {
+            bestVisits = count;
+            bestIndex = index;
+        }
+    }
+    if(bestIndex >= 0) result.best = policyAction(bestIndex, mover);
+    result.iterations = total;
+    result.value = (total > 0) ? static_cast<float>(valueSum / total) : 0.0f;
+    return result;
+}
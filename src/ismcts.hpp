@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <action.hpp>
+#include <packed.hpp>
+
+class bc_board;
+class threadPool;
+class tablebaseSet;
+
+/* 비밀 로얄 계승의 불완전 정보 (ismcts.cpp)
+   계승(rule.md 12)으로 로얄이 된 기물은 상대에게 보이지 않는다. 상대가 아는 것은
+     - 계승이 있었다는 사실과 살아 있는 비밀 로얄 수 (로얄이 잡히면 같은 편 전체 스턴 +3으로 드러남)
+     - 후보: 계승 시점에 공개 로얄이 아니던 그 편 기물 (이후 착수한 기물은 후보가 아님)
+   변장은 로얄만 할 수 있으므로 변장한 비밀 로얄은 공개 로얄이 된다.
+   후보/비밀 표시는 기물(piece)에 붙어 함께 움직이고, 포지션 문자열(접미사 '!'/'?'), packed 레코드(secretRoyals/
+   royalCandidates), 게임 기록 헤더에 함께 저장된다. observe()는 상대의 비밀 로얄 비트를 칸 코드와 마스크에서 모두 지운다.
+
+   정보 집합 탐색 (SO-ISMCTS): 반복마다 관찰과 일치하는 로얄 배정을 하나 뽑아(결정화) 그 보드에서
+   트리를 내려가고 무작위 롤아웃을 한다. 자식 선택은 그 결정화에서 가능한 액션만 보고(가용 횟수 기반 UCB),
+   액션은 policyIndex(둘 차례 관점 번호)로 구분한다. 스레드마다 독립 트리를 돌리고 루트 방문 수를 합친다.
+*/
+struct royalObservation {
+    uint64_t candidates = 0;  // 비밀 로얄일 수 있는 상대 기물 칸
+    int hiddenCount = 0;      // 살아 있는 상대 비밀 로얄 수
+};
+
+// 관찰에 로얄 배정 하나를 채운다: 후보 칸에서 hiddenCount개를 균등하게 비복원 추출 (rng는 호출마다 전진)
+void sampleRoyalAssignment(const packedPosition& observed, const royalObservation& hidden, uint64_t& rng, packedPosition& out);
+
+struct ismctsConfig {
+    int iterations = 4000;      // 전체 반복 수 (스레드에 나눠 실행)
+    int rolloutActions = 48;    // 롤아웃 최대 액션 수, 넘으면 정적 평가로 끝냄
+    float exploration = 0.7f;   // UCB 상수
+    uint64_t seed = 1;
+    const tablebaseSet* tables = nullptr; // 있으면 롤아웃 중 턴 시작 포지션을 조회해 증명된 승패에서 멈춘다
+};
+
+struct ismctsResult {
+    boardAction best;                          // 합친 방문 수가 가장 많은 루트 액션
+    std::vector<std::pair<int, int>> visits;   // (policyIndex, 방문 수), 번호 순
+    float value = 0.0f;                        // 루트 평균 가치 (둘 차례 기준, -1..1)
+    int iterations = 0;
+};
+
+// 둘 차례의 관찰만으로 탐색 (실제 비밀 로얄은 보지 않는다). pool이 없으면 호출 스레드에서 트리 하나
+ismctsResult informationSetSearch(const bc_board& board, const ismctsConfig& config, threadPool* pool = nullptr);
@@ -0,0 +1,155 @@
+#include <lanes.hpp>
+#include <simd.hpp>
+
+namespace {
+
+using stunnedKernel = uint64_t (*)(const int16_t* stun, uint64_t mask);
+using tickKernel = uint64_t (*)(int16_t* stun, int16_t* move, uint64_t mask);
+using addKernel = void (*)(int16_t* stun, uint64_t mask, int delta);
+
+uint64_t stunnedScalar(const int16_t* stun, uint64_t mask) {
+    uint64_t stunned = 0;
+    for(int sq = 0; sq < 64; ++sq) stunned |= static_cast<uint64_t>(stun[sq] > 0) << sq;
+    return stunned & mask;
+}
+
+// 레인마다 선택(-1)/비선택(0)을 산술로 만들어 분기 없이 더한다
+uint64_t tickScalar(int16_t* stun, int16_t* move, uint64_t mask) {
+    uint64_t ticked = 0;
+    for(int sq = 0; sq < 64; ++sq) {
+        const int selected = -static_cast<int>((mask >> sq) & 1);
+        const int t = selected & -static_cast<int>(stun[sq] > 0);
+        stun[sq] = static_cast<int16_t>(stun[sq] + t);
+        move[sq] = static_cast<int16_t>(std::min(move[sq] - t, LANE_STACK_MAX));
+        ticked |= static_cast<uint64_t>(t & 1) << sq;
+    }
+    return ticked;
+}
+
+void addScalar(int16_t* stun, uint64_t mask, int delta) {
+    for(int sq = 0; sq < 64; ++sq) {
+        const int selected = -static_cast<int>((mask >> sq) & 1);
+        stun[sq] = static_cast<int16_t>(std::clamp(stun[sq] + (selected & delta), 0, LANE_STACK_MAX));
+    }
+}
+
+#ifdef BC_SIMD_X86
+// 16비트 마스크 -> 레인별 0/-1 (레인 i는 비트 i)
+BC_SIMD_TARGET("avx2")
+__m256i expandMask(uint64_t mask, int first) {
+    const __m256i laneBits = _mm256_setr_epi16(0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+                                               0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, static_cast<short>(0x8000));
+    const __m256i bits = _mm256_set1_epi16(static_cast<short>((mask >> first) & 0xFFFF));
+    return _mm256_cmpeq_epi16(_mm256_and_si256(bits, laneBits), laneBits);
+}
+
+// 16비트 레인 32개(0/-1) -> 32비트 마스크 (packs는 128비트 단위로 섞으므로 순서를 되돌린다)
+BC_SIMD_TARGET("avx2")
+uint32_t laneBits(__m256i low, __m256i high) {
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(low, high), 0xD8);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(packed));
+}
+
+BC_SIMD_TARGET("avx2")
+uint64_t stunnedAvx2(const int16_t* stun, uint64_t mask) {
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t stunned = 0;
+    for(int first = 0; first < 64; first += 32) {
+        const __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(stun + first));
+        const __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(stun + first + 16));
+        stunned |= static_cast<uint64_t>(laneBits(_mm256_cmpgt_epi16(low, zero), _mm256_cmpgt_epi16(high, zero))) << first;
+    }
+    return stunned & mask;
+}
+
+BC_SIMD_TARGET("avx2")
+uint64_t tickAvx2(int16_t* stun, int16_t* move, uint64_t mask) {
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t ticked = 0;
+    for(int first = 0; first < 64; first += 32) {
+        __m256i t[2];
+        for(int h = 0; h < 2; ++h) {
+            __m256i* s = reinterpret_cast<__m256i*>(stun + first + 16 * h);
+            __m256i* m = reinterpret_cast<__m256i*>(move + first + 16 * h);
+            const __m256i sv = _mm256_load_si256(s);
+            t[h] = _mm256_and_si256(_mm256_cmpgt_epi16(sv, zero), expandMask(mask, first + 16 * h));
+            _mm256_store_si256(s, _mm256_add_epi16(sv, t[h]));
+            _mm256_store_si256(m, _mm256_subs_epi16(_mm256_load_si256(m), t[h]));
+        }
+        ticked |= static_cast<uint64_t>(laneBits(t[0], t[1])) << first;
+    }
+    return ticked;
+}
+
+BC_SIMD_TARGET("avx2")
+void addAvx2(int16_t* stun, uint64_t mask, int delta) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i d = _mm256_set1_epi16(static_cast<short>(std::clamp(delta, -LANE_STACK_MAX, LANE_STACK_MAX)));
+    for(int first = 0; first < 64; first += 16) {
+        __m256i* s = reinterpret_cast<__m256i*>(stun + first);
+        const __m256i add = _mm256_and_si256(d, expandMask(mask, first));
+        _mm256_store_si256(s, _mm256_max_epi16(_mm256_adds_epi16(_mm256_load_si256(s), add), zero));
+    }
+}
+#endif
+
+struct kernelTable {
+    laneKernel kind = laneKernel::SCALAR;
+    stunnedKernel stunned = stunnedScalar;
+    tickKernel tick = tickScalar;
+    addKernel add = addScalar;
+};
+
+kernelTable tableFor(laneKernel kind) {
+#ifdef BC_SIMD_X86
+    if(kind == laneKernel::AVX2) return {kind, stunnedAvx2, tickAvx2, addAvx2};
+#endif
+    return {laneKernel::SCALAR, stunnedScalar, tickScalar, addScalar};
+}
+
+kernelTable& activeKernels() {
+    static kernelTable table = [] {
+        if(laneKernelSupported(laneKernel::AVX2)) return tableFor(laneKernel::AVX2);
+        return tableFor(laneKernel::SCALAR);
+    }();
+    return table;
+}
+
+} // namespace
+
+uint64_t laneStunned(const pieceLanes& lanes, uint64_t mask) {
+    return activeKernels().stunned(lanes.stun.data(), mask);
+}
+
+uint64_t laneStunTick(pieceLanes& lanes, uint64_t mask) {
+    return activeKernels().tick(lanes.stun.data(), lanes.move.data(), mask);
+}
+
+void laneAddStun(pieceLanes& lanes, uint64_t mask, int delta) {
+    activeKernels().add(lanes.stun.data(), mask, delta);
+}
+
+bool laneKernelSupported(laneKernel kernel) {
+    switch(kernel) {
+        case laneKernel::SCALAR: return true;
+        case laneKernel::AVX2:   return cpuHasAvx2();
+        default:                 return false;
+    }
+}
+
+bool laneSetKernel(laneKernel kernel) {
+    if(!laneKernelSupported(kernel)) return false;
+    activeKernels() = tableFor(kernel);
+    return true;
+}
+
+laneKernel laneActiveKernel() {
+    return activeKernels().kind;
+}
+
+const char* laneKernelName(laneKernel kernel) {
+    switch(kernel) {
+        case laneKernel::AVX2: return "avx2";
+        default:               return "scalar";
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <enum.hpp>
+
+// 스턴/이동 스택 상한: 레인이 int16이므로 모든 스택은 0..LANE_STACK_MAX로 자른다
+inline constexpr int LANE_STACK_MAX = 0x7FFF;
+
+inline int16_t clampLaneStack(int value) {
+    return static_cast<int16_t>(std::clamp(value, 0, LANE_STACK_MAX));
+}
+
+/* 기물 핫 스칼라의 칸 인덱스 병렬 배열 (SoA)
+   bc_board가 소유하고, 스턴/이동 스택/로얄 여부는 여기에만 저장된다 (piece의 getter/setter가 자기 칸을 읽고 씀).
+   레인 = 칸 (rank*8+file), 빈 칸은 0, 색상과 로얄은 비트보드.
+   턴마다 도는 스턴 틱과 로얄 캡처 페널티(+3)는 64레인을 분기 없이 한 번에 처리한다.
+*/
+struct pieceLanes {
+    alignas(32) std::array<int16_t, 64> stun{}; // 스턴 스택
+    alignas(32) std::array<int16_t, 64> move{}; // 이동 스택
+    std::array<uint64_t, 2> colors{};           // 색상별 점유 (0 = 백, 1 = 흑)
+    std::array<uint64_t, 2> royals{};           // 색상별 로얄 피스
+
+    static int sideOf(colorType color) { return (color == colorType::WHITE) ? 0 : 1; }
+
+    // 빈 칸에 새 기물: 스택 0, 로얄 아님
+    void place(int square, colorType color) {
+        erase(square);
+        colors[sideOf(color)] |= uint64_t(1) << square;
+    }
+    void erase(int square) {
+        const uint64_t bit = uint64_t(1) << square;
+        colors[0] &= ~bit;
+        colors[1] &= ~bit;
+        royals[0] &= ~bit;
+        royals[1] &= ~bit;
+        stun[square] = 0;
+        move[square] = 0;
+    }
+    // 기물 이동: 도착 칸은 비어 있어야 한다 (잡힌 기물은 먼저 erase)
+    void relocate(int from, int to) {
+        const uint64_t fromBit = uint64_t(1) << from;
+        const uint64_t toBit = uint64_t(1) << to;
+        for(int side = 0; side < 2; ++side) {
+            if(colors[side] & fromBit) colors[side] = (colors[side] & ~fromBit) | toBit;
+            if(royals[side] & fromBit) royals[side] = (royals[side] & ~fromBit) | toBit;
+        }
+        stun[to] = stun[from];
+        move[to] = move[from];
+        stun[from] = 0;
+        move[from] = 0;
+    }
+    uint64_t occupied(colorType color) const { return colors[sideOf(color)]; }
+};
+
+// mask 칸 중 스턴 > 0인 칸
+uint64_t laneStunned(const pieceLanes& lanes, uint64_t mask);
+// mask 칸 중 스턴 > 0인 레인: 스턴 -1, 이동 +1 (상한에서 멈춤). 바뀐 칸 마스크를 반환
+uint64_t laneStunTick(pieceLanes& lanes, uint64_t mask);
+// mask 칸의 스턴 += delta (0..LANE_STACK_MAX로 자름)
+void laneAddStun(pieceLanes& lanes, uint64_t mask, int delta);
+
+// 레인 커널 (기본값: CPU가 지원하는 가장 넓은 것)
+enum class laneKernel : uint8_t {
+    SCALAR,
+    AVX2
+};
+bool laneKernelSupported(laneKernel kernel);
+bool laneSetKernel(laneKernel kernel); // 지원하지 않으면 false, 기존 커널 유지
+laneKernel laneActiveKernel();
+const char* laneKernelName(laneKernel kernel);
@@ -0,0 +1,66 @@
+#include <log.hpp>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+#if BC_ENABLE_LOG
+logSink currentSink = &stderrLogSink;
+#else
+logSink currentSink = nullptr;
+#endif
+}
+
+void setLogSink(logSink sink) {
+    currentSink = sink;
+}
+
+logSink getLogSink() {
+    return currentSink;
+}
+
+void stderrLogSink(actionResult result, const char* message) {
+    std::fprintf(stderr, "[%s] %s\n", actionResultName(result), message);
+}
+
+const char* actionResultName(actionResult result) {
+    switch(result) {
+        case actionResult::OK:                       return "OK";
+        case actionResult::INVALID_POSITION:         return "INVALID_POSITION";
+        case actionResult::ACTION_ALREADY_PERFORMED: return "ACTION_ALREADY_PERFORMED";
+        case actionResult::ANOTHER_PIECE_ACTED:      return "ANOTHER_PIECE_ACTED";
+        case actionResult::NOT_YOUR_TURN:            return "NOT_YOUR_TURN";
+        case actionResult::NO_PIECE:                 return "NO_PIECE";
+        case actionResult::NOT_OWN_PIECE:            return "NOT_OWN_PIECE";
+        case actionResult::OCCUPIED:                 return "OCCUPIED";
+        case actionResult::POCKET_EMPTY:             return "POCKET_EMPTY";
+        case actionResult::PAWN_ON_FINAL_RANK:       return "PAWN_ON_FINAL_RANK";
+        case actionResult::PIECE_STUNNED:            return "PIECE_STUNNED";
+        case actionResult::NO_MOVE_STACK:            return "NO_MOVE_STACK";
+        case actionResult::ILLEGAL_MOVE:             return "ILLEGAL_MOVE";
+        case actionResult::NOT_A_PAWN:               return "NOT_A_PAWN";
+        case actionResult::NOT_PROMOTION_RANK:       return "NOT_PROMOTION_RANK";
+        case actionResult::INVALID_PROMOTION:        return "INVALID_PROMOTION";
+        case actionResult::NOT_ROYAL:                return "NOT_ROYAL";
+        case actionResult::ALREADY_ROYAL:            return "ALREADY_ROYAL";
+        case actionResult::INVALID_DISGUISE:         return "INVALID_DISGUISE";
+        case actionResult::INVALID_NOTATION:         return "INVALID_NOTATION";
+        case actionResult::AMBIGUOUS_NOTATION:       return "AMBIGUOUS_NOTATION";
+        case actionResult::NOT_CHECKMATED:           return "NOT_CHECKMATED";
+    }
+    return "UNKNOWN";
+}
+
+#if BC_ENABLE_LOG
+void emitLog(actionResult result, const char* fmt, ...) {
+    logSink sink = currentSink;
+    if(sink == nullptr) return;
+
+    // 스택 버퍼에 포맷 (힙 할당 없음, 넘치면 잘라냄)
+    char buffer[192];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    sink(result, buffer);
+}
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+#include <enum.hpp>
+
+// 엔진 진단 로그.
+// BC_ENABLE_LOG=1로 빌드했을 때만 BC_LOG 호출이 남으며, 기본값(0)에서는 인자 평가를 포함해
+// 전부 컴파일 타임에 제거되므로 액션마다 포맷팅이나 I/O가 발생하지 않는다.
+#ifndef BC_ENABLE_LOG
+#define BC_ENABLE_LOG 0
+#endif
+
+// 로그 싱크: 액션 결과 코드와 포맷된 메시지를 받는다. 메시지 버퍼는 호출 동안만 유효하다.
+using logSink = void(*)(actionResult result, const char* message);
+
+// 싱크 교체 (nullptr이면 로그를 버린다). BC_ENABLE_LOG=1일 때 기본 싱크는 stderrLogSink.
+void setLogSink(logSink sink);
+logSink getLogSink();
+
+// 기본 제공 싱크: "[RESULT] message" 형식으로 stderr에 출력
+void stderrLogSink(actionResult result, const char* message);
+
+// 결과 코드 이름 (예: "NOT_YOUR_TURN")
+const char* actionResultName(actionResult result);
+
+#if BC_ENABLE_LOG
+void emitLog(actionResult result, const char* fmt, ...);
+#define BC_LOG(result, ...) emitLog((result), __VA_ARGS__)
+#else
+#define BC_LOG(result, ...) ((void)0)
+#endif
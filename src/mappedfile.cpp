@@ -0,0 +1,103 @@
+#include <mappedfile.hpp>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+mappedFile::mappedFile(mappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+mappedFile& mappedFile::operator=(mappedFile&& other) noexcept {
+    if(this == &other) return *this;
+    close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    isOpenEmpty = std::exchange(other.isOpenEmpty, false);
+#ifdef _WIN32
+    fileHandle = std::exchange(other.fileHandle, nullptr);
+    mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#else
+    fd = std::exchange(other.fd, -1);
+#endif
+    return *this;
+}
+
+bool mappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if(size_ == 0) {
+        isOpenEmpty = true;
+        return true;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr) {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+    data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if(data_ == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if(size_ == 0) {
+        isOpenEmpty = true;
+        return true;
+    }
+    void* p = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if(p == MAP_FAILED) {
+        close();
+        return false;
+    }
+    madvise(p, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t*>(p);
+    return true;
+#endif
+}
+
+void mappedFile::close() {
+#ifdef _WIN32
+    if(data_ != nullptr) UnmapViewOfFile(data_);
+    if(mappingHandle != nullptr) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if(fileHandle != nullptr) CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if(data_ != nullptr) munmap(const_cast<uint8_t*>(data_), size_);
+    if(fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    isOpenEmpty = false;
+}
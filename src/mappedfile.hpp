@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 읽기 전용 메모리 맵 파일 (POSIX mmap / Win32 MapViewOfFile)
+class mappedFile {
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        bool isOpenEmpty = false; // 0바이트 파일은 매핑 없이 열린 상태로 취급
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int fd = -1;
+#endif
+
+    public:
+        mappedFile() = default;
+        explicit mappedFile(const std::string& path) { open(path); }
+        ~mappedFile() { close(); }
+        mappedFile(const mappedFile&) = delete;
+        mappedFile& operator=(const mappedFile&) = delete;
+        mappedFile(mappedFile&& other) noexcept;
+        mappedFile& operator=(mappedFile&& other) noexcept;
+
+        bool open(const std::string& path); // 실패 시 false (빈 파일도 성공, size()==0)
+        void close();
+
+        bool isOpen() const { return data_ != nullptr || isOpenEmpty; }
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+};
@@ -51,10 +51,11 @@ bool legalMoveChunk::isValidTarget(bc_board* board, int targetFile, int targetRa
 }
 
 // Ray 기반 이동 계산 (RAY_INFINITE, RAY_FINITE)
-std::vector<PGN> legalMoveChunk::calculateRayMoves(int startFile, int startRank, pieceType pT, colorType cT, bc_board* board) const {
-    std::vector<PGN> moves;
-    
-    if(board == nullptr) return moves;
+void legalMoveChunk::calculateRayMoves(int startFile, int startRank, pieceType pT, colorType cT, bc_board* board, std::vector<PGN>& moves,
+                                       uint64_t& attacks, uint64_t& scanned) const {
+    if(board == nullptr) return;
+    // 공격 맵: 이 패턴으로 캡처가 가능한 칸 (MOVE는 캡처하지 않음)
+    const bool capturesOnRay = (tT == threatType::TAKE || tT == threatType::TAKEMOVE || tT == threatType::CATCH);
     
     for(const auto& dir : directions) {
         int fileDir = dir.first;
@@ -68,6 +69,9 @@ std::vector<PGN> legalMoveChunk::calculateRayMoves(int startFile, int startRank,
             
             if(!board->isValidPosition(newFile, newRank)) break;
             
+            const uint64_t bit = uint64_t(1) << (newRank * 8 + newFile);
+            scanned |= bit;
+            if(capturesOnRay) attacks |= bit;
             piece* targetPiece = board->getPiece(newFile, newRank);
             
             if(targetPiece == nullptr) {
@@ -89,9 +93,12 @@ std::vector<PGN> legalMoveChunk::calculateRayMoves(int startFile, int startRank,
                         int jumpFile = newFile + fileDir;
                         int jumpRank = newRank + rankDir;
                         if(board->isValidPosition(jumpFile, jumpRank)) {
+                            const uint64_t jumpBit = uint64_t(1) << (jumpRank * 8 + jumpFile);
+                            scanned |= jumpBit;
                             piece* jumpTarget = board->getPiece(jumpFile, jumpRank);
                             bool destCapture = (jumpTarget != nullptr && jumpTarget->getColor() != cT);
                             if(jumpTarget == nullptr || destCapture) {
+                                attacks |= bit | jumpBit; // 뛰어넘는 칸과 착지 칸 모두 잡는다
                                 PGN m(startFile, startRank, jumpFile, jumpRank, pT, cT, destCapture);
                                 m.captureJumped = true;
                                 m.jumpedFile = newFile;
@@ -104,6 +111,9 @@ std::vector<PGN> legalMoveChunk::calculateRayMoves(int startFile, int startRank,
                         int jumpFile = newFile + fileDir;
                         int jumpRank = newRank + rankDir;
                         if(board->isValidPosition(jumpFile, jumpRank)) {
+                            const uint64_t jumpBit = uint64_t(1) << (jumpRank * 8 + jumpFile);
+                            scanned |= jumpBit;
+                            attacks |= jumpBit; // 착지 칸의 적은 잡힌다
                             piece* jumpTarget = board->getPiece(jumpFile, jumpRank);
                             bool destCapture = (jumpTarget != nullptr && jumpTarget->getColor() != cT);
                             if(jumpTarget == nullptr || destCapture) {
@@ -120,6 +130,9 @@ std::vector<PGN> legalMoveChunk::calculateRayMoves(int startFile, int startRank,
                         int jumpFile = newFile + fileDir;
                         int jumpRank = newRank + rankDir;
                         if(board->isValidPosition(jumpFile, jumpRank)) {
+                            const uint64_t jumpBit = uint64_t(1) << (jumpRank * 8 + jumpFile);
+                            scanned |= jumpBit;
+                            attacks |= jumpBit; // 착지 칸의 적은 잡힌다
                             piece* jumpTarget = board->getPiece(jumpFile, jumpRank);
                             bool destCapture = (jumpTarget != nullptr && jumpTarget->getColor() != cT);
                             if(jumpTarget == nullptr || destCapture) {
@@ -136,26 +149,57 @@ std::vector<PGN> legalMoveChunk::calculateRayMoves(int startFile, int startRank,
             }
         }
     }
-    
-    return moves;
+}
+
+// 점유 비트보드 기반 공격 칸 계산 (calculateRayMoves의 attacks/scanned와 같은 결과)
+uint64_t legalMoveChunk::attackMask(int startFile, int startRank, uint64_t own, uint64_t enemy, uint64_t& scanned) const {
+    if(mT != moveType::RAY_INFINITE && mT != moveType::RAY_FINITE) return 0;
+    const bool capturesOnRay = (tT == threatType::TAKE || tT == threatType::TAKEMOVE || tT == threatType::CATCH);
+    const int maxDist = (mT == moveType::RAY_INFINITE) ? 8 : maxDistance;
+    uint64_t attacks = 0;
+
+    for(const auto& dir : directions) {
+        for(int dist = 1; dist <= maxDist; dist++) {
+            const int f = startFile + dir.first * dist;
+            const int r = startRank + dir.second * dist;
+            if(f < 0 || f >= 8 || r < 0 || r >= 8) break;
+            const uint64_t bit = uint64_t(1) << (r * 8 + f);
+            scanned |= bit;
+            if(capturesOnRay) attacks |= bit;
+            if(((own | enemy) & bit) == 0) continue;
+
+            const bool jumps = (tT == threatType::MOVEJUMP) || (tT == threatType::TAKEJUMP && (enemy & bit));
+            const int jf = f + dir.first;
+            const int jr = r + dir.second;
+            if(jumps && jf >= 0 && jf < 8 && jr >= 0 && jr < 8) {
+                const uint64_t jbit = uint64_t(1) << (jr * 8 + jf);
+                scanned |= jbit;
+                if(tT == threatType::MOVEJUMP) attacks |= jbit;
+                else if((own & jbit) == 0) attacks |= bit | jbit;
+            }
+            break; // 경로 중단
+        }
+    }
+    return attacks;
 }
 
 // 메인 이동 계산 함수
-std::vector<PGN> legalMoveChunk::calculateMoves(int startFile, int startRank, pieceType pT, 
-                                       colorType cT, bc_board* board) const {
-    std::vector<PGN> moves;
-    
-    if(board == nullptr) return moves;
+void legalMoveChunk::calculateMoves(int startFile, int startRank, pieceType pT, 
+                                    colorType cT, bc_board* board, std::vector<PGN>& out,
+                                    uint64_t& attacks, uint64_t& scanned) const {
+    if(board == nullptr) return;
+    [[maybe_unused]] const size_t before = out.size();
     
     switch(mT) {
         case moveType::RAY_INFINITE:
-        case moveType::RAY_FINITE:
-            moves = calculateRayMoves(startFile, startRank, pT, cT, board);
+        case moveType::RAY_FINITE: {
+            BC_TRACE_SCOPE(patternKindName(patternKind(mT, tT)), "pattern");
+            calculateRayMoves(startFile, startRank, pT, cT, board, out, attacks, scanned);
+            BC_STAT_MOVES(mT, tT, out.size() - before);
             break;
+        }
             
         default:
             break;
     }
-    
-    return moves;
 }
@@ -1,7 +1,9 @@
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <enum.hpp>
 
@@ -34,8 +36,8 @@ struct PGN{
         // PGN 문자열로 변환 (예: "Nf3", "exd5", "Q@d4")
         std::string toString() const;
         
-        // 문자열에서 PGN 파싱 (예: "e4", "Nf3", "exd5", "Q@d4")
-        static PGN fromString(const std::string& str, colorType c);
+        // 문자열에서 PGN 파싱 (예: "e4", "Nf3", "exd5", "Q@d4", "H@c3", "f1=Q", "suc e5")
+        static PGN fromString(std::string_view str, colorType c);
 };
 
 struct moveLog{
@@ -67,17 +69,64 @@ class legalMoveChunk{
         const std::vector<std::pair<int, int>>& getDirections() const { return directions; }
         int getMaxDistance() const { return maxDistance; }
         
-        // 이동 계산 함수
-        std::vector<PGN> calculateMoves(int startFile, int startRank, pieceType pT, colorType cT, 
-                                        class bc_board* board) const;
+        // 이동 계산 함수: 계산된 이동을 out 뒤에 덧붙인다 (out의 용량을 재사용해 할당을 피함)
+        // attacks: 적 기물이 있다면 잡을 수 있는 칸, scanned: 계산 중 점유 여부를 확인한 칸 (칸 비트 = rank*8+file)
+        void calculateMoves(int startFile, int startRank, pieceType pT, colorType cT, 
+                            class bc_board* board, std::vector<PGN>& out,
+                            uint64_t& attacks, uint64_t& scanned) const;
+
+        // 보드 없이 점유 비트보드(own = 같은 편, enemy = 상대 편)만으로 calculateMoves와 같은 규칙을 적용한다
+        // (가정한 배치를 검사할 때 사용: checkmate.cpp)
+        uint64_t attackMask(int startFile, int startRank, uint64_t own, uint64_t enemy, uint64_t& scanned) const;
+        // 합법 이동마다 visit(도착 칸, 잡히는 칸 비트)를 호출
+        template<class Visit>
+        void forEachTarget(int startFile, int startRank, uint64_t own, uint64_t enemy, Visit&& visit) const;
         
     private:
         // 개별 이동 계산 헬퍼 함수들
-        std::vector<PGN> calculateRayMoves(int startFile, int startRank, pieceType pT, colorType cT, 
-                                          class bc_board* board) const;
+        void calculateRayMoves(int startFile, int startRank, pieceType pT, colorType cT, 
+                               class bc_board* board, std::vector<PGN>& moves,
+                               uint64_t& attacks, uint64_t& scanned) const;
         
         // threatType에 따른 필터링
         bool isValidTarget(class bc_board* board, int targetFile, int targetRank, colorType cT) const;
 };
 
+template<class Visit>
+void legalMoveChunk::forEachTarget(int startFile, int startRank, uint64_t own, uint64_t enemy, Visit&& visit) const {
+    if(mT != moveType::RAY_INFINITE && mT != moveType::RAY_FINITE) return;
+    const int maxDist = (mT == moveType::RAY_INFINITE) ? 8 : maxDistance;
+    auto inside = [](int f, int r) { return f >= 0 && f < 8 && r >= 0 && r < 8; };
+
+    for(const auto& dir : directions) {
+        for(int dist = 1; dist <= maxDist; dist++) {
+            const int f = startFile + dir.first * dist;
+            const int r = startRank + dir.second * dist;
+            if(!inside(f, r)) break;
+            const int sq = r * 8 + f;
+            const uint64_t bit = uint64_t(1) << sq;
+
+            if(((own | enemy) & bit) == 0) {
+                if(tT == threatType::MOVE || tT == threatType::TAKEMOVE) visit(sq, uint64_t(0));
+                continue;
+            }
 
+            const bool enemyHere = (enemy & bit) != 0;
+            if(enemyHere && (tT == threatType::TAKE || tT == threatType::TAKEMOVE)) {
+                visit(sq, bit);
+            } else if((enemyHere && tT == threatType::TAKEJUMP) || tT == threatType::MOVEJUMP) {
+                const int jf = f + dir.first;
+                const int jr = r + dir.second;
+                if(inside(jf, jr)) {
+                    const int jsq = jr * 8 + jf;
+                    const uint64_t jbit = uint64_t(1) << jsq;
+                    if((own & jbit) == 0) {
+                        const uint64_t landing = (enemy & jbit) ? jbit : uint64_t(0);
+                        visit(jsq, (tT == threatType::TAKEJUMP ? bit : uint64_t(0)) | landing);
+                    }
+                }
+            }
+            break; // 경로 중단
+        }
+    }
+}
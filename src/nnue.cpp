@@ -0,0 +1,355 @@
+#include <nnue.hpp>
+#include <action.hpp>
+#include <byteio.hpp>
+#include <mappedfile.hpp>
+#include <simd.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[4] = {'B', 'C', 'N', 'N'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t FILE_HEADER_SIZE = 16;
+constexpr size_t FILE_SIZE = FILE_HEADER_SIZE +
+    2 * (static_cast<size_t>(NNUE_FEATURES) * NNUE_HIDDEN + NNUE_HIDDEN + 2 * NNUE_HIDDEN) + 4;
+constexpr size_t DIRTY_LIMIT = 64; // 미뤄 둔 변화가 이보다 많으면 바로 적용
+
+// ---------------------------------------------------------------- 커널
+
+// acc += adds[...] - subs[...] (열마다 NNUE_HIDDEN개)
+using updateKernel = void (*)(int16_t* acc, const int16_t* const* adds, int addCount, const int16_t* const* subs, int subCount);
+// [0, QA]로 자른 두 관점 누적기와 출력 가중치의 내적
+using outputKernel = int32_t (*)(const int16_t* stm, const int16_t* other, const int16_t* weights);
+
+void updateScalar(int16_t* acc, const int16_t* const* adds, int addCount, const int16_t* const* subs, int subCount) {
+    for(int i = 0; i < NNUE_HIDDEN; ++i) {
+        int v = acc[i];
+        for(int a = 0; a < addCount; ++a) v += adds[a][i];
+        for(int s = 0; s < subCount; ++s) v -= subs[s][i];
+        acc[i] = static_cast<int16_t>(v);
+    }
+}
+
+int32_t outputScalar(const int16_t* stm, const int16_t* other, const int16_t* weights) {
+    int32_t sum = 0;
+    for(int i = 0; i < NNUE_HIDDEN; ++i) {
+        sum += std::clamp<int>(stm[i], 0, NNUE_QA) * weights[i];
+        sum += std::clamp<int>(other[i], 0, NNUE_QA) * weights[NNUE_HIDDEN + i];
+    }
+    return sum;
+}
+
+#ifdef BC_SIMD_X86
+BC_SIMD_TARGET("sse4.1")
+void updateSse41(int16_t* acc, const int16_t* const* adds, int addCount, const int16_t* const* subs, int subCount) {
+    for(int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(acc + i));
+        for(int a = 0; a < addCount; ++a) v = _mm_add_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(adds[a] + i)));
+        for(int s = 0; s < subCount; ++s) v = _mm_sub_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(subs[s] + i)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(acc + i), v);
+    }
+}
+
+BC_SIMD_TARGET("sse4.1")
+int32_t outputSse41(const int16_t* stm, const int16_t* other, const int16_t* weights) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i qa = _mm_set1_epi16(NNUE_QA);
+    __m128i sum = _mm_setzero_si128();
+    for(int i = 0; i < NNUE_HIDDEN; i += 8) {
+        const __m128i a = _mm_min_epi16(_mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(stm + i)), zero), qa);
+        const __m128i b = _mm_min_epi16(_mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(other + i)), zero), qa);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i))));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + NNUE_HIDDEN + i))));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+BC_SIMD_TARGET("avx2")
+void updateAvx2(int16_t* acc, const int16_t* const* adds, int addCount, const int16_t* const* subs, int subCount) {
+    for(int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc + i));
+        for(int a = 0; a < addCount; ++a) v = _mm256_add_epi16(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(adds[a] + i)));
+        for(int s = 0; s < subCount; ++s) v = _mm256_sub_epi16(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(subs[s] + i)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(acc + i), v);
+    }
+}
+
+BC_SIMD_TARGET("avx2")
+int32_t outputAvx2(const int16_t* stm, const int16_t* other, const int16_t* weights) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i qa = _mm256_set1_epi16(NNUE_QA);
+    __m256i sum = _mm256_setzero_si256();
+    for(int i = 0; i < NNUE_HIDDEN; i += 16) {
+        const __m256i a = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(stm + i)), zero), qa);
+        const __m256i b = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(other + i)), zero), qa);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i))));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + NNUE_HIDDEN + i))));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+    return _mm_cvtsi128_si32(half);
+}
+#endif
+
+struct kernelTable {
+    nnueKernel kind = nnueKernel::SCALAR;
+    updateKernel update = updateScalar;
+    outputKernel output = outputScalar;
+};
+
+kernelTable tableFor(nnueKernel kind) {
+    switch(kind) {
+#ifdef BC_SIMD_X86
+        case nnueKernel::AVX2:  return {kind, updateAvx2, outputAvx2};
+        case nnueKernel::SSE41: return {kind, updateSse41, outputSse41};
+#endif
+        default: return {};
+    }
+}
+
+kernelTable& activeKernels() {
+    static kernelTable table = [] {
+        if(nnueKernelSupported(nnueKernel::AVX2)) return tableFor(nnueKernel::AVX2);
+        if(nnueKernelSupported(nnueKernel::SSE41)) return tableFor(nnueKernel::SSE41);
+        return tableFor(nnueKernel::SCALAR);
+    }();
+    return table;
+}
+
+// ---------------------------------------------------------------- 특징
+
+inline int sideOf(colorType c) { return (c == colorType::WHITE) ? 0 : 1; }
+
+inline int stunBucket(int stun) { return stun >= 5 ? 3 : (stun >= 3 ? 2 : stun - 1); }
+inline int moveBucket(int move) { return move >= 4 ? 3 : move - 1; }
+
+// 백 관점 번호만 만든다 (흑 관점은 nnueMirrorFeature)
+inline int pieceFeature(int kind, int rel, int sq) { return NNUE_PIECE_BASE + (kind * 2 + rel) * 64 + sq; }
+inline int stunFeature(int rel, int bucket, int sq) { return NNUE_STUN_BASE + (rel * NNUE_STUN_BUCKETS + bucket) * 64 + sq; }
+inline int moveFeature(int rel, int bucket, int sq) { return NNUE_MOVE_BASE + (rel * NNUE_MOVE_BUCKETS + bucket) * 64 + sq; }
+inline int pocketFeature(int rel, int index, int k) { return NNUE_POCKET_BASE + (rel * NNUE_POCKET_KINDS + index) * NNUE_POCKET_DEPTH + k; }
+
+template <typename Visit>
+void forEachPieceFeature(const piece& p, colorType perspective, Visit visit) {
+    const int rel = (p.getColor() == perspective) ? 0 : 1;
+    int sq = squareOf(p.getFile(), p.getRank());
+    if(perspective == colorType::BLACK) sq ^= 56;
+    const int kind = p.isRoyal() ? NNUE_PIECE_KINDS - 1 : static_cast<int>(p.getPieceType());
+    visit(pieceFeature(kind, rel, sq));
+    if(p.getStunStack() > 0) visit(stunFeature(rel, stunBucket(p.getStunStack()), sq));
+    if(p.getMoveStack() > 0) visit(moveFeature(rel, moveBucket(p.getMoveStack()), sq));
+}
+
+} // namespace
+
+bool nnueKernelSupported(nnueKernel kernel) {
+    switch(kernel) {
+        case nnueKernel::SCALAR: return true;
+#ifdef BC_SIMD_X86
+        case nnueKernel::SSE41: return cpuHasSse41();
+        case nnueKernel::AVX2:  return cpuHasAvx2();
+#endif
+        default: return false;
+    }
+}
+
+bool nnueSetKernel(nnueKernel kernel) {
+    if(!nnueKernelSupported(kernel)) return false;
+    activeKernels() = tableFor(kernel);
+    return true;
+}
+
+nnueKernel nnueActiveKernel() {
+    return activeKernels().kind;
+}
+
+const char* nnueKernelName(nnueKernel kernel) {
+    switch(kernel) {
+        case nnueKernel::AVX2:  return "avx2";
+        case nnueKernel::SSE41: return "sse4.1";
+        default:                return "scalar";
+    }
+}
+
+void nnueActiveFeatures(const piece& p, colorType perspective, std::vector<int>& out) {
+    forEachPieceFeature(p, perspective, [&out](int f) { out.push_back(f); });
+}
+
+void nnueActivePocketFeatures(const std::array<int, NNUE_POCKET_KINDS>& pocket, int rel, std::vector<int>& out) {
+    for(int index = 0; index < NNUE_POCKET_KINDS; ++index) {
+        for(int k = 0; k < std::min(pocket[index], NNUE_POCKET_DEPTH); ++k) out.push_back(pocketFeature(rel, index, k));
+    }
+}
+
+int nnueMirrorFeature(int f) {
+    if(f < NNUE_STUN_BASE) {
+        const int off = f - NNUE_PIECE_BASE;
+        const int sq = off % 64, group = off / 64;
+        return NNUE_PIECE_BASE + (group ^ 1) * 64 + (sq ^ 56); // group = kind * 2 + rel
+    }
+    if(f < NNUE_POCKET_BASE) {
+        const int base = (f < NNUE_MOVE_BASE) ? NNUE_STUN_BASE : NNUE_MOVE_BASE;
+        const int off = f - base;
+        const int sq = off % 64, group = off / 64; // group = rel * 4 + bucket
+        return base + ((group + NNUE_STUN_BUCKETS) % (2 * NNUE_STUN_BUCKETS)) * 64 + (sq ^ 56);
+    }
+    const int off = f - NNUE_POCKET_BASE;
+    const int group = off / NNUE_POCKET_DEPTH; // group = rel * 16 + index
+    return NNUE_POCKET_BASE + ((group + NNUE_POCKET_KINDS) % (2 * NNUE_POCKET_KINDS)) * NNUE_POCKET_DEPTH + off % NNUE_POCKET_DEPTH;
+}
+
+// ---------------------------------------------------------------- 네트워크
+
+nnueNetwork::nnueNetwork() : featureWeights(static_cast<size_t>(NNUE_FEATURES) * NNUE_HIDDEN, 0) {}
+
+bool nnueNetwork::load(const std::string& path) {
+    mappedFile file;
+    if(!file.open(path) || file.size() != FILE_SIZE) return false;
+    const uint8_t* p = file.data();
+    if(std::memcmp(p, MAGIC, 4) != 0 || readU32(p + 4) != FORMAT_VERSION ||
+       readU32(p + 8) != static_cast<uint32_t>(NNUE_FEATURES) || readU32(p + 12) != static_cast<uint32_t>(NNUE_HIDDEN)) {
+        return false;
+    }
+    p += FILE_HEADER_SIZE;
+    for(auto& w : featureWeights) { w = static_cast<int16_t>(readU16(p)); p += 2; }
+    for(auto& w : hiddenBias) { w = static_cast<int16_t>(readU16(p)); p += 2; }
+    for(auto& w : outputWeights) { w = static_cast<int16_t>(readU16(p)); p += 2; }
+    outputBias = static_cast<int32_t>(readU32(p));
+    return true;
+}
+
+bool nnueNetwork::save(const std::string& path) const {
+    std::vector<uint8_t> out;
+    out.reserve(FILE_SIZE);
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    putU32(out, FORMAT_VERSION);
+    putU32(out, NNUE_FEATURES);
+    putU32(out, NNUE_HIDDEN);
+    for(int16_t w : featureWeights) putU16(out, static_cast<uint16_t>(w));
+    for(int16_t w : hiddenBias) putU16(out, static_cast<uint16_t>(w));
+    for(int16_t w : outputWeights) putU16(out, static_cast<uint16_t>(w));
+    putU32(out, static_cast<uint32_t>(outputBias));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if(file == nullptr) return false;
+    const bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    return (std::fclose(file) == 0) && ok;
+}
+
+void nnueNetwork::randomize(uint32_t seed, int featureRange, int outputRange) {
+    auto next = [&seed](int range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int16_t>(static_cast<int>((seed >> 8) % static_cast<uint32_t>(2 * range + 1)) - range);
+    };
+    for(auto& w : featureWeights) w = next(featureRange);
+    for(auto& w : hiddenBias) w = next(featureRange);
+    for(auto& w : outputWeights) w = next(outputRange);
+    outputBias = next(outputRange) * NNUE_QA;
+}
+
+int nnueNetwork::output(const int16_t* stm, const int16_t* other) const {
+    const int64_t sum = static_cast<int64_t>(activeKernels().output(stm, other, outputWeights.data())) + outputBias;
+    return static_cast<int>(sum * NNUE_OUTPUT_SCALE / (NNUE_QA * NNUE_QB));
+}
+
+// ---------------------------------------------------------------- 누적기
+
+void nnueAccumulator::addFeature(int feature) {
+    auto it = std::find(removed.begin(), removed.end(), feature);
+    if(it != removed.end()) {
+        *it = removed.back();
+        removed.pop_back();
+        return;
+    }
+    added.push_back(feature);
+}
+
+void nnueAccumulator::removeFeature(int feature) {
+    auto it = std::find(added.begin(), added.end(), feature);
+    if(it != added.end()) {
+        *it = added.back();
+        added.pop_back();
+        return;
+    }
+    removed.push_back(feature);
+}
+
+void nnueAccumulator::refresh(const std::list<piece>& pieces,
+                              const std::array<int, NNUE_POCKET_KINDS>& whitePocket,
+                              const std::array<int, NNUE_POCKET_KINDS>& blackPocket) {
+    added.clear();
+    removed.clear();
+    pocketCounts[0] = whitePocket;
+    pocketCounts[1] = blackPocket;
+    if(net == nullptr) return;
+
+    std::vector<int> features;
+    for(const auto& p : pieces) nnueActiveFeatures(p, colorType::WHITE, features);
+    nnueActivePocketFeatures(pocketCounts[0], 0, features);
+    nnueActivePocketFeatures(pocketCounts[1], 1, features);
+    std::vector<const int16_t*> columns[2];
+    for(int f : features) {
+        columns[0].push_back(net->column(f));
+        columns[1].push_back(net->column(nnueMirrorFeature(f)));
+    }
+    const updateKernel update = activeKernels().update;
+    for(int view = 0; view < 2; ++view) {
+        std::copy(net->bias(), net->bias() + NNUE_HIDDEN, values[view].begin());
+        update(values[view].data(), columns[view].data(), static_cast<int>(columns[view].size()), nullptr, 0);
+    }
+}
+
+void nnueAccumulator::pieceChanged(const piece& p, int sign) {
+    if(net == nullptr) return;
+    forEachPieceFeature(p, colorType::WHITE, [this, sign](int f) {
+        if(sign > 0) addFeature(f);
+        else removeFeature(f);
+    });
+    if(added.size() + removed.size() > DIRTY_LIMIT) flush();
+}
+
+void nnueAccumulator::pocketChanged(colorType color, int index, int count) {
+    const int side = sideOf(color);
+    const int before = std::min(pocketCounts[side][index], NNUE_POCKET_DEPTH);
+    const int after = std::min(std::max(count, 0), NNUE_POCKET_DEPTH);
+    pocketCounts[side][index] = count;
+    if(net == nullptr) return;
+    for(int k = after; k < before; ++k) removeFeature(pocketFeature(side, index, k));
+    for(int k = before; k < after; ++k) addFeature(pocketFeature(side, index, k));
+}
+
+void nnueAccumulator::flush() {
+    if(net == nullptr || !isDirty()) return;
+    std::array<const int16_t*, DIRTY_LIMIT + 8> adds[2];
+    std::array<const int16_t*, DIRTY_LIMIT + 8> subs[2];
+    const updateKernel update = activeKernels().update;
+    // 한 번에 최대 DIRTY_LIMIT개씩 (열 포인터 배열 크기)
+    size_t a = 0, s = 0;
+    while(a < added.size() || s < removed.size()) {
+        int addCount = 0, subCount = 0;
+        for(; a < added.size() && addCount < static_cast<int>(DIRTY_LIMIT); ++a, ++addCount) {
+            adds[0][addCount] = net->column(added[a]);
+            adds[1][addCount] = net->column(nnueMirrorFeature(added[a]));
+        }
+        for(; s < removed.size() && subCount < static_cast<int>(DIRTY_LIMIT); ++s, ++subCount) {
+            subs[0][subCount] = net->column(removed[s]);
+            subs[1][subCount] = net->column(nnueMirrorFeature(removed[s]));
+        }
+        for(int view = 0; view < 2; ++view) {
+            update(values[view].data(), adds[view].data(), addCount, subs[view].data(), subCount);
+        }
+    }
+    added.clear();
+    removed.clear();
+}
+
+int nnueAccumulator::evaluate(colorType sideToScore) const {
+    if(net == nullptr) return 0;
+    const colorType other = (sideToScore == colorType::WHITE) ? colorType::BLACK : colorType::WHITE;
+    return net->output(perspective(sideToScore), perspective(other));
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+#include <piece.hpp>
+
+/* NNUE 평가 (nnue.cpp)
+   입력 특징 (관점 기준: 자기 편 = 0, 상대 편 = 1, 흑 관점은 랭크를 뒤집어 sq ^ 56)
+     - 기물:      (종류 17 = pieceType 16 + 로얄) x 편 2 x 칸 64
+     - 스턴:      편 2 x 구간 4 (1, 2, 3-4, 5+) x 칸 64
+     - 이동 스택: 편 2 x 구간 4 (1, 2, 3, 4+) x 칸 64
+     - 포켓:      편 2 x 포켓 종류 16 x 보유 수 1..8 (보유 수 >= k 이면 k번째 특징 활성)
+   구조: 특징 -> int16 누적기 NNUE_HIDDEN (관점 2개) -> [0, QA] 클램프 -> 출력 1개
+   누적기는 보드가 기물 상태를 바꿀 때마다 바뀐 특징만 더하고 빼며(취소되는 쌍은 버림),
+   평가 직전에 몰아서 적용한다. 커널은 실행 중인 CPU에 맞춰 AVX2 / SSE4.1 / 스칼라 중 고른다.
+
+   가중치 파일 (리틀 엔디언)
+     "BCNN" + u32 버전(1) + u32 특징 수(NNUE_FEATURES) + u32 은닉 크기(NNUE_HIDDEN)
+     int16 특징 가중치 [NNUE_FEATURES][NNUE_HIDDEN]   (QA 스케일)
+     int16 은닉 바이어스 [NNUE_HIDDEN]                (QA 스케일)
+     int16 출력 가중치 [2 * NNUE_HIDDEN] (앞 절반 = 둘 차례 관점)  (QB 스케일)
+     int32 출력 바이어스                              (QA * QB 스케일)
+   평가값 = (출력 합 + 바이어스) * NNUE_OUTPUT_SCALE / (QA * QB), 폰 = 100 근처가 되도록 학습한다.
+   출력 합은 int32로 계산하므로 |출력 가중치| * QA * 2 * NNUE_HIDDEN 이 int32를 넘지 않게 양자화한다.
+*/
+inline constexpr int NNUE_HIDDEN = 256;
+inline constexpr int NNUE_PIECE_KINDS = 17;   // pieceType 16종 + 로얄
+inline constexpr int NNUE_STUN_BUCKETS = 4;
+inline constexpr int NNUE_MOVE_BUCKETS = 4;
+inline constexpr int NNUE_POCKET_KINDS = 16;  // POCKET_SIZE
+inline constexpr int NNUE_POCKET_DEPTH = 8;
+
+inline constexpr int NNUE_PIECE_BASE = 0;
+inline constexpr int NNUE_STUN_BASE = NNUE_PIECE_BASE + NNUE_PIECE_KINDS * 2 * 64;
+inline constexpr int NNUE_MOVE_BASE = NNUE_STUN_BASE + 2 * NNUE_STUN_BUCKETS * 64;
+inline constexpr int NNUE_POCKET_BASE = NNUE_MOVE_BASE + 2 * NNUE_MOVE_BUCKETS * 64;
+inline constexpr int NNUE_FEATURES = NNUE_POCKET_BASE + 2 * NNUE_POCKET_KINDS * NNUE_POCKET_DEPTH;
+
+inline constexpr int NNUE_QA = 255;
+inline constexpr int NNUE_QB = 64;
+inline constexpr int NNUE_OUTPUT_SCALE = 400;
+
+// 누적기 갱신/출력 커널 (기본값: CPU가 지원하는 가장 넓은 것)
+enum class nnueKernel : uint8_t {
+    SCALAR,
+    SSE41,
+    AVX2
+};
+bool nnueKernelSupported(nnueKernel kernel);
+bool nnueSetKernel(nnueKernel kernel); // 지원하지 않으면 false, 기존 커널 유지
+nnueKernel nnueActiveKernel();
+const char* nnueKernelName(nnueKernel kernel);
+
+// 양자화된 가중치 (읽기 전용으로 여러 보드/스레드가 공유)
+class nnueNetwork {
+    private:
+        std::vector<int16_t> featureWeights; // [NNUE_FEATURES][NNUE_HIDDEN]
+        std::array<int16_t, NNUE_HIDDEN> hiddenBias{};
+        std::array<int16_t, 2 * NNUE_HIDDEN> outputWeights{};
+        int32_t outputBias = 0;
+
+    public:
+        nnueNetwork();
+
+        bool load(const std::string& path); // 형식/크기가 맞지 않으면 false, 기존 가중치 유지
+        bool save(const std::string& path) const;
+        void randomize(uint32_t seed, int featureRange, int outputRange); // 테스트/벤치마크용 [-range, range] 균등 분포
+
+        const int16_t* column(int feature) const { return featureWeights.data() + static_cast<size_t>(feature) * NNUE_HIDDEN; }
+        const int16_t* bias() const { return hiddenBias.data(); }
+        int output(const int16_t* stm, const int16_t* other) const; // 둘 차례 관점 / 상대 관점 누적기
+};
+
+// 관점별 int16 누적기 + 아직 적용하지 않은 특징 변화
+class nnueAccumulator {
+    private:
+        alignas(32) std::array<std::array<int16_t, NNUE_HIDDEN>, 2> values{}; // 0 = 백 관점, 1 = 흑 관점
+        std::array<std::array<int, NNUE_POCKET_KINDS>, 2> pocketCounts{};    // 특징에 반영한 포켓 보유 수
+        std::vector<int> added;   // 백 관점 특징 번호
+        std::vector<int> removed;
+        const nnueNetwork* net = nullptr;
+
+        void addFeature(int feature);
+        void removeFeature(int feature);
+
+    public:
+        void attach(const nnueNetwork* network) { net = network; added.clear(); removed.clear(); }
+        bool active() const { return net != nullptr; }
+        const nnueNetwork* network() const { return net; }
+
+        // 전체 재계산
+        void refresh(const std::list<piece>& pieces,
+                     const std::array<int, NNUE_POCKET_KINDS>& whitePocket,
+                     const std::array<int, NNUE_POCKET_KINDS>& blackPocket);
+        // 기물 상태가 바뀌기 전에 sign = -1, 바뀐 뒤 sign = +1
+        void pieceChanged(const piece& p, int sign);
+        void pocketChanged(colorType color, int index, int count);
+        void flush(); // 미뤄 둔 변화를 누적기에 적용
+        bool isDirty() const { return !added.empty() || !removed.empty(); }
+
+        const int16_t* perspective(colorType color) const { return values[color == colorType::WHITE ? 0 : 1].data(); }
+        int evaluate(colorType sideToScore) const; // flush된 상태에서 호출
+};
+
+// 특징 번호 (관점 기준)
+void nnueActiveFeatures(const piece& p, colorType perspective, std::vector<int>& out); // 기물/스턴/이동 스택 특징
+void nnueActivePocketFeatures(const std::array<int, NNUE_POCKET_KINDS>& pocket, int rel, std::vector<int>& out); // rel: 자기 편 0, 상대 1
+int nnueMirrorFeature(int whiteFeature); // 백 관점 번호 -> 흑 관점 번호
@@ -0,0 +1,284 @@
+#include <gameboard.hpp>
+#include <cctype>
+
+namespace {
+
+bool isFileChar(char c) { return c >= 'a' && c <= 'h'; }
+bool isRankChar(char c) { return c >= '1' && c <= '8'; }
+bool isSpace(char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+
+bool readSquare(std::string_view text, size_t pos, int8_t& file, int8_t& rank) {
+    if(pos + 2 > text.size()) return false;
+    if(!isFileChar(text[pos]) || !isRankChar(text[pos + 1])) return false;
+    file = static_cast<int8_t>(text[pos] - 'a');
+    rank = static_cast<int8_t>(text[pos + 1] - '1');
+    return true;
+}
+
+// 대문자 기물 글자 (pieceCode의 두 글자 코드 Kr/Tr/Cl 포함). 읽은 글자 수, 기물이 아니면 0
+size_t readPieceLetter(std::string_view text, size_t pos, pieceType& out) {
+    if(pos >= text.size() || !std::isupper(static_cast<unsigned char>(text[pos]))) return 0;
+    if(pos + 1 < text.size()) {
+        out = pieceFromCode(text.substr(pos, 2));
+        if(out != pieceType::NONE) return 2;
+    }
+    out = pieceFromSymbol(text[pos]);
+    return out == pieceType::NONE ? 0 : 1;
+}
+
+actionResult applyResolved(bc_board& board, const resolvedNotation& r) {
+    actionResult res = board.applyAction(r.action);
+    if(res != actionResult::OK || r.promoteTo == pieceType::NONE) return res;
+    return board.promote(squareFile(r.action.toSquare), squareRank(r.action.toSquare), r.promoteTo);
+}
+
+} // namespace
+
+bool parseNotation(std::string_view token, notationToken& out) {
+    out = notationToken();
+    while(!token.empty()) {
+        const char c = token.back();
+        if(c != '+' && c != '#' && c != '!' && c != '?') break;
+        token.remove_suffix(1);
+    }
+    if(token.empty()) return false;
+
+    if(token == "--") {
+        out.kind = notationKind::END_TURN;
+        return true;
+    }
+
+    // 계승: "suc e5" 또는 "suce5"
+    if(token.substr(0, 3) == "suc") {
+        size_t pos = 3;
+        while(pos < token.size() && token[pos] == ' ') pos++;
+        out.kind = notationKind::SUCCESSION;
+        return token.size() == pos + 2 && readSquare(token, pos, out.fromFile, out.fromRank);
+    }
+
+    // 스턴: '*' 개수만큼 스턴 추가
+    if(token[0] == '*') {
+        size_t pos = 0;
+        while(pos < token.size() && token[pos] == '*') pos++;
+        out.kind = notationKind::STUN;
+        out.stunDelta = static_cast<int8_t>(pos);
+        return pos <= 127 && token.size() == pos + 2 && readSquare(token, pos, out.fromFile, out.fromRank);
+    }
+
+    size_t pos = readPieceLetter(token, 0, out.pT);
+
+    // 착수
+    if(pos < token.size() && token[pos] == '@') {
+        out.kind = notationKind::DROP;
+        pos++;
+        return token.size() == pos + 2 && readSquare(token, pos, out.toFile, out.toRank);
+    }
+
+    // 이동: [출발 파일][출발 랭크][x|-]<도착>[=X]
+    out.kind = notationKind::MOVE;
+    std::string_view body = token.substr(pos);
+    const size_t eq = body.find('=');
+    if(eq != std::string_view::npos) {
+        const size_t len = readPieceLetter(body, eq + 1, out.suffix);
+        if(len == 0 || eq + 1 + len != body.size()) return false;
+        body = body.substr(0, eq);
+    }
+    if(body.size() < 2 || !readSquare(body, body.size() - 2, out.toFile, out.toRank)) return false;
+    body.remove_suffix(2);
+    if(!body.empty() && (body.back() == 'x' || body.back() == '-')) {
+        out.take = (body.back() == 'x');
+        body.remove_suffix(1);
+    }
+    if(!body.empty() && isFileChar(body[0])) {
+        out.fromFile = static_cast<int8_t>(body[0] - 'a');
+        body.remove_prefix(1);
+    }
+    if(!body.empty() && isRankChar(body[0])) {
+        out.fromRank = static_cast<int8_t>(body[0] - '1');
+        body.remove_prefix(1);
+    }
+    return body.empty();
+}
+
+// 토큰을 현재 차례의 boardAction으로 해석. 이동은 합법수 목록에서 출발 기물을 찾는다
+actionResult bc_board::resolveNotation(std::string_view token, resolvedNotation& out) const {
+    BC_STAT_TIMER(RESOLVE_NOTATION);
+    BC_TRACE_METHOD(RESOLVE_NOTATION);
+    notationToken t;
+    if(!parseNotation(token, t)) return actionResult::INVALID_NOTATION;
+
+    out = resolvedNotation();
+    switch(t.kind) {
+        case notationKind::END_TURN:
+            out.action = boardAction::endTurn();
+            return actionResult::OK;
+        case notationKind::DROP:
+            out.action = boardAction::drop(t.pT == pieceType::NONE ? pieceType::PWAN : t.pT, squareOf(t.toFile, t.toRank));
+            return actionResult::OK;
+        case notationKind::STUN:
+            out.action = boardAction::stun(squareOf(t.fromFile, t.fromRank), t.stunDelta);
+            return actionResult::OK;
+        case notationKind::SUCCESSION:
+            out.action = boardAction::succession(squareOf(t.fromFile, t.fromRank));
+            return actionResult::OK;
+        case notationKind::MOVE:
+            break;
+    }
+
+    const colorType side = currentPlayerColor();
+
+    // 변장: 기물/출발/캡처 표시 없이 자신의 로얄 피스 칸을 가리키는 "f1=Q"
+    if(t.suffix != pieceType::NONE && t.pT == pieceType::NONE && t.fromFile < 0 && t.fromRank < 0 && !t.take) {
+        const piece* target = board[t.toFile][t.toRank];
+        if(target != nullptr && target->isRoyal() && target->getColor() == side) {
+            out.action = boardAction::disguise(squareOf(t.toFile, t.toRank), t.suffix);
+            return actionResult::OK;
+        }
+    }
+
+    // 도착 칸이 합법수인 같은 종류의 자기 기물을 찾는다. 실제로 움직일 수 있는 기물(스턴 아님, 이동 스택 있음,
+    // 이번 턴의 활성 기물)을 우선하므로 움직일 수 없는 쪽은 모호성 제거 표기가 없어도 된다
+    const pieceType type = (t.pT == pieceType::NONE) ? pieceType::PWAN : t.pT;
+    const piece* anyPiece = nullptr;
+    const PGN* anyMove = nullptr;
+    int anyCount = 0;
+    const piece* movablePiece = nullptr;
+    const PGN* movableMove = nullptr;
+    int movableCount = 0;
+
+    const uint64_t toBit = uint64_t(1) << squareOf(t.toFile, t.toRank);
+    for(int file = 0; file < BOARD_SIZE; ++file) {
+        if(t.fromFile >= 0 && file != t.fromFile) continue;
+        for(int rank = 0; rank < BOARD_SIZE; ++rank) {
+            if(t.fromRank >= 0 && rank != t.fromRank) continue;
+            const piece* p = board[file][rank];
+            if(p == nullptr || p->getColor() != side || p->getPieceType() != type) continue;
+            // 도착 칸은 항상 확인 칸에 들어가므로, 닿지 않는 기물은 합법 이동 목록을 만들지 않고 건너뛴다
+            if((p->getScanMask() & toBit) == 0 || (p->getDestinationMask() & toBit) == 0) continue;
+
+            const PGN* match = nullptr;
+            for(const PGN& m : p->getLegalMoves()) {
+                if(m.endFile == t.toFile && m.endRank == t.toRank) {
+                    match = &m;
+                    break;
+                }
+            }
+            if(match == nullptr) continue;
+
+            if(anyCount++ == 0) {
+                anyPiece = p;
+                anyMove = match;
+            }
+            const bool canMove = !p->isStunned() && p->getMoveStack() > 0 &&
+                                 (!performedActionThisTurn || p == activePieceThisTurn);
+            if(canMove && movableCount++ == 0) {
+                movablePiece = p;
+                movableMove = match;
+            }
+        }
+    }
+
+    if(movableCount > 1 || (movableCount == 0 && anyCount > 1)) return actionResult::AMBIGUOUS_NOTATION;
+    const piece* mover = (movableCount == 1) ? movablePiece : anyPiece;
+    const PGN* move = (movableCount == 1) ? movableMove : anyMove;
+    if(mover == nullptr) return actionResult::ILLEGAL_MOVE;
+
+    if(t.suffix != pieceType::NONE) {
+        if(type != pieceType::PWAN) return actionResult::NOT_A_PAWN;
+        const int lastRank = (side == colorType::WHITE) ? BOARD_SIZE - 1 : 0;
+        if(t.toRank != lastRank) return actionResult::NOT_PROMOTION_RANK;
+        if(t.suffix == pieceType::KING || t.suffix == pieceType::PWAN) return actionResult::INVALID_PROMOTION;
+        out.promoteTo = t.suffix;
+    }
+
+    out.action = boardAction::move(squareOf(mover->getFile(), mover->getRank()), squareOf(t.toFile, t.toRank));
+    out.action.take = (board[t.toFile][t.toRank] != nullptr);
+    if(move->captureJumped) out.action.jumpedSquare = static_cast<int8_t>(squareOf(move->jumpedFile, move->jumpedRank));
+    return actionResult::OK;
+}
+
+actionResult bc_board::applyNotation(std::string_view token) {
+    BC_STAT_TIMER(APPLY_NOTATION);
+    BC_TRACE_METHOD(APPLY_NOTATION);
+    resolvedNotation r;
+    const actionResult res = resolveNotation(token, r);
+    if(res != actionResult::OK) return res;
+    return applyResolved(*this, r);
+}
+
+// 공백으로 구분된 기보를 순서대로 적용한다. 이미 액션한 턴에서 다음 토큰이 그 턴을 이어가지 못하면
+// (활성 기물의 연속 이동, 자기 로얄 피스의 변장/계승이 아니면) 자동으로 nextTurn 한다
+replayReport bc_board::replayNotation(std::string_view text) {
+    BC_STAT_TIMER(REPLAY_NOTATION);
+    BC_TRACE_METHOD(REPLAY_NOTATION);
+    replayReport report;
+    size_t pos = 0;
+
+    while(true) {
+        while(pos < text.size() && isSpace(text[pos])) pos++;
+        if(pos >= text.size()) break;
+
+        // 주석 {...}, 태그 [...], 줄 주석 ;
+        const char c = text[pos];
+        if(c == '{' || c == '[' || c == ';') {
+            const size_t close = text.find(c == '{' ? '}' : (c == '[' ? ']' : '\n'), pos);
+            pos = (close == std::string_view::npos) ? text.size() : close + 1;
+            continue;
+        }
+
+        size_t start = pos;
+        while(pos < text.size() && !isSpace(text[pos])) pos++;
+        std::string_view token = text.substr(start, pos - start);
+
+        // 수 번호: "12." / "12..." / "12.e4"
+        size_t digits = 0;
+        while(digits < token.size() && std::isdigit(static_cast<unsigned char>(token[digits]))) digits++;
+        if(digits > 0 && digits < token.size() && token[digits] == '.') {
+            while(digits < token.size() && token[digits] == '.') digits++;
+            token.remove_prefix(digits);
+            start += digits;
+            if(token.empty()) continue;
+        }
+
+        // 결과 표기에서 종료
+        if(token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*") break;
+
+        // "suc e5"는 다음 토큰(칸)까지 하나로 묶는다
+        if(token == "suc") {
+            while(pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) pos++;
+            while(pos < text.size() && !isSpace(text[pos])) pos++;
+            token = text.substr(start, pos - start);
+        }
+
+        resolvedNotation r;
+        actionResult res = resolveNotation(token, r);
+        if(performedActionThisTurn && !(res == actionResult::OK && r.action.type == actionType::END_TURN)) {
+            bool continues = false;
+            if(res == actionResult::OK) {
+                const boardAction& a = r.action;
+                if(a.type == actionType::MOVE) {
+                    continues = activePieceThisTurn != nullptr &&
+                                squareOf(activePieceThisTurn->getFile(), activePieceThisTurn->getRank()) == a.fromSquare &&
+                                activePieceThisTurn->getMoveStack() > 0;
+                } else if(a.type == actionType::DISGUISE || a.type == actionType::SUCCESSION) {
+                    const piece* target = board[squareFile(a.fromSquare)][squareRank(a.fromSquare)];
+                    continues = target != nullptr && target->getColor() == currentPlayerColor();
+                }
+            }
+            if(!continues) {
+                nextTurn();
+                res = resolveNotation(token, r);
+            }
+        }
+        if(res == actionResult::OK) res = applyResolved(*this, r);
+
+        if(res != actionResult::OK) {
+            report.result = res;
+            report.errorOffset = start;
+            report.errorLength = token.size();
+            return report;
+        }
+        report.actionsApplied++;
+    }
+    return report;
+}
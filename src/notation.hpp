@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <enum.hpp>
+#include <action.hpp>
+
+/* 기보 표기
+   printGameLog 출력과 SAN 스타일 표기를 모두 받는다. 기물 글자는 pieceSymbol (K Q R B N P A G H W D L F C T M),
+   파이썬 바인딩식 두 글자 표기 Kr/Tr/Cl도 허용한다. 폰 글자는 생략 가능.
+
+     착수      Q@d4, @e4 (폰)
+     이동      Nf3, Nbd7, R1a3, exd5, Pe2-e4, Qh4xe1   (출발 칸 일부/전체로 모호성 제거)
+     프로모션  e8=Q, exd8=N                             (이동 후 같은 턴에 promote)
+     변장      f1=Q                                     (해당 칸이 자신의 로얄 피스면 변장으로 해석)
+     계승      suc e5
+     스턴      *e4 (+1), **e4 (+2) ...
+     턴 종료   --
+   끝의 + # ! ? 는 무시한다.
+*/
+
+enum class notationKind : uint8_t {
+    DROP,
+    MOVE,
+    STUN,
+    SUCCESSION,
+    END_TURN
+};
+
+// 보드 없이 토큰 하나를 구문 분석한 결과 (모르는 좌표는 -1)
+struct notationToken {
+    notationKind kind = notationKind::END_TURN;
+    pieceType pT = pieceType::NONE;      // DROP/MOVE 기물 (생략 시 NONE)
+    pieceType suffix = pieceType::NONE;  // '=X': 프로모션 또는 변장
+    int8_t fromFile = -1;                // MOVE 모호성 제거용 출발 파일/랭크, STUN/SUCCESSION 대상 칸
+    int8_t fromRank = -1;
+    int8_t toFile = -1;
+    int8_t toRank = -1;
+    bool take = false;
+    int8_t stunDelta = 1;
+};
+
+// 보드에 대해 해석된 토큰: 액션 하나 + 이동 뒤 프로모션
+struct resolvedNotation {
+    boardAction action;
+    pieceType promoteTo = pieceType::NONE;
+};
+
+// 기보 전체 재생 결과
+struct replayReport {
+    actionResult result = actionResult::OK; // 첫 실패 사유 (전부 성공하면 OK)
+    size_t errorOffset = 0;                 // 실패한 토큰의 시작 위치 (text 기준)
+    size_t errorLength = 0;
+    size_t actionsApplied = 0;
+};
+
+// 토큰 하나를 구문 분석 (할당 없음). 형식이 틀리면 false
+bool parseNotation(std::string_view token, notationToken& out);
@@ -0,0 +1,124 @@
+#include <gameboard.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// 필드 폭에 맞춰 저장: packedPosition은 자르고 widePosition은 그대로
+inline void storeField(uint8_t& out, int v) { out = static_cast<uint8_t>(std::clamp(v, 0, 255)); }
+inline void storeField(uint16_t& out, int v) { out = static_cast<uint16_t>(std::clamp(v, 0, 0xFFFF)); }
+inline void storeField(int& out, int v) { out = v; }
+
+inline bool validStack(int v) { return v >= 0 && v <= LANE_STACK_MAX; }
+
+} // namespace
+
+template <typename Encoded>
+void bc_board::encodeState(Encoded& out) const {
+    std::memset(&out, 0, sizeof(out));
+
+    for(const auto& p : pieces) {
+        const int sq = p.getRank() * BOARD_SIZE + p.getFile();
+        uint8_t code = static_cast<uint8_t>(static_cast<int>(p.getPieceType()) + 1) & PACKED_TYPE_MASK;
+        if(p.getColor() == colorType::BLACK) code |= PACKED_BLACK;
+        if(p.isRoyal()) code |= PACKED_ROYAL;
+        if(p.getDisguisedAs() != pieceType::NONE) code |= PACKED_DISGUISED;
+        out.squares[sq] = code;
+        storeField(out.stun[sq], p.getStunStack());
+        storeField(out.move[sq], p.getMoveStack());
+        if(p.isSecretRoyal()) out.secretRoyals |= uint64_t(1) << sq;
+        if(p.isRoyalCandidate()) out.royalCandidates |= uint64_t(1) << sq;
+    }
+
+    for(int i = 0; i < POCKET_SIZE; ++i) {
+        storeField(out.pockets[i], whitePocket[i]);
+        storeField(out.pockets[POCKET_SIZE + i], blackPocket[i]);
+    }
+
+    storeField(out.whiteMoveCount, whiteMoveCount);
+    storeField(out.blackMoveCount, blackMoveCount);
+    out.flags = performedActionThisTurn ? PACKED_FLAG_PERFORMED : 0;
+    out.activeSquare = (activePieceThisTurn != nullptr)
+        ? static_cast<uint8_t>(activePieceThisTurn->getRank() * BOARD_SIZE + activePieceThisTurn->getFile())
+        : PACKED_NO_SQUARE;
+}
+
+template <typename Encoded>
+bool bc_board::decodeState(const Encoded& in) {
+    constexpr int typeCount = POCKET_SIZE; // pieceType 0..15
+    for(int sq = 0; sq < BOARD_SIZE * BOARD_SIZE; ++sq) {
+        int typeCode = in.squares[sq] & PACKED_TYPE_MASK;
+        if(typeCode > typeCount) return false;
+        if(typeCode == 0 && in.squares[sq] != 0) return false;
+        if(!validStack(in.stun[sq]) || !validStack(in.move[sq])) return false;
+        // 비밀 로얄은 로얄 기물 칸, 후보는 기물이 있는 칸에만
+        const uint64_t bit = uint64_t(1) << sq;
+        if((in.secretRoyals & bit) && !(in.squares[sq] & PACKED_ROYAL)) return false;
+        if((in.royalCandidates & bit) && in.squares[sq] == 0) return false;
+    }
+    for(int i = 0; i < 2 * POCKET_SIZE; ++i) {
+        if(static_cast<int>(in.pockets[i]) < 0) return false;
+    }
+    if(static_cast<int>(in.whiteMoveCount) < 0 || static_cast<int>(in.blackMoveCount) < 0) return false;
+    if(in.activeSquare != PACKED_NO_SQUARE && in.activeSquare >= BOARD_SIZE * BOARD_SIZE) return false;
+
+    clearBoard();
+    for(int sq = 0; sq < BOARD_SIZE * BOARD_SIZE; ++sq) {
+        const uint8_t code = in.squares[sq];
+        if(code == 0) continue;
+        const int file = sq % BOARD_SIZE;
+        const int rank = sq / BOARD_SIZE;
+        const pieceType type = static_cast<pieceType>((code & PACKED_TYPE_MASK) - 1);
+        const colorType color = (code & PACKED_BLACK) ? colorType::BLACK : colorType::WHITE;
+
+        pieces.emplace_back(type, color, file, rank, pieces.size(), *this, lanes);
+        piece* p = &pieces.back();
+        p->setStun(in.stun[sq]);
+        p->setMoveStack(in.move[sq]);
+        p->setRoyal((code & PACKED_ROYAL) != 0);
+        p->setSecretRoyal((in.secretRoyals >> sq) & 1);
+        p->setRoyalCandidate((in.royalCandidates >> sq) & 1);
+        // 변장은 실제 타입을 변장 타입으로 바꾸므로 변장 대상 = 현재 타입
+        p->setDisguisedAs((code & PACKED_DISGUISED) ? type : pieceType::NONE);
+        setupPiecePatterns(p);
+        board[file][rank] = p;
+    }
+
+    for(int i = 0; i < POCKET_SIZE; ++i) {
+        whitePocket[i] = in.pockets[i];
+        blackPocket[i] = in.pockets[POCKET_SIZE + i];
+    }
+    whiteMoveCount = in.whiteMoveCount;
+    blackMoveCount = in.blackMoveCount;
+    performedActionThisTurn = (in.flags & PACKED_FLAG_PERFORMED) != 0;
+    activePieceThisTurn = (in.activeSquare != PACKED_NO_SQUARE)
+        ? board[in.activeSquare % BOARD_SIZE][in.activeSquare / BOARD_SIZE]
+        : nullptr;
+
+    updateAllLegalMoves();
+    return true;
+}
+
+// bc_board -> packedPosition
+void bc_board::encodePacked(packedPosition& out) const {
+    BC_STAT_TIMER(ENCODE_PACKED);
+    BC_TRACE_METHOD(ENCODE_PACKED);
+    encodeState(out);
+}
+
+// packedPosition -> bc_board (잘못된 기물 코드가 있으면 false, 보드는 변경되지 않음)
+bool bc_board::decodePacked(const packedPosition& in) {
+    BC_STAT_TIMER(DECODE_PACKED);
+    BC_TRACE_METHOD(DECODE_PACKED);
+    return decodeState(in);
+}
+
+// bc_board -> widePosition (값을 자르지 않음)
+void bc_board::encodeWide(widePosition& out) const {
+    encodeState(out);
+}
+
+// widePosition -> bc_board (잘못된 기물 코드, 범위 밖 스택, 음수 포켓/수 카운트면 false, 보드는 변경되지 않음)
+bool bc_board::decodeWide(const widePosition& in) {
+    return decodeState(in);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+
+/* 데이터셋용 고정 크기 바이너리 포지션 레코드 (248바이트, 패딩 없음)
+   칸 인덱스 = rank * 8 + file.
+   squares[i]: 비트 0-4 = pieceType + 1 (0이면 빈 칸), 비트 5 = 흑, 비트 6 = 로얄, 비트 7 = 변장
+   stun/move: 스턴/이동 스택 (255로 클램프)
+   pockets: [0,16) 백, [16,32) 흑, pocketIndex 순서 (255로 클램프)
+   flags: 비트 0 = 이번 턴에 액션 수행함
+   activeSquare: 이번 턴에 액션한 기물의 칸 (없으면 PACKED_NO_SQUARE)
+   secretRoyals: 계승으로 로얄이 되어 상대가 모르는 기물 칸 (칸 코드에도 로얄 비트가 켜져 있다)
+   royalCandidates: 상대가 보기에 비밀 로얄일 수 있는 기물 칸 (계승 시점의 그 편 기물)
+   두 마스크는 비트 = rank*8+file이고 8바이트 경계(오프셋 232/240)에 놓여 레코드 안에 패딩이 없다.
+   NumPy 구조체 dtype으로 그대로 memmap 할 수 있다.
+*/
+struct packedPosition {
+    uint8_t squares[64];
+    uint8_t stun[64];
+    uint8_t move[64];
+    uint8_t pockets[32];
+    uint16_t whiteMoveCount;
+    uint16_t blackMoveCount;
+    uint8_t flags;
+    uint8_t activeSquare;
+    uint8_t reserved[2];
+    uint64_t secretRoyals;
+    uint64_t royalCandidates;
+};
+
+static_assert(sizeof(packedPosition) == 248, "packedPosition layout must stay fixed");
+
+/* packedPosition과 같은 칸 코드/플래그를 쓰되 스택/포켓/수 카운트를 자르지 않는 전체 폭 상태
+   (기보 헤더처럼 값을 그대로 보존해야 하는 곳용, 메모리 레이아웃은 고정하지 않는다)
+*/
+struct widePosition {
+    uint8_t squares[64];
+    int stun[64];
+    int move[64];
+    int pockets[32];
+    int whiteMoveCount;
+    int blackMoveCount;
+    uint8_t flags;
+    uint8_t activeSquare;
+    uint64_t secretRoyals;
+    uint64_t royalCandidates;
+};
+
+inline constexpr uint8_t PACKED_TYPE_MASK = 0x1F;
+inline constexpr uint8_t PACKED_BLACK = 0x20;
+inline constexpr uint8_t PACKED_ROYAL = 0x40;
+inline constexpr uint8_t PACKED_DISGUISED = 0x80;
+inline constexpr uint8_t PACKED_FLAG_PERFORMED = 0x01;
+inline constexpr uint8_t PACKED_NO_SQUARE = 0xFF;
@@ -1,59 +1,89 @@
 #include <piece.hpp>
 #include <gameboard.hpp>
 
-// 기본 생성자
-piece::piece() 
-        : player_idx(0), stun_stack(0), is_stunned(false), move_stack(0), pT(pieceType::NONE), 
-            file(0), rank(0), cT(colorType::NONE), is_royal(false), disguised_as(pieceType::NONE) {}
-
-// 매개변수 생성자
-piece::piece(pieceType type, colorType color, int f, int r, int idx)
-        : player_idx(idx), stun_stack(0), is_stunned(false), move_stack(0), pT(type), 
-      file(f), rank(r), cT(color), is_royal(false), disguised_as(pieceType::NONE) {}
+// 생성자: 보드 레인에 자기 칸 등록
+piece::piece(pieceType type, colorType color, int f, int r, int idx, bc_board& ownerBoard, pieceLanes& boardLanes)
+        : player_idx(idx), owner(&ownerBoard), lanes(&boardLanes), pT(type), file(f), rank(r), cT(color), disguised_as(pieceType::NONE) {
+    lanes->place(square(), color);
+}
 
 // 이동 패턴 추가
 void piece::addMovePattern(const legalMoveChunk& m) {
     movePatterns.push_back(m);
+    moves_epoch = 0;
 }
 
 // 이동 패턴 초기화
 void piece::clearMovePatterns() {
     movePatterns.clear();
+    moves_epoch = 0;
 }
 
-// 합법 이동 계산 및 업데이트
-// 모든 movePattern에서 이동들을 계산하여 합산한다
-void piece::calculateAndUpdateLegalMoves(bc_board* board) {
-    clearLegalMoves();
-    
-    if(board == nullptr) return;
-    
-    // 스턴 상태이면 이동 불가 (합법 수 없음)
-    if(is_stunned) {
-        return;
+// 공격/확인 칸 재계산 (보드가 바뀐 뒤 refreshLegalMoves가 호출)
+// 공격 맵과 평가는 매 행동마다 필요하므로 점유 비트보드로 바로 계산하고, 합법 이동 목록은 무효화만 한다
+// 스턴 중에도 공격 맵은 그대로 계산한다 (스턴 기물도 로얄 피스를 위협함)
+void piece::refreshAttacks(uint64_t epoch) {
+    const int side = pieceLanes::sideOf(cT);
+    attack_mask = 0;
+    scan_mask = 0;
+    for(const auto& pattern : movePatterns) {
+        attack_mask |= pattern.attackMask(file, rank, lanes->colors[side], lanes->colors[1 - side], scan_mask);
     }
-    
-    // 각 이동 패턴에서 이동을 계산하고 합산
+    generated_stunned = isStunned();
+    inputs_epoch = epoch;
+}
+
+// 합법 이동 지연 생성: 마지막 refreshAttacks 이후 처음 조회할 때 모든 movePattern의 이동을 합산한다
+void piece::ensureLegalMoves() const {
+    if(moves_epoch >= inputs_epoch) return;
+    BC_STAT_ADD(LEGAL_MOVE_LISTS, 1);
+    legal_move.clear(); // 기존 용량 재사용
+    destination_mask = 0;
+    jump_capture_mask = 0;
+    moves_epoch = inputs_epoch;
+
+    // 스턴 상태이면 이동 불가 (합법 수 없음)
+    if(owner == nullptr || generated_stunned) return;
+    uint64_t attacks = 0; // 공격/확인 칸은 refreshAttacks에서 이미 계산됨
+    uint64_t scanned = 0;
     for(const auto& pattern : movePatterns) {
-        std::vector<PGN> moves = pattern.calculateMoves(file, rank, pT, cT, board);
-        for(const auto& m : moves) {
-            addLegalMove(m);
-        }
+        pattern.calculateMoves(file, rank, pT, cT, owner, legal_move, attacks, scanned);
     }
+    for(const PGN& m : legal_move) noteDestination(m);
 }
 
 // 합법 이동 업데이트
 void piece::updateLegalMoves(const std::vector<PGN>& moves) {
+    clearLegalMoves();
     legal_move = moves;
+    moves_epoch = inputs_epoch;
+    for(const PGN& m : legal_move) noteDestination(m);
 }
 
 // 합법 이동 추가
 void piece::addLegalMove(const PGN& move) {
+    ensureLegalMoves();
     legal_move.push_back(move);
+    noteDestination(move);
 }
 
 // 합법 이동 초기화
 void piece::clearLegalMoves() {
     legal_move.clear();
+    destination_mask = 0;
+    jump_capture_mask = 0;
+    moves_epoch = inputs_epoch;
+}
+
+// 같은 도착 칸이 여러 번 나오면 첫 이동이 이긴다 (movePiece가 고르는 이동)
+void piece::noteDestination(const PGN& move) const {
+    const int sq = move.endRank * 8 + move.endFile;
+    const uint64_t bit = uint64_t(1) << sq;
+    if(destination_mask & bit) return;
+    destination_mask |= bit;
+    if(move.captureJumped && move.jumpedFile >= 0 && move.jumpedRank >= 0) {
+        jump_capture_mask |= bit;
+        jumped_square[static_cast<size_t>(sq)] = static_cast<int8_t>(move.jumpedRank * 8 + move.jumpedFile);
+    }
 }
 
@@ -1,99 +1,57 @@
 #pragma once
+#include <array>
 #include <iostream>
 #include <vector>
 #include <enum.hpp>
+#include <lanes.hpp>
 #include <moves.hpp>
+#include <piecetraits.hpp>
+#include <stats.hpp>
 #include <algorithm>
 
-// 각 기물의 이동 방향 정보 (file, rank 오프셋)
-// 나이트: JUMP 이동
-const std::vector<std::pair<int, int>> KNIGHT_DIRECTIONS = {
-    {2, 1}, {2, -1}, {-2, 1}, {-2, -1},
-    {1, 2}, {1, -2}, {-1, 2}, {-1, -2}
-};
-
-// 비숍: RAY_INFINITE 대각선
-const std::vector<std::pair<int, int>> BISHOP_DIRECTIONS = {
-    {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
-};
-
-// 룩: RAY_INFINITE 수평/수직
-const std::vector<std::pair<int, int>> ROOK_DIRECTIONS = {
-    {1, 0}, {-1, 0}, {0, 1}, {0, -1}
-};
-
-// 퀸: RAY_INFINITE 모든 방향 (룩+비숍)
-const std::vector<std::pair<int, int>> QUEEN_DIRECTIONS = {
-    {1, 0}, {-1, 0}, {0, 1}, {0, -1},
-    {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
-};
-
-// 킹: RAY_FINITE 모든 방향 (maxDistance=1)
-const std::vector<std::pair<int, int>> KING_DIRECTIONS = {
-    {1, 0}, {-1, 0}, {0, 1}, {0, -1},
-    {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
-};
-
-// 폰 전진 방향: WHITE는 +1, BLACK은 -1 (별도 처리 필요)
-// 폰 대각선 캡처 방향: TAKEMOVE 패턴으로 사용
-const std::vector<std::pair<int, int>> PAWN_CAPTURE_DIRECTIONS = {
-    {1, 1}, {-1, 1}  // 상대 진영 방향 대각선 (방향은 색깔에 따라 조정)
-};
-
-const std::vector<std::pair<int, int>> DABBABA_DIRECTIONS = {
-    {2, 0}, {0, 2}, {-2, 0}, {0, -2}
-};
-
-const std::vector<std::pair<int, int>> ALFIL_DIRECTIONS = {
-    {2, 2}, {2, -2}, {-2, 2}, {-2, -2}
-};
-
-const std::vector<std::pair<int, int>> CAMEL_DIRECTIONS = {
-    {3, 1}, {3, -1}, {-3, 1}, {-3, -1},
-    {1, 3}, {1, -3}, {-1, 3}, {-1, -3}
-};
-
-// 기물 점수 테이블 (스턴 스택 부여에 사용)
-inline int pieceScore(pieceType t) {
-    switch(t) {
-        case pieceType::KING:        return 4;
-        case pieceType::QUEEN:       return 9;
-        case pieceType::ROOK:        return 5;
-        case pieceType::BISHOP:      return 3;
-        case pieceType::KNIGHT:      return 3;
-        case pieceType::AMAZON:      return 13;
-        case pieceType::GRASSHOPPER: return 4;
-        case pieceType::KNIGHTRIDER: return 7;
-        case pieceType::ARCHBISHOP:  return 6;
-        case pieceType::DABBABA:     return 2;
-        case pieceType::ALFIL:       return 2;
-        case pieceType::FERZ:        return 1;
-        case pieceType::CENTAUR:     return 5;
-        case pieceType::TESTROOK:    return 6;
-        case pieceType::CAMEL:       return 3;
-        case pieceType::PWAN:        return 0; // 폰은 랭크 기반 별도 규칙
-        default: return 1;
-    }
+// 각 기물의 이동 방향 정보 (file, rank 오프셋): 기물 특성 레지스트리(piecetraits.hpp)의 방향 표와 같은 값
+inline std::vector<std::pair<int, int>> stepVector(const pieceStep* steps, int count) {
+    return std::vector<std::pair<int, int>>(steps, steps + count);
 }
+const std::vector<std::pair<int, int>> KNIGHT_DIRECTIONS = stepVector(KNIGHT_STEPS.data(), static_cast<int>(KNIGHT_STEPS.size()));
+const std::vector<std::pair<int, int>> BISHOP_DIRECTIONS = stepVector(BISHOP_STEPS.data(), static_cast<int>(BISHOP_STEPS.size()));
+const std::vector<std::pair<int, int>> ROOK_DIRECTIONS = stepVector(ROOK_STEPS.data(), static_cast<int>(ROOK_STEPS.size()));
+const std::vector<std::pair<int, int>> QUEEN_DIRECTIONS = stepVector(QUEEN_STEPS.data(), static_cast<int>(QUEEN_STEPS.size()));
+const std::vector<std::pair<int, int>> KING_DIRECTIONS = QUEEN_DIRECTIONS;
 
 class piece{
     private:
         int player_idx;
-        int stun_stack; // 스턴 스택: 0 이상
-        bool is_stunned; // 스턴 상태: true면 현재 스턴 중
-        int move_stack; // 이동 스택: 한 턴에 여러 번 움직일 수 있는 횟수
+        class bc_board* owner; // 합법수를 지연 생성할 때 읽는 보드
+        pieceLanes* lanes; // 스턴/이동 스택과 로얄 여부는 보드의 레인에 있다 (자기 칸 레인)
         pieceType pT;
         int file, rank; // 보드 위치
         colorType cT;
         std::vector<legalMoveChunk> movePatterns; // 기물이 가질 수 있는 이동 패턴들
-        std::vector<PGN> legal_move; // 계산된 합법 이동들
-        bool is_royal; // 로얄 피스 여부
+        uint64_t attack_mask = 0; // 이 기물이 잡을 수 있는 칸 (스턴 중에도 유지)
+        uint64_t scan_mask = 0; // 계산 중 점유 여부를 확인한 칸: 이 칸이 바뀌면 다시 계산해야 함
+        bool generated_stunned = false; // 마지막 계산 시점의 스턴 상태
+        // 합법 이동 캐시: 처음 조회할 때 만든다. inputs_epoch = 입력(점유/스턴/패턴)이 마지막으로 바뀐 보드 에포크,
+        // moves_epoch = 캐시를 만든 입력 에포크 (inputs_epoch보다 작으면 다시 만든다)
+        uint64_t inputs_epoch = 1;
+        mutable uint64_t moves_epoch = 0;
+        mutable std::vector<PGN> legal_move; // 계산된 합법 이동들
+        mutable uint64_t destination_mask = 0; // legal_move의 도착 칸 (칸 비트 = rank*8+file)
+        mutable uint64_t jump_capture_mask = 0; // 도착 칸 중 중간 기물도 잡는 칸 (같은 도착 칸이면 legal_move의 첫 이동 기준)
+        mutable std::array<int8_t, 64> jumped_square{}; // jump_capture_mask 칸에서 함께 잡히는 칸 (그 밖의 칸은 의미 없음)
+        bool secret_royal = false; // 계승으로 로얄이 되어 상대가 모르는 상태 (rule.md 12)
+        bool royal_candidate = false; // 상대가 보기에 비밀 로얄일 수 있는 기물 (계승 시점의 자기 편 기물)
         pieceType disguised_as; // 변장 상태 (로얄 피스만 사용, NONE이면 변장 안 함)
 
+        void noteDestination(const PGN& move) const; // legal_move에 넣은 이동을 도착 칸 마스크에 반영
+        void ensureLegalMoves() const; // 캐시가 입력보다 오래됐으면 합법 이동을 다시 만든다
+
+        int square() const { return rank * 8 + file; }
+        uint64_t squareBit() const { return uint64_t(1) << square(); }
+
     public:
-        // 생성자
-        piece();
-        piece(pieceType type, colorType color, int f, int r, int idx);
+        // 생성자: 보드의 레인에 자기 칸을 등록한다 (스택 0, 로얄 아님)
+        piece(pieceType type, colorType color, int f, int r, int idx, class bc_board& ownerBoard, pieceLanes& boardLanes);
         
         // getter
         pieceType getPieceType() const { return pT; }
@@ -101,71 +59,70 @@ class piece{
         int getFile() const { return file; }
         int getRank() const { return rank; }
         int getPlayerIdx() const { return player_idx; }
-        int getStunStack() const { return stun_stack; }
-        bool isStunned() const { return is_stunned; }
-        int getMoveStack() const { return move_stack; }
-        const std::vector<PGN>& getLegalMoves() const { return legal_move; }
+        int getStunStack() const { return lanes->stun[square()]; }
+        bool isStunned() const { return lanes->stun[square()] > 0; }
+        int getMoveStack() const { return lanes->move[square()]; }
+        // 합법 이동 관련 getter는 첫 조회 때 캐시를 채운다 (한 보드를 여러 스레드가 동시에 읽지 말 것)
+        const std::vector<PGN>& getLegalMoves() const { ensureLegalMoves(); return legal_move; }
+        uint64_t getAttackMask() const { return attack_mask; }
+        uint64_t getScanMask() const { return scan_mask; }
+        bool isGeneratedStunned() const { return generated_stunned; }
+        uint64_t getDestinationMask() const { ensureLegalMoves(); return destination_mask; }
+        // destination으로 이동할 때 함께 잡히는 칸 (TAKEJUMP), 없으면 -1
+        int getJumpedSquare(int destination) const {
+            ensureLegalMoves();
+            return ((jump_capture_mask >> destination) & 1) ? jumped_square[static_cast<size_t>(destination)] : -1;
+        }
+        bool hasCachedLegalMoves() const { return moves_epoch >= inputs_epoch; }
         const std::vector<legalMoveChunk>& getMovePatterns() const { return movePatterns; }
-        bool isRoyal() const { return is_royal; }
+        bool isRoyal() const { return (lanes->royals[pieceLanes::sideOf(cT)] & squareBit()) != 0; }
+        bool isSecretRoyal() const { return secret_royal; }
+        bool isRoyalCandidate() const { return royal_candidate; }
         pieceType getDisguisedAs() const { return disguised_as; }
         
         // 이동 패턴 관리
         void addMovePattern(const legalMoveChunk& m);
         void clearMovePatterns();
         
-        // 합법 이동 계산 및 업데이트
-        void calculateAndUpdateLegalMoves(class bc_board* board);
+        // 공격/확인 칸과 스턴 상태를 다시 계산하고 합법 이동 캐시를 무효화 (epoch = 보드 에포크)
+        void refreshAttacks(uint64_t epoch);
+        // 합법 이동을 직접 넣으면 그 목록이 현재 캐시가 된다
         void updateLegalMoves(const std::vector<PGN>& moves);
         void addLegalMove(const PGN& move);
         void clearLegalMoves();
         
         // setter
-        void setFile(int f) { file = f; }
-        void setRank(int r) { rank = r; }
-        void setPieceType(pieceType type) { pT = type; }
-        void setRoyal(bool royal) { is_royal = royal; }
-        void setDisguisedAs(pieceType type) { disguised_as = type; }
-        // 스턴 조작
-        void setStun(int s) { 
-            stun_stack = std::max(0, s);
-            is_stunned = (stun_stack > 0); // 스턴 스택이 0이면 스턴 해제
-        }
-        void addStun(int delta) { 
-            stun_stack = std::max(0, stun_stack + delta);
-            is_stunned = (stun_stack > 0); // 스턴 스택이 0이면 스턴 해제
+        // 위치 변경: 레인도 함께 옮긴다 (도착 칸 레인은 비어 있어야 함)
+        void moveTo(int f, int r) {
+            const int from = square();
+            file = f;
+            rank = r;
+            lanes->relocate(from, square());
         }
-        void decrementStun() {
-            if(stun_stack > 0) {
-                stun_stack--;
-                is_stunned = (stun_stack > 0); // 스턴 스택이 0이면 스턴 해제
-            }
-        }
-
-        // 스택 틱: 각 플레이어가 수를 둘 때마다 스턴 스택 1 감소, 그러면 이동 스택 1 증가
-        void applyStunTick() {
-            if(stun_stack > 0) {
-                stun_stack--;
-                is_stunned = (stun_stack > 0);
-                move_stack++; // 스턴 감소할 때마다 이동 스택 1 증가
-            }
+        void setPieceType(pieceType type) { pT = type; }
+        void setRoyal(bool royal) {
+            uint64_t& royals = lanes->royals[pieceLanes::sideOf(cT)];
+            royals = royal ? (royals | squareBit()) : (royals & ~squareBit());
         }
+        void setSecretRoyal(bool secret) { secret_royal = secret; }
+        void setRoyalCandidate(bool candidate) { royal_candidate = candidate; }
+        void setDisguisedAs(pieceType type) { disguised_as = type; }
+        // 스턴 조작 (스택은 0..LANE_STACK_MAX로 자른다)
+        void setStun(int s) { lanes->stun[square()] = clampLaneStack(s); }
+        void addStun(int delta) { setStun(getStunStack() + delta); }
         
         // 이동 스택 소비
         bool consumeMoveStack(int amount = 1) {
-            if(move_stack >= amount) {
-                move_stack -= amount;
+            if(getMoveStack() >= amount) {
+                setMoveStack(getMoveStack() - amount);
                 return true;
             }
             return false;
         }
         
         // 이동 스택 설정
-        void setMoveStack(int m) {
-            move_stack = std::max(0, m);
-        }
+        void setMoveStack(int m) { lanes->move[square()] = clampLaneStack(m); }
         
         // 이동 스택 추가
-        void addMoveStack(int amount) {
-            move_stack = std::max(0, move_stack + amount);
-        }
+        void addMoveStack(int amount) { setMoveStack(getMoveStack() + amount); }
 };
@@ -0,0 +1,181 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <enum.hpp>
+
+/* 기물 특성 레지스트리: 기물 종류마다 한 줄 (인덱스 = pieceType = pocketIndex)
+   기호(포지션 문자열/FEN), 코드(기보/파이썬 바인딩/UI), 이름, 점수/가치, 포켓 칸, 이동 패턴을 여기에만 적는다.
+   pieceScore/materialValue/pieceSymbol/pieceFromSymbol, bc_board::pieceTypeToPocketIndex, setupPiecePatterns,
+   기보의 기물 글자와 바인딩의 문자열 표는 모두 이 표에서 읽는다.
+   조회는 배열 인덱싱이라 상수 인자면 컴파일 타임에 끝나고, 표의 일관성은 아래 static_assert가 검사한다.
+*/
+
+using pieceStep = std::pair<int, int>; // (file 변화, rank 변화)
+
+inline constexpr std::array<pieceStep, 8> KNIGHT_STEPS = {{
+    {2, 1}, {2, -1}, {-2, 1}, {-2, -1},
+    {1, 2}, {1, -2}, {-1, 2}, {-1, -2}
+}};
+inline constexpr std::array<pieceStep, 4> BISHOP_STEPS = {{{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+inline constexpr std::array<pieceStep, 4> ROOK_STEPS = {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+// 퀸/킹: 룩 + 비숍 방향
+inline constexpr std::array<pieceStep, 8> QUEEN_STEPS = {{
+    {1, 0}, {-1, 0}, {0, 1}, {0, -1},
+    {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+}};
+inline constexpr std::array<pieceStep, 4> DABBABA_STEPS = {{{2, 0}, {0, 2}, {-2, 0}, {0, -2}}};
+inline constexpr std::array<pieceStep, 4> ALFIL_STEPS = {{{2, 2}, {2, -2}, {-2, 2}, {-2, -2}}};
+inline constexpr std::array<pieceStep, 8> CAMEL_STEPS = {{
+    {3, 1}, {3, -1}, {-3, 1}, {-3, -1},
+    {1, 3}, {1, -3}, {-1, 3}, {-1, -3}
+}};
+// 폰 (백 기준, 흑은 rank 방향을 뒤집는다)
+inline constexpr std::array<pieceStep, 1> PAWN_PUSH_STEPS = {{{0, 1}}};
+inline constexpr std::array<pieceStep, 2> PAWN_CAPTURE_STEPS = {{{-1, 1}, {1, 1}}};
+
+// 이동 패턴 하나 (legalMoveChunk 생성 인자)
+struct patternTraits {
+    threatType threat = threatType::NONE;
+    moveType move = moveType::NONE;
+    const pieceStep* steps = nullptr;
+    int stepCount = 0;
+    int maxDistance = 0; // RAY_FINITE 최대 거리 (RAY_INFINITE는 0)
+};
+
+template<std::size_t N>
+constexpr patternTraits rayPattern(threatType threat, const std::array<pieceStep, N>& steps) {
+    return {threat, moveType::RAY_INFINITE, steps.data(), static_cast<int>(N), 0};
+}
+
+template<std::size_t N>
+constexpr patternTraits stepPattern(threatType threat, const std::array<pieceStep, N>& steps, int maxDistance = 1) {
+    return {threat, moveType::RAY_FINITE, steps.data(), static_cast<int>(N), maxDistance};
+}
+
+inline constexpr int MAX_PIECE_PATTERNS = 2;
+
+struct pieceTraits {
+    pieceType type;
+    char symbol;          // 한 글자 기호 (백 기준 대문자, 흑은 소문자)
+    const char* code;     // 기보/바인딩/UI 코드: 한 글자면 symbol과 같고, 첫 글자가 다른 기물과 겹치면 두 글자
+    const char* name;     // 바인딩이 받는 긴 이름 (대소문자 무시)
+    int score;            // 착수 시 스턴 (폰은 랭크 규칙이라 0)
+    int value;            // 평가/교환 가치 (materialValue)
+    pocketIndex pocket;
+    bool blackMirrored;   // 흑은 패턴의 rank 방향을 뒤집는다
+    int patternCount;
+    std::array<patternTraits, MAX_PIECE_PATTERNS> patterns;
+};
+
+inline constexpr int PIECE_TYPE_COUNT = 16;
+
+inline constexpr std::array<pieceTraits, PIECE_TYPE_COUNT> PIECE_TRAITS = {{
+    {pieceType::KING,        'K', "K",  "KING",        4,  4,  pocketIndex::KING,        false, 1, {stepPattern(threatType::TAKEMOVE, QUEEN_STEPS)}},
+    {pieceType::QUEEN,       'Q', "Q",  "QUEEN",       9,  9,  pocketIndex::QUEEN,       false, 1, {rayPattern(threatType::TAKEMOVE, QUEEN_STEPS)}},
+    {pieceType::BISHOP,      'B', "B",  "BISHOP",      3,  3,  pocketIndex::BISHOP,      false, 1, {rayPattern(threatType::TAKEMOVE, BISHOP_STEPS)}},
+    // 나이트: 유한 레이 1칸 (경로상 기물에 영향)
+    {pieceType::KNIGHT,      'N', "N",  "KNIGHT",      3,  3,  pocketIndex::KNIGHT,      false, 1, {stepPattern(threatType::TAKEMOVE, KNIGHT_STEPS)}},
+    {pieceType::ROOK,        'R', "R",  "ROOK",        5,  5,  pocketIndex::ROOK,        false, 1, {rayPattern(threatType::TAKEMOVE, ROOK_STEPS)}},
+    {pieceType::PWAN,        'P', "P",  "PAWN",        0,  1,  pocketIndex::PAWN,        true,  2, {stepPattern(threatType::MOVE, PAWN_PUSH_STEPS),
+                                                                                                    stepPattern(threatType::TAKE, PAWN_CAPTURE_STEPS)}},
+    {pieceType::AMAZON,      'A', "A",  "AMAZON",      13, 13, pocketIndex::AMAZON,      false, 2, {stepPattern(threatType::TAKEMOVE, KNIGHT_STEPS),
+                                                                                                    rayPattern(threatType::TAKEMOVE, QUEEN_STEPS)}},
+    {pieceType::GRASSHOPPER, 'G', "G",  "GRASSHOPPER", 4,  4,  pocketIndex::GRASSHOPPER, false, 1, {rayPattern(threatType::MOVEJUMP, QUEEN_STEPS)}},
+    {pieceType::KNIGHTRIDER, 'H', "Kr", "KNIGHTRIDER", 7,  7,  pocketIndex::KNIGHTRIDER, false, 1, {rayPattern(threatType::TAKEMOVE, KNIGHT_STEPS)}},
+    {pieceType::ARCHBISHOP,  'W', "W",  "ARCHBISHOP",  6,  6,  pocketIndex::ARCHBISHOP,  false, 2, {stepPattern(threatType::TAKEMOVE, KNIGHT_STEPS),
+                                                                                                    rayPattern(threatType::TAKEMOVE, BISHOP_STEPS)}},
+    {pieceType::DABBABA,     'D', "D",  "DABBABA",     2,  2,  pocketIndex::DABBABA,     false, 1, {stepPattern(threatType::TAKEMOVE, DABBABA_STEPS)}},
+    {pieceType::ALFIL,       'L', "L",  "ALFIL",       2,  2,  pocketIndex::ALFIL,       false, 1, {stepPattern(threatType::TAKEMOVE, ALFIL_STEPS)}},
+    {pieceType::FERZ,        'F', "F",  "FERZ",        1,  1,  pocketIndex::FERZ,        false, 1, {stepPattern(threatType::TAKEMOVE, BISHOP_STEPS)}},
+    {pieceType::CENTAUR,     'C', "C",  "CENTAUR",     5,  5,  pocketIndex::CENTAUR,     false, 2, {stepPattern(threatType::TAKEMOVE, QUEEN_STEPS),
+                                                                                                    stepPattern(threatType::TAKEMOVE, KNIGHT_STEPS)}},
+    {pieceType::TESTROOK,    'T', "Tr", "TESTROOK",    6,  6,  pocketIndex::TESTROOK,    false, 1, {rayPattern(threatType::TAKEJUMP, ROOK_STEPS)}},
+    {pieceType::CAMEL,       'M', "Cl", "CAMEL",       3,  3,  pocketIndex::CAMEL,       false, 1, {stepPattern(threatType::TAKEMOVE, CAMEL_STEPS)}},
+}};
+
+// pieceType의 특성, NONE/범위 밖이면 nullptr
+constexpr const pieceTraits* findPieceTraits(pieceType t) {
+    const int i = static_cast<int>(t);
+    return (i >= 0 && i < PIECE_TYPE_COUNT) ? &PIECE_TRAITS[static_cast<std::size_t>(i)] : nullptr;
+}
+
+// 기물 점수 (착수 시 스턴 스택 부여에 사용, 모르는 타입은 1)
+constexpr int pieceScore(pieceType t) {
+    const pieceTraits* traits = findPieceTraits(t);
+    return traits ? traits->score : 1;
+}
+
+// 기물 가치 (평가/교환용): 기물 점수와 같고 폰만 1
+constexpr int materialValue(pieceType t) {
+    const pieceTraits* traits = findPieceTraits(t);
+    return traits ? traits->value : 1;
+}
+
+// FEN/포지션 문자열용 한 글자 기물 기호 (백 기준 대문자)
+constexpr char pieceSymbol(pieceType t) {
+    const pieceTraits* traits = findPieceTraits(t);
+    return traits ? traits->symbol : '?';
+}
+
+// 기보/바인딩 코드 ("Kr" 등), 모르는 타입은 "?"
+constexpr const char* pieceCode(pieceType t) {
+    const pieceTraits* traits = findPieceTraits(t);
+    return traits ? traits->code : "?";
+}
+
+// 한 글자 기호 -> 기물 타입 (대소문자 무시, 모르는 기호면 NONE)
+constexpr pieceType pieceFromSymbol(char c) {
+    const char upper = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    for(const pieceTraits& traits : PIECE_TRAITS) {
+        if(traits.symbol == upper) return traits.type;
+    }
+    return pieceType::NONE;
+}
+
+// 코드 -> 기물 타입 (대소문자 구분, "Kr"/"Tr"/"Cl"처럼 기호와 다른 코드 포함). 모르면 NONE
+constexpr pieceType pieceFromCode(std::string_view code) {
+    for(const pieceTraits& traits : PIECE_TRAITS) {
+        if(code == traits.code) return traits.type;
+    }
+    return pieceType::NONE;
+}
+
+// 바인딩 입력: 긴 이름(대소문자 무시), 코드, 한 글자 기호를 모두 받는다. 모르면 NONE
+constexpr pieceType pieceFromName(std::string_view text) {
+    for(const pieceTraits& traits : PIECE_TRAITS) {
+        const std::string_view name = traits.name;
+        if(name.size() != text.size()) continue;
+        bool same = true;
+        for(std::size_t i = 0; i < name.size() && same; ++i) {
+            const char c = text[i];
+            same = ((c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c) == name[i];
+        }
+        if(same) return traits.type;
+    }
+    const pieceType byCode = pieceFromCode(text);
+    if(byCode != pieceType::NONE) return byCode;
+    return (text.size() == 1 && text[0] >= 'A' && text[0] <= 'Z') ? pieceFromSymbol(text[0]) : pieceType::NONE;
+}
+
+namespace pieceTraitsDetail {
+
+// 표 순서 = pieceType = pocketIndex, 기호/코드/이름은 서로 겹치지 않고, 한 글자 코드는 기호와 같다
+constexpr bool registryConsistent() {
+    for(int i = 0; i < PIECE_TYPE_COUNT; ++i) {
+        const pieceTraits& a = PIECE_TRAITS[static_cast<std::size_t>(i)];
+        if(static_cast<int>(a.type) != i || static_cast<int>(a.pocket) != i) return false;
+        if(a.symbol < 'A' || a.symbol > 'Z') return false;
+        if(a.patternCount < 1 || a.patternCount > MAX_PIECE_PATTERNS) return false;
+        const std::string_view code = a.code;
+        if(code.size() == 1 && code[0] != a.symbol) return false;
+        if(pieceFromSymbol(a.symbol) != a.type || pieceFromCode(code) != a.type || pieceFromName(a.name) != a.type) return false;
+    }
+    return true;
+}
+
+} // namespace pieceTraitsDetail
+
+static_assert(pieceTraitsDetail::registryConsistent(), "PIECE_TRAITS: 순서/기호/코드/이름이 어긋남");
+static_assert(static_cast<int>(pieceType::CAMEL) + 1 == PIECE_TYPE_COUNT, "새 pieceType에는 PIECE_TRAITS 항목이 필요함");
@@ -0,0 +1,421 @@
+#include <policy.hpp>
+#include <byteio.hpp>
+#include <gameboard.hpp>
+#include <mappedfile.hpp>
+#include <simd.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[4] = {'B', 'C', 'P', 'V'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t FILE_HEADER_SIZE = 24;
+
+// 캐시 블록: B 패널 KB x NB (64 x 256 float = 64KB, L2), C 타일 4 x 16 (레지스터)
+constexpr int BLOCK_K = 64;
+constexpr int BLOCK_N = 256;
+constexpr int TILE_M = 4;
+constexpr int TILE_N = 16;
+
+// C[4 x 16] += A[4 x kb] * B[kb x 16]
+using tileKernel = void (*)(int kb, const float* A, int lda, const float* B, int ldb, float* C, int ldc);
+
+void tileScalar(int kb, const float* A, int lda, const float* B, int ldb, float* C, int ldc) {
+    float acc[TILE_M][TILE_N];
+    for(int r = 0; r < TILE_M; ++r) {
+        for(int j = 0; j < TILE_N; ++j) acc[r][j] = C[r * ldc + j];
+    }
+    for(int k = 0; k < kb; ++k) {
+        const float* b = B + static_cast<size_t>(k) * ldb;
+        for(int r = 0; r < TILE_M; ++r) {
+            const float a = A[r * lda + k];
+            for(int j = 0; j < TILE_N; ++j) acc[r][j] += a * b[j];
+        }
+    }
+    for(int r = 0; r < TILE_M; ++r) {
+        for(int j = 0; j < TILE_N; ++j) C[r * ldc + j] = acc[r][j];
+    }
+}
+
+#ifdef BC_SIMD_X86
+// 4 x 8 두 번 (xmm 16개 안에서 누적기 8개 + B 2개 + A 1개)
+BC_SIMD_TARGET("sse4.1")
+void tileSse41(int kb, const float* A, int lda, const float* B, int ldb, float* C, int ldc) {
+    for(int half = 0; half < TILE_N; half += 8) {
+        __m128 acc[TILE_M][2];
+        for(int r = 0; r < TILE_M; ++r) {
+            acc[r][0] = _mm_loadu_ps(C + r * ldc + half);
+            acc[r][1] = _mm_loadu_ps(C + r * ldc + half + 4);
+        }
+        for(int k = 0; k < kb; ++k) {
+            const float* b = B + static_cast<size_t>(k) * ldb + half;
+            const __m128 b0 = _mm_loadu_ps(b);
+            const __m128 b1 = _mm_loadu_ps(b + 4);
+            for(int r = 0; r < TILE_M; ++r) {
+                const __m128 a = _mm_set1_ps(A[r * lda + k]);
+                acc[r][0] = _mm_add_ps(acc[r][0], _mm_mul_ps(a, b0));
+                acc[r][1] = _mm_add_ps(acc[r][1], _mm_mul_ps(a, b1));
+            }
+        }
+        for(int r = 0; r < TILE_M; ++r) {
+            _mm_storeu_ps(C + r * ldc + half, acc[r][0]);
+            _mm_storeu_ps(C + r * ldc + half + 4, acc[r][1]);
+        }
+    }
+}
+
+BC_SIMD_TARGET("avx2,fma")
+void tileAvx2Fma(int kb, const float* A, int lda, const float* B, int ldb, float* C, int ldc) {
+    __m256 acc[TILE_M][2];
+    for(int r = 0; r < TILE_M; ++r) {
+        acc[r][0] = _mm256_loadu_ps(C + r * ldc);
+        acc[r][1] = _mm256_loadu_ps(C + r * ldc + 8);
+    }
+    for(int k = 0; k < kb; ++k) {
+        const float* b = B + static_cast<size_t>(k) * ldb;
+        const __m256 b0 = _mm256_loadu_ps(b);
+        const __m256 b1 = _mm256_loadu_ps(b + 8);
+        for(int r = 0; r < TILE_M; ++r) {
+            const __m256 a = _mm256_broadcast_ss(A + r * lda + k);
+            acc[r][0] = _mm256_fmadd_ps(a, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_ps(a, b1, acc[r][1]);
+        }
+    }
+    for(int r = 0; r < TILE_M; ++r) {
+        _mm256_storeu_ps(C + r * ldc, acc[r][0]);
+        _mm256_storeu_ps(C + r * ldc + 8, acc[r][1]);
+    }
+}
+#endif
+
+struct kernelTable {
+    policyKernel kind = policyKernel::SCALAR;
+    tileKernel tile = tileScalar;
+};
+
+kernelTable tableFor(policyKernel kind) {
+    switch(kind) {
+#ifdef BC_SIMD_X86
+        case policyKernel::AVX2_FMA: return {kind, tileAvx2Fma};
+        case policyKernel::SSE41:    return {kind, tileSse41};
+#endif
+        default: return {};
+    }
+}
+
+kernelTable& activeKernels() {
+    static kernelTable table = [] {
+        if(policyKernelSupported(policyKernel::AVX2_FMA)) return tableFor(policyKernel::AVX2_FMA);
+        if(policyKernelSupported(policyKernel::SSE41)) return tableFor(policyKernel::SSE41);
+        return tableFor(policyKernel::SCALAR);
+    }();
+    return table;
+}
+
+// ---------------------------------------------------------------- 파일 입출력
+
+void readFloats(const uint8_t*& p, float* out, size_t count) {
+    for(size_t i = 0; i < count; ++i, p += 4) {
+        const uint32_t bits = readU32(p);
+        std::memcpy(out + i, &bits, 4);
+    }
+}
+
+void putFloats(std::vector<uint8_t>& out, const float* in, size_t count) {
+    for(size_t i = 0; i < count; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, in + i, 4);
+        putU32(out, bits);
+    }
+}
+
+size_t fileSizeFor(size_t hidden, size_t blocks) {
+    const size_t floats = NNUE_FEATURES * hidden + hidden +
+                          blocks * 2 * (hidden * hidden + hidden) +
+                          hidden * POLICY_ACTIONS + POLICY_ACTIONS + hidden + 1;
+    return FILE_HEADER_SIZE + 4 * floats;
+}
+
+// 둘 차례 관점 칸
+inline int relativeSquare(int sq, colorType mover) { return (mover == colorType::WHITE) ? sq : (sq ^ 56); }
+
+inline bool validKind(pieceType t) {
+    const int k = static_cast<int>(t);
+    return k >= 0 && k < 16;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- 액션 번호
+
+int policyIndex(const boardAction& action, colorType mover) {
+    const int from = action.fromSquare >= 0 ? relativeSquare(action.fromSquare, mover) : -1;
+    const int to = action.toSquare >= 0 ? relativeSquare(action.toSquare, mover) : -1;
+    const int kind = static_cast<int>(action.pT);
+    switch(action.type) {
+        case actionType::DROP:
+            return (validKind(action.pT) && to >= 0) ? POLICY_DROP_BASE + kind * 64 + to : -1;
+        case actionType::MOVE:
+            return (from >= 0 && to >= 0) ? POLICY_MOVE_BASE + from * 64 + to : -1;
+        case actionType::STUN:
+            return from >= 0 ? POLICY_STUN_BASE + from : -1;
+        case actionType::PROMOTE:
+            return (validKind(action.pT) && from >= 0) ? POLICY_PROMOTE_BASE + kind * 64 + from : -1;
+        case actionType::DISGUISE:
+            return (validKind(action.pT) && from >= 0) ? POLICY_DISGUISE_BASE + kind * 64 + from : -1;
+        case actionType::SUCCESSION:
+            return from >= 0 ? POLICY_SUCCESSION_BASE + from : -1;
+        case actionType::END_TURN:
+            return POLICY_END_TURN;
+    }
+    return -1;
+}
+
+boardAction policyAction(int index, colorType mover) {
+    if(index >= POLICY_END_TURN || index < 0) return boardAction::endTurn();
+    if(index >= POLICY_SUCCESSION_BASE) return boardAction::succession(relativeSquare(index - POLICY_SUCCESSION_BASE, mover));
+    if(index >= POLICY_DISGUISE_BASE) {
+        const int off = index - POLICY_DISGUISE_BASE;
+        return boardAction::disguise(relativeSquare(off % 64, mover), static_cast<pieceType>(off / 64));
+    }
+    if(index >= POLICY_PROMOTE_BASE) {
+        const int off = index - POLICY_PROMOTE_BASE;
+        return boardAction::promote(relativeSquare(off % 64, mover), static_cast<pieceType>(off / 64));
+    }
+    if(index >= POLICY_STUN_BASE) return boardAction::stun(relativeSquare(index - POLICY_STUN_BASE, mover));
+    if(index >= POLICY_MOVE_BASE) {
+        const int off = index - POLICY_MOVE_BASE;
+        return boardAction::move(relativeSquare(off / 64, mover), relativeSquare(off % 64, mover));
+    }
+    return boardAction::drop(static_cast<pieceType>(index / 64), relativeSquare(index % 64, mover));
+}
+
+// ---------------------------------------------------------------- 커널
+
+bool policyKernelSupported(policyKernel kernel) {
+    switch(kernel) {
+        case policyKernel::SCALAR:   return true;
+        case policyKernel::SSE41:    return cpuHasSse41();
+        case policyKernel::AVX2_FMA: return cpuHasAvx2() && cpuHasFma();
+    }
+    return false;
+}
+
+bool policySetKernel(policyKernel kernel) {
+    if(!policyKernelSupported(kernel)) return false;
+    activeKernels() = tableFor(kernel);
+    return true;
+}
+
+policyKernel policyActiveKernel() {
+    return activeKernels().kind;
+}
+
+const char* policyKernelName(policyKernel kernel) {
+    switch(kernel) {
+        case policyKernel::AVX2_FMA: return "avx2+fma";
+        case policyKernel::SSE41:    return "sse4.1";
+        default:                     return "scalar";
+    }
+}
+
+void policyGemm(int M, int N, int K, const float* A, int lda, const float* B, int ldb, float* C, int ldc) {
+    const tileKernel tile = activeKernels().tile;
+    for(int n0 = 0; n0 < N; n0 += BLOCK_N) {
+        const int n1 = std::min(N, n0 + BLOCK_N);
+        for(int k0 = 0; k0 < K; k0 += BLOCK_K) {
+            const int kb = std::min(K - k0, BLOCK_K);
+            const float* panel = B + static_cast<size_t>(k0) * ldb;
+            for(int m = 0; m < M; m += TILE_M) {
+                const float* a = A + static_cast<size_t>(m) * lda + k0;
+                float* c = C + static_cast<size_t>(m) * ldc;
+                for(int j = n0; j < n1; j += TILE_N) tile(kb, a, lda, panel + j, ldb, c + j, ldc);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------- 배치 입력
+
+void policyBatch::add(const bc_board& board) {
+    const colorType mover = board.currentPlayerColor();
+    const std::vector<int> active = board.getNeuralFeatures(mover);
+    addFeatures(active.data(), active.size());
+}
+
+void policyBatch::addFeatures(const int* begin, size_t count) {
+    features.insert(features.end(), begin, begin + count);
+    offsets.push_back(static_cast<uint32_t>(features.size()));
+}
+
+// ---------------------------------------------------------------- 네트워크
+
+bool policyNetwork::load(const std::string& path) {
+    mappedFile file;
+    if(!file.open(path) || file.size() < FILE_HEADER_SIZE) return false;
+    const uint8_t* p = file.data();
+    if(std::memcmp(p, MAGIC, 4) != 0 || readU32(p + 4) != FORMAT_VERSION ||
+       readU32(p + 8) != static_cast<uint32_t>(NNUE_FEATURES) || readU32(p + 20) != static_cast<uint32_t>(POLICY_ACTIONS)) {
+        return false;
+    }
+    const size_t h = readU32(p + 12);
+    const size_t blocks = readU32(p + 16);
+    if(h == 0 || h % TILE_M != 0 || h > 4096 || blocks > 64 || file.size() != fileSizeFor(h, blocks)) return false;
+    p += FILE_HEADER_SIZE;
+
+    policyNetwork next;
+    next.hidden = static_cast<int>(h);
+    next.embed.resize(NNUE_FEATURES * h);
+    next.embedBias.resize(h);
+    readFloats(p, next.embed.data(), next.embed.size());
+    readFloats(p, next.embedBias.data(), h);
+    next.tower.resize(blocks);
+    for(auto& block : next.tower) {
+        block.w1.resize(h * h); block.b1.resize(h);
+        block.w2.resize(h * h); block.b2.resize(h);
+        readFloats(p, block.w1.data(), h * h);
+        readFloats(p, block.b1.data(), h);
+        readFloats(p, block.w2.data(), h * h);
+        readFloats(p, block.b2.data(), h);
+    }
+    next.policyWeights.assign(h * POLICY_STRIDE, 0.0f);
+    for(size_t row = 0; row < h; ++row) readFloats(p, next.policyWeights.data() + row * POLICY_STRIDE, POLICY_ACTIONS);
+    next.policyBias.assign(POLICY_STRIDE, 0.0f);
+    readFloats(p, next.policyBias.data(), POLICY_ACTIONS);
+    next.valueWeights.resize(h);
+    readFloats(p, next.valueWeights.data(), h);
+    readFloats(p, &next.valueBias, 1);
+    *this = std::move(next);
+    return true;
+}
+
+bool policyNetwork::save(const std::string& path) const {
+    if(!ready()) return false;
+    const size_t h = static_cast<size_t>(hidden);
+    std::vector<uint8_t> out;
+    out.reserve(fileSizeFor(h, tower.size()));
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    putU32(out, FORMAT_VERSION);
+    putU32(out, NNUE_FEATURES);
+    putU32(out, static_cast<uint32_t>(h));
+    putU32(out, static_cast<uint32_t>(tower.size()));
+    putU32(out, POLICY_ACTIONS);
+    putFloats(out, embed.data(), embed.size());
+    putFloats(out, embedBias.data(), h);
+    for(const auto& block : tower) {
+        putFloats(out, block.w1.data(), h * h);
+        putFloats(out, block.b1.data(), h);
+        putFloats(out, block.w2.data(), h * h);
+        putFloats(out, block.b2.data(), h);
+    }
+    for(size_t row = 0; row < h; ++row) putFloats(out, policyWeights.data() + row * POLICY_STRIDE, POLICY_ACTIONS);
+    putFloats(out, policyBias.data(), POLICY_ACTIONS);
+    putFloats(out, valueWeights.data(), h);
+    putFloats(out, &valueBias, 1);
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if(file == nullptr) return false;
+    const bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    return (std::fclose(file) == 0) && ok;
+}
+
+void policyNetwork::randomize(uint32_t seed, int hiddenSize, int blocks) {
+    auto next = [&seed](float scale) {
+        seed = seed * 1664525u + 1013904223u;
+        return (static_cast<float>((seed >> 8) & 0xFFFF) / 32768.0f - 1.0f) * scale;
+    };
+    const size_t h = static_cast<size_t>((std::max(hiddenSize, TILE_M) + TILE_M - 1) / TILE_M * TILE_M);
+    const float layerScale = 1.0f / std::sqrt(static_cast<float>(h));
+    hidden = static_cast<int>(h);
+    embed.resize(NNUE_FEATURES * h);
+    for(auto& w : embed) w = next(0.1f);
+    embedBias.resize(h);
+    for(auto& w : embedBias) w = next(0.1f);
+    tower.assign(static_cast<size_t>(std::max(blocks, 0)), residualBlock{});
+    for(auto& block : tower) {
+        block.w1.resize(h * h); block.b1.resize(h);
+        block.w2.resize(h * h); block.b2.resize(h);
+        for(auto& w : block.w1) w = next(layerScale);
+        for(auto& w : block.b1) w = next(0.01f);
+        for(auto& w : block.w2) w = next(layerScale);
+        for(auto& w : block.b2) w = next(0.01f);
+    }
+    policyWeights.assign(h * POLICY_STRIDE, 0.0f);
+    for(size_t row = 0; row < h; ++row) {
+        for(int a = 0; a < POLICY_ACTIONS; ++a) policyWeights[row * POLICY_STRIDE + a] = next(layerScale);
+    }
+    policyBias.assign(POLICY_STRIDE, 0.0f);
+    for(int a = 0; a < POLICY_ACTIONS; ++a) policyBias[a] = next(0.01f);
+    valueWeights.resize(h);
+    for(auto& w : valueWeights) w = next(layerScale);
+    valueBias = next(0.01f);
+}
+
+void policyNetwork::forward(const policyBatch& batch, policyWorkspace& work) const {
+    const size_t n = batch.size();
+    work.logitStride = POLICY_STRIDE;
+    work.values.assign(n, 0.0f);
+    if(!ready() || n == 0) {
+        work.logits.assign(n * POLICY_STRIDE, 0.0f);
+        return;
+    }
+    const size_t h = static_cast<size_t>(hidden);
+    const size_t rows = (n + TILE_M - 1) / TILE_M * TILE_M; // GEMM 타일에 맞춰 0 행 패딩
+    work.x.assign(rows * h, 0.0f);
+    work.h.resize(rows * h);
+
+    // 임베딩: 활성 특징 열의 합 (희소 입력이라 GEMM 대신 열 덧셈)
+    for(size_t i = 0; i < n; ++i) {
+        float* x = work.x.data() + i * h;
+        std::copy(embedBias.begin(), embedBias.end(), x);
+        const int* f = batch.featuresOf(i);
+        for(size_t k = 0; k < batch.featureCount(i); ++k) {
+            const float* column = embed.data() + static_cast<size_t>(f[k]) * h;
+            for(size_t j = 0; j < h; ++j) x[j] += column[j];
+        }
+        for(size_t j = 0; j < h; ++j) x[j] = std::max(x[j], 0.0f);
+    }
+
+    const int M = static_cast<int>(rows), H = hidden;
+    for(const auto& block : tower) {
+        for(size_t r = 0; r < rows; ++r) std::copy(block.b1.begin(), block.b1.end(), work.h.begin() + r * h);
+        policyGemm(M, H, H, work.x.data(), H, block.w1.data(), H, work.h.data(), H);
+        for(float& v : work.h) v = std::max(v, 0.0f);
+        // x += h W2 + b2, 그 뒤 ReLU
+        for(size_t r = 0; r < rows; ++r) {
+            float* x = work.x.data() + r * h;
+            for(size_t j = 0; j < h; ++j) x[j] += block.b2[j];
+        }
+        policyGemm(M, H, H, work.h.data(), H, block.w2.data(), H, work.x.data(), H);
+        for(float& v : work.x) v = std::max(v, 0.0f);
+    }
+
+    work.logits.resize(rows * POLICY_STRIDE);
+    for(size_t r = 0; r < rows; ++r) std::copy(policyBias.begin(), policyBias.end(), work.logits.begin() + r * POLICY_STRIDE);
+    policyGemm(M, static_cast<int>(POLICY_STRIDE), H, work.x.data(), H, policyWeights.data(), static_cast<int>(POLICY_STRIDE),
+               work.logits.data(), static_cast<int>(POLICY_STRIDE));
+    work.logits.resize(n * POLICY_STRIDE);
+
+    for(size_t i = 0; i < n; ++i) {
+        const float* x = work.x.data() + i * h;
+        float v = valueBias;
+        for(size_t j = 0; j < h; ++j) v += x[j] * valueWeights[j];
+        work.values[i] = std::tanh(v);
+    }
+}
+
+void policyPriors(const float* logits, const std::vector<int>& indices, std::vector<float>& priors) {
+    priors.resize(indices.size());
+    if(indices.empty()) return;
+    float top = logits[indices[0]];
+    for(int a : indices) top = std::max(top, logits[a]);
+    float total = 0.0f;
+    for(size_t i = 0; i < indices.size(); ++i) {
+        priors[i] = std::exp(logits[indices[i]] - top);
+        total += priors[i];
+    }
+    for(float& p : priors) p /= total;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <action.hpp>
+#include <nnue.hpp>
+
+class bc_board;
+
+/* 정책/가치 네트워크 (policy.cpp)
+   입력: NNUE 특징(nnue.hpp)을 둘 차례 관점으로 본 희소 벡터
+   구조: 특징 임베딩 합 -> ReLU -> 잔차 블록 x B (x = ReLU(x + W2 ReLU(W1 x + b1) + b2)) -> 정책 / 가치 헤드
+   출력: 전체 액션 공간의 로짓 POLICY_ACTIONS개 + tanh 가치 (둘 차례 기준, -1..1)
+   배치 추론은 [배치 x 은닉] 행렬과 가중치 행렬의 캐시 블록 GEMM이며 커널은 CPU에 맞춰 고른다.
+
+   액션 번호 (둘 차례 관점, 흑이면 칸을 sq ^ 56으로 뒤집음)
+     DROP        종류 x 64 + 도착 칸
+     MOVE        출발 칸 x 64 + 도착 칸
+     STUN        대상 칸 (스턴 양은 1로 본다)
+     PROMOTE     종류 x 64 + 칸
+     DISGUISE    종류 x 64 + 칸
+     SUCCESSION  칸
+     END_TURN    1개
+
+   가중치 파일 (리틀 엔디언 float32, 행렬은 [입력][출력] 행 우선)
+     "BCPV" + u32 버전(1) + u32 특징 수(NNUE_FEATURES) + u32 은닉 크기 + u32 블록 수 + u32 액션 수(POLICY_ACTIONS)
+     임베딩 [특징][은닉], 바이어스 [은닉]
+     블록마다 W1 [은닉][은닉], b1 [은닉], W2 [은닉][은닉], b2 [은닉]
+     정책 [은닉][액션], 바이어스 [액션]
+     가치 [은닉], 바이어스 1개
+*/
+inline constexpr int POLICY_DROP_BASE = 0;
+inline constexpr int POLICY_MOVE_BASE = POLICY_DROP_BASE + 16 * 64;
+inline constexpr int POLICY_STUN_BASE = POLICY_MOVE_BASE + 64 * 64;
+inline constexpr int POLICY_PROMOTE_BASE = POLICY_STUN_BASE + 64;
+inline constexpr int POLICY_DISGUISE_BASE = POLICY_PROMOTE_BASE + 16 * 64;
+inline constexpr int POLICY_SUCCESSION_BASE = POLICY_DISGUISE_BASE + 16 * 64;
+inline constexpr int POLICY_END_TURN = POLICY_SUCCESSION_BASE + 64;
+inline constexpr int POLICY_ACTIONS = POLICY_END_TURN + 1;
+
+int policyIndex(const boardAction& action, colorType mover); // 표현할 수 없으면 -1
+boardAction policyAction(int index, colorType mover);
+
+// GEMM 커널 (기본값: CPU가 지원하는 가장 넓은 것)
+enum class policyKernel : uint8_t {
+    SCALAR,
+    SSE41,
+    AVX2_FMA
+};
+bool policyKernelSupported(policyKernel kernel);
+bool policySetKernel(policyKernel kernel); // 지원하지 않으면 false, 기존 커널 유지
+policyKernel policyActiveKernel();
+const char* policyKernelName(policyKernel kernel);
+
+// C[M x N] += A[M x K] * B[K x N] (행 우선, M은 4의 배수, N은 16의 배수)
+void policyGemm(int M, int N, int K, const float* A, int lda, const float* B, int ldb, float* C, int ldc);
+
+// 배치 입력: 포지션마다 활성 특징 번호
+class policyBatch {
+    private:
+        std::vector<int> features;
+        std::vector<uint32_t> offsets{0};
+
+    public:
+        void clear() { features.clear(); offsets.assign(1, 0); }
+        void add(const bc_board& board); // 둘 차례 관점
+        void addFeatures(const int* begin, size_t count);
+        size_t size() const { return offsets.size() - 1; }
+        const int* featuresOf(size_t i) const { return features.data() + offsets[i]; }
+        size_t featureCount(size_t i) const { return offsets[i + 1] - offsets[i]; }
+};
+
+// 추론 결과 + 중간 버퍼 (스레드마다 하나, 배치 사이에 재사용)
+struct policyWorkspace {
+    std::vector<float> logits;  // [배치][logitStride], 앞 POLICY_ACTIONS개만 의미 있음
+    std::vector<float> values;  // [배치]
+    size_t logitStride = 0;
+    std::vector<float> x, h;    // 은닉 활성값
+
+    const float* logitsOf(size_t i) const { return logits.data() + i * logitStride; }
+};
+
+class policyNetwork {
+    private:
+        struct residualBlock {
+            std::vector<float> w1, b1, w2, b2;
+        };
+        int hidden = 0;
+        std::vector<float> embed;          // [NNUE_FEATURES][hidden]
+        std::vector<float> embedBias;      // [hidden]
+        std::vector<residualBlock> tower;
+        std::vector<float> policyWeights;  // [hidden][stride] (열을 16의 배수로 0 패딩)
+        std::vector<float> policyBias;     // [stride]
+        std::vector<float> valueWeights;   // [hidden]
+        float valueBias = 0.0f;
+
+    public:
+        static constexpr size_t POLICY_STRIDE = (POLICY_ACTIONS + 15) / 16 * 16;
+
+        bool load(const std::string& path); // 형식/크기가 맞지 않으면 false, 기존 가중치 유지
+        bool save(const std::string& path) const;
+        void randomize(uint32_t seed, int hiddenSize, int blocks); // 테스트/벤치마크용
+        bool ready() const { return hidden > 0; }
+        int hiddenSize() const { return hidden; }
+        int blockCount() const { return static_cast<int>(tower.size()); }
+
+        void forward(const policyBatch& batch, policyWorkspace& work) const;
+};
+
+// 합법 액션만 남긴 softmax 사전 확률 (indices는 policyIndex 번호)
+void policyPriors(const float* logits, const std::vector<int>& indices, std::vector<float>& priors);
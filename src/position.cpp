@@ -0,0 +1,310 @@
+#include <gameboard.hpp>
+#include <charconv>
+#include <cctype>
+
+/* chesstack 포지션 문자열
+   FEN을 확장해 bc_board의 전체 상태를 한 줄로 표현한다. 필드는 공백으로 구분한다.
+
+     <배치> <차례> [<포켓>] [<턴 상태>] [<백 수> <흑 수>]
+
+   배치: 8랭크부터 1랭크까지 '/'로 구분, 빈 칸은 숫자, 기물은 pieceSymbol 한 글자 (백=대문자, 흑=소문자).
+         기물 기호 뒤에 선택 접미사를 이 순서로 붙인다.
+           ^ 또는 !  로얄 피스 ('!'는 계승으로 로얄이 되어 상대가 모르는 비밀 로얄)
+           ?        비밀 로얄 후보 (계승 시점의 그 편 기물, ismcts.hpp)
+           =X       X로 변장 중 (disguised_as)
+           (s,m)    스턴 스택 s, 이동 스택 m (둘 다 0이면 생략)
+         예) K^(0,2)  = 이동 스택 2인 백 로얄 킹,  q^=q(3,0) = 퀸으로 변장한 흑 로얄 피스,
+             p!?      = 계승한 흑 비밀 로얄 폰 (후보이기도 함)
+   차례: w 또는 b
+   포켓: "<백>/<흑>", 각 쪽은 기호+개수 나열 (개수 1은 생략, 0은 나열하지 않음, 비어 있으면 '-')
+         생략하면 기본 포켓 재고
+   턴 상태: '-' = 이번 턴에 액션 없음, 칸 이름(예: e4) = 그 칸의 기물이 이번 턴에 액션함,
+            '+' = 액션했지만 해당 기물이 보드에 없음. 생략하면 '-'
+   수 카운트: whiteMoveCount blackMoveCount. 생략하면 setTurn()과 같은 규칙으로 차례에서 유도
+
+   예) 기본 시작 포지션: "8/8/8/8/8/8/8/8 w KQB2N2R2P8/kqb2n2r2p8 - 0 0"
+*/
+
+namespace {
+
+bool parseInt(std::string_view text, size_t& pos, int& out) {
+    const char* first = text.data() + pos;
+    const char* last = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(first, last, out);
+    if(ec != std::errc() || ptr == first) return false;
+    pos += static_cast<size_t>(ptr - first);
+    return true;
+}
+
+void skipSpaces(std::string_view text, size_t& pos) {
+    while(pos < text.size() && text[pos] == ' ') pos++;
+}
+
+// 공백 전까지의 토큰을 잘라낸다 (없으면 빈 view)
+std::string_view nextField(std::string_view text, size_t& pos) {
+    skipSpaces(text, pos);
+    size_t start = pos;
+    while(pos < text.size() && text[pos] != ' ') pos++;
+    return text.substr(start, pos - start);
+}
+
+void appendInt(std::string& out, int value) {
+    char buf[16];
+    auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    (void)ec;
+    out.append(buf, ptr);
+}
+
+} // namespace
+
+// 전체 상태 포지션 문자열 생성
+std::string bc_board::getPositionString() const {
+    BC_STAT_TIMER(GET_POSITION_STRING);
+    BC_TRACE_METHOD(GET_POSITION_STRING);
+    std::string out;
+    out.reserve(160);
+
+    // 1) 배치
+    for(int rank = BOARD_SIZE - 1; rank >= 0; --rank) {
+        int emptyCount = 0;
+        for(int file = 0; file < BOARD_SIZE; ++file) {
+            const piece* p = board[file][rank];
+            if(p == nullptr) {
+                emptyCount++;
+                continue;
+            }
+            if(emptyCount > 0) {
+                out += char('0' + emptyCount);
+                emptyCount = 0;
+            }
+            const bool white = (p->getColor() == colorType::WHITE);
+            char symbol = pieceSymbol(p->getPieceType());
+            out += white ? symbol : char(std::tolower(symbol));
+            if(p->isRoyal()) out += p->isSecretRoyal() ? '!' : '^';
+            if(p->isRoyalCandidate()) out += '?';
+            if(p->getDisguisedAs() != pieceType::NONE) {
+                char d = pieceSymbol(p->getDisguisedAs());
+                out += '=';
+                out += white ? d : char(std::tolower(d));
+            }
+            if(p->getStunStack() != 0 || p->getMoveStack() != 0) {
+                out += '(';
+                appendInt(out, p->getStunStack());
+                out += ',';
+                appendInt(out, p->getMoveStack());
+                out += ')';
+            }
+        }
+        if(emptyCount > 0) out += char('0' + emptyCount);
+        if(rank > 0) out += '/';
+    }
+
+    // 2) 차례
+    out += ' ';
+    out += (currentPlayerColor() == colorType::WHITE) ? 'w' : 'b';
+
+    // 3) 포켓 (pocketIndex 순서 = pieceType 순서)
+    out += ' ';
+    for(int side = 0; side < 2; ++side) {
+        const auto& pocket = (side == 0) ? whitePocket : blackPocket;
+        bool any = false;
+        for(int i = 0; i < POCKET_SIZE; ++i) {
+            if(pocket[i] <= 0) continue;
+            char symbol = pieceSymbol(static_cast<pieceType>(i));
+            out += (side == 0) ? symbol : char(std::tolower(symbol));
+            if(pocket[i] != 1) appendInt(out, pocket[i]);
+            any = true;
+        }
+        if(!any) out += '-';
+        if(side == 0) out += '/';
+    }
+
+    // 4) 턴 상태
+    out += ' ';
+    if(!performedActionThisTurn) {
+        out += '-';
+    } else if(activePieceThisTurn == nullptr) {
+        out += '+';
+    } else {
+        out += char('a' + activePieceThisTurn->getFile());
+        out += char('1' + activePieceThisTurn->getRank());
+    }
+
+    // 5) 수 카운트
+    out += ' ';
+    appendInt(out, whiteMoveCount);
+    out += ' ';
+    appendInt(out, blackMoveCount);
+    return out;
+}
+
+// 포지션 문자열 로드: 전체를 먼저 검증한 뒤 한 번에 보드에 반영한다
+bool bc_board::loadPositionString(std::string_view text) {
+    BC_STAT_TIMER(LOAD_POSITION_STRING);
+    BC_TRACE_METHOD(LOAD_POSITION_STRING);
+    struct stagedPiece {
+        pieceType type;
+        colorType color;
+        int file, rank, stun, move;
+        bool royal;
+        bool secret;
+        bool candidate;
+        pieceType disguise;
+    };
+    std::array<stagedPiece, BOARD_SIZE * BOARD_SIZE> staged{};
+    int stagedCount = 0;
+
+    size_t pos = 0;
+    skipSpaces(text, pos);
+
+    // 1) 배치
+    int rank = BOARD_SIZE - 1;
+    int file = 0;
+    while(pos < text.size() && text[pos] != ' ') {
+        char c = text[pos];
+        if(c == '/') {
+            if(file != BOARD_SIZE || rank == 0) return false;
+            rank--;
+            file = 0;
+            pos++;
+            continue;
+        }
+        if(c >= '1' && c <= '8') {
+            file += c - '0';
+            if(file > BOARD_SIZE) return false;
+            pos++;
+            continue;
+        }
+
+        pieceType type = pieceFromSymbol(c);
+        if(type == pieceType::NONE || file >= BOARD_SIZE) return false;
+        stagedPiece& sp = staged[stagedCount++];
+        sp = stagedPiece{type, std::isupper(static_cast<unsigned char>(c)) ? colorType::WHITE : colorType::BLACK,
+                         file, rank, 0, 0, false, false, false, pieceType::NONE};
+        pos++;
+
+        if(pos < text.size() && (text[pos] == '^' || text[pos] == '!')) {
+            sp.royal = true;
+            sp.secret = (text[pos] == '!');
+            pos++;
+        }
+        if(pos < text.size() && text[pos] == '?') {
+            sp.candidate = true;
+            pos++;
+        }
+        if(pos < text.size() && text[pos] == '=') {
+            pos++;
+            if(pos >= text.size()) return false;
+            sp.disguise = pieceFromSymbol(text[pos]);
+            if(sp.disguise == pieceType::NONE) return false;
+            pos++;
+        }
+        if(pos < text.size() && text[pos] == '(') {
+            pos++;
+            if(!parseInt(text, pos, sp.stun) || sp.stun < 0 || sp.stun > LANE_STACK_MAX) return false;
+            if(pos >= text.size() || text[pos] != ',') return false;
+            pos++;
+            if(!parseInt(text, pos, sp.move) || sp.move < 0 || sp.move > LANE_STACK_MAX) return false;
+            if(pos >= text.size() || text[pos] != ')') return false;
+            pos++;
+        }
+        file++;
+    }
+    if(rank != 0 || file != BOARD_SIZE) return false;
+
+    // 2) 차례
+    std::string_view sideField = nextField(text, pos);
+    if(sideField.size() != 1 || (sideField[0] != 'w' && sideField[0] != 'b')) return false;
+    const colorType side = (sideField[0] == 'w') ? colorType::WHITE : colorType::BLACK;
+
+    // 3) 포켓 (생략 시 기본 재고)
+    std::array<int, POCKET_SIZE> stagedWhitePocket = DEFAULT_POCKET_STOCK;
+    std::array<int, POCKET_SIZE> stagedBlackPocket = DEFAULT_POCKET_STOCK;
+    std::string_view pocketField = nextField(text, pos);
+    if(!pocketField.empty()) {
+        size_t slash = pocketField.find('/');
+        if(slash == std::string_view::npos) return false;
+        for(int sideIdx = 0; sideIdx < 2; ++sideIdx) {
+            std::string_view part = (sideIdx == 0) ? pocketField.substr(0, slash) : pocketField.substr(slash + 1);
+            auto& pocket = (sideIdx == 0) ? stagedWhitePocket : stagedBlackPocket;
+            pocket.fill(0);
+            if(part == "-") continue;
+            size_t i = 0;
+            while(i < part.size()) {
+                pieceType type = pieceFromSymbol(part[i]);
+                int idx = static_cast<int>(pieceTypeToPocketIndex(type));
+                if(idx < 0 || idx >= POCKET_SIZE) return false;
+                i++;
+                int count = 1;
+                if(i < part.size() && std::isdigit(static_cast<unsigned char>(part[i]))) {
+                    if(!parseInt(part, i, count)) return false;
+                }
+                pocket[idx] = count;
+            }
+        }
+    }
+
+    // 4) 턴 상태
+    bool stagedPerformed = false;
+    int activeFile = -1, activeRank = -1;
+    std::string_view stateField = nextField(text, pos);
+    if(!stateField.empty() && stateField != "-") {
+        stagedPerformed = true;
+        if(stateField != "+") {
+            if(stateField.size() != 2) return false;
+            activeFile = stateField[0] - 'a';
+            activeRank = stateField[1] - '1';
+            if(!isValidPosition(activeFile, activeRank)) return false;
+        }
+    }
+
+    // 5) 수 카운트 (생략 시 차례에서 유도)
+    int stagedWhiteCount = 1, stagedBlackCount = 1;
+    if(side == colorType::BLACK) stagedWhiteCount = 2;
+    skipSpaces(text, pos);
+    if(pos < text.size()) {
+        if(!parseInt(text, pos, stagedWhiteCount) || stagedWhiteCount < 0) return false;
+        skipSpaces(text, pos);
+        if(!parseInt(text, pos, stagedBlackCount) || stagedBlackCount < 0) return false;
+        const colorType countSide = (stagedWhiteCount == stagedBlackCount) ? colorType::WHITE : colorType::BLACK;
+        if(countSide != side) return false;
+    }
+    skipSpaces(text, pos);
+    if(pos != text.size()) return false;
+
+    // 이번 턴에 행동한 칸에는 기물이 있어야 한다 (스턴 부여 대상은 상대 기물일 수 있다)
+    if(activeFile >= 0) {
+        bool activeFound = false;
+        for(int i = 0; i < stagedCount && !activeFound; ++i) {
+            activeFound = (staged[i].file == activeFile && staged[i].rank == activeRank);
+        }
+        if(!activeFound) return false;
+    }
+
+    // 검증 완료: 보드에 반영
+    clearBoard();
+    whitePocket = stagedWhitePocket;
+    blackPocket = stagedBlackPocket;
+    whiteMoveCount = stagedWhiteCount;
+    blackMoveCount = stagedBlackCount;
+
+    for(int i = 0; i < stagedCount; ++i) {
+        const stagedPiece& sp = staged[i];
+        pieces.emplace_back(sp.type, sp.color, sp.file, sp.rank, pieces.size(), *this, lanes);
+        piece* p = &pieces.back();
+        p->setStun(sp.stun);
+        p->setMoveStack(sp.move);
+        p->setRoyal(sp.royal);
+        p->setSecretRoyal(sp.secret);
+        p->setRoyalCandidate(sp.candidate);
+        p->setDisguisedAs(sp.disguise);
+        setupPiecePatterns(p);
+        board[sp.file][sp.rank] = p;
+    }
+
+    performedActionThisTurn = stagedPerformed;
+    activePieceThisTurn = (activeFile >= 0) ? board[activeFile][activeRank] : nullptr;
+
+    updateAllLegalMoves();
+    return true;
+}
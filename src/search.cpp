@@ -0,0 +1,230 @@
+#include <search.hpp>
+#include <gameboard.hpp>
+#include <threadpool.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+inline colorType opponentOf(colorType c) {
+    return (c == colorType::WHITE) ? colorType::BLACK : colorType::WHITE;
+}
+
+// 첫 턴 이후 로얄 피스가 없는 편이 패배 (둘 차례 기준 값)
+bool terminalValue(const bc_board& board, float& value) {
+    if(board.getWhiteMoveCount() + board.getBlackMoveCount() < 2) return false;
+    const colorType mover = board.currentPlayerColor();
+    const bool own = board.hasRoyalPiece(mover);
+    const bool other = board.hasRoyalPiece(opponentOf(mover));
+    if(own && other) return false;
+    value = (own == other) ? 0.0f : (own ? 1.0f : -1.0f);
+    return true;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- 트리
+
+void searchTree::reset(const bc_board& position, const searchConfig& cfg) {
+    config = &cfg;
+    position.encodePacked(root);
+    nodes.assign(1, node{});
+    nodes[0].mover = position.currentPlayerColor();
+    pending.clear();
+    leafBatch.clear();
+    batchOffset = 0;
+    terminalLeaves = 0;
+}
+
+bool searchTree::finished() const {
+    return pending.empty() && nodes[0].visits >= config->simulations;
+}
+
+int searchTree::selectChild(int parent) const {
+    const node& p = nodes[parent];
+    const float scale = config->cPuct * std::sqrt(static_cast<float>(std::max(1, p.visits + p.pendingVisits)));
+    int best = p.firstChild;
+    float bestScore = -1e30f;
+    for(int c = p.firstChild; c < p.firstChild + p.childCount; ++c) {
+        const node& child = nodes[c];
+        const int n = child.visits + child.pendingVisits;
+        const float q = (n > 0) ? (child.valueSum - config->virtualLoss * child.pendingVisits) / static_cast<float>(n) : 0.0f;
+        const float score = q + scale * child.prior / static_cast<float>(1 + n);
+        if(score > bestScore) {
+            bestScore = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+// value는 valueSide 기준. 각 노드에는 부모(루트는 자신)의 둘 차례 기준으로 더한다
+void searchTree::backup(int leaf, float value, colorType valueSide, bool releaseVirtualLoss) {
+    for(int n = leaf; n >= 0; n = nodes[n].parent) {
+        node& cur = nodes[n];
+        const colorType chooser = (cur.parent >= 0) ? nodes[cur.parent].mover : cur.mover;
+        cur.visits++;
+        cur.valueSum += (chooser == valueSide) ? value : -value;
+        if(releaseVirtualLoss) cur.pendingVisits--;
+    }
+}
+
+void searchTree::expand(int leaf, const pendingLeaf& info, const float* logits) {
+    policyPriors(logits, info.indices, priors);
+    const int first = static_cast<int>(nodes.size());
+    for(size_t i = 0; i < info.actions.size(); ++i) {
+        node child;
+        child.action = info.actions[i];
+        child.parent = leaf;
+        child.prior = priors[i];
+        nodes.push_back(child);
+    }
+    nodes[leaf].firstChild = first;
+    nodes[leaf].childCount = static_cast<int>(info.actions.size());
+    nodes[leaf].expanded = true;
+}
+
+void searchTree::resume(const policyWorkspace* results) {
+    if(results != nullptr) {
+        for(size_t i = 0; i < pending.size(); ++i) {
+            const pendingLeaf& info = pending[i];
+            expand(info.nodeIndex, info, results->logitsOf(batchOffset + i));
+            nodes[info.nodeIndex].pending = false;
+            backup(info.nodeIndex, results->values[batchOffset + i], nodes[info.nodeIndex].mover, true);
+        }
+    }
+    pending.clear();
+    leafBatch.clear();
+
+    bc_board board;
+    const size_t limit = static_cast<size_t>(std::max(1, config->leavesPerTree));
+    while(pending.size() < limit && nodes[0].visits + nodes[0].pendingVisits < config->simulations) {
+        board.decodePacked(root);
+        int cur = 0;
+        while(nodes[cur].expanded && nodes[cur].childCount > 0) {
+            cur = selectChild(cur);
+            board.applyAction(nodes[cur].action);
+            nodes[cur].mover = board.currentPlayerColor();
+        }
+        if(nodes[cur].pending) break; // 가상 손실로도 같은 리프로 모이면 이번 라운드는 여기까지
+
+        float value = 0.0f;
+        if(terminalValue(board, value)) {
+            backup(cur, value, nodes[cur].mover, false);
+            terminalLeaves++;
+            continue;
+        }
+
+        pendingLeaf info{cur, {}, {}};
+        board.collectLegalActions(info.actions);
+        info.indices.reserve(info.actions.size());
+        for(const auto& a : info.actions) info.indices.push_back(policyIndex(a, nodes[cur].mover));
+        nodes[cur].pending = true;
+        for(int n = cur; n >= 0; n = nodes[n].parent) nodes[n].pendingVisits++;
+        leafBatch.add(board);
+        pending.push_back(std::move(info));
+    }
+}
+
+searchResult searchTree::result() const {
+    searchResult out;
+    const node& r = nodes[0];
+    out.rootVisits = r.visits;
+    out.value = (r.visits > 0) ? r.valueSum / static_cast<float>(r.visits) : 0.0f;
+    int best = -1;
+    for(int c = r.firstChild; c < r.firstChild + r.childCount; ++c) {
+        out.visits.emplace_back(policyIndex(nodes[c].action, r.mover), nodes[c].visits);
+        if(best < 0 || nodes[c].visits > nodes[best].visits) best = c;
+    }
+    if(best >= 0) out.best = nodes[best].action;
+    return out;
+}
+
+// ---------------------------------------------------------------- 배치 구동
+
+batchedSearch::batchedSearch(const searchConfig& cfg) : config(cfg), pool(std::make_unique<threadPool>(cfg.threads)) {}
+
+batchedSearch::~batchedSearch() = default;
+
+bool batchedSearch::run(const std::vector<const bc_board*>& roots, const leafEvaluator& evaluate) {
+    using clock = std::chrono::steady_clock;
+    const auto started = clock::now();
+    lastStats = searchStats{};
+    trees.assign(roots.size(), searchTree{});
+    for(size_t i = 0; i < roots.size(); ++i) trees[i].reset(*roots[i], config);
+
+    struct treeGroup {
+        size_t begin = 0, end = 0;
+        policyBatch batch;
+        policyWorkspace work;
+        bool evaluated = false;
+    };
+    std::array<treeGroup, 2> groups;
+    const size_t split = (config.overlap && trees.size() > 1) ? trees.size() / 2 : trees.size();
+    groups[0].end = split;
+    groups[1].begin = split;
+    groups[1].end = trees.size();
+
+    auto resumeGroup = [&](treeGroup& g) {
+        const policyWorkspace* results = g.evaluated ? &g.work : nullptr;
+        g.evaluated = false;
+        for(size_t i = g.begin; i < g.end; ++i) pool->submit([this, i, results] {
+            BC_TRACE_SCOPE("resume tree", "search");
+            trees[i].resume(results);
+        });
+    };
+    auto gather = [&](treeGroup& g) {
+        g.batch.clear();
+        for(size_t i = g.begin; i < g.end; ++i) {
+            const policyBatch& leaves = trees[i].leaves();
+            trees[i].setBatchOffset(g.batch.size());
+            for(size_t k = 0; k < leaves.size(); ++k) g.batch.addFeatures(leaves.featuresOf(k), leaves.featureCount(k));
+            lastStats.terminalLeaves += trees[i].takeTerminalCount();
+        }
+    };
+    // 평가기 출력 크기가 배치와 맞는지
+    auto evaluateGroup = [&](treeGroup& g) {
+        if(g.batch.size() == 0) return true;
+        BC_TRACE_SCOPE("evaluate batch", "search");
+        const auto t0 = clock::now();
+        evaluate(g.batch, g.work);
+        lastStats.evaluatorSeconds += std::chrono::duration<double>(clock::now() - t0).count();
+        const size_t n = g.batch.size();
+        if(g.work.values.size() < n || g.work.logitStride < static_cast<size_t>(POLICY_ACTIONS) ||
+           g.work.logits.size() < (n - 1) * g.work.logitStride + POLICY_ACTIONS) {
+            return false;
+        }
+        lastStats.batches++;
+        lastStats.leaves += n;
+        lastStats.largestBatch = std::max(lastStats.largestBatch, n);
+        g.evaluated = true;
+        return true;
+    };
+
+    resumeGroup(groups[0]);
+    pool->wait();
+    gather(groups[0]);
+    bool ok = true;
+    for(int cur = 0; ok; cur = 1 - cur) {
+        treeGroup& evaluating = groups[cur];
+        treeGroup& resuming = groups[1 - cur];
+        resumeGroup(resuming); // 이 그룹의 역전파/선택은 평가와 겹쳐 워커에서 진행
+        try {
+            ok = evaluateGroup(evaluating);
+        } catch(...) {
+            pool->wait(); // 워커가 트리를 건드리는 중에 되감지 않는다
+            throw;
+        }
+        pool->wait();
+        gather(resuming);
+        if(evaluating.batch.size() == 0 && resuming.batch.size() == 0) break;
+    }
+    lastStats.totalSeconds = std::chrono::duration<double>(clock::now() - started).count();
+    return ok;
+}
+
+leafEvaluator networkEvaluator(const policyNetwork& network) {
+    return [&network](const policyBatch& batch, policyWorkspace& out) { network.forward(batch, out); };
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <action.hpp>
+#include <packed.hpp>
+#include <policy.hpp>
+
+class bc_board;
+class threadPool;
+
+/* 리프 배치 탐색 (search.cpp)
+   여러 트리(게임)를 동시에 PUCT 탐색하면서 평가가 필요한 리프를 모아 평가기를 배치 하나에 한 번만 부른다.
+   트리마다 "역전파 -> 다음 리프 선택 -> 평가 대기"를 반복하는 재개형 작업이고,
+   트리를 두 그룹으로 나눠 한 그룹의 배치를 평가하는 동안(호출 스레드, 예: GIL을 쥔 Python 콜백)
+   다른 그룹은 스레드 풀에서 역전파/선택을 진행한다.
+   한 트리 안에서는 가상 손실로 경로를 흩어 라운드마다 리프를 최대 leavesPerTree개 모은다.
+
+   값은 모두 노드에서 둘 차례 기준 (-1..1). 한 턴에 여러 액션을 하므로 부모와 자식의 둘 차례가 같을 수 있다.
+   종료: 첫 턴 이후(양쪽 수 카운트 합 >= 2) 로얄 피스가 없는 편이 패배.
+*/
+struct searchConfig {
+    int simulations = 256;      // 트리마다 역전파 횟수
+    int leavesPerTree = 8;      // 한 라운드에 트리에서 모으는 최대 리프 수
+    float cPuct = 1.5f;
+    float virtualLoss = 1.0f;   // 평가 대기 중인 경로에 더하는 패배 횟수
+    unsigned threads = 0;       // 0이면 hardware_concurrency
+    bool overlap = true;        // 두 그룹 겹쳐 실행 (false면 모든 트리를 한 배치로)
+};
+
+// 리프 평가기: batch의 포지션마다 로짓(out.logitsOf(i)[0..POLICY_ACTIONS))과 가치(out.values[i])를 채운다
+using leafEvaluator = std::function<void(const policyBatch& batch, policyWorkspace& out)>;
+
+struct searchStats {
+    size_t batches = 0;
+    size_t leaves = 0;           // 평가기로 보낸 리프 수
+    size_t terminalLeaves = 0;   // 평가 없이 끝난 리프 수
+    size_t largestBatch = 0;
+    double evaluatorSeconds = 0.0;
+    double totalSeconds = 0.0;
+};
+
+struct searchResult {
+    boardAction best;                          // 방문 수가 가장 많은 루트 액션
+    std::vector<std::pair<int, int>> visits;   // (policyIndex, 방문 수), 루트 합법 액션 순서
+    float value = 0.0f;                        // 루트 평균 가치 (둘 차례 기준)
+    int rootVisits = 0;
+};
+
+class searchTree {
+    private:
+        struct node {
+            boardAction action;       // 부모에서 이 노드로 온 액션
+            int parent = -1;
+            int firstChild = -1;
+            int childCount = 0;
+            float prior = 0.0f;
+            int visits = 0;
+            int pendingVisits = 0;    // 가상 손실
+            float valueSum = 0.0f;    // 부모의 둘 차례 기준
+            colorType mover = colorType::WHITE;
+            bool expanded = false;
+            bool pending = false;     // 평가 대기 중인 리프
+        };
+        struct pendingLeaf {
+            int nodeIndex;
+            std::vector<boardAction> actions;
+            std::vector<int> indices;   // actions의 policyIndex
+        };
+
+        const searchConfig* config = nullptr;
+        packedPosition root{};
+        std::vector<node> nodes;
+        std::vector<pendingLeaf> pending;
+        policyBatch leafBatch;          // pending 순서
+        size_t batchOffset = 0;         // 그룹 배치 안에서의 시작 위치
+        size_t terminalLeaves = 0;
+        std::vector<float> priors;      // expand 작업 버퍼
+
+        int selectChild(int parent) const;
+        void backup(int leaf, float value, colorType valueSide, bool releaseVirtualLoss);
+        void expand(int leaf, const pendingLeaf& info, const float* logits);
+
+    public:
+        void reset(const bc_board& position, const searchConfig& cfg);
+        bool finished() const;
+
+        // 재개: 지난 라운드 결과(없으면 nullptr)를 역전파하고 다음 리프를 모은다
+        void resume(const policyWorkspace* results);
+        const policyBatch& leaves() const { return leafBatch; }
+        void setBatchOffset(size_t offset) { batchOffset = offset; }
+        size_t takeTerminalCount() { const size_t n = terminalLeaves; terminalLeaves = 0; return n; }
+
+        searchResult result() const;
+};
+
+class batchedSearch {
+    private:
+        searchConfig config;
+        std::vector<searchTree> trees;
+        std::unique_ptr<threadPool> pool;
+        searchStats lastStats;
+
+    public:
+        explicit batchedSearch(const searchConfig& cfg = searchConfig());
+        ~batchedSearch();
+        batchedSearch(const batchedSearch&) = delete;
+        batchedSearch& operator=(const batchedSearch&) = delete;
+
+        const searchConfig& getConfig() const { return config; }
+
+        // 포지션마다 트리 하나. evaluate는 호출 스레드에서만 불린다 (예외는 워커를 멈춘 뒤 그대로 전달)
+        bool run(const std::vector<const bc_board*>& roots, const leafEvaluator& evaluate); // 평가기 출력 크기가 배치와 다르면 false
+        size_t treeCount() const { return trees.size(); }
+        searchResult result(size_t tree) const { return trees[tree].result(); }
+        const searchStats& stats() const { return lastStats; }
+};
+
+// policyNetwork를 평가기로 쓰는 어댑터 (네트워크는 탐색보다 오래 유지)
+leafEvaluator networkEvaluator(const policyNetwork& network);
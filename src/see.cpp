@@ -0,0 +1,155 @@
+#include <gameboard.hpp>
+#include <algorithm>
+
+namespace {
+
+inline uint64_t bitOf(int square) { return uint64_t(1) << square; }
+inline int sideOf(colorType c) { return (c == colorType::WHITE) ? 0 : 1; }
+
+// 교환에 참여할 수 있는 기물 (스턴이 아니고 이동 스택이 있음)
+struct exchanger {
+    const piece* p;
+    int square;
+    int side;
+    uint64_t attacks;
+    uint64_t scanned;
+    bool used;
+};
+
+// 지금 목표 칸에 있는 기물 (이어받은 스택 포함)
+struct occupant {
+    pieceType type;
+    int stun;
+    int move;
+    bool royal;
+    int side;
+};
+
+// 목표 칸의 기물을 잡는 방식: 2 = 내려앉아 잡음, 1 = 뛰어넘으며 잡음(TAKEJUMP), 0 = 잡을 수 없음
+int captureKind(const piece& p, int square, int target, uint64_t own, uint64_t enemy) {
+    int kind = 0;
+    for(const auto& pattern : p.getMovePatterns()) {
+        pattern.forEachTarget(squareFile(square), squareRank(square), own, enemy, [&](int to, uint64_t captured) {
+            if(captured & bitOf(target)) kind = std::max(kind, to == target ? 2 : 1);
+        });
+    }
+    return kind;
+}
+
+} // namespace
+
+// from -> to 이동(또는 잡기) 뒤 to에서 벌어지는 교환의 기대 이득 (이동하는 편 기준, see.hpp 단위)
+int bc_board::staticExchange(int fromFile, int fromRank, int toFile, int toRank) const {
+    BC_STAT_TIMER(STATIC_EXCHANGE);
+    BC_TRACE_METHOD(STATIC_EXCHANGE);
+    const piece* mover = getPieceAt(fromFile, fromRank);
+    if(mover == nullptr || !isValidPosition(toFile, toRank)) return 0;
+    const piece* victim = getPieceAt(toFile, toRank);
+    if(victim != nullptr && victim->getColor() == mover->getColor()) return 0;
+
+    const int target = squareOf(toFile, toRank);
+    const int from = squareOf(fromFile, fromRank);
+    std::array<uint64_t, 2> occ{};
+    std::array<int, 2> count{};
+    std::vector<exchanger> exchangers;
+    exchangers.reserve(pieces.size());
+    for(const auto& p : pieces) {
+        const int sq = squareOf(p.getFile(), p.getRank());
+        const int side = sideOf(p.getColor());
+        occ[side] |= bitOf(sq);
+        count[side]++;
+        if(&p == mover || p.isStunned() || p.getMoveStack() <= 0) continue;
+        exchangers.push_back({&p, sq, side, p.getAttackMask(), p.getScanMask(), false});
+    }
+
+    auto gainOf = [&count](const occupant& o) {
+        int g = SEE_PIECE_SCALE * materialValue(o.type) + SEE_MOVE_STACK_VALUE * std::max(0, o.move) - SEE_STUN_COST * o.stun;
+        if(o.royal) g += SEE_STUN_COST * SEE_ROYAL_STUN * count[o.side];
+        return g;
+    };
+
+    // 칸 점유가 바뀌면 그 칸을 확인했던 기물의 공격 칸을 다시 계산 (뒤에 숨어 있던 기물이 드러남)
+    auto refresh = [&](uint64_t changed) {
+        for(auto& e : exchangers) {
+            if(e.used || (e.scanned & changed) == 0) continue;
+            e.attacks = 0;
+            e.scanned = 0;
+            for(const auto& pattern : e.p->getMovePatterns()) {
+                e.attacks |= pattern.attackMask(squareFile(e.square), squareRank(e.square), occ[e.side], occ[1 - e.side], e.scanned);
+            }
+        }
+    };
+
+    std::array<int, 66> gains{};
+    int depth = 0;
+    int side = sideOf(mover->getColor());
+    uint64_t vacated = bitOf(from);
+    occ[side] &= ~bitOf(from);
+
+    // 첫 수: movePiece가 고르는 이동이 TAKEJUMP면 함께 잡히는 기물도 이득에 넣는다
+    const int jsq = mover->getJumpedSquare(squareOf(toFile, toRank));
+    const piece* jumped = (jsq >= 0) ? getPieceAt(squareFile(jsq), squareRank(jsq)) : nullptr;
+    if(jumped != nullptr) {
+        gains[0] += gainOf({jumped->getPieceType(), jumped->getStunStack(), jumped->getMoveStack(), jumped->isRoyal(), 1 - side});
+        if(jumped->isRoyal()) return gains[0];
+        occ[1 - side] &= ~bitOf(jsq);
+        count[1 - side]--;
+        vacated |= bitOf(jsq);
+        for(auto& e : exchangers) e.used = e.used || e.square == jsq;
+    }
+
+    occupant current{mover->getPieceType(), mover->getStunStack(), mover->getMoveStack() - 1, mover->isRoyal(), side};
+    if(victim != nullptr) {
+        const occupant captured{victim->getPieceType(), victim->getStunStack(), victim->getMoveStack(), victim->isRoyal(), 1 - side};
+        gains[0] += gainOf(captured);
+        if(captured.royal) return gains[0]; // 상대 전체 스턴: 되잡기 없음
+        count[1 - side]--;
+        current.stun += captured.stun;
+        current.move += captured.move;
+        for(auto& e : exchangers) e.used = e.used || e.square == target;
+    }
+    occ[1 - side] &= ~bitOf(target);
+    occ[side] |= bitOf(target);
+    refresh(vacated | bitOf(target));
+    depth = 1;
+    side = 1 - side;
+
+    while(depth < static_cast<int>(gains.size()) - 1) {
+        // 가장 싼 되잡기 기물 (내려앉는 기물 우선, 없으면 뛰어넘는 기물로 마지막 잡기)
+        exchanger* best = nullptr;
+        int bestKind = 0;
+        for(auto& e : exchangers) {
+            if(e.used || e.side != side || (e.attacks & bitOf(target)) == 0) continue;
+            const int kind = captureKind(*e.p, e.square, target, occ[side], occ[1 - side]);
+            if(kind == 0) continue;
+            if(best == nullptr || kind > bestKind ||
+               (kind == bestKind && materialValue(e.p->getPieceType()) < materialValue(best->p->getPieceType()))) {
+                best = &e;
+                bestKind = kind;
+            }
+        }
+        if(best == nullptr) break;
+
+        gains[depth] = gainOf(current) - gains[depth - 1];
+        count[current.side]--;
+        depth++;
+        if(current.royal || bestKind != 2) break;
+
+        best->used = true;
+        current = {best->p->getPieceType(), best->p->getStunStack() + current.stun,
+                   best->p->getMoveStack() - 1 + current.move, best->p->isRoyal(), side};
+        occ[side] &= ~bitOf(best->square);
+        occ[1 - side] &= ~bitOf(target);
+        occ[side] |= bitOf(target);
+        refresh(bitOf(best->square) | bitOf(target));
+        side = 1 - side;
+    }
+
+    // 각 단계에서 잡지 않고 멈출 수 있다
+    while(--depth > 0) gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+    return gains[0];
+}
+
+bool bc_board::staticExchangeAtLeast(int fromFile, int fromRank, int toFile, int toRank, int threshold) const {
+    return staticExchange(fromFile, fromRank, toFile, toRank) >= threshold;
+}
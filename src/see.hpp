@@ -0,0 +1,16 @@
+#pragma once
+
+/* 정적 교환 평가 (SEE, see.cpp)
+   한 칸에서 벌어지는 잡고 되잡기를 양쪽이 가장 싼 기물부터 쓰는 것으로 가정해 순서대로 시뮬레이션한다.
+   chesstack 규칙을 반영한다.
+     - 잡은 기물은 잡힌 기물의 스턴/이동 스택을 그대로 이어받는다 (잡을수록 칸 위 기물에 스택이 쌓임)
+     - 되잡을 수 있는 기물은 지금 스턴이 아니고 이동 스택이 있는 기물뿐
+     - 로얄 피스를 잡으면 그 편 모든 기물이 스턴 +3 -> 더 이상 되잡을 수 없고 교환이 끝난다
+     - 칸을 뛰어넘어 잡는 기물(TAKEJUMP)은 칸에 남지 않으므로 마지막 잡기로만 쓴다
+   값 단위: 기물 가치(materialValue) 1 = SEE_PIECE_SCALE.
+   잡기 한 번의 이득 = 잡힌 기물 가치 + 이어받는 이동 스택 가치 - 이어받는 스턴 비용 (+ 로얄이면 상대 전체 스턴 가치)
+*/
+inline constexpr int SEE_PIECE_SCALE = 100;
+inline constexpr int SEE_STUN_COST = 25;         // 이어받은 스턴 스택 1 (한 턴 묶임)
+inline constexpr int SEE_MOVE_STACK_VALUE = 10;  // 이어받은 이동 스택 1
+inline constexpr int SEE_ROYAL_STUN = 3;         // 로얄 피스가 잡힐 때 같은 편 전체에 더해지는 스턴
@@ -0,0 +1,42 @@
+#include <simd.hpp>
+
+#ifdef BC_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+namespace {
+
+// AVX 레지스터 저장을 OS가 지원하는지 (XSAVE + YMM 상태)
+bool osSavesYmm() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+}
+
+} // namespace
+
+bool cpuHasSse41() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+}
+
+bool cpuHasAvx2() {
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return osSavesYmm() && (info[1] & (1 << 5)) != 0;
+}
+
+bool cpuHasFma() {
+    int info[4];
+    __cpuid(info, 1);
+    return osSavesYmm() && (info[2] & (1 << 12)) != 0;
+}
+#else
+bool cpuHasSse41() { return __builtin_cpu_supports("sse4.1"); }
+bool cpuHasAvx2() { return __builtin_cpu_supports("avx2"); }
+bool cpuHasFma() { return __builtin_cpu_supports("fma"); }
+#endif
+#else
+bool cpuHasSse41() { return false; }
+bool cpuHasAvx2() { return false; }
+bool cpuHasFma() { return false; }
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+
+/* SIMD 공통 (nnue.cpp, policy.cpp)
+   전역 -march 플래그 없이 커널 함수마다 대상 명령어를 지정(BC_SIMD_TARGET)하고,
+   실행 중인 CPU를 확인해 커널을 고른다. x86이 아니면 스칼라 커널만 쓴다.
+*/
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BC_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BC_SIMD_TARGET(isa)
+#else
+#define BC_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+bool cpuHasSse41();
+bool cpuHasAvx2();
+bool cpuHasFma();
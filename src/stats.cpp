@@ -0,0 +1,88 @@
+#include <stats.hpp>
+#include <cstdlib>
+#include <new>
+
+namespace engineStatsDetail {
+
+std::array<std::atomic<uint64_t>, SLOT_COUNT> slots{};
+
+} // namespace engineStatsDetail
+
+#if BC_ENABLE_STATS
+// 할당 횟수: 계측 빌드에서만 전역 operator new를 바꾼다 (이 빌드의 모든 할당을 센다)
+void* operator new(std::size_t size) {
+    engineStatsDetail::add(engineStatsDetail::ALLOCATIONS, 1);
+    if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+engineStats readEngineStats() {
+    using namespace engineStatsDetail;
+    engineStats out;
+    if(!ENGINE_STATS_ENABLED) return out;
+    auto read = [](int index) { return slots[static_cast<size_t>(index)].load(std::memory_order_relaxed); };
+    out.legalMoveRecomputes = read(LEGAL_MOVE_RECOMPUTES);
+    out.piecesRegenerated = read(PIECES_REGENERATED);
+    out.legalMoveLists = read(LEGAL_MOVE_LISTS);
+    out.actions = read(ACTIONS);
+    out.allocations = read(ALLOCATIONS);
+    out.captures = read(CAPTURES);
+    out.stunTicks = read(STUN_TICKS);
+    for(int i = 0; i < PATTERN_KIND_COUNT; ++i) out.movesByPattern[static_cast<size_t>(i)] = read(MOVES_BY_PATTERN + i);
+    for(int i = 0; i < BOARD_METHOD_COUNT; ++i) {
+        out.methodCalls[static_cast<size_t>(i)] = read(METHOD_CALLS + i);
+        out.methodNanos[static_cast<size_t>(i)] = read(METHOD_NANOS + i);
+    }
+    return out;
+}
+
+void resetEngineStats() {
+    for(auto& s : engineStatsDetail::slots) s.store(0, std::memory_order_relaxed);
+}
+
+const char* boardMethodName(boardMethod method) {
+    switch(method) {
+        case boardMethod::PLACE_PIECE:               return "placePiece";
+        case boardMethod::MOVE_PIECE:                return "movePiece";
+        case boardMethod::REMOVE_PIECE:              return "removePiece";
+        case boardMethod::PASS_AND_ADD_STUN:         return "passAndAddStun";
+        case boardMethod::PROMOTE:                   return "promote";
+        case boardMethod::DISGUISE_PIECE:            return "disguisePiece";
+        case boardMethod::SUCCEED_ROYAL_PIECE:       return "succeedRoyalPiece";
+        case boardMethod::NEXT_TURN:                 return "nextTurn";
+        case boardMethod::APPLY_ACTION:              return "applyAction";
+        case boardMethod::APPLY_ACTIONS:             return "applyActions";
+        case boardMethod::COLLECT_LEGAL_ACTIONS:     return "collectLegalActions";
+        case boardMethod::UPDATE_ALL_LEGAL_MOVES:    return "updateAllLegalMoves";
+        case boardMethod::SETUP_POSITION:            return "setupPosition";
+        case boardMethod::LOAD_POSITION_STRING:      return "loadPositionString";
+        case boardMethod::GET_POSITION_STRING:       return "getPositionString";
+        case boardMethod::GET_BOARD_AS_FEN:          return "getBoardAsFEN";
+        case boardMethod::ENCODE_PACKED:             return "encodePacked";
+        case boardMethod::DECODE_PACKED:             return "decodePacked";
+        case boardMethod::OBSERVE:                   return "observe";
+        case boardMethod::RESOLVE_NOTATION:          return "resolveNotation";
+        case boardMethod::APPLY_NOTATION:            return "applyNotation";
+        case boardMethod::REPLAY_NOTATION:           return "replayNotation";
+        case boardMethod::STATIC_EXCHANGE:           return "staticExchange";
+        case boardMethod::EVALUATE:                  return "evaluate";
+        case boardMethod::EVALUATE_NEURAL:           return "evaluateNeural";
+        case boardMethod::IS_ROYAL_PIECE_CHECKMATED: return "isRoyalPieceCheckmated";
+        case boardMethod::COUNT:                     break;
+    }
+    return "unknown";
+}
+
+const char* patternKindName(int kind) {
+    static const char* const names[PATTERN_KIND_COUNT] = {
+        "RAY_INFINITE/CATCH", "RAY_INFINITE/TAKE", "RAY_INFINITE/MOVE", "RAY_INFINITE/TAKEMOVE", "RAY_INFINITE/TAKEJUMP", "RAY_INFINITE/MOVEJUMP",
+        "RAY_FINITE/CATCH",   "RAY_FINITE/TAKE",   "RAY_FINITE/MOVE",   "RAY_FINITE/TAKEMOVE",   "RAY_FINITE/TAKEJUMP",   "RAY_FINITE/MOVEJUMP",
+    };
+    return (kind >= 0 && kind < PATTERN_KIND_COUNT) ? names[kind] : "unknown";
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <enum.hpp>
+
+// 엔진 계측 카운터/타이머.
+// BC_ENABLE_STATS=1로 빌드했을 때만 BC_STAT_* 호출이 남으며, 기본값(0)에서는 인자 평가를 포함해
+// 전부 컴파일 타임에 제거되고 readEngineStats()는 0만 돌려준다.
+// 값은 프로세스 전체 합계다 (모든 보드/스레드, relaxed 원자 연산으로 더함).
+#ifndef BC_ENABLE_STATS
+#define BC_ENABLE_STATS 0
+#endif
+
+#if BC_ENABLE_STATS
+#include <chrono>
+#endif
+
+inline constexpr bool ENGINE_STATS_ENABLED = BC_ENABLE_STATS != 0;
+
+// 시간을 재는 bc_board 공개 메서드 (인라인 getter 제외). 중첩 호출은 각자 포함 시간으로 잰다
+// (예: applyAction 시간에 movePiece 시간이 들어 있다)
+enum class boardMethod : uint8_t {
+    PLACE_PIECE,
+    MOVE_PIECE,
+    REMOVE_PIECE,
+    PASS_AND_ADD_STUN,
+    PROMOTE,
+    DISGUISE_PIECE,
+    SUCCEED_ROYAL_PIECE,
+    NEXT_TURN,
+    APPLY_ACTION,
+    APPLY_ACTIONS,
+    COLLECT_LEGAL_ACTIONS,
+    UPDATE_ALL_LEGAL_MOVES,
+    SETUP_POSITION,
+    LOAD_POSITION_STRING,
+    GET_POSITION_STRING,
+    GET_BOARD_AS_FEN,
+    ENCODE_PACKED,
+    DECODE_PACKED,
+    OBSERVE,
+    RESOLVE_NOTATION,
+    APPLY_NOTATION,
+    REPLAY_NOTATION,
+    STATIC_EXCHANGE,
+    EVALUATE,
+    EVALUATE_NEURAL,
+    IS_ROYAL_PIECE_CHECKMATED,
+    COUNT
+};
+
+inline constexpr int BOARD_METHOD_COUNT = static_cast<int>(boardMethod::COUNT);
+inline constexpr int THREAT_TYPE_COUNT = 6;                       // CATCH..MOVEJUMP
+inline constexpr int PATTERN_KIND_COUNT = 2 * THREAT_TYPE_COUNT;  // moveType x threatType
+
+struct engineStats {
+    uint64_t legalMoveRecomputes = 0; // 합법수 재계산 (updateAllLegalMoves + 액션마다의 증분 재계산) 횟수
+    uint64_t piecesRegenerated = 0;   // 공격/확인 칸을 다시 계산한 기물 수
+    uint64_t legalMoveLists = 0;      // 조회 때문에 실제로 만든 합법 이동 목록 수 (지연 생성)
+    uint64_t actions = 0;             // 받아들여진 액션 수 (착수/이동/스턴/프로모션/변장/계승/턴 종료)
+    uint64_t allocations = 0;         // 전역 operator new 호출 수
+    uint64_t captures = 0;            // 잡힌 기물 수 (TAKEJUMP로 뛰어넘어 잡은 기물 포함)
+    uint64_t stunTicks = 0;           // 스턴 스택이 1 줄어든 횟수
+    std::array<uint64_t, PATTERN_KIND_COUNT> movesByPattern{}; // [moveType * 6 + threatType] 생성한 이동 수
+    std::array<uint64_t, BOARD_METHOD_COUNT> methodCalls{};
+    std::array<uint64_t, BOARD_METHOD_COUNT> methodNanos{};
+
+    double piecesPerAction() const { return actions ? static_cast<double>(piecesRegenerated) / static_cast<double>(actions) : 0.0; }
+};
+
+engineStats readEngineStats(); // 꺼진 빌드에서는 항상 0
+void resetEngineStats();
+const char* boardMethodName(boardMethod method); // 예: "movePiece"
+const char* patternKindName(int kind);           // 예: "RAY_FINITE/TAKEMOVE"
+
+inline int patternKind(moveType m, threatType t) {
+    return static_cast<int>(m) * THREAT_TYPE_COUNT + static_cast<int>(t);
+}
+
+namespace engineStatsDetail {
+
+// 카운터 칸: 스칼라 7개, 패턴별 이동 수, 메서드별 호출 수, 메서드별 시간
+enum slot : int {
+    LEGAL_MOVE_RECOMPUTES,
+    PIECES_REGENERATED,
+    LEGAL_MOVE_LISTS,
+    ACTIONS,
+    ALLOCATIONS,
+    CAPTURES,
+    STUN_TICKS,
+    MOVES_BY_PATTERN,
+    METHOD_CALLS = MOVES_BY_PATTERN + PATTERN_KIND_COUNT,
+    METHOD_NANOS = METHOD_CALLS + BOARD_METHOD_COUNT,
+    SLOT_COUNT = METHOD_NANOS + BOARD_METHOD_COUNT
+};
+
+extern std::array<std::atomic<uint64_t>, SLOT_COUNT> slots;
+
+inline void add(int index, uint64_t n) {
+    slots[static_cast<std::size_t>(index)].fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void addMoves(moveType m, threatType t, uint64_t n) {
+    if(m == moveType::NONE || t == threatType::NONE) return;
+    add(MOVES_BY_PATTERN + patternKind(m, t), n);
+}
+
+#if BC_ENABLE_STATS
+class methodTimer {
+    private:
+        boardMethod method;
+        std::chrono::steady_clock::time_point started;
+
+    public:
+        explicit methodTimer(boardMethod m) : method(m), started(std::chrono::steady_clock::now()) {}
+        ~methodTimer() {
+            const auto elapsed = std::chrono::steady_clock::now() - started;
+            add(METHOD_CALLS + static_cast<int>(method), 1);
+            add(METHOD_NANOS + static_cast<int>(method),
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+        methodTimer(const methodTimer&) = delete;
+        methodTimer& operator=(const methodTimer&) = delete;
+};
+#endif
+
+} // namespace engineStatsDetail
+
+#if BC_ENABLE_STATS
+#define BC_STAT_ADD(name, n) engineStatsDetail::add(engineStatsDetail::name, static_cast<uint64_t>(n))
+#define BC_STAT_MOVES(move, threat, n) engineStatsDetail::addMoves((move), (threat), static_cast<uint64_t>(n))
+#define BC_STAT_TIMER(method) const engineStatsDetail::methodTimer bcStatTimer(boardMethod::method)
+#else
+#define BC_STAT_ADD(name, n) ((void)0)
+#define BC_STAT_MOVES(move, threat, n) ((void)0)
+#define BC_STAT_TIMER(method) ((void)0)
+#endif
@@ -0,0 +1,544 @@
+#include <tablebase.hpp>
+#include <book.hpp>
+#include <byteio.hpp>
+#include <gameboard.hpp>
+#include <threadpool.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+
+constexpr char MAGIC[4] = {'B', 'C', 'T', 'B'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 48;
+constexpr size_t ROYAL_SLOTS = 16;
+constexpr uint8_t NO_TYPE = 0xFF;
+constexpr uint32_t BLOCK_SIZE = 4096;
+constexpr int LOCATIONS = 130;        // 64 백 칸 + 64 흑 칸 + 포켓 2
+constexpr int WHITE_POCKET = 128;
+constexpr int BLACK_POCKET = 129;
+constexpr int MAX_HORIZON = 15;
+constexpr size_t BUILD_GRAIN = 1024;
+constexpr size_t SOLVE_GRAIN = 4096;
+
+inline colorType opponentOf(colorType c) {
+    return (c == colorType::WHITE) ? colorType::BLACK : colorType::WHITE;
+}
+
+struct extraSlot {
+    int type;
+    uint64_t code;
+    bool operator<(const extraSlot& o) const { return type != o.type ? type < o.type : code < o.code; }
+};
+
+// 턴 시작 포지션 하나에서 이번 턴 안의 액션 순서를 모두 펼친다 (스레드마다 하나)
+class turnExpander {
+    private:
+        const tablebaseIndexer& indexer;
+        bc_board node;
+        bc_board scratch;
+        std::vector<boardAction> actions;
+        std::vector<packedPosition> open;
+        std::unordered_set<uint64_t> seen;
+        bool royalAllowed[POCKET_SIZE] = {};
+
+    public:
+        explicit turnExpander(const tablebaseIndexer& ix) : indexer(ix) {
+            for(pieceType t : ix.signature().royalTypes) royalAllowed[static_cast<int>(t)] = true;
+        }
+
+        // RETRO_* 플래그, 턴 종료 후속 인덱스를 out에 (중복 포함)
+        uint8_t expand(const packedPosition& start, std::vector<uint32_t>& out) {
+            uint8_t flags = RETRO_VALID;
+            const colorType mover = bc_board::playerToMove(start.whiteMoveCount, start.blackMoveCount);
+            const colorType opponent = opponentOf(mover);
+            open.clear();
+            seen.clear();
+            open.push_back(start);
+            seen.insert(positionHash(start));
+
+            packedPosition child;
+            while(!open.empty()) {
+                const packedPosition cur = open.back();
+                open.pop_back();
+                node.decodePacked(cur);
+                node.collectLegalActions(actions);
+                for(const boardAction& a : actions) {
+                    if(a.type == actionType::PROMOTE || a.type == actionType::SUCCESSION) {
+                        flags |= RETRO_EXIT;
+                        continue;
+                    }
+                    if(a.type == actionType::DISGUISE && !royalAllowed[static_cast<int>(a.pT)]) continue;
+
+                    scratch.decodePacked(cur);
+                    if(scratch.applyAction(a) != actionResult::OK) continue;
+                    if(a.type == actionType::END_TURN) {
+                        scratch.encodePacked(child);
+                        uint64_t index = 0;
+                        if(indexer.indexOf(child, index)) out.push_back(static_cast<uint32_t>(index));
+                        else flags |= RETRO_EXIT;
+                        continue;
+                    }
+                    if(!scratch.hasRoyalPiece(opponent)) return flags | RETRO_WIN_NOW;
+                    if(!scratch.hasRoyalPiece(mover)) continue;
+                    scratch.encodePacked(child);
+                    if(seen.insert(positionHash(child)).second) open.push_back(child);
+                }
+            }
+            return flags;
+        }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------- 서명
+
+bool tablebaseSignature::fromLetters(std::string_view extras, std::string_view royals, tablebaseSignature& out) {
+    tablebaseSignature sig;
+    sig.stunHorizon = out.stunHorizon;
+    sig.moveHorizon = out.moveHorizon;
+    sig.royalTypes.clear();
+    for(char c : extras) {
+        const pieceType t = pieceFromSymbol(c);
+        if(t == pieceType::NONE || t == pieceType::KING) return false;
+        sig.extras.push_back(t);
+    }
+    if(sig.extras.size() > static_cast<size_t>(TABLEBASE_MAX_EXTRAS)) return false;
+    for(char c : royals) {
+        const pieceType t = pieceFromSymbol(c);
+        if(t == pieceType::NONE || t == pieceType::PWAN) return false;
+        if(std::find(sig.royalTypes.begin(), sig.royalTypes.end(), t) == sig.royalTypes.end()) sig.royalTypes.push_back(t);
+    }
+    if(std::find(sig.royalTypes.begin(), sig.royalTypes.end(), pieceType::KING) == sig.royalTypes.end()) return false;
+    std::sort(sig.extras.begin(), sig.extras.end());
+    std::sort(sig.royalTypes.begin(), sig.royalTypes.end());
+    out = std::move(sig);
+    return true;
+}
+
+std::string tablebaseSignature::name() const {
+    std::string s;
+    for(pieceType t : royalTypes) s += pieceSymbol(t);
+    s += ':';
+    if(extras.empty()) s += '-';
+    for(pieceType t : extras) s += pieceSymbol(t);
+    s += " s" + std::to_string(stunHorizon) + "m" + std::to_string(moveHorizon);
+    return s;
+}
+
+bool tablebaseSignature::operator==(const tablebaseSignature& other) const {
+    return extras == other.extras && royalTypes == other.royalTypes &&
+           stunHorizon == other.stunHorizon && moveHorizon == other.moveHorizon;
+}
+
+// ---------------------------------------------------------------- 인덱스
+
+tablebaseIndexer::tablebaseIndexer(const tablebaseSignature& signature) : sig(signature) {
+    std::sort(sig.extras.begin(), sig.extras.end());
+    std::sort(sig.royalTypes.begin(), sig.royalTypes.end());
+    stackRadix = static_cast<uint64_t>(sig.stunHorizon + 1) * static_cast<uint64_t>(sig.moveHorizon + 1);
+    royalRadix = 64 * static_cast<uint64_t>(sig.royalTypes.size()) * stackRadix;
+    extraRadix = LOCATIONS * stackRadix;
+    total = 2 * royalRadix * royalRadix;
+    for(size_t i = 0; i < sig.extras.size(); ++i) total *= extraRadix;
+}
+
+bool tablebaseIndexer::indexOf(const packedPosition& p, uint64_t& index) const {
+    if(p.flags != 0 || p.activeSquare != PACKED_NO_SQUARE) return false;
+    const uint64_t moveRadix = static_cast<uint64_t>(sig.moveHorizon + 1);
+    const uint64_t typeCount = sig.royalTypes.size();
+    const size_t extraCount = sig.extras.size();
+
+    int64_t royal[2] = {-1, -1};
+    std::array<extraSlot, TABLEBASE_MAX_EXTRAS> found{};
+    size_t count = 0;
+    // 기물 수가 적으므로 넣을 때 삽입 정렬로 순서를 유지한다
+    auto insertFound = [&](const extraSlot& slot) {
+        size_t i = count++;
+        for(; i > 0 && slot < found[i - 1]; --i) found[i] = found[i - 1];
+        found[i] = slot;
+    };
+
+    for(int sq = 0; sq < 64; ++sq) {
+        const uint8_t code = p.squares[sq];
+        if(code == 0) continue;
+        const int type = (code & PACKED_TYPE_MASK) - 1;
+        const int black = (code & PACKED_BLACK) ? 1 : 0;
+        const uint64_t stun = std::min<uint64_t>(p.stun[sq], static_cast<uint64_t>(sig.stunHorizon));
+        const uint64_t move = std::min<uint64_t>(p.move[sq], static_cast<uint64_t>(sig.moveHorizon));
+        const uint64_t stack = stun * moveRadix + move;
+        if(code & PACKED_ROYAL) {
+            const auto it = std::find(sig.royalTypes.begin(), sig.royalTypes.end(), static_cast<pieceType>(type));
+            if(it == sig.royalTypes.end() || royal[black] >= 0) return false;
+            if(((code & PACKED_DISGUISED) != 0) != (type != static_cast<int>(pieceType::KING))) return false;
+            const uint64_t t = static_cast<uint64_t>(it - sig.royalTypes.begin());
+            royal[black] = static_cast<int64_t>((static_cast<uint64_t>(sq) * typeCount + t) * stackRadix + stack);
+        } else {
+            if((code & PACKED_DISGUISED) || count == extraCount) return false;
+            const uint64_t loc = static_cast<uint64_t>(sq + 64 * black);
+            insertFound({type, loc * stackRadix + stack});
+        }
+    }
+    for(int color = 0; color < 2; ++color) {
+        for(int kind = 0; kind < POCKET_SIZE; ++kind) {
+            for(int n = p.pockets[color * POCKET_SIZE + kind]; n > 0; --n) {
+                if(count == extraCount) return false;
+                insertFound({kind, static_cast<uint64_t>(WHITE_POCKET + color) * stackRadix});
+            }
+        }
+    }
+    if(royal[0] < 0 || royal[1] < 0 || count != extraCount) return false;
+    for(size_t i = 0; i < count; ++i) {
+        if(found[i].type != static_cast<int>(sig.extras[i])) return false;
+    }
+
+    uint64_t ix = (bc_board::playerToMove(p.whiteMoveCount, p.blackMoveCount) == colorType::WHITE) ? 0 : 1;
+    for(size_t i = count; i-- > 0;) ix = ix * extraRadix + found[i].code;
+    ix = ix * royalRadix + static_cast<uint64_t>(royal[1]);
+    ix = ix * royalRadix + static_cast<uint64_t>(royal[0]);
+    index = ix;
+    return true;
+}
+
+bool tablebaseIndexer::positionOf(uint64_t index, packedPosition& out) const {
+    if(index >= total) return false;
+    const uint64_t moveRadix = static_cast<uint64_t>(sig.moveHorizon + 1);
+    const uint64_t typeCount = sig.royalTypes.size();
+    std::memset(&out, 0, sizeof(out));
+
+    for(int black = 0; black < 2; ++black) {
+        const uint64_t code = index % royalRadix;
+        index /= royalRadix;
+        const uint64_t stack = code % stackRadix;
+        const uint64_t t = (code / stackRadix) % typeCount;
+        const int sq = static_cast<int>(code / stackRadix / typeCount);
+        if(out.squares[sq] != 0) return false;
+        const pieceType type = sig.royalTypes[t];
+        uint8_t square = static_cast<uint8_t>(static_cast<int>(type) + 1) | PACKED_ROYAL;
+        if(black) square |= PACKED_BLACK;
+        if(type != pieceType::KING) square |= PACKED_DISGUISED;
+        out.squares[sq] = square;
+        out.stun[sq] = static_cast<uint8_t>(stack / moveRadix);
+        out.move[sq] = static_cast<uint8_t>(stack % moveRadix);
+    }
+
+    uint64_t previous = 0;
+    for(size_t i = 0; i < sig.extras.size(); ++i) {
+        const uint64_t code = index % extraRadix;
+        index /= extraRadix;
+        // 같은 타입은 코드 오름차순만 정규형
+        if(i > 0 && sig.extras[i] == sig.extras[i - 1] && code < previous) return false;
+        previous = code;
+        const uint64_t stack = code % stackRadix;
+        const int loc = static_cast<int>(code / stackRadix);
+        const int type = static_cast<int>(sig.extras[i]);
+        if(loc >= WHITE_POCKET) {
+            if(stack != 0) return false;
+            out.pockets[(loc - WHITE_POCKET) * POCKET_SIZE + type]++;
+            continue;
+        }
+        const int sq = loc % 64;
+        if(out.squares[sq] != 0) return false;
+        out.squares[sq] = static_cast<uint8_t>(type + 1) | (loc >= 64 ? PACKED_BLACK : 0);
+        out.stun[sq] = static_cast<uint8_t>(stack / moveRadix);
+        out.move[sq] = static_cast<uint8_t>(stack % moveRadix);
+    }
+
+    // 둘 차례만 의미가 있다 (첫 턴 규칙을 피하도록 몇 턴 진행한 수 카운트)
+    out.whiteMoveCount = (index == 0) ? 5 : 6;
+    out.blackMoveCount = 5;
+    out.flags = 0;
+    out.activeSquare = PACKED_NO_SQUARE;
+    return true;
+}
+
+// ---------------------------------------------------------------- 풀이
+
+int solveRetrograde(const retrogradeGraph& graph, threadPool& pool, std::vector<int16_t>& values) {
+    const size_t n = graph.flags.size();
+    values.assign(n, 0);
+    for(size_t i = 0; i < n; ++i) {
+        if(!(graph.flags[i] & RETRO_VALID)) values[i] = TABLEBASE_INVALID;
+    }
+
+    const size_t chunks = (n + SOLVE_GRAIN - 1) / SOLVE_GRAIN;
+    std::vector<std::vector<std::pair<uint32_t, int16_t>>> changes(chunks);
+    int passes = 0;
+    for(int pass = 1; pass < INT16_MAX; ++pass) {
+        // 이전 단계 값만 읽고 바뀐 값은 모아서 나중에 쓴다 (스레드 수와 무관한 결과)
+        pool.parallelFor(0, n, SOLVE_GRAIN, [&](size_t begin, size_t end) {
+            auto& out = changes[begin / SOLVE_GRAIN];
+            out.clear();
+            for(size_t i = begin; i < end; ++i) {
+                const uint8_t flags = graph.flags[i];
+                if(!(flags & RETRO_VALID) || values[i] != 0) continue;
+                if(flags & RETRO_WIN_NOW) {
+                    out.emplace_back(static_cast<uint32_t>(i), static_cast<int16_t>(pass));
+                    continue;
+                }
+                bool win = false;
+                bool allLost = (flags & RETRO_EXIT) == 0; // 모든 후속에서 상대가 이김
+                for(uint64_t e = graph.offsets[i]; e < graph.offsets[i + 1]; ++e) {
+                    const int16_t v = values[graph.successors[e]];
+                    if(v < 0 && v != TABLEBASE_INVALID) {
+                        win = true;
+                        break;
+                    }
+                    if(v <= 0) allLost = false;
+                }
+                if(win) out.emplace_back(static_cast<uint32_t>(i), static_cast<int16_t>(pass));
+                else if(allLost) out.emplace_back(static_cast<uint32_t>(i), static_cast<int16_t>(-pass));
+            }
+        });
+        bool changed = false;
+        for(const auto& chunk : changes) {
+            for(const auto& [i, v] : chunk) values[i] = v;
+            changed = changed || !chunk.empty();
+        }
+        if(!changed) break;
+        passes = pass;
+    }
+    return passes;
+}
+
+bool buildTablebase(const tablebaseSignature& signature, threadPool& pool, std::vector<int16_t>& values, tablebaseBuildStats& stats) {
+    const auto started = std::chrono::steady_clock::now();
+    stats = tablebaseBuildStats{};
+    if(signature.stunHorizon < 0 || signature.stunHorizon > MAX_HORIZON ||
+       signature.moveHorizon < 0 || signature.moveHorizon > MAX_HORIZON ||
+       signature.extras.size() > static_cast<size_t>(TABLEBASE_MAX_EXTRAS) || signature.royalTypes.empty()) {
+        return false;
+    }
+    const tablebaseIndexer indexer(signature);
+    const uint64_t n = indexer.size();
+    if(n >= UINT32_MAX) return false;
+    stats.indices = n;
+
+    // 1. 후속 그래프: 청크마다 펼쳐 두고 청크 순서대로 잇는다
+    retrogradeGraph graph;
+    graph.flags.assign(n, 0);
+    std::vector<uint32_t> counts(n, 0);
+    const size_t chunks = (n + BUILD_GRAIN - 1) / BUILD_GRAIN;
+    std::vector<std::vector<uint32_t>> chunkSuccessors(chunks);
+    pool.parallelFor(0, n, BUILD_GRAIN, [&](size_t begin, size_t end) {
+        turnExpander expander(indexer);
+        std::vector<uint32_t>& out = chunkSuccessors[begin / BUILD_GRAIN];
+        std::vector<uint32_t> local;
+        packedPosition position;
+        for(size_t i = begin; i < end; ++i) {
+            if(!indexer.positionOf(i, position)) continue;
+            local.clear();
+            const uint8_t flags = expander.expand(position, local);
+            graph.flags[i] = flags;
+            if(flags & RETRO_WIN_NOW) continue; // 후속은 필요 없음
+            std::sort(local.begin(), local.end());
+            local.erase(std::unique(local.begin(), local.end()), local.end());
+            counts[i] = static_cast<uint32_t>(local.size());
+            out.insert(out.end(), local.begin(), local.end());
+        }
+    });
+
+    graph.offsets.resize(n + 1);
+    graph.offsets[0] = 0;
+    for(uint64_t i = 0; i < n; ++i) graph.offsets[i + 1] = graph.offsets[i] + counts[i];
+    std::vector<uint32_t>().swap(counts);
+    graph.successors.reserve(graph.offsets[n]);
+    for(auto& chunk : chunkSuccessors) {
+        graph.successors.insert(graph.successors.end(), chunk.begin(), chunk.end());
+        std::vector<uint32_t>().swap(chunk);
+    }
+    stats.edges = graph.successors.size();
+
+    // 2. 단계별 풀이
+    stats.passes = solveRetrograde(graph, pool, values);
+    for(uint64_t i = 0; i < n; ++i) {
+        const int16_t v = values[i];
+        if(v == TABLEBASE_INVALID) continue;
+        stats.positions++;
+        if(v > 0) stats.wins++;
+        else if(v < 0) stats.losses++;
+        else stats.draws++;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return true;
+}
+
+// ---------------------------------------------------------------- 파일
+
+bool saveTablebase(const std::string& path, const tablebaseSignature& signature, const std::vector<int16_t>& values) {
+    const tablebaseIndexer indexer(signature);
+    const tablebaseSignature& sig = indexer.signature();
+    if(values.size() != indexer.size() || sig.royalTypes.size() > ROYAL_SLOTS) return false;
+
+    std::vector<uint8_t> data;
+    std::vector<uint64_t> starts;
+    const uint64_t n = values.size();
+    for(uint64_t begin = 0; begin < n; begin += BLOCK_SIZE) {
+        starts.push_back(data.size());
+        const uint64_t end = std::min<uint64_t>(n, begin + BLOCK_SIZE);
+        // 블록 첫 런 값: 첫 유효 값 (무효 인덱스는 어느 런에 붙어도 된다)
+        int current = 0;
+        for(uint64_t i = begin; i < end; ++i) {
+            if(values[i] != TABLEBASE_INVALID) {
+                current = values[i];
+                break;
+            }
+        }
+        uint32_t length = 0;
+        for(uint64_t i = begin; i < end; ++i) {
+            const int v = values[i];
+            if(v == TABLEBASE_INVALID || v == current) {
+                length++;
+                continue;
+            }
+            putVarint(data, zigzag(current));
+            putVarint(data, length - 1);
+            current = v;
+            length = 1;
+        }
+        putVarint(data, zigzag(current));
+        putVarint(data, length - 1);
+    }
+    starts.push_back(data.size());
+
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + starts.size() * 8 + data.size());
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    putU32(out, FORMAT_VERSION);
+    out.push_back(static_cast<uint8_t>(sig.stunHorizon));
+    out.push_back(static_cast<uint8_t>(sig.moveHorizon));
+    out.push_back(static_cast<uint8_t>(sig.royalTypes.size()));
+    out.push_back(static_cast<uint8_t>(sig.extras.size()));
+    for(size_t i = 0; i < ROYAL_SLOTS; ++i) {
+        out.push_back(i < sig.royalTypes.size() ? static_cast<uint8_t>(sig.royalTypes[i]) : NO_TYPE);
+    }
+    for(size_t i = 0; i < static_cast<size_t>(TABLEBASE_MAX_EXTRAS); ++i) {
+        out.push_back(i < sig.extras.size() ? static_cast<uint8_t>(sig.extras[i]) : NO_TYPE);
+    }
+    putU64(out, n);
+    putU32(out, BLOCK_SIZE);
+    putU32(out, static_cast<uint32_t>(starts.size() - 1));
+    for(uint64_t s : starts) putU64(out, s);
+    out.insert(out.end(), data.begin(), data.end());
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if(f == nullptr) return false;
+    const bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+bool tablebase::open(const std::string& path) {
+    close();
+    if(!file.open(path) || file.size() < HEADER_SIZE) {
+        file.close();
+        return false;
+    }
+    const uint8_t* p = file.data();
+    auto fail = [this] {
+        close();
+        return false;
+    };
+    if(std::memcmp(p, MAGIC, 4) != 0 || readU32(p + 4) != FORMAT_VERSION) return fail();
+
+    tablebaseSignature sig;
+    sig.stunHorizon = p[8];
+    sig.moveHorizon = p[9];
+    const size_t royalCount = p[10];
+    const size_t extraCount = p[11];
+    if(sig.stunHorizon > MAX_HORIZON || sig.moveHorizon > MAX_HORIZON || royalCount == 0 || royalCount > ROYAL_SLOTS ||
+       extraCount > static_cast<size_t>(TABLEBASE_MAX_EXTRAS)) {
+        return fail();
+    }
+    sig.royalTypes.clear();
+    for(size_t i = 0; i < royalCount; ++i) {
+        const int t = p[12 + i];
+        if(t >= POCKET_SIZE || t == static_cast<int>(pieceType::PWAN)) return fail();
+        sig.royalTypes.push_back(static_cast<pieceType>(t));
+    }
+    for(size_t i = 0; i < extraCount; ++i) {
+        const int t = p[12 + ROYAL_SLOTS + i];
+        if(t >= POCKET_SIZE || t == static_cast<int>(pieceType::KING)) return fail();
+        sig.extras.push_back(static_cast<pieceType>(t));
+    }
+    indexer = tablebaseIndexer(sig);
+
+    const uint64_t indexCount = readU64(p + 32);
+    blockSize = readU32(p + 40);
+    blockCount = readU32(p + 44);
+    if(indexCount != indexer.size() || blockSize == 0 || blockCount != (indexCount + blockSize - 1) / blockSize) return fail();
+    const size_t tableBytes = (static_cast<size_t>(blockCount) + 1) * 8;
+    if(file.size() < HEADER_SIZE + tableBytes) return fail();
+    blockStarts = p + HEADER_SIZE;
+    dataSize = file.size() - HEADER_SIZE - tableBytes;
+    uint64_t previous = 0;
+    for(uint32_t b = 0; b <= blockCount; ++b) {
+        const uint64_t s = readU64(blockStarts + 8 * b);
+        if(s < previous || s > dataSize) return fail();
+        previous = s;
+    }
+    if(previous != dataSize) return fail();
+    data = blockStarts + tableBytes;
+    return true;
+}
+
+void tablebase::close() {
+    file.close();
+    indexer = tablebaseIndexer();
+    blockStarts = nullptr;
+    data = nullptr;
+    dataSize = 0;
+    blockSize = 0;
+    blockCount = 0;
+}
+
+int tablebase::valueAt(uint64_t index) const {
+    if(data == nullptr || index >= indexer.size()) return 0;
+    const uint64_t block = index / blockSize;
+    const uint8_t* p = data + readU64(blockStarts + 8 * block);
+    const uint8_t* end = data + readU64(blockStarts + 8 * (block + 1));
+    uint64_t offset = index % blockSize;
+    uint32_t value = 0, length = 0;
+    while(getVarint(p, end, value) && getVarint(p, end, length)) {
+        if(offset <= length) return unzigzag(value);
+        offset -= static_cast<uint64_t>(length) + 1;
+    }
+    return 0;
+}
+
+bool tablebase::probe(const packedPosition& position, int& value) const {
+    uint64_t index = 0;
+    if(data == nullptr || !indexer.indexOf(position, index)) return false;
+    value = valueAt(index);
+    return true;
+}
+
+bool tablebase::probe(const bc_board& board, int& value) const {
+    packedPosition packed;
+    board.encodePacked(packed);
+    return probe(packed, value);
+}
+
+bool tablebaseSet::add(const std::string& path) {
+    auto table = std::make_unique<tablebase>();
+    if(!table->open(path)) return false;
+    tables.push_back(std::move(table));
+    return true;
+}
+
+bool tablebaseSet::probe(const packedPosition& position, int& value) const {
+    for(const auto& t : tables) {
+        if(t->probe(position, value)) return true;
+    }
+    return false;
+}
+
+bool tablebaseSet::probe(const bc_board& board, int& value) const {
+    if(tables.empty()) return false;
+    packedPosition packed;
+    board.encodePacked(packed);
+    return probe(packed, value);
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <enum.hpp>
+#include <mappedfile.hpp>
+#include <packed.hpp>
+
+class bc_board;
+class threadPool;
+
+/* 소수 기물 엔드게임 테이블베이스 (tablebase.cpp)
+   도메인: 각 편 로얄 하나 + 로얄이 아닌 기물 몇 개(extras). extras는 색/위치가 고정되지 않는다
+   (보드 위 백/흑, 백/흑 포켓 중 어디든, 잡히면 잡은 편 포켓으로). 턴 시작 포지션만 저장한다.
+
+   인덱스 (혼합 진법, 앞이 상위 자리)
+     둘 차례(2) x extras 역순 [위치(130) x 스턴 x 이동] x 흑 로얄 [칸(64) x 타입 x 스턴 x 이동] x 백 로얄 [...]
+     위치: 0..63 백 기물 칸, 64..127 흑 기물 칸, 128 백 포켓, 129 흑 포켓 (포켓이면 스택 0)
+     같은 타입 extras는 코드 오름차순만 정규형 (나머지 인덱스는 무효)
+   근사: 스턴/이동 스택은 지평선(stunHorizon/moveHorizon)에서 포화시킨다 (더 큰 값은 지평선 값으로 본다).
+   변장은 royalTypes에 있는 타입으로만 고려한다 (기본 K: 변장 없음).
+   프로모션, 계승(rule.md 12)은 표 밖으로 나가는 출구다. 출구가 있는 포지션은 패배로 증명하지 않는다.
+
+   값 (둘 차례 기준): n > 0 이면 n턴 안에 이김 (1 = 이번 턴에 상대 로얄을 잡음), n < 0 이면 -n턴 안에 짐,
+   0은 무승부 또는 증명되지 않음.
+
+   풀이: 인덱스마다 bc_board로 한 턴 안의 액션 순서를 전부 펼쳐(연속 이동 포함) 턴 종료 후속 포지션을 모으고(병렬),
+   후속 그래프에서 단계마다 모든 미해결 포지션을 이전 단계 값으로 다시 판정한다(병렬, 스레드 수와 무관한 결과).
+*/
+
+inline constexpr int TABLEBASE_MAX_EXTRAS = 4;
+inline constexpr int16_t TABLEBASE_INVALID = INT16_MIN; // 빌더 출력: 정규형이 아니거나 불가능한 인덱스
+
+struct tablebaseSignature {
+    std::vector<pieceType> extras;                       // 타입 순 정렬
+    std::vector<pieceType> royalTypes{pieceType::KING};  // 로얄이 가질 수 있는 타입 (K 이외는 변장)
+    int stunHorizon = 2;
+    int moveHorizon = 2;
+
+    // 기물 글자 (pieceSymbol)로 지정: extras "R", "NB", royals "K", "KQ". 모르는 글자/킹 extras면 false
+    static bool fromLetters(std::string_view extras, std::string_view royals, tablebaseSignature& out);
+    std::string name() const; // 예: "K:R s2m2"
+    bool operator==(const tablebaseSignature& other) const;
+};
+
+// 인덱스 <-> 턴 시작 포지션 (packedPosition)
+class tablebaseIndexer {
+    private:
+        tablebaseSignature sig;
+        uint64_t stackRadix = 0;
+        uint64_t royalRadix = 0;
+        uint64_t extraRadix = 0;
+        uint64_t total = 0;
+
+    public:
+        tablebaseIndexer() = default;
+        explicit tablebaseIndexer(const tablebaseSignature& signature);
+
+        const tablebaseSignature& signature() const { return sig; }
+        uint64_t size() const { return total; }
+        // 도메인 밖(턴 중간, 기물 구성/로얄 타입 불일치)이면 false, 스택은 지평선으로 포화
+        bool indexOf(const packedPosition& position, uint64_t& index) const;
+        // 무효 인덱스면 false
+        bool positionOf(uint64_t index, packedPosition& out) const;
+};
+
+// 후속 그래프 풀이 (게임 규칙과 무관한 부분)
+inline constexpr uint8_t RETRO_VALID = 0x01;   // 유효 노드
+inline constexpr uint8_t RETRO_WIN_NOW = 0x02; // 이번 턴에 이김
+inline constexpr uint8_t RETRO_EXIT = 0x04;    // 표 밖 후속이 있음 (패배로 증명 불가)
+
+struct retrogradeGraph {
+    std::vector<uint64_t> offsets;    // 노드 i의 후속 = successors[offsets[i], offsets[i+1])
+    std::vector<uint32_t> successors; // 상대 차례 노드
+    std::vector<uint8_t> flags;
+};
+
+// values: 노드마다 위의 값 (무효 노드는 TABLEBASE_INVALID). 반환값은 단계 수
+int solveRetrograde(const retrogradeGraph& graph, threadPool& pool, std::vector<int16_t>& values);
+
+struct tablebaseBuildStats {
+    uint64_t indices = 0;
+    uint64_t positions = 0;   // 유효 포지션
+    uint64_t edges = 0;
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    uint64_t draws = 0;
+    int passes = 0;
+    double seconds = 0.0;
+};
+
+// 전체 인덱스 공간을 풀어 values에 채운다 (인덱스 수가 2^32 이상이면 false)
+bool buildTablebase(const tablebaseSignature& signature, threadPool& pool, std::vector<int16_t>& values, tablebaseBuildStats& stats);
+
+/* 파일 (리틀 엔디언)
+     "BCTB" + u32 버전(1) + u8 스턴 지평선 + u8 이동 지평선 + u8 로얄 타입 수 + u8 extras 수
+     u8 로얄 타입[16] + u8 extras 타입[4] (남는 칸 0xFF)
+     u64 인덱스 수 + u32 블록 크기 + u32 블록 수 + u64 블록 시작[블록 수 + 1] (데이터 기준)
+     데이터: 블록마다 (zigzag 값 varint, 길이-1 varint) 런 나열. 무효 인덱스는 앞 런에 붙인다.
+*/
+bool saveTablebase(const std::string& path, const tablebaseSignature& signature, const std::vector<int16_t>& values);
+
+class tablebase {
+    private:
+        mappedFile file;
+        tablebaseIndexer indexer;
+        const uint8_t* blockStarts = nullptr;
+        const uint8_t* data = nullptr;
+        size_t dataSize = 0;
+        uint32_t blockSize = 0;
+        uint32_t blockCount = 0;
+
+    public:
+        bool open(const std::string& path); // 형식이 맞지 않으면 false
+        void close();
+        bool isOpen() const { return data != nullptr; }
+        const tablebaseSignature& signature() const { return indexer.signature(); }
+        uint64_t size() const { return indexer.size(); }
+        size_t fileSize() const { return file.size(); }
+
+        int valueAt(uint64_t index) const;
+        bool probe(const packedPosition& position, int& value) const; // 도메인 밖이면 false
+        bool probe(const bc_board& board, int& value) const;
+};
+
+// 여러 표를 묶어 맞는 표를 찾아 조회 (탐색에서 사용)
+class tablebaseSet {
+    private:
+        std::vector<std::unique_ptr<tablebase>> tables;
+
+    public:
+        bool add(const std::string& path);
+        size_t size() const { return tables.size(); }
+        bool probe(const packedPosition& position, int& value) const;
+        bool probe(const bc_board& board, int& value) const;
+};
@@ -0,0 +1,108 @@
+#include <threadpool.hpp>
+#include <trace.hpp>
+
+namespace {
+
+// 현재 스레드가 어느 풀의 몇 번 워커인지 (워커가 아니면 nullptr)
+thread_local const threadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+} // namespace
+
+threadPool::threadPool(unsigned threadCount) {
+    if(threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if(threadCount == 0) threadCount = 1;
+
+    queues.reserve(threadCount);
+    for(unsigned i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<workQueue>());
+    workers.reserve(threadCount);
+    for(unsigned i = 0; i < threadCount; ++i) workers.emplace_back(&threadPool::workerLoop, this, i);
+}
+
+threadPool::~threadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(auto& w : workers) w.join();
+}
+
+void threadPool::submit(std::function<void()> task) {
+    const size_t target = (currentPool == this)
+        ? currentWorker
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        // 잠든 워커가 queued 증가를 놓치지 않도록 sleepLock 아래에서 올린다
+        std::lock_guard<std::mutex> guard(sleepLock);
+        queued.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+bool threadPool::popLocal(size_t self, std::function<void()>& task) {
+    workQueue& q = *queues[self];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if(q.tasks.empty()) return false;
+    task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+}
+
+bool threadPool::steal(size_t self, std::function<void()>& task) {
+    const size_t n = queues.size();
+    for(size_t i = 1; i < n; ++i) {
+        workQueue& q = *queues[(self + i) % n];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if(q.tasks.empty()) continue;
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void threadPool::workerLoop(size_t self) {
+    currentPool = this;
+    currentWorker = self;
+    if(ENGINE_TRACE_ENABLED) setTraceThreadName("worker " + std::to_string(self));
+
+    std::function<void()> task;
+    while(true) {
+        if(popLocal(self, task) || steal(self, task)) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            task = nullptr;
+            if(pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if(stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+void threadPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepLock);
+    idle.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+void threadPool::parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if(begin >= end) return;
+    if(grain == 0) grain = 1;
+    for(size_t chunk = begin; chunk < end; chunk += grain) {
+        const size_t chunkEnd = (end - chunk > grain) ? chunk + grain : end;
+        submit([&fn, chunk, chunkEnd] { fn(chunk, chunkEnd); });
+    }
+    wait();
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* 작업 훔치기(work-stealing) 스레드 풀
+   워커마다 자기 큐를 갖고 뒤에서 꺼내며(LIFO, 캐시 친화), 비면 다른 워커 큐의 앞에서 훔친다(FIFO).
+   워커 안에서 submit하면 자기 큐로, 밖에서 submit하면 라운드 로빈으로 분배한다.
+*/
+class threadPool {
+    private:
+        struct workQueue {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<workQueue>> queues;
+        std::vector<std::thread> workers;
+
+        std::mutex sleepLock;
+        std::condition_variable wake;     // 새 작업 / 종료
+        std::condition_variable idle;     // 모든 작업 완료
+        std::atomic<size_t> queued{0};    // 큐에 있는 작업 수
+        std::atomic<size_t> pending{0};   // 제출되었지만 끝나지 않은 작업 수
+        std::atomic<size_t> nextQueue{0};
+        bool stopping = false;
+
+        bool popLocal(size_t self, std::function<void()>& task);
+        bool steal(size_t self, std::function<void()>& task);
+        void workerLoop(size_t self);
+
+    public:
+        explicit threadPool(unsigned threadCount = 0); // 0이면 hardware_concurrency
+        ~threadPool();
+        threadPool(const threadPool&) = delete;
+        threadPool& operator=(const threadPool&) = delete;
+
+        unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+        void submit(std::function<void()> task);
+        void wait(); // 제출된 작업(작업 중 추가 제출 포함)이 모두 끝날 때까지 대기 (워커 밖에서만 호출)
+
+        // [begin, end)를 grain 크기 조각으로 나눠 fn(chunkBegin, chunkEnd)를 병렬 실행하고 완료까지 대기
+        void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
+};
@@ -0,0 +1,175 @@
+#include <trace.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct traceEvent {
+    const char* name = nullptr;
+    const char* category = nullptr;
+    uint64_t start = 0;
+    uint64_t end = 0;
+};
+
+// 스레드 하나의 링 버퍼. events/epoch는 주인 스레드만 바꾸고, 다른 스레드는 기록이 멈춘 뒤에만 읽는다
+struct threadBuffer {
+    std::vector<traceEvent> events;
+    std::atomic<uint64_t> head{0}; // 지금까지 기록한 수 (슬롯 = head % 용량)
+    uint64_t epoch = 0;            // 버퍼를 비운 startTrace 세대
+    uint32_t tid = 0;
+    std::string name;              // registryLock 아래에서만 접근
+};
+
+std::mutex registryLock;
+std::vector<std::unique_ptr<threadBuffer>> buffers; // 스레드가 끝나도 내보낼 수 있게 해제하지 않는다
+std::atomic<uint64_t> currentEpoch{0};
+size_t capacity = 0;   // startTrace가 currentEpoch를 올리기 전에 쓴다
+uint64_t origin = 0;   // 트레이스 시각 0
+thread_local threadBuffer* localBuffer = nullptr;
+
+threadBuffer& ownBuffer() {
+    if(localBuffer == nullptr) {
+        std::lock_guard<std::mutex> guard(registryLock);
+        buffers.push_back(std::make_unique<threadBuffer>());
+        localBuffer = buffers.back().get();
+        localBuffer->tid = static_cast<uint32_t>(buffers.size());
+        localBuffer->name = "thread " + std::to_string(localBuffer->tid);
+    }
+    return *localBuffer;
+}
+
+void appendEscaped(std::string& out, const std::string& text) {
+    for(char c : text) {
+        if(c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if(static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+            out += code;
+        } else {
+            out += c;
+        }
+    }
+}
+
+} // namespace
+
+namespace engineTraceDetail {
+
+std::atomic<bool> recording{false};
+
+uint64_t nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void record(const char* name, const char* category, uint64_t start, uint64_t end) {
+    threadBuffer& b = ownBuffer();
+    const uint64_t epoch = currentEpoch.load(std::memory_order_acquire);
+    if(b.epoch != epoch) { // 새 기록: 자기 버퍼를 비우고 이번 용량으로 맞춘다
+        b.events.assign(capacity, traceEvent{});
+        b.head.store(0, std::memory_order_relaxed);
+        b.epoch = epoch;
+    }
+    const uint64_t h = b.head.load(std::memory_order_relaxed);
+    b.events[h % b.events.size()] = traceEvent{name, category, start, end};
+    b.head.store(h + 1, std::memory_order_release);
+}
+
+} // namespace engineTraceDetail
+
+void startTrace(size_t eventsPerThread) {
+    if(!ENGINE_TRACE_ENABLED) return;
+    std::lock_guard<std::mutex> guard(registryLock);
+    capacity = std::max<size_t>(1, eventsPerThread);
+    origin = engineTraceDetail::nowNanos();
+    currentEpoch.fetch_add(1, std::memory_order_release);
+    engineTraceDetail::recording.store(true, std::memory_order_release);
+}
+
+void stopTrace() {
+    engineTraceDetail::recording.store(false, std::memory_order_release);
+}
+
+bool isTracing() {
+    return engineTraceDetail::recording.load(std::memory_order_relaxed);
+}
+
+void setTraceThreadName(const std::string& name) {
+    threadBuffer& b = ownBuffer();
+    std::lock_guard<std::mutex> guard(registryLock);
+    b.name = name;
+}
+
+traceSummary summarizeTrace() {
+    traceSummary s;
+    std::lock_guard<std::mutex> guard(registryLock);
+    const uint64_t epoch = currentEpoch.load(std::memory_order_acquire);
+    for(const auto& b : buffers) {
+        if(epoch == 0 || b->epoch != epoch) continue;
+        const uint64_t h = b->head.load(std::memory_order_acquire);
+        const uint64_t kept = std::min<uint64_t>(h, b->events.size());
+        s.events += kept;
+        s.dropped += h - kept;
+        s.threads++;
+    }
+    return s;
+}
+
+std::string traceJson() {
+    stopTrace();
+    std::string out = "{\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&] {
+        if(!first) out += ",\n";
+        first = false;
+    };
+    char line[256];
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    const uint64_t epoch = currentEpoch.load(std::memory_order_acquire);
+    uint64_t dropped = 0;
+    separator();
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"chesstack\"}}";
+    for(const auto& b : buffers) {
+        if(epoch == 0 || b->epoch != epoch) continue;
+        separator();
+        std::snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", b->tid);
+        out += line;
+        appendEscaped(out, b->name);
+        out += "\"}}";
+
+        // 남아 있는 이벤트를 오래된 것부터
+        const uint64_t h = b->head.load(std::memory_order_acquire);
+        const uint64_t size = b->events.size();
+        const uint64_t kept = std::min<uint64_t>(h, size);
+        dropped += h - kept;
+        for(uint64_t i = h - kept; i < h; ++i) {
+            const traceEvent& e = b->events[i % size];
+            const uint64_t start = e.start > origin ? e.start - origin : 0;
+            const uint64_t duration = e.end > e.start ? e.end - e.start : 0;
+            separator();
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                          e.name, e.category, b->tid, static_cast<double>(start) / 1000.0, static_cast<double>(duration) / 1000.0);
+            out += line;
+        }
+    }
+    std::snprintf(line, sizeof(line), "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":%llu}}\n",
+                  static_cast<unsigned long long>(dropped));
+    out += line;
+    return out;
+}
+
+bool writeTrace(const std::string& path) {
+    const std::string json = traceJson();
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if(f == nullptr) return false;
+    const bool ok = std::fwrite(json.data(), 1, json.size(), f) == json.size();
+    return std::fclose(f) == 0 && ok;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <stats.hpp>
+
+// 엔진 활동 트레이스 (Chrome trace-event JSON, chrome://tracing / ui.perfetto.dev에서 연다).
+// BC_ENABLE_TRACE=1로 빌드했을 때만 BC_TRACE_* 구간이 남으며, 기본값(0)에서는 전부 컴파일 타임에 제거된다.
+// 켠 빌드에서도 startTrace()를 부르기 전에는 구간마다 원자 변수 하나만 읽는다.
+// 이벤트는 스레드마다 고정 크기 링 버퍼에 쌓인다 (쓰는 쪽은 자기 버퍼만 만지고 잠그지 않음, 가득 차면 오래된 것부터 덮어씀).
+#ifndef BC_ENABLE_TRACE
+#define BC_ENABLE_TRACE 0
+#endif
+
+inline constexpr bool ENGINE_TRACE_ENABLED = BC_ENABLE_TRACE != 0;
+
+// 기록 시작: 모든 스레드 버퍼를 비우고 스레드당 eventsPerThread개까지 보관. 꺼진 빌드에서는 아무것도 하지 않는다
+void startTrace(size_t eventsPerThread = size_t(1) << 16);
+void stopTrace();
+bool isTracing();
+void setTraceThreadName(const std::string& name); // 부른 스레드의 이름 (트레이스의 스레드 줄 이름)
+
+struct traceSummary {
+    uint64_t events = 0;  // 버퍼에 남아 있는 이벤트
+    uint64_t dropped = 0; // 링 버퍼가 넘쳐 덮어쓴 이벤트
+    size_t threads = 0;
+};
+traceSummary summarizeTrace();
+
+// 기록을 멈추고 Chrome trace-event JSON으로 내보낸다 (버퍼는 다음 startTrace까지 유지)
+std::string traceJson();
+bool writeTrace(const std::string& path);
+
+namespace engineTraceDetail {
+
+extern std::atomic<bool> recording;
+uint64_t nowNanos();
+void record(const char* name, const char* category, uint64_t start, uint64_t end);
+
+// 구간: 시작할 때 기록 중이었으면 끝날 때 이벤트 하나 (name/category는 정적 문자열)
+class traceScope {
+    private:
+        const char* name;
+        const char* category;
+        uint64_t start = 0;
+
+    public:
+        traceScope(const char* n, const char* c) : name(nullptr), category(c) {
+            if(recording.load(std::memory_order_relaxed)) {
+                name = n;
+                start = nowNanos();
+            }
+        }
+        ~traceScope() {
+            if(name != nullptr) record(name, category, start, nowNanos());
+        }
+        traceScope(const traceScope&) = delete;
+        traceScope& operator=(const traceScope&) = delete;
+};
+
+} // namespace engineTraceDetail
+
+#define BC_TRACE_JOIN2(a, b) a##b
+#define BC_TRACE_JOIN(a, b) BC_TRACE_JOIN2(a, b)
+
+#if BC_ENABLE_TRACE
+#define BC_TRACE_SCOPE(name, category) const engineTraceDetail::traceScope BC_TRACE_JOIN(bcTraceScope, __LINE__)((name), (category))
+#else
+#define BC_TRACE_SCOPE(name, category) ((void)0)
+#endif
+
+// bc_board 공개 메서드 (이름은 stats.hpp의 boardMethodName)
+#define BC_TRACE_METHOD(method) BC_TRACE_SCOPE(boardMethodName(boardMethod::method), "board")
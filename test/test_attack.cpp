@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// 공격 맵 테스트: 스턴 기물도 체크를 주고, 증분 갱신한 합법수/공격 맵이 전체 재계산 결과와 같아야 한다
+namespace {
+
+uint64_t squareBit(int file, int rank) { return uint64_t(1) << squareOf(file, rank); }
+
+// 칸별 합법 목적지 비트 (증분/전체 비교용)
+std::vector<uint64_t> destinationMasks(const bc_board& board) {
+    std::vector<uint64_t> masks(64, 0);
+    for(int f = 0; f < 8; ++f) {
+        for(int r = 0; r < 8; ++r) {
+            piece* p = board.getPiece(f, r);
+            if(!p) continue;
+            for(const PGN& m : p->getLegalMoves()) masks[squareOf(f, r)] |= squareBit(m.endFile, m.endRank);
+        }
+    }
+    return masks;
+}
+
+// 점유 비트보드만 쓰는 생성기(attackMask/forEachTarget)가 보드 기반 계산과 같은 결과를 내는지
+bool sameAsBitboardGenerator(const bc_board& board) {
+    const std::vector<uint64_t> destinations = destinationMasks(board);
+    uint64_t white = 0, black = 0;
+    for(int sq = 0; sq < 64; ++sq) {
+        piece* p = board.getPiece(squareFile(sq), squareRank(sq));
+        if(p) (p->getColor() == colorType::WHITE ? white : black) |= uint64_t(1) << sq;
+    }
+    for(int sq = 0; sq < 64; ++sq) {
+        piece* p = board.getPiece(squareFile(sq), squareRank(sq));
+        if(!p) continue;
+        const uint64_t own = (p->getColor() == colorType::WHITE) ? white : black;
+        const uint64_t enemy = (p->getColor() == colorType::WHITE) ? black : white;
+        uint64_t attacks = 0, scanned = 0, targets = 0;
+        for(const auto& pattern : p->getMovePatterns()) {
+            attacks |= pattern.attackMask(squareFile(sq), squareRank(sq), own, enemy, scanned);
+            pattern.forEachTarget(squareFile(sq), squareRank(sq), own, enemy, [&targets](int to, uint64_t) {
+                targets |= uint64_t(1) << to;
+            });
+        }
+        if(attacks != p->getAttackMask() || scanned != p->getScanMask()) return false;
+        if(!p->isStunned() && targets != destinations[sq]) return false;
+    }
+    return true;
+}
+
+bool sameAsFullRebuild(const bc_board& board) {
+    bc_board fresh;
+    if(!fresh.loadPositionString(board.getPositionString())) return false;
+    return fresh.getAttackMap(colorType::WHITE) == board.getAttackMap(colorType::WHITE) &&
+           fresh.getAttackMap(colorType::BLACK) == board.getAttackMap(colorType::BLACK) &&
+           fresh.getRoyalMask(colorType::WHITE) == board.getRoyalMask(colorType::WHITE) &&
+           fresh.getRoyalMask(colorType::BLACK) == board.getRoyalMask(colorType::BLACK) &&
+           destinationMasks(fresh) == destinationMasks(board) &&
+           sameAsBitboardGenerator(board);
+}
+
+// 착수/이동/스턴 중 하나를 무작위로 골라 둔다 (항상 턴은 넘긴다)
+void playRandomTurn(bc_board& board, colorType side, uint32_t& seed) {
+    auto next = [&seed](uint32_t bound) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % bound;
+    };
+    const uint32_t choice = next(3);
+    if(choice == 0) {
+        const auto stock = board.getPocketStock(side);
+        for(int attempt = 0; attempt < 16; ++attempt) {
+            const int kind = static_cast<int>(next(POCKET_SIZE));
+            if(stock[kind] <= 0) continue;
+            const pieceType type = static_cast<pieceType>(kind); // 포켓 인덱스는 pieceType 순서
+            if(board.placePiece(type, side, static_cast<int>(next(8)), static_cast<int>(next(8))) == actionResult::OK) break;
+        }
+    } else if(choice == 1) {
+        std::vector<std::pair<piece*, PGN>> candidates;
+        for(int f = 0; f < 8; ++f) {
+            for(int r = 0; r < 8; ++r) {
+                piece* p = board.getPiece(f, r);
+                if(!p || p->getColor() != side || p->getMoveStack() <= 0) continue;
+                for(const PGN& m : p->getLegalMoves()) candidates.push_back({p, m});
+            }
+        }
+        if(!candidates.empty()) {
+            const PGN m = candidates[next(static_cast<uint32_t>(candidates.size()))].second;
+            board.movePiece(m.startFile, m.startRank, m.endFile, m.endRank);
+        }
+    } else {
+        const int f = static_cast<int>(next(8));
+        const int r = static_cast<int>(next(8));
+        if(board.getPiece(f, r)) board.passAndAddStun(f, r);
+    }
+    board.nextTurn();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 공격 맵 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 스턴 중인 룩도 e열의 킹을 체크한다 (합법수는 없음)
+    bc_board board;
+    board.loadPositionString("k^3r(3,0)3/8/8/8/8/8/8/4K^(0,1)3 w -/- - 5 5");
+    piece* rook = board.getPiece(4, 7);
+    check("stunned rook has no legal moves", rook && rook->isStunned() && rook->getLegalMoves().empty());
+    check("stunned rook still attacks", board.isSquareAttacked(4, 0, colorType::BLACK));
+    check("stunned attacker gives check", board.isRoyalPieceInCheck(colorType::WHITE));
+    check("no check on black", !board.isRoyalPieceInCheck(colorType::BLACK));
+
+    // 2. 가로막으면 체크 해제 (증분 갱신)
+    board.loadPositionString("k^3r(3,0)3/8/8/8/8/8/8/4K^(0,1)3 w Q/- - 5 5");
+    check("interposing drop", board.placePiece(pieceType::QUEEN, colorType::WHITE, 4, 3) == actionResult::OK);
+    check("check blocked", !board.isRoyalPieceInCheck(colorType::WHITE));
+    check("blocker square attacked", board.isSquareAttacked(4, 3, colorType::BLACK) &&
+          !board.isSquareAttacked(4, 2, colorType::BLACK));
+
+    // 3. 로얄 마스크: 계승하면 로얄 칸이 늘어난다 (움직일 수 없는 킹을 두 룩이 노리는 체크메이트)
+    board.loadPositionString("k^3r(0,1)3/8/8/8/8/8/P7/r(0,1)3K^3 w -/- - 5 5");
+    check("succession", board.succeedRoyalPiece(0, 1, colorType::WHITE) == actionResult::OK);
+    check("royal mask follows succession", board.getRoyalMask(colorType::WHITE) == (squareBit(4, 0) | squareBit(0, 1)));
+
+    // 4. 무작위 대국: 매 턴 증분 결과가 전체 재계산과 같아야 한다
+    uint32_t seed = 12345;
+    bool consistent = true;
+    int turns = 0;
+    for(int game = 0; game < 40 && consistent; ++game) {
+        // 요정 기물까지 포켓에 넣어 모든 이동 패턴을 거친다
+        bc_board played;
+        played.loadPositionString("4k^3/8/8/8/8/8/8/4K^3 w QB2N2R2P8AGHWDLFCTM/qb2n2r2p8aghwdlfctm - 1 1");
+        for(int ply = 0; ply < 80 && consistent; ++ply) {
+            const colorType side = played.currentPlayerColor();
+            playRandomTurn(played, side, seed);
+            consistent = sameAsFullRebuild(played);
+            if(!consistent) std::cout << "diverged at: " << played.getPositionString() << std::endl;
+            turns++;
+        }
+    }
+    std::cout << "random turns checked: " << turns << std::endl;
+    check("incremental maps match full rebuild", consistent);
+
+    return check.finish();
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <book.hpp>
+#include <chess.hpp>
+#include <policy.hpp>
+#include <threadpool.hpp>
+#include "test_check.hpp"
+
+// 오프닝 북 테스트: 포지션 해시 안정성, 빌드 -> 저장 -> mmap 조회 왕복, 조회 결과 합법성, 손상 파일 거절
+namespace {
+
+const char* DROP_START = "4k^3/8/8/8/8/8/8/4K^3 w QR2P2/qr2p2 - 1 1";
+const char* DROP_BLACK = "4k^3/8/8/8/8/8/8/4K^3 b QR2P2/qr2p2 - 1 1";
+
+} // namespace
+
+int main() {
+    std::cout << "=== 오프닝 북 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 해시: packed 왕복에 불변, 둘 차례가 다르면 달라진다
+    bc_board start;
+    check("load start", start.loadPositionString(DROP_START));
+    {
+        packedPosition packed;
+        start.encodePacked(packed);
+        bc_board decoded;
+        decoded.decodePacked(packed);
+        check("hash stable across packed round trip", positionHash(decoded) == positionHash(start));
+        bc_board black;
+        black.loadPositionString(DROP_BLACK);
+        check("hash depends on side to move", positionHash(black) != positionHash(start));
+    }
+
+    // 2. 빌드 -> 저장
+    threadPool pool(4);
+    bookBuildConfig config;
+    config.depth = 3;
+    config.width = 2;
+    config.movesPerEntry = 4;
+    config.analysis.iterations = 200;
+    config.analysis.rolloutActions = 8;
+    openingBookWriter writer;
+    const bookBuildStats stats = buildOpeningBook(start, config, pool, writer);
+    std::cout << "  positions: " << stats.positions << ", entries: " << writer.size() << ", " << stats.seconds << " s" << std::endl;
+    check("book has entries", writer.size() > 1 && stats.positions >= writer.size());
+
+    const std::string path = "bc_test_book.bcob";
+    std::remove(path.c_str());
+    check("save", writer.save(path));
+
+    // 3. mmap 조회
+    openingBook book;
+    check("open", book.open(path) && book.isOpen() && book.size() == writer.size());
+    std::vector<bookMove> moves;
+    check("probe start", book.probe(start, moves) && !moves.empty() && moves.size() <= 4);
+    bool sorted = true;
+    for(size_t i = 1; i < moves.size(); ++i) sorted = sorted && moves[i - 1].weight >= moves[i].weight;
+    check("weights descending", sorted);
+    bool legal = true;
+    for(const auto& m : moves) {
+        bc_board b;
+        b.loadPositionString(DROP_START);
+        legal = legal && b.applyAction(policyAction(m.policyIndex, colorType::WHITE)) == actionResult::OK;
+    }
+    check("book moves legal", legal);
+
+    boardAction picked;
+    bool pickedLegal = true;
+    for(uint64_t r = 0; r < 16; ++r) {
+        bc_board b;
+        b.loadPositionString(DROP_START);
+        pickedLegal = pickedLegal && book.pick(b, r * 0x9E3779B97F4A7C15ull, picked) && b.applyAction(picked) == actionResult::OK;
+    }
+    check("pick legal", pickedLegal);
+    check("unknown hash misses", !book.probe(positionHash(start) ^ 1, moves) && moves.empty());
+
+    // 펼친 자식 포지션도 조회된다 (착수 뒤 END_TURN은 강제 액션이라 건너뛴 포지션)
+    {
+        book.probe(start, moves);
+        bc_board child;
+        child.loadPositionString(DROP_START);
+        child.applyAction(policyAction(moves[0].policyIndex, colorType::WHITE));
+        std::vector<boardAction> actions;
+        for(child.collectLegalActions(actions); actions.size() == 1; child.collectLegalActions(actions)) child.applyAction(actions[0]);
+        std::vector<bookMove> reply;
+        check("probe child", book.probe(child, reply));
+    }
+    book.close();
+
+    // 4. 손상 파일 거절
+    {
+        std::FILE* f = std::fopen(path.c_str(), "rb+");
+        std::fseek(f, 0, SEEK_END);
+        const long size = std::ftell(f);
+        std::fclose(f);
+        std::vector<char> bytes(static_cast<size_t>(size));
+        f = std::fopen(path.c_str(), "rb");
+        std::fread(bytes.data(), 1, bytes.size(), f);
+        std::fclose(f);
+
+        f = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size() - 3, f);
+        std::fclose(f);
+        check("reject truncated", !book.open(path) && !book.isOpen());
+
+        bytes[0] = 'X';
+        f = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), f);
+        std::fclose(f);
+        check("reject bad magic", !book.open(path));
+    }
+    std::remove(path.c_str());
+
+    return check.finish();
+}
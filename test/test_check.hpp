@@ -0,0 +1,19 @@
+#pragma once
+#include <iostream>
+
+// 테스트 공용 검사: 항목마다 [PASS]/[FAIL] 한 줄을 찍고, 끝에서 finish()가 요약을 찍고 종료 코드를 돌려준다
+class testChecker {
+    private:
+        int failures = 0;
+
+    public:
+        void operator()(const char* label, bool ok) {
+            std::cout << (ok ? "[PASS] " : "[FAIL] ") << label << std::endl;
+            if(!ok) failures++;
+        }
+
+        int finish() const {
+            std::cout << (failures == 0 ? "모든 테스트 통과" : "실패한 테스트 있음") << std::endl;
+            return failures == 0 ? 0 : 1;
+        }
+};
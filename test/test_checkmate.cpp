@@ -0,0 +1,71 @@
+#include <chrono>
+#include <iostream>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// 체크메이트 판정 테스트: 착수 가로막기, 위협 기물 스턴, 연속 이동 탈출, 상대 로얄 잡기를 모두 방어로 인정해야 한다
+int main() {
+    std::cout << "=== 체크메이트 판정 테스트 ===" << std::endl;
+    testChecker check;
+
+    bc_board board;
+
+    // 1. 움직일 수 없는 킹을 두 룩이 노림: 스턴은 하나만 멈추고 포켓도 비어 있음
+    const char* mate = "k^3r(0,1)3/8/8/8/8/8/P7/r(0,1)3K^3 w -/- - 5 5";
+    board.loadPositionString(mate);
+    check("double attack threatens", board.isRoyalCaptureThreatened(colorType::WHITE));
+    check("double attack is mate", board.isRoyalPieceCheckmated(colorType::WHITE));
+    check("attacker side not mated", !board.isRoyalPieceCheckmated(colorType::BLACK));
+    check("succession allowed when mated", board.succeedRoyalPiece(0, 1, colorType::WHITE) == actionResult::OK);
+
+    // 2. 위협 기물이 하나면 스턴으로 막을 수 있으므로 계승 불가
+    board.loadPositionString("k^3r(0,1)3/8/8/8/8/8/P7/4K^3 w -/- - 5 5");
+    check("single attacker threatens", board.isRoyalCaptureThreatened(colorType::WHITE));
+    check("single attacker can be stunned", !board.isRoyalPieceCheckmated(colorType::WHITE));
+    check("succession rejected", board.succeedRoyalPiece(0, 1, colorType::WHITE) == actionResult::NOT_CHECKMATED);
+
+    // 3. 스턴 중인 공격 기물: 체크이지만 다음 턴에 잡을 수는 없음
+    board.loadPositionString("k^3r(1,1)3/8/8/8/8/8/8/4K^3 w -/- - 5 5");
+    check("stunned attacker gives check", board.isRoyalPieceInCheck(colorType::WHITE));
+    check("stunned attacker cannot capture", !board.isRoyalCaptureThreatened(colorType::WHITE));
+
+    // 4. 착수 가로막기: a4 룩(이동 스택 2)은 e4를 거쳐서만, e8 룩은 e열로만 닿는다 -> e2/e3/e4 착수가 둘 다 막음
+    board.loadPositionString("k^3r(0,1)3/8/8/8/r(0,2)7/8/8/1P2K^3 w -/- - 5 5");
+    check("two-hop attacker threatens", board.isRoyalCaptureThreatened(colorType::WHITE));
+    check("no pocket: mate", board.isRoyalPieceCheckmated(colorType::WHITE));
+    board.loadPositionString("k^3r(0,1)3/8/8/8/r(0,2)7/8/8/1P2K^3 w Q/- - 5 5");
+    check("drop interposition blocks both", !board.isRoyalPieceCheckmated(colorType::WHITE));
+    board.loadPositionString("k^3r(0,1)3/8/8/8/r(0,2)7/8/8/1P2K^3 w P/- - 5 5");
+    check("pawn drop interposition", !board.isRoyalPieceCheckmated(colorType::WHITE));
+
+    // 5. 연속 이동 탈출: 한 칸으로는 모두 공격받지만 이동 스택 2면 b2를 거쳐 c3로 빠져나감
+    board.loadPositionString("r(0,1)r(0,1)4k^1/8/8/8/8/8/7r(0,1)/K^(0,1)6r(0,1) w -/- - 5 5");
+    check("one hop: mate", board.isRoyalPieceCheckmated(colorType::WHITE));
+    board.loadPositionString("r(0,1)r(0,1)4k^1/8/8/8/8/8/7r(0,1)/K^(0,2)6r(0,1) w -/- - 5 5");
+    check("two hops: escape", !board.isRoyalPieceCheckmated(colorType::WHITE));
+    // 이미 다른 액션을 한 턴이면 남은 행동이 없다
+    board.loadPositionString("r(0,1)r(0,1)4k^1/8/8/8/8/8/7r(0,1)/K^(0,2)6r(0,1) w -/- + 5 5");
+    check("mid-turn: no actions left", board.isRoyalPieceCheckmated(colorType::WHITE));
+
+    // 6. 상대 로얄 피스를 잡으면 상대 기물 전체가 스턴되어 위협이 사라진다
+    board.loadPositionString("k^3r(0,1)3/1Q(0,1)6/8/8/8/8/P7/r(0,1)3K^3 w -/- - 5 5");
+    check("capturing enemy royal defends", !board.isRoyalPieceCheckmated(colorType::WHITE));
+
+    // 7. 호출 비용
+    const char* timed[] = {
+        mate,
+        "k^3r(0,1)3/8/8/8/r(0,2)7/8/8/1P2K^3 w Q/- - 5 5",
+        "r(0,1)r(0,1)4k^1/8/8/8/8/8/7r(0,1)/K^(0,2)6r(0,1) w -/- - 5 5",
+    };
+    for(const char* text : timed) {
+        board.loadPositionString(text);
+        constexpr int ITERATIONS = 20000;
+        int mated = 0;
+        const auto started = std::chrono::steady_clock::now();
+        for(int i = 0; i < ITERATIONS; ++i) mated += board.isRoyalPieceCheckmated(colorType::WHITE) ? 1 : 0;
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "  " << (us / ITERATIONS) << " us/call (mated=" << (mated > 0) << ")  " << text << std::endl;
+    }
+
+    return check.finish();
+}
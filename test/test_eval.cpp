@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// 정적 평가 테스트: 액션마다 증분 갱신한 평가 항목이 같은 포지션을 새로 불러와 전체 계산한 결과와 같아야 한다
+namespace {
+
+bool sameAsFullRebuild(const bc_board& board) {
+    bc_board fresh;
+    if(!fresh.loadPositionString(board.getPositionString())) return false;
+    return fresh.getEvalTerms(colorType::WHITE) == board.getEvalTerms(colorType::WHITE) &&
+           fresh.getEvalTerms(colorType::BLACK) == board.getEvalTerms(colorType::BLACK) &&
+           fresh.evaluate(colorType::WHITE) == board.evaluate(colorType::WHITE);
+}
+
+// 착수/이동/스턴/합법이 아닌 이동 시도 중 하나를 무작위로 골라 둔다 (항상 턴은 넘긴다)
+void playRandomTurn(bc_board& board, colorType side, uint32_t& seed) {
+    auto next = [&seed](uint32_t bound) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % bound;
+    };
+    const uint32_t choice = next(4);
+    if(choice == 0) {
+        const auto stock = board.getPocketStock(side);
+        for(int attempt = 0; attempt < 16; ++attempt) {
+            const int kind = static_cast<int>(next(POCKET_SIZE));
+            if(stock[kind] <= 0) continue;
+            const pieceType type = static_cast<pieceType>(kind); // 포켓 인덱스는 pieceType 순서
+            if(board.placePiece(type, side, static_cast<int>(next(8)), static_cast<int>(next(8))) == actionResult::OK) break;
+        }
+    } else if(choice == 1) {
+        std::vector<PGN> candidates;
+        for(int f = 0; f < 8; ++f) {
+            for(int r = 0; r < 8; ++r) {
+                piece* p = board.getPiece(f, r);
+                if(!p || p->getColor() != side || p->getMoveStack() <= 0) continue;
+                for(const PGN& m : p->getLegalMoves()) candidates.push_back(m);
+            }
+        }
+        if(!candidates.empty()) {
+            const PGN m = candidates[next(static_cast<uint32_t>(candidates.size()))];
+            board.movePiece(m.startFile, m.startRank, m.endFile, m.endRank);
+        }
+    } else if(choice == 2) {
+        const int f = static_cast<int>(next(8));
+        const int r = static_cast<int>(next(8));
+        if(board.getPiece(f, r)) board.passAndAddStun(f, r);
+    } else {
+        // 거절되는 이동도 상태를 바꾸면 평가가 따라가야 한다
+        board.movePiece(static_cast<int>(next(8)), static_cast<int>(next(8)), static_cast<int>(next(8)), static_cast<int>(next(8)));
+    }
+    board.nextTurn();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 정적 평가 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 대칭 포지션은 0점
+    bc_board board;
+    board.loadPositionString("r(0,1)3k^3/8/8/8/8/8/8/R(0,1)3K^3 w QP/qp - 5 5");
+    check("symmetric position is even", board.evaluate(colorType::WHITE) == 0 && board.evaluate(colorType::BLACK) == 0);
+
+    // 2. 잡기: 보드 위 가치가 포켓으로 옮겨가고 잡힌 편 점수가 떨어짐
+    board.loadPositionString("k^7/8/8/3n4/8/8/8/3R(0,1)2K^1 w -/- - 5 5");
+    const int before = board.evaluate(colorType::WHITE);
+    check("capture", board.movePiece(3, 0, 3, 4) == actionResult::OK);
+    check("captured piece goes to pocket", board.getEvalTerms(colorType::WHITE).pocket == materialValue(pieceType::KNIGHT) &&
+          board.getEvalTerms(colorType::BLACK).material == materialValue(pieceType::KING));
+    check("capture improves score", board.evaluate(colorType::WHITE) > before);
+    check("perspective is antisymmetric", board.evaluate(colorType::WHITE) == -board.evaluate(colorType::BLACK));
+    check("capture matches rebuild", sameAsFullRebuild(board));
+
+    // 3. 스턴 빚: 스턴을 받으면 점수가 내려가고 틱마다 회복
+    board.loadPositionString("k^7/8/8/8/8/8/8/Q(0,1)5K^1 w -/- - 5 5");
+    const int fresh = board.evaluate(colorType::WHITE);
+    board.passAndAddStun(0, 0, 2);
+    check("stun debt counted", board.getEvalTerms(colorType::WHITE).stunDebt == 2 * materialValue(pieceType::QUEEN));
+    check("stunned piece scores lower", board.evaluate(colorType::WHITE) < fresh);
+    board.nextTurn();
+    check("tick pays stun back", board.getEvalTerms(colorType::WHITE).stunDebt == materialValue(pieceType::QUEEN) &&
+          board.getEvalTerms(colorType::WHITE).moveStacks == 2);
+    check("tick matches rebuild", sameAsFullRebuild(board));
+
+    // 4. 로얄 안전도: 공격받는 로얄과 주변 칸
+    board.loadPositionString("k^3r(0,1)3/8/8/8/8/8/8/4K^3 w -/- - 5 5");
+    check("attacked royal penalized", board.royalSafety(colorType::WHITE) < 0 && board.royalSafety(colorType::BLACK) == 0);
+
+    // 5. 무작위 대국: 매 턴 증분 결과가 전체 재계산과 같아야 한다
+    uint32_t seed = 777;
+    bool consistent = true;
+    int turns = 0;
+    for(int game = 0; game < 40 && consistent; ++game) {
+        bc_board played;
+        played.loadPositionString("4k^3/8/8/8/8/8/8/4K^3 w QB2N2R2P8AGHWDLFCTM/qb2n2r2p8aghwdlfctm - 1 1");
+        for(int ply = 0; ply < 80 && consistent; ++ply) {
+            const colorType side = played.currentPlayerColor();
+            playRandomTurn(played, side, seed);
+            consistent = sameAsFullRebuild(played);
+            if(!consistent) std::cout << "diverged at: " << played.getPositionString() << std::endl;
+            turns++;
+        }
+    }
+    std::cout << "random turns checked: " << turns << std::endl;
+    check("incremental terms match full rebuild", consistent);
+
+    // 6. 호출 비용
+    board.loadPositionString("r(0,1)n(0,1)b(0,1)q(0,1)k^b(0,1)n(0,1)r(0,1)/pppppppp/8/8/8/8/PPPPPPPP/R(0,1)N(0,1)B(0,1)Q(0,1)K^B(0,1)N(0,1)R(0,1) w -/- - 5 5");
+    constexpr int ITERATIONS = 1000000;
+    long long sink = 0;
+    const auto started = std::chrono::steady_clock::now();
+    for(int i = 0; i < ITERATIONS; ++i) sink += board.evaluate((i & 1) ? colorType::BLACK : colorType::WHITE);
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "  " << (ns / ITERATIONS) << " ns/call (sink=" << sink << ")" << std::endl;
+
+    return check.finish();
+}
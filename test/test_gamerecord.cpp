@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chess.hpp>
+#include <gamerecord.hpp>
+#include "test_check.hpp"
+
+// 게임 기록 파일 테스트: 기록 -> mmap 읽기 -> 재생 결과가 원래 진행과 같아야 한다
+int main() {
+    std::cout << "=== 게임 기록 테스트 ===" << std::endl;
+    testChecker check;
+
+    const std::string path = "bc_test_gamerecord.bcgr";
+    std::remove(path.c_str());
+
+    struct recordedGame {
+        std::string initial;
+        std::string final;
+        size_t actions;
+    };
+    std::vector<recordedGame> expected;
+
+    gameRecordWriter writer;
+    check("open writer", writer.open(path));
+
+    // 1. 기본 시작 포지션에서 착수/스턴 위주 게임
+    {
+        bc_board board;
+        board.initializeBoard();
+        recordedGame game{board.getPositionString(), "", 0};
+        writer.beginGame(board);
+        const std::vector<boardAction> actions = {
+            boardAction::drop(pieceType::KING, squareOf(4, 0)), boardAction::endTurn(),
+            boardAction::drop(pieceType::KING, squareOf(4, 7)), boardAction::endTurn(),
+            boardAction::drop(pieceType::PWAN, squareOf(4, 3)), boardAction::endTurn(),
+            boardAction::drop(pieceType::QUEEN, squareOf(4, 6)), boardAction::endTurn(),
+            boardAction::stun(squareOf(4, 3), 2), boardAction::endTurn(),
+        };
+        bool allOk = true;
+        for(const boardAction& a : actions) {
+            allOk = allOk && board.applyAction(a) == actionResult::OK;
+            writer.addAction(a);
+            game.actions++;
+        }
+        check("game 1 actions applied", allOk);
+        check("end game 1", writer.endGame(gameResult::DRAW));
+        game.final = board.getPositionString();
+        expected.push_back(game);
+    }
+
+    // 2. 손으로 쓴 포지션에서 연속 이동 (이어지는 MOVE 압축 경로)
+    {
+        bc_board board;
+        board.loadPositionString("4k^3/8/3q^=q(3,0)4/8/3H(0,2)4/8/8/4K^(0,1)3 w QA2/m - 5 5");
+        recordedGame game{board.getPositionString(), "", 0};
+        writer.beginGame(board);
+        const std::vector<boardAction> actions = {
+            boardAction::move(squareOf(3, 3), squareOf(4, 5)),
+            boardAction::move(squareOf(4, 5), squareOf(3, 3)),
+            boardAction::endTurn(),
+            boardAction::drop(pieceType::CAMEL, squareOf(0, 7)),
+            boardAction::endTurn(),
+        };
+        bool allOk = true;
+        for(const boardAction& a : actions) {
+            allOk = allOk && board.applyAction(a) == actionResult::OK;
+            writer.addAction(a);
+            game.actions++;
+        }
+        check("game 2 actions applied", allOk);
+        check("end game 2", writer.endGame(gameResult::WHITE_WIN));
+        game.final = board.getPositionString();
+        expected.push_back(game);
+    }
+    writer.close();
+
+    // 3. 읽어서 재생
+    gameRecordReader reader;
+    check("open reader", reader.open(path));
+    std::cout << "file size: " << reader.fileSize() << " bytes" << std::endl;
+
+    gameRecordView view;
+    size_t gameIndex = 0;
+    while(reader.nextGame(view)) {
+        if(gameIndex >= expected.size()) {
+            check("no extra games", false);
+            break;
+        }
+        const recordedGame& game = expected[gameIndex];
+        bc_board board;
+        check("load initial position", view.loadInitial(board) && board.getPositionString() == game.initial);
+        check("action count", view.actionCount() == game.actions);
+
+        boardAction a;
+        bool allOk = true;
+        size_t replayed = 0;
+        while(view.nextAction(a)) {
+            allOk = allOk && board.applyAction(a) == actionResult::OK;
+            replayed++;
+        }
+        check("replayed all actions", allOk && replayed == game.actions);
+        std::cout << "final: " << board.getPositionString() << std::endl;
+        check("replay final position", board.getPositionString() == game.final);
+        gameIndex++;
+    }
+    check("read both games", gameIndex == expected.size() && !reader.isCorrupt());
+
+    // 4. 기존 파일에 덧붙이기
+    check("reopen writer (append)", writer.open(path));
+    bc_board empty;
+    empty.initializeBoard();
+    writer.beginGame(empty);
+    writer.addAction(boardAction::endTurn());
+    check("end appended game", writer.endGame());
+    writer.close();
+
+    check("reopen reader", reader.open(path));
+    size_t total = 0;
+    gameResult lastResult = gameResult::DRAW;
+    while(reader.nextGame(view)) {
+        lastResult = view.result();
+        total++;
+    }
+    check("appended game readable", total == 3 && lastResult == gameResult::UNKNOWN);
+
+    // 5. 범위 밖 기물 타입은 읽기와 적용 모두 거절
+    const boardAction badDrop = boardAction::drop(static_cast<pieceType>(40), squareOf(3, 3));
+    check("board rejects bad drop type", empty.applyAction(badDrop) != actionResult::OK);
+    check("board rejects bad promote type",
+          empty.promote(3, 3, static_cast<pieceType>(40)) != actionResult::OK);
+    check("reopen writer (bad type)", writer.open(path));
+    writer.beginGame(empty);
+    writer.addAction(badDrop);
+    check("end bad type game", writer.endGame());
+    writer.close();
+    check("reopen reader (bad type)", reader.open(path));
+    boardAction decoded;
+    bool badTypeRejected = false;
+    while(reader.nextGame(view)) badTypeRejected = !view.nextAction(decoded);
+    check("reject out of range piece type", badTypeRejected);
+
+    // 6. 범위 밖 점프 칸도 거절
+    check("reopen writer (bad jump)", writer.open(path));
+    writer.beginGame(empty);
+    boardAction badJump = boardAction::move(squareOf(3, 3), squareOf(3, 5));
+    badJump.jumpedSquare = 100;
+    writer.addAction(badJump);
+    check("end bad jump game", writer.endGame());
+    writer.close();
+    check("reopen reader (bad jump)", reader.open(path));
+    bool badJumpRejected = false;
+    while(reader.nextGame(view)) badJumpRejected = !view.nextAction(decoded);
+    check("reject out of range jump square", badJumpRejected);
+
+    // 7. 헤더는 packed 레코드의 8/16비트 폭으로 자르지 않는다 (큰 스택/포켓/수 카운트)
+    {
+        bc_board wide;
+        check("load wide position", wide.loadPositionString("4k^3/8/8/8/8/8/8/R(300,700)3K^(0,32767)3 w Q300/n2 - 70000 70000"));
+        check("reopen writer (wide)", writer.open(path));
+        writer.beginGame(wide);
+        check("end wide game", writer.endGame());
+        writer.close();
+        check("reopen reader (wide)", reader.open(path));
+        bool sawWide = false;
+        while(reader.nextGame(view)) {
+            bc_board loaded;
+            sawWide = view.loadInitial(loaded) && loaded.getPositionString() == wide.getPositionString();
+        }
+        check("wide values survive the header", sawWide);
+    }
+
+    // 8. 잘못된 파일은 거절
+    std::FILE* bad = std::fopen(path.c_str(), "wb");
+    std::fputs("NOPE1234", bad);
+    std::fclose(bad);
+    check("reject bad magic", !reader.open(path));
+
+    std::remove(path.c_str());
+    return check.finish();
+}
@@ -0,0 +1,195 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chess.hpp>
+#include <gamerecord.hpp>
+#include <threadpool.hpp>
+#include "test_check.hpp"
+
+// 비밀 로얄 계승 테스트: 관찰에서 비밀 로얄이 가려지는지, 결정화 표본이 후보에 고르게 퍼지는지, 탐색이 진짜 배정을 보지 않는지
+namespace {
+
+// 흑 룩 두 개가 백 킹을 노리고 백 기물은 모두 스턴 (계승 가능)
+const char* MATED = "k^3r(0,1)3/8/8/8/8/8/PN(5,0)B(5,0)5/r(0,1)3K^3 w -/- - 5 5";
+const char* ROYAL_CAPTURE = "k^7/8/8/8/8/8/8/R(0,1)3K^3 w -/- - 5 5";
+// 흑 킹이 백 룩 세 개에 막혀 있고 흑 차례 (h7 폰으로 계승 가능)
+const char* BLACK_MATED = "k^6R(0,1)/7p/8/8/8/8/8/R(0,1)R(0,1)2K^3 b -/- - 5 4";
+
+// 계승 후 흑 차례까지 진행한 보드
+bool succeedAndPass(bc_board& board, int file, int rank) {
+    if(!board.loadPositionString(MATED)) return false;
+    if(board.succeedRoyalPiece(file, rank, colorType::WHITE) != actionResult::OK) return false;
+    board.nextTurn();
+    return true;
+}
+
+inline uint64_t bitOf(int file, int rank) { return uint64_t(1) << squareOf(file, rank); }
+
+} // namespace
+
+int main() {
+    std::cout << "=== 비밀 로얄 / 정보 집합 탐색 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 관찰: 상대 비밀 로얄은 가려지고 자기 편은 보인다
+    bc_board board;
+    check("succession", succeedAndPass(board, 1, 1));
+    packedPosition seen;
+    royalObservation hidden;
+    board.observe(colorType::BLACK, seen, hidden);
+    const uint64_t expectedCandidates = bitOf(0, 1) | bitOf(1, 1) | bitOf(2, 1);
+    check("secret royal hidden from opponent", (seen.squares[squareOf(1, 1)] & PACKED_ROYAL) == 0);
+    check("king stays public", (seen.squares[squareOf(4, 0)] & PACKED_ROYAL) != 0);
+    check("candidates are pieces present at succession", hidden.candidates == expectedCandidates && hidden.hiddenCount == 1);
+    board.observe(colorType::WHITE, seen, hidden);
+    check("own secret royal visible", (seen.squares[squareOf(1, 1)] & PACKED_ROYAL) != 0 && hidden.hiddenCount == 0);
+
+    // 턴이 지나도 후보 표시는 기물에 남는다
+    {
+        bc_board later;
+        succeedAndPass(later, 1, 1);
+        later.nextTurn();
+        later.nextTurn();
+        packedPosition p;
+        royalObservation h;
+        later.observe(colorType::BLACK, p, h);
+        check("candidate flags survive turns", h.candidates == expectedCandidates && h.hiddenCount == 1);
+    }
+
+    // 2. 변장하면 비밀 로얄이 공개된다
+    {
+        bc_board disguised;
+        disguised.loadPositionString(MATED);
+        disguised.succeedRoyalPiece(1, 1, colorType::WHITE);
+        disguised.disguisePiece(1, 1, pieceType::ROOK);
+        packedPosition p;
+        royalObservation h;
+        disguised.observe(colorType::BLACK, p, h);
+        check("disguise reveals royal", (p.squares[squareOf(1, 1)] & PACKED_ROYAL) != 0 && h.hiddenCount == 0);
+    }
+
+    // 3. 결정화 표본: 후보 셋에 고르게, 항상 정확히 한 개
+    board.observe(colorType::BLACK, seen, hidden);
+    {
+        constexpr int SAMPLES = 30000;
+        int counts[3] = {0, 0, 0};
+        bool exact = true;
+        uint64_t rng = 7;
+        packedPosition world;
+        const auto started = std::chrono::steady_clock::now();
+        for(int i = 0; i < SAMPLES; ++i) {
+            sampleRoyalAssignment(seen, hidden, rng, world);
+            int royals = 0;
+            for(int f = 0; f < 3; ++f) {
+                if(world.squares[squareOf(f, 1)] & PACKED_ROYAL) {
+                    counts[f]++;
+                    royals++;
+                }
+            }
+            exact = exact && royals == 1;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "  samples: " << counts[0] << " / " << counts[1] << " / " << counts[2] << ", "
+                  << static_cast<long long>(SAMPLES / seconds) << " samples/sec" << std::endl;
+        check("one royal per sample", exact);
+        bool uniform = true;
+        for(int c : counts) uniform = uniform && c > SAMPLES / 3 - SAMPLES / 20 && c < SAMPLES / 3 + SAMPLES / 20;
+        check("samples spread over candidates", uniform);
+
+        bc_board decoded;
+        check("sample decodes", decoded.decodePacked(world) && decoded.hasRoyalPiece(colorType::WHITE));
+    }
+
+    // 4. 탐색은 관찰만 본다: 진짜 비밀 로얄이 어디든 결과가 같다
+    threadPool pool(4);
+    ismctsConfig config;
+    config.iterations = 600;
+    config.rolloutActions = 16;
+    config.seed = 3;
+    std::vector<ismctsResult> results;
+    for(int file = 0; file < 3; ++file) {
+        bc_board b;
+        succeedAndPass(b, file, 1);
+        results.push_back(informationSetSearch(b, config, &pool));
+    }
+    check("search ignores true royal", results[0].visits == results[1].visits && results[1].visits == results[2].visits);
+    int total = 0;
+    for(const auto& v : results[0].visits) total += v.second;
+    check("visits add up", total == config.iterations);
+    {
+        bc_board b;
+        succeedAndPass(b, 0, 1);
+        check("best action legal", b.applyAction(results[0].best) == actionResult::OK);
+    }
+
+    // 5. 결정적: 같은 시드/스레드 수면 같은 결과
+    {
+        bc_board b;
+        succeedAndPass(b, 2, 1);
+        check("deterministic with seed", informationSetSearch(b, config, &pool).visits == results[2].visits);
+    }
+
+    // 6. 비밀/후보 표시는 포지션 문자열, packed 레코드, 게임 기록을 거쳐도 남는다
+    {
+        bc_board original;
+        original.loadPositionString(BLACK_MATED);
+        check("black succession", original.succeedRoyalPiece(7, 6, colorType::BLACK) == actionResult::OK);
+        const std::string text = original.getPositionString();
+        std::cout << "  " << text << std::endl;
+        check("secret marker in position string", text.find("p!?") != std::string::npos && text.find("p^") == std::string::npos);
+        packedPosition truth;
+        royalObservation truthHidden;
+        original.observe(colorType::WHITE, truth, truthHidden);
+
+        auto sameState = [&](const bc_board& b) {
+            packedPosition seen;
+            royalObservation h;
+            b.observe(colorType::WHITE, seen, h);
+            return b.getPositionString() == text && h.hiddenCount == 1 && h.candidates == truthHidden.candidates &&
+                   (seen.squares[squareOf(7, 6)] & PACKED_ROYAL) == 0 && seen.secretRoyals == 0;
+        };
+
+        bc_board fromText;
+        check("position string keeps secret royal", fromText.loadPositionString(text) && sameState(fromText));
+
+        packedPosition record;
+        original.encodePacked(record);
+        bc_board fromPacked;
+        check("packed record keeps secret royal", fromPacked.decodePacked(record) && sameState(fromPacked));
+        record.secretRoyals |= uint64_t(1) << squareOf(3, 3);
+        check("reject secret royal on empty square", !fromPacked.decodePacked(record) && sameState(fromPacked));
+
+        const std::string path = "bc_test_ismcts.bcgr";
+        std::remove(path.c_str());
+        gameRecordWriter writer;
+        bool recorded = writer.open(path);
+        writer.beginGame(original);
+        recorded = recorded && writer.endGame();
+        writer.close();
+        gameRecordReader reader;
+        gameRecordView view;
+        bc_board fromRecord;
+        check("game record keeps secret royal", recorded && reader.open(path) && reader.nextGame(view) &&
+                                                view.loadInitial(fromRecord) && sameState(fromRecord));
+        std::remove(path.c_str());
+    }
+
+    // 7. 완전 정보 포지션에서 로얄 잡기를 찾는다
+    {
+        bc_board capture;
+        capture.loadPositionString(ROYAL_CAPTURE);
+        ismctsConfig cfg;
+        cfg.iterations = 800;
+        cfg.rolloutActions = 8;
+        const auto started = std::chrono::steady_clock::now();
+        const ismctsResult r = informationSetSearch(capture, cfg, &pool);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "  " << static_cast<long long>(cfg.iterations / seconds) << " iterations/sec" << std::endl;
+        check("finds royal capture", r.best.type == actionType::MOVE && r.best.fromSquare == squareOf(0, 0) && r.best.toSquare == squareOf(0, 7));
+    }
+
+    return check.finish();
+}
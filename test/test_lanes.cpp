@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// 스턴/이동 스택 레인 테스트: 커널 규칙 (스칼라 = AVX2), 스턴 틱/로얄 캡처 페널티, 스택 상한, 무작위 진행 중 비트보드와 보드 일치
+namespace {
+
+const char* STUNNED = "4k^3/8/8/8/8/8/8/R(2,0)N(1,3)2K^(0,1)3 w -/- - 5 5";
+const char* ROYAL_TAKE = "R(0,1)3k^3/4n(1,0)3/8/8/8/8/8/4K^3 w -/- - 5 5";
+
+// 레인의 점유/로얄 비트보드가 보드 칸과 같고, 빈 칸 레인은 0인지
+bool lanesMatch(const bc_board& board) {
+    const pieceLanes& lanes = board.getLanes();
+    for(int sq = 0; sq < 64; ++sq) {
+        const piece* p = board.getPiece(squareFile(sq), squareRank(sq));
+        const uint64_t bit = uint64_t(1) << sq;
+        if(p == nullptr) {
+            if(((lanes.colors[0] | lanes.colors[1] | lanes.royals[0] | lanes.royals[1]) & bit) != 0 ||
+               lanes.stun[sq] != 0 || lanes.move[sq] != 0) return false;
+            continue;
+        }
+        if((lanes.occupied(p->getColor()) & bit) == 0 || ((lanes.colors[0] & lanes.colors[1]) & bit) != 0) return false;
+        if(((board.getRoyalMask(p->getColor()) & bit) != 0) != p->isRoyal()) return false;
+    }
+    return true;
+}
+
+pieceLanes randomLanes(std::mt19937& rng) {
+    pieceLanes l;
+    for(int sq = 0; sq < 64; ++sq) {
+        const int kind = static_cast<int>(rng() % 8);
+        if(kind == 0) continue;
+        l.place(sq, (rng() & 1) ? colorType::WHITE : colorType::BLACK);
+        l.stun[sq] = clampLaneStack(kind == 7 ? LANE_STACK_MAX : static_cast<int>(rng() % 4));
+        l.move[sq] = clampLaneStack(kind == 6 ? LANE_STACK_MAX : static_cast<int>(rng() % 4));
+    }
+    return l;
+}
+
+bool sameLanes(const pieceLanes& a, const pieceLanes& b) {
+    return a.stun == b.stun && a.move == b.move && a.colors == b.colors && a.royals == b.royals;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 스턴 레인 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 커널 규칙: 레인마다 기물 규칙과 같고, 커널끼리 같다
+    std::mt19937 rng(7);
+    bool tickRule = true;
+    bool addRule = true;
+    bool kernelsAgree = true;
+    for(int round = 0; round < 200; ++round) {
+        const pieceLanes start = randomLanes(rng);
+        const uint64_t mask = (static_cast<uint64_t>(rng()) << 32) ^ rng();
+        const int delta = static_cast<int>(rng() % 7) - 3;
+
+        laneSetKernel(laneKernel::SCALAR);
+        pieceLanes scalar = start;
+        const uint64_t stunned = laneStunned(scalar, mask);
+        const uint64_t ticked = laneStunTick(scalar, mask);
+        pieceLanes scalarAdd = start;
+        laneAddStun(scalarAdd, mask, delta);
+        for(int sq = 0; sq < 64; ++sq) {
+            const bool tick = ((mask >> sq) & 1) && start.stun[sq] > 0;
+            if(((ticked >> sq) & 1) != static_cast<uint64_t>(tick) || ((stunned >> sq) & 1) != static_cast<uint64_t>(tick)) tickRule = false;
+            if(scalar.stun[sq] != start.stun[sq] - (tick ? 1 : 0)) tickRule = false;
+            if(scalar.move[sq] != std::min(start.move[sq] + (tick ? 1 : 0), LANE_STACK_MAX)) tickRule = false;
+            const int added = ((mask >> sq) & 1) ? std::clamp(start.stun[sq] + delta, 0, LANE_STACK_MAX) : start.stun[sq];
+            if(scalarAdd.stun[sq] != added) addRule = false;
+        }
+
+        if(laneSetKernel(laneKernel::AVX2)) {
+            pieceLanes wide = start;
+            kernelsAgree = kernelsAgree && laneStunned(wide, mask) == stunned;
+            kernelsAgree = kernelsAgree && laneStunTick(wide, mask) == ticked && sameLanes(wide, scalar);
+            pieceLanes wideAdd = start;
+            laneAddStun(wideAdd, mask, delta);
+            kernelsAgree = kernelsAgree && sameLanes(wideAdd, scalarAdd);
+        }
+    }
+    check("tick rule", tickRule);
+    check("add rule", addRule);
+    check(laneKernelSupported(laneKernel::AVX2) ? "avx2 matches scalar" : "avx2 unsupported (scalar only)", kernelsAgree);
+    laneSetKernel(laneKernelSupported(laneKernel::AVX2) ? laneKernel::AVX2 : laneKernel::SCALAR);
+
+    // 2. 턴 종료 스턴 틱: 스턴 있는 기물만 스턴 -1, 이동 +1
+    bc_board board;
+    board.loadPositionString(STUNNED);
+    check("lanes after load", lanesMatch(board));
+    board.nextTurn();
+    const piece* rook = board.getPiece(0, 0);
+    const piece* knight = board.getPiece(1, 0);
+    const piece* king = board.getPiece(4, 0);
+    check("stun ticked", rook->getStunStack() == 1 && rook->getMoveStack() == 1 && knight->getStunStack() == 0 &&
+                         knight->getMoveStack() == 4 && !knight->isStunned());
+    check("unstunned untouched", king->getStunStack() == 0 && king->getMoveStack() == 1);
+    check("lanes after tick", lanesMatch(board));
+
+    // 3. 로얄 캡처: 잡힌 편 모든 기물 스턴 +3, 평가 누적기도 같이 맞춘다
+    board.loadPositionString(ROYAL_TAKE);
+    check("capture royal", board.movePiece(0, 7, 4, 7) == actionResult::OK);
+    const piece* blackKnight = board.getPiece(4, 6);
+    check("penalty applied", blackKnight != nullptr && blackKnight->getStunStack() == 4);
+    check("lanes after penalty", lanesMatch(board));
+    bc_board reloaded;
+    reloaded.loadPositionString(board.getPositionString());
+    check("eval consistent", board.evaluate(colorType::WHITE) == reloaded.evaluate(colorType::WHITE));
+
+    // 4. 스택 상한: 큰 스턴도 레인 범위로 잘리고, 틱마다 줄어든다
+    board.loadPositionString(STUNNED);
+    check("huge stun accepted", board.passAndAddStun(1, 0, 40000) == actionResult::OK);
+    const piece* capped = board.getPiece(1, 0);
+    check("stun capped", capped->getStunStack() == LANE_STACK_MAX && board.getLanes().stun[squareOf(1, 0)] == LANE_STACK_MAX);
+    board.nextTurn();
+    board.nextTurn();
+    check("capped stun ticks", capped->getStunStack() == LANE_STACK_MAX - 1 && capped->getMoveStack() == 4);
+    check("capped position reloads", reloaded.loadPositionString(board.getPositionString()) &&
+                                      reloaded.getPositionString() == board.getPositionString() &&
+                                      reloaded.evaluate(colorType::WHITE) == board.evaluate(colorType::WHITE));
+    // 상한을 넘는 문자열은 잘라 받지 않고 거절, 보드는 그대로
+    const std::string before = reloaded.getPositionString();
+    check("oversized stack rejected", !reloaded.loadPositionString("4k3/8/8/8/8/8/8/R(0,40000)3K3 w -/- - 0 0") &&
+                                      !reloaded.loadPositionString("4k3/8/8/8/8/8/8/R(32768,0)3K3 w -/- - 0 0") &&
+                                      reloaded.getPositionString() == before);
+    // 기물이 보드 레인을 가리키므로 보드는 복사할 수 없다
+    static_assert(!std::is_copy_constructible_v<bc_board> && !std::is_copy_assignable_v<bc_board>,
+                  "bc_board must not be copyable");
+
+    // 5. 무작위 진행 내내 레인 비트보드 = 보드
+    bool alwaysMatch = true;
+    std::vector<boardAction> actions;
+    const char* starts[] = {STUNNED, ROYAL_TAKE, "r^(1,1)n(2,0)1q1k2/pp4pp/8/3Q4/8/5N(3,0)2/PP3PPP/R(1,2)3K^2 w Q2N/q2n - 3 3"};
+    for(const char* start : starts) {
+        board.loadPositionString(start);
+        for(int i = 0; i < 300 && alwaysMatch; ++i) {
+            board.collectLegalActions(actions);
+            board.applyAction(actions[rng() % actions.size()]);
+            alwaysMatch = lanesMatch(board);
+        }
+    }
+    check("lanes match during play", alwaysMatch);
+
+    return check.finish();
+}
@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// NNUE 테스트: 가중치 파일 왕복, 증분 누적기 = 전체 재계산, 모든 커널이 같은 값, 특징 목록 = 누적기
+namespace {
+
+bool sameAccumulator(const bc_board& a, const bc_board& b) {
+    const nnueAccumulator& x = a.getNeuralAccumulator();
+    const nnueAccumulator& y = b.getNeuralAccumulator();
+    for(colorType c : {colorType::WHITE, colorType::BLACK}) {
+        for(int i = 0; i < NNUE_HIDDEN; ++i) {
+            if(x.perspective(c)[i] != y.perspective(c)[i]) return false;
+        }
+    }
+    return true;
+}
+
+bool sameAsFullRebuild(const bc_board& board, const nnueNetwork& net) {
+    bc_board fresh;
+    if(!fresh.loadPositionString(board.getPositionString())) return false;
+    fresh.attachNetwork(&net);
+    return sameAccumulator(board, fresh) &&
+           fresh.evaluateNeural(colorType::WHITE) == board.evaluateNeural(colorType::WHITE) &&
+           fresh.evaluateNeural(colorType::BLACK) == board.evaluateNeural(colorType::BLACK);
+}
+
+// 특징 목록으로 직접 더한 누적기가 보드의 누적기와 같은지
+bool featuresMatchAccumulator(const bc_board& board, const nnueNetwork& net) {
+    for(colorType c : {colorType::WHITE, colorType::BLACK}) {
+        std::vector<int> sums(net.bias(), net.bias() + NNUE_HIDDEN);
+        for(int f : board.getNeuralFeatures(c)) {
+            for(int i = 0; i < NNUE_HIDDEN; ++i) sums[i] += net.column(f)[i];
+        }
+        const int16_t* acc = board.getNeuralAccumulator().perspective(c);
+        for(int i = 0; i < NNUE_HIDDEN; ++i) {
+            if(static_cast<int16_t>(sums[i]) != acc[i]) return false;
+        }
+    }
+    return true;
+}
+
+void playRandomTurn(bc_board& board, colorType side, uint32_t& seed) {
+    auto next = [&seed](uint32_t bound) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % bound;
+    };
+    const uint32_t choice = next(3);
+    if(choice == 0) {
+        const auto stock = board.getPocketStock(side);
+        for(int attempt = 0; attempt < 16; ++attempt) {
+            const int kind = static_cast<int>(next(POCKET_SIZE));
+            if(stock[kind] <= 0) continue;
+            if(board.placePiece(static_cast<pieceType>(kind), side, static_cast<int>(next(8)), static_cast<int>(next(8))) == actionResult::OK) break;
+        }
+    } else if(choice == 1) {
+        std::vector<PGN> candidates;
+        for(int f = 0; f < 8; ++f) {
+            for(int r = 0; r < 8; ++r) {
+                piece* p = board.getPiece(f, r);
+                if(!p || p->getColor() != side || p->getMoveStack() <= 0) continue;
+                for(const PGN& m : p->getLegalMoves()) candidates.push_back(m);
+            }
+        }
+        if(!candidates.empty()) {
+            const PGN m = candidates[next(static_cast<uint32_t>(candidates.size()))];
+            board.movePiece(m.startFile, m.startRank, m.endFile, m.endRank);
+        }
+    } else {
+        const int f = static_cast<int>(next(8));
+        const int r = static_cast<int>(next(8));
+        if(board.getPiece(f, r)) board.passAndAddStun(f, r, 1 + static_cast<int>(next(5)));
+    }
+    board.nextTurn();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== NNUE 테스트 ===" << std::endl;
+    testChecker check;
+
+    std::cout << "  features: " << NNUE_FEATURES << ", kernel: " << nnueKernelName(nnueActiveKernel()) << std::endl;
+
+    // 1. 가중치 파일 왕복
+    nnueNetwork net;
+    net.randomize(2024, 64, 32);
+    const char* path = "bc_test_nnue.bcnn";
+    check("save", net.save(path));
+    nnueNetwork loaded;
+    check("load", loaded.load(path));
+
+    const char* start = "r(0,1)n(0,1)b(0,1)q(0,1)k^b(0,1)n(0,1)r(0,1)/pppppppp/8/8/8/8/PPPPPPPP/R(0,1)N(0,1)B(0,1)Q(0,1)K^B(0,1)N(0,1)R(0,1) w QP/qp - 5 5";
+    bc_board a, b;
+    a.loadPositionString(start);
+    b.loadPositionString(start);
+    a.attachNetwork(&net);
+    b.attachNetwork(&loaded);
+    check("loaded network evaluates the same", a.evaluateNeural(colorType::WHITE) == b.evaluateNeural(colorType::WHITE));
+    check("mirrored start is even", a.evaluateNeural(colorType::WHITE) == a.evaluateNeural(colorType::BLACK));
+
+    // 잘린 파일은 거절, 기존 가중치 유지
+    if(std::FILE* f = std::fopen(path, "wb")) {
+        std::fputs("BCNN", f);
+        std::fclose(f);
+    }
+    check("truncated file rejected", !loaded.load(path));
+    check("weights kept after failed load", a.evaluateNeural(colorType::WHITE) == b.evaluateNeural(colorType::WHITE));
+    std::remove(path);
+
+    // 2. 특징 목록과 누적기
+    check("feature list matches accumulator", featuresMatchAccumulator(a, net));
+
+    // 3. 무작위 대국: 매 턴 증분 누적기가 전체 재계산과 같아야 한다
+    uint32_t seed = 99;
+    bool consistent = true;
+    int turns = 0;
+    for(int game = 0; game < 30 && consistent; ++game) {
+        bc_board played;
+        played.loadPositionString("4k^3/8/8/8/8/8/8/4K^3 w QB2N2R2P8AGHWDLFCTM/qb2n2r2p8aghwdlfctm - 1 1");
+        played.attachNetwork(&net);
+        for(int ply = 0; ply < 80 && consistent; ++ply) {
+            const colorType side = played.currentPlayerColor();
+            playRandomTurn(played, side, seed);
+            consistent = sameAsFullRebuild(played, net) && featuresMatchAccumulator(played, net);
+            if(!consistent) std::cout << "diverged at: " << played.getPositionString() << std::endl;
+            turns++;
+        }
+    }
+    std::cout << "random turns checked: " << turns << std::endl;
+    check("incremental accumulator matches refresh", consistent);
+
+    // 4. 커널별 결과가 같아야 한다
+    const nnueKernel original = nnueActiveKernel();
+    std::vector<int> reference;
+    bool kernelsAgree = true;
+    for(nnueKernel k : {nnueKernel::SCALAR, nnueKernel::SSE41, nnueKernel::AVX2}) {
+        if(!nnueSetKernel(k)) {
+            std::cout << "  " << nnueKernelName(k) << ": not supported" << std::endl;
+            continue;
+        }
+        bc_board board;
+        board.loadPositionString("4k^3/8/8/8/8/8/8/4K^3 w QB2N2R2P8AGHWDLFCTM/qb2n2r2p8aghwdlfctm - 1 1");
+        board.attachNetwork(&net);
+        uint32_t s = 5;
+        std::vector<int> scores;
+        for(int ply = 0; ply < 60; ++ply) {
+            const colorType side = board.currentPlayerColor();
+            playRandomTurn(board, side, s);
+            scores.push_back(board.evaluateNeural(side));
+        }
+        constexpr int ITERATIONS = 200000;
+        long long sink = 0;
+        const auto started = std::chrono::steady_clock::now();
+        for(int i = 0; i < ITERATIONS; ++i) sink += board.evaluateNeural((i & 1) ? colorType::BLACK : colorType::WHITE);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "  " << nnueKernelName(k) << ": " << (ns / ITERATIONS) << " ns/eval (sink=" << sink << ")" << std::endl;
+        if(reference.empty()) reference = scores;
+        else kernelsAgree = kernelsAgree && scores == reference;
+    }
+    nnueSetKernel(original);
+    check("all kernels agree", kernelsAgree);
+
+    // 5. 네트워크가 없으면 수제 평가
+    bc_board plain;
+    plain.loadPositionString(start);
+    check("fallback without network", !plain.hasNetwork() && plain.evaluateNeural(colorType::WHITE) == plain.evaluate(colorType::WHITE));
+
+    return check.finish();
+}
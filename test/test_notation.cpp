@@ -0,0 +1,93 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// 기보 표기 해석/재생 테스트: 보드의 합법수로 출발 칸을 찾고, printGameLog 출력을 그대로 재생할 수 있어야 한다
+int main() {
+    std::cout << "=== 기보 표기 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 구문 분석
+    notationToken t;
+    check("parse drop", parseNotation("Q@d4", t) && t.kind == notationKind::DROP && t.pT == pieceType::QUEEN);
+    check("parse fairy drop", parseNotation("H@c3", t) && t.pT == pieceType::KNIGHTRIDER);
+    check("parse two-letter drop", parseNotation("Cl@c3", t) && t.pT == pieceType::CAMEL);
+    check("code and symbol agree", parseNotation("Kr@c3", t) && t.pT == pieceType::KNIGHTRIDER &&
+          pieceFromName("knightrider") == pieceType::KNIGHTRIDER && pieceFromName("H") == pieceType::KNIGHTRIDER &&
+          pieceFromCode(pieceCode(pieceType::CAMEL)) == pieceFromSymbol(pieceSymbol(pieceType::CAMEL)));
+    check("parse long move", parseNotation("Pe2-e4", t) && t.kind == notationKind::MOVE &&
+          t.fromFile == 4 && t.fromRank == 1 && t.toFile == 4 && t.toRank == 3 && !t.take);
+    check("parse disambiguated capture", parseNotation("Nbxd7+", t) && t.fromFile == 1 && t.fromRank < 0 && t.take);
+    check("parse promotion suffix", parseNotation("exd8=N", t) && t.suffix == pieceType::KNIGHT);
+    check("parse succession", parseNotation("suc e5", t) && t.kind == notationKind::SUCCESSION && t.fromFile == 4);
+    check("parse stun", parseNotation("**e4", t) && t.kind == notationKind::STUN && t.stunDelta == 2);
+    check("reject garbage", !parseNotation("Xz9", t) && !parseNotation("e9", t) && !parseNotation("Q@", t));
+
+    // 2. 모호성 제거: 두 룩이 모두 d1에 갈 수 있다
+    bc_board board;
+    const std::string rooks = "4k^3/8/8/8/8/8/4K^(0,1)3/R(0,1)6R(0,1) w -/- - 5 5";
+    board.loadPositionString(rooks);
+    resolvedNotation r;
+    check("ambiguous rook move", board.resolveNotation("Rd1", r) == actionResult::AMBIGUOUS_NOTATION);
+    check("file disambiguation", board.resolveNotation("Rad1", r) == actionResult::OK && r.action.fromSquare == squareOf(0, 0));
+    check("rank-free apply", board.applyNotation("Rhf1") == actionResult::OK && board.getPiece(5, 0) != nullptr);
+
+    // 움직일 수 없는(스턴) 룩은 후보에서 밀려나므로 표기 없이도 하나로 정해진다
+    board.loadPositionString("4k^3/8/8/8/8/8/4K^(0,1)3/R(0,1)6R(2,0) w -/- - 5 5");
+    check("stunned rook ignored", board.resolveNotation("Rd1", r) == actionResult::OK && r.action.fromSquare == squareOf(0, 0));
+
+    // 3. 변장 / 계승 / 프로모션
+    board.loadPositionString("k^7/4P(0,1)3/8/8/8/8/8/4K^(0,1)3 w -/- - 5 5");
+    check("disguise notation", board.applyNotation("e1=Q") == actionResult::OK &&
+          board.getPiece(4, 0)->getDisguisedAs() == pieceType::QUEEN);
+    board.loadPositionString("k^7/4P(0,1)3/8/8/8/8/8/4K^(0,1)3 w -/- - 5 5");
+    check("promotion notation", board.applyNotation("e8=N") == actionResult::OK &&
+          board.getPiece(4, 7)->getPieceType() == pieceType::KNIGHT);
+    // 계승은 체크메이트일 때만: 움직일 수 없는 킹을 두 룩이 노린다
+    board.loadPositionString("k^3r(0,1)3/8/8/8/8/8/P7/r(0,1)3K^3 w -/- - 5 5");
+    check("succession notation", board.applyNotation("suc a2") == actionResult::OK && board.getPiece(0, 1)->isRoyal());
+
+    // 4. 기보 재생: 수 번호/주석/결과 표기를 건너뛰고 턴 경계를 자동으로 판단
+    bc_board replayed;
+    replayed.initializeBoard();
+    replayReport report = replayed.replayNotation("1. K@e1 K@e8 {kings} 2. P@e4 Q@e7 3. N@g1 *e4 4. -- -- 5. N@b8 1-0");
+    check("replay text", report.result == actionResult::OK && report.actionsApplied == 9);
+
+    bc_board manual;
+    manual.initializeBoard();
+    manual.placePiece(pieceType::KING, colorType::WHITE, 4, 0); manual.nextTurn();
+    manual.placePiece(pieceType::KING, colorType::BLACK, 4, 7); manual.nextTurn();
+    manual.placePiece(pieceType::PWAN, colorType::WHITE, 4, 3); manual.nextTurn();
+    manual.placePiece(pieceType::QUEEN, colorType::BLACK, 4, 6); manual.nextTurn();
+    manual.placePiece(pieceType::KNIGHT, colorType::WHITE, 6, 0); manual.nextTurn();
+    manual.passAndAddStun(4, 3); manual.nextTurn();
+    manual.nextTurn();
+    manual.placePiece(pieceType::KNIGHT, colorType::BLACK, 1, 7);
+    std::cout << "replayed: " << replayed.getPositionString() << std::endl;
+    check("replay matches manual play", replayed.getPositionString() == manual.getPositionString());
+
+    // 5. printGameLog 출력을 그대로 재생
+    std::ostringstream captured;
+    std::streambuf* old = std::cout.rdbuf(captured.rdbuf());
+    manual.printGameLog();
+    std::cout.rdbuf(old);
+    std::string logText = captured.str();
+    logText = logText.substr(logText.find('\n') + 1); // 머리말 줄 제거
+    std::cout << "log: " << logText;
+
+    bc_board fromLog;
+    fromLog.initializeBoard();
+    report = fromLog.replayNotation(logText);
+    check("replay printed log", report.result == actionResult::OK);
+
+    // 6. 실패 위치 보고
+    fromLog.initializeBoard();
+    const std::string bad = "1. K@e1 K@e8 2. Q@z9";
+    report = fromLog.replayNotation(bad);
+    check("first failure reported", report.result == actionResult::INVALID_NOTATION &&
+          bad.substr(report.errorOffset, report.errorLength) == "Q@z9" && report.actionsApplied == 2);
+
+    return check.finish();
+}
@@ -2,17 +2,17 @@
 #include <iostream>
 #include <vector>
 #include <chess.hpp>
+#include "test_check.hpp"
 
 void printPockets(const bc_board& board) {
     auto wp = board.getPocketStock(colorType::WHITE);
     auto bp = board.getPocketStock(colorType::BLACK);
     auto printSide = [](const char* label, const std::array<int, POCKET_SIZE>& p) {
-        std::cout << label << " [K Q B N R P A G Kr W D L F C Tr Cl] = "
-                  << p[0] << " " << p[1] << " " << p[2] << " "
-                  << p[3] << " " << p[4] << " " << p[5] << " " << p[6] << " "
-                  << p[7] << " " << p[8] << " " << p[9] << " " << p[10] << " "
-                  << p[11] << " " << p[12] << " " << p[13] << " " << p[14] << " "
-                  << p[15] << std::endl;
+        std::cout << label << " [";
+        for(const pieceTraits& traits : PIECE_TRAITS) std::cout << (traits.type == pieceType::KING ? "" : " ") << traits.code;
+        std::cout << "] =";
+        for(const pieceTraits& traits : PIECE_TRAITS) std::cout << " " << p[static_cast<size_t>(traits.pocket)];
+        std::cout << std::endl;
     };
     printSide("White", wp);
     printSide("Black", bp);
@@ -95,8 +95,9 @@ int main(){
     // 턴 7: 백 나이트 g1→f3 (이동 스택 소비 확인), 같은 턴 2회 이동 시도 실패
     std::cout << "\n[턴 " << turnLabel++ << "] 백: 나이트 g1→f3 이동 (move 스택 소비)" << std::endl;
     board.movePiece(6, 0, 5, 2);
-    bool secondMove = board.movePiece(5, 2, 4, 4); // 같은 턴 추가 이동 시도 (거절 예상)
-    std::cout << "  두 번째 이동 시도 결과: " << (secondMove ? "성공" : "거절") << std::endl;
+    actionResult secondMove = board.movePiece(5, 2, 4, 4); // 같은 턴 추가 이동 시도 (거절 예상)
+    std::cout << "  두 번째 이동 시도 결과: " << (secondMove == actionResult::OK ? "성공" : "거절")
+              << " (" << actionResultName(secondMove) << ")" << std::endl;
     printStacks("White knight", board.getPiece(5, 2));
     board.printBoard();
     printPockets(board);
@@ -108,6 +109,86 @@ int main(){
     std::cout << "누적 수: 백=" << board.getWhiteMoveCount() 
               << ", 흑=" << board.getBlackMoveCount() << std::endl;
 
-    return 0;
+    // 거절된 이동은 상태를 바꾸지 않고, 도착 칸 마스크는 합법수의 첫 이동을 따른다
+    std::cout << "\n=== 이동 검증 ===" << std::endl;
+    testChecker check;
+
+    bc_board probe;
+    probe.loadPositionString("4k^3/8/8/8/8/8/8/R(0,2)3K^3 w -/- - 5 5");
+    piece* rook = probe.getPiece(0, 0);
+    const int stackBefore = rook->getMoveStack();
+    const evalTerms termsBefore = probe.getEvalTerms(colorType::WHITE);
+    const int scoreBefore = probe.evaluate(colorType::WHITE);
+    check("illegal move rejected", probe.movePiece(0, 0, 1, 1) == actionResult::ILLEGAL_MOVE);
+    const evalTerms termsAfter = probe.getEvalTerms(colorType::WHITE);
+    check("move stack unchanged", rook->getMoveStack() == stackBefore);
+    check("eval terms unchanged", termsAfter.material == termsBefore.material && termsAfter.stunDebt == termsBefore.stunDebt &&
+                                  termsAfter.moveStacks == termsBefore.moveStacks && termsAfter.placement == termsBefore.placement &&
+                                  probe.evaluate(colorType::WHITE) == scoreBefore);
+    check("legal move accepted", probe.movePiece(0, 0, 0, 5) == actionResult::OK && probe.getPiece(0, 5) == rook &&
+                                 rook->getMoveStack() == stackBefore - 1);
+
+    // 같은 도착 칸 d4: 먼저 들어간 이동이 함께 잡는 칸을 정한다
+    PGN plain(3, 1, 3, 3, pieceType::ROOK, colorType::WHITE, false);
+    PGN jump(3, 1, 3, 3, pieceType::ROOK, colorType::WHITE, false);
+    jump.captureJumped = true;
+    jump.jumpedFile = 3;
+    jump.jumpedRank = 2;
+    rook->clearLegalMoves();
+    rook->addLegalMove(plain);
+    rook->addLegalMove(jump);
+    check("first plain move wins", rook->getJumpedSquare(squareOf(3, 3)) == -1 &&
+                                   (rook->getDestinationMask() >> squareOf(3, 3)) & 1);
+    rook->updateLegalMoves({jump, plain});
+    check("first jump move wins", rook->getJumpedSquare(squareOf(3, 3)) == squareOf(3, 2));
+    rook->clearLegalMoves();
+    check("cleared mask", rook->getDestinationMask() == 0 && rook->getJumpedSquare(squareOf(3, 3)) == -1);
+
+    // 합법 이동 목록은 조회할 때 만들고, 확인 칸이 바뀌지 않은 기물은 캐시를 유지한다
+    bc_board lazy;
+    lazy.loadPositionString("4k^3/8/8/8/8/8/8/R(0,2)3K^3 w -/- - 5 5");
+    piece* lazyRook = lazy.getPiece(0, 0);
+    piece* blackKing = lazy.getPiece(4, 7);
+    check("not built before query", !lazyRook->hasCachedLegalMoves() && !blackKing->hasCachedLegalMoves());
+    check("built on query", !blackKing->getLegalMoves().empty() && blackKing->hasCachedLegalMoves() &&
+                            !lazyRook->hasCachedLegalMoves());
+    check("lazy move accepted", lazy.movePiece(0, 0, 0, 4) == actionResult::OK);
+    check("untouched cache kept", blackKing->hasCachedLegalMoves() && !lazyRook->hasCachedLegalMoves());
+    check("moved piece rebuilt", (lazyRook->getDestinationMask() >> squareOf(0, 7)) & 1);
+
+    std::cout << "\n=== 액션 묶음 ===" << std::endl;
+    // 같은 기물의 연속 이동: 두 번째 이동은 첫 이동 뒤의 자리에서 검사해야 한다
+    const std::vector<boardAction> batch = {
+        boardAction::move(squareOf(0, 0), squareOf(0, 3)),
+        boardAction::move(squareOf(0, 3), squareOf(7, 3)),
+        boardAction::endTurn(),
+        boardAction::stun(squareOf(4, 7)),
+    };
+    bc_board batched;
+    bc_board stepped;
+    batched.loadPositionString("4k^3/8/8/8/8/8/8/R(0,2)3K^3 w -/- - 5 5");
+    stepped.loadPositionString("4k^3/8/8/8/8/8/8/R(0,2)3K^3 w -/- - 5 5");
+    for(const boardAction& a : batch) stepped.applyAction(a);
+    actionBatchReport report = batched.applyActions(batch);
+    check("batch applied", report.result == actionResult::OK && report.firstInvalid == batch.size());
+    check("batch matches single steps", batched.getPositionString() == stepped.getPositionString() &&
+                                        batched.getAttackMap(colorType::WHITE) == stepped.getAttackMap(colorType::WHITE) &&
+                                        batched.getAttackMap(colorType::BLACK) == stepped.getAttackMap(colorType::BLACK) &&
+                                        batched.evaluate(colorType::WHITE) == stepped.evaluate(colorType::WHITE));
+    check("moves rebuilt after batch", (batched.getPiece(7, 3)->getDestinationMask() >> squareOf(7, 7)) & 1);
+
+    // 거절된 액션에서 멈추고 그 앞까지만 적용된다
+    batched.loadPositionString("4k^3/8/8/8/8/8/8/R(0,2)3K^3 w -/- - 5 5");
+    const boardAction badBatch[] = {
+        boardAction::move(squareOf(0, 0), squareOf(0, 3)),
+        boardAction::move(squareOf(0, 3), squareOf(1, 4)),
+        boardAction::move(squareOf(0, 3), squareOf(0, 4)),
+    };
+    report = batched.applyActions(badBatch, 3);
+    check("first invalid index", report.result == actionResult::ILLEGAL_MOVE && report.firstInvalid == 1);
+    check("prefix applied", batched.getPiece(0, 3) != nullptr && batched.getPiece(0, 3)->getMoveStack() == 1 &&
+                            batched.isSquareAttacked(0, 7, colorType::WHITE));
+
+    return check.finish();
 }
 
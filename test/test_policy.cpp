@@ -0,0 +1,211 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <chess.hpp>
+#include <policy.hpp>
+#include "test_check.hpp"
+
+// 정책/가치 네트워크 테스트: 액션 번호 왕복, 합법 액션 목록, GEMM 커널 = 기준 구현, 가중치 파일 왕복, 배치 = 단일 추론
+namespace {
+
+const char* START = "r(0,1)n(0,1)b(0,1)q(0,1)k^b(0,1)n(0,1)r(0,1)/pppppppp/8/8/8/8/PPPPPPPP/R(0,1)N(0,1)B(0,1)Q(0,1)K^B(0,1)N(0,1)R(0,1) w QP/qp - 5 5";
+const char* DROP_START = "4k^3/8/8/8/8/8/8/4K^3 w QB2N2R2P8AGHWDLFCTM/qb2n2r2p8aghwdlfctm - 1 1";
+
+uint32_t nextRandom(uint32_t& seed, uint32_t bound) {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) % bound;
+}
+
+bool sameAction(const boardAction& a, const boardAction& b) {
+    return a.type == b.type && a.pT == b.pT && a.fromSquare == b.fromSquare && a.toSquare == b.toSquare;
+}
+
+void naiveGemm(int M, int N, int K, const float* A, const float* B, float* C) {
+    for(int m = 0; m < M; ++m) {
+        for(int n = 0; n < N; ++n) {
+            double sum = C[m * N + n];
+            for(int k = 0; k < K; ++k) sum += static_cast<double>(A[m * K + k]) * B[k * N + n];
+            C[m * N + n] = static_cast<float>(sum);
+        }
+    }
+}
+
+// 합법 액션을 무작위로 골라 한 턴 진행 (END_TURN이 나오거나 4번 액션하면 턴 종료)
+void playRandomTurn(bc_board& board, uint32_t& seed) {
+    std::vector<boardAction> actions;
+    for(int step = 0; step < 4; ++step) {
+        board.collectLegalActions(actions);
+        const boardAction a = actions[nextRandom(seed, static_cast<uint32_t>(actions.size()))];
+        board.applyAction(a);
+        if(a.type == actionType::END_TURN) return;
+    }
+    board.nextTurn();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 정책/가치 네트워크 테스트 ===" << std::endl;
+    testChecker check;
+
+    std::cout << "  actions: " << POLICY_ACTIONS << ", kernel: " << policyKernelName(policyActiveKernel()) << std::endl;
+
+    // 1. 액션 번호 <-> 액션 왕복 (양쪽 색)
+    bool roundTrip = true;
+    for(colorType c : {colorType::WHITE, colorType::BLACK}) {
+        for(int i = 0; i < POLICY_ACTIONS && roundTrip; ++i) {
+            roundTrip = policyIndex(policyAction(i, c), c) == i;
+            if(!roundTrip) std::cout << "index mismatch: " << i << std::endl;
+        }
+    }
+    check("policy index round trip", roundTrip);
+    check("black moves are mirrored", policyIndex(boardAction::move(squareOf(4, 6), squareOf(4, 4)), colorType::BLACK) ==
+                                      policyIndex(boardAction::move(squareOf(4, 1), squareOf(4, 3)), colorType::WHITE));
+
+    // 2. 합법 액션 목록: 모두 적용 가능하고 번호가 겹치지 않아야 한다
+    bool allApply = true;
+    bool distinct = true;
+    int listed = 0;
+    uint32_t seed = 17;
+    for(int game = 0; game < 4 && allApply && distinct; ++game) {
+        bc_board board;
+        board.loadPositionString(game % 2 ? START : DROP_START);
+        for(int ply = 0; ply < 24 && allApply && distinct; ++ply) {
+            const colorType mover = board.currentPlayerColor();
+            std::vector<boardAction> actions;
+            board.collectLegalActions(actions);
+            std::vector<bool> seen(POLICY_ACTIONS, false);
+            const std::string position = board.getPositionString();
+            for(const boardAction& a : actions) {
+                const int index = policyIndex(a, mover);
+                if(index < 0 || seen[index] || !sameAction(policyAction(index, mover), a)) {
+                    distinct = false;
+                    std::cout << "bad index for action at: " << position << std::endl;
+                    break;
+                }
+                seen[index] = true;
+                if(a.type == actionType::END_TURN) continue;
+                bc_board copy;
+                copy.loadPositionString(position);
+                if(copy.applyAction(a) != actionResult::OK) {
+                    allApply = false;
+                    std::cout << "rejected action " << static_cast<int>(a.type) << " at: " << position << std::endl;
+                    break;
+                }
+            }
+            listed += static_cast<int>(actions.size());
+            playRandomTurn(board, seed);
+        }
+    }
+    std::cout << "legal actions checked: " << listed << std::endl;
+    check("legal actions all apply", allApply);
+    check("legal action indices distinct", distinct);
+
+    // 3. GEMM 커널 = 기준 구현
+    {
+        const int M = 12, N = 80, K = 150;
+        std::vector<float> A(M * K), B(K * N), C0(M * N);
+        uint32_t s = 3;
+        for(auto& v : A) v = static_cast<float>(nextRandom(s, 2001)) / 1000.0f - 1.0f;
+        for(auto& v : B) v = static_cast<float>(nextRandom(s, 2001)) / 1000.0f - 1.0f;
+        for(auto& v : C0) v = static_cast<float>(nextRandom(s, 2001)) / 1000.0f - 1.0f;
+        std::vector<float> expected = C0;
+        naiveGemm(M, N, K, A.data(), B.data(), expected.data());
+
+        const policyKernel original = policyActiveKernel();
+        bool kernelsMatch = true;
+        for(policyKernel k : {policyKernel::SCALAR, policyKernel::SSE41, policyKernel::AVX2_FMA}) {
+            if(!policySetKernel(k)) {
+                std::cout << "  " << policyKernelName(k) << ": not supported" << std::endl;
+                continue;
+            }
+            std::vector<float> C = C0;
+            policyGemm(M, N, K, A.data(), K, B.data(), N, C.data(), N);
+            for(int i = 0; i < M * N; ++i) kernelsMatch = kernelsMatch && std::fabs(C[i] - expected[i]) < 1e-3f;
+        }
+        policySetKernel(original);
+        check("gemm kernels match reference", kernelsMatch);
+    }
+
+    // 4. 가중치 파일 왕복
+    policyNetwork net;
+    net.randomize(2024, 64, 2);
+    const char* path = "bc_test_policy.bcpv";
+    check("save", net.save(path));
+    policyNetwork loaded;
+    check("load", loaded.load(path) && loaded.hiddenSize() == 64 && loaded.blockCount() == 2);
+
+    bc_board start;
+    start.loadPositionString(START);
+    policyBatch single;
+    single.add(start);
+    policyWorkspace a, b;
+    net.forward(single, a);
+    loaded.forward(single, b);
+    check("loaded network gives same output", a.logits == b.logits && a.values == b.values);
+
+    if(std::FILE* f = std::fopen(path, "wb")) {
+        std::fputs("BCPV", f);
+        std::fclose(f);
+    }
+    check("truncated file rejected", !loaded.load(path) && loaded.ready());
+    std::remove(path);
+
+    // 5. 배치 추론 = 포지션별 단일 추론 (패딩 행이 결과에 섞이지 않음)
+    std::vector<bc_board> positions(7);
+    seed = 41;
+    for(size_t i = 0; i < positions.size(); ++i) {
+        positions[i].loadPositionString(i % 2 ? START : DROP_START);
+        for(size_t t = 0; t < i * 3; ++t) playRandomTurn(positions[i], seed);
+    }
+    policyBatch batch;
+    for(const auto& p : positions) batch.add(p);
+    policyWorkspace batched;
+    net.forward(batch, batched);
+    bool batchMatches = batched.values.size() == positions.size();
+    bool valuesBounded = true;
+    for(size_t i = 0; i < positions.size() && batchMatches; ++i) {
+        policyBatch one;
+        one.add(positions[i]);
+        policyWorkspace alone;
+        net.forward(one, alone);
+        for(int k = 0; k < POLICY_ACTIONS; ++k) batchMatches = batchMatches && std::fabs(alone.logitsOf(0)[k] - batched.logitsOf(i)[k]) < 1e-4f;
+        batchMatches = batchMatches && std::fabs(alone.values[0] - batched.values[i]) < 1e-5f;
+        valuesBounded = valuesBounded && batched.values[i] >= -1.0f && batched.values[i] <= 1.0f;
+    }
+    check("batched forward matches single", batchMatches);
+    check("values in [-1, 1]", valuesBounded);
+
+    // 6. 합법 액션 사전 확률
+    {
+        std::vector<boardAction> actions;
+        start.collectLegalActions(actions);
+        std::vector<int> indices;
+        for(const auto& act : actions) indices.push_back(policyIndex(act, colorType::WHITE));
+        std::vector<float> priors;
+        policyPriors(a.logitsOf(0), indices, priors);
+        float total = 0.0f;
+        for(float p : priors) total += p;
+        check("priors sum to one", priors.size() == indices.size() && std::fabs(total - 1.0f) < 1e-4f);
+    }
+
+    // 7. 처리량 (배치 256, 은닉 128, 블록 4)
+    {
+        policyNetwork bench;
+        bench.randomize(7, 128, 4);
+        policyBatch big;
+        for(int i = 0; i < 256; ++i) big.add(positions[static_cast<size_t>(i) % positions.size()]);
+        policyWorkspace work;
+        constexpr int ITERATIONS = 5;
+        const auto started = std::chrono::steady_clock::now();
+        for(int i = 0; i < ITERATIONS; ++i) bench.forward(big, work);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "  " << policyKernelName(policyActiveKernel()) << ": "
+                  << static_cast<long long>(ITERATIONS * big.size() / seconds) << " positions/sec" << std::endl;
+    }
+
+    return check.finish();
+}
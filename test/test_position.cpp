@@ -0,0 +1,75 @@
+#include <iostream>
+#include <string>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// 포지션 문자열 왕복 변환 테스트: export -> load -> export 결과가 같아야 한다
+int main() {
+    std::cout << "=== 포지션 문자열 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 기본 시작 포지션
+    bc_board board;
+    board.initializeBoard();
+    std::string start = board.getPositionString();
+    std::cout << "start: " << start << std::endl;
+    check("start position string", start == "8/8/8/8/8/8/8/8 w KQB2N2R2P8/kqb2n2r2p8 - 0 0");
+
+    // 2. 실제 진행으로 스턴/이동 스택/로얄/턴 상태를 만든 뒤 왕복
+    board.placePiece(pieceType::KING, colorType::WHITE, 4, 0);
+    board.nextTurn();
+    board.placePiece(pieceType::KING, colorType::BLACK, 4, 7);
+    board.nextTurn();
+    board.placePiece(pieceType::PWAN, colorType::WHITE, 4, 3);
+    std::string mid = board.getPositionString();
+    std::cout << "mid:   " << mid << std::endl;
+
+    bc_board loaded;
+    check("load mid-turn position", loaded.loadPositionString(mid));
+    check("mid-turn round trip", loaded.getPositionString() == mid);
+    check("turn state kept (second drop rejected)",
+          loaded.placePiece(pieceType::QUEEN, colorType::WHITE, 3, 3) == actionResult::ACTION_ALREADY_PERFORMED);
+
+    // 3. 손으로 쓴 포지션: 변장 로얄, 스택, 포켓, 페어리 기물
+    const std::string custom = "4k^3/8/3q^=q(3,0)4/8/3H(0,2)4/8/8/4K^(0,1)3 w QA2/m - 5 5";
+    check("load custom position", loaded.loadPositionString(custom));
+    std::cout << "custom: " << loaded.getPositionString() << std::endl;
+    check("custom round trip", loaded.getPositionString() == custom);
+    piece* disguised = loaded.getPiece(3, 5);
+    check("disguised royal flags", disguised && disguised->isRoyal() &&
+          disguised->getDisguisedAs() == pieceType::QUEEN && disguised->getStunStack() == 3);
+    piece* rider = loaded.getPiece(3, 3);
+    check("knightrider stacks and moves", rider && rider->getMoveStack() == 2 && !rider->getLegalMoves().empty());
+    check("camel pocket", loaded.getPocketCount(colorType::BLACK, pocketIndex::CAMEL) == 1);
+
+    // 4. 생략 필드 기본값
+    check("minimal fields", loaded.loadPositionString("4k3/8/8/8/8/8/8/4K3 b"));
+    check("minimal turn", loaded.getWhiteMoveCount() == 2 && loaded.getBlackMoveCount() == 1);
+
+    // 5. 잘못된 입력은 거절하고 보드를 유지
+    std::string before = loaded.getPositionString();
+    check("reject bad rank", !loaded.loadPositionString("4k3/8/8/8/8/8/8/4K2 w"));
+    check("reject bad symbol", !loaded.loadPositionString("4x3/8/8/8/8/8/8/4K3 w"));
+    check("reject inconsistent counts", !loaded.loadPositionString("4k3/8/8/8/8/8/8/4K3 w - - 2 1"));
+    check("reject negative counts", !loaded.loadPositionString("4k3/8/8/8/8/8/8/4K3 w -/- - -1 -1"));
+    check("reject empty active square", !loaded.loadPositionString("4k3/8/8/8/8/8/8/4K3 w -/- d4 1 1"));
+    check("accept stunned opponent active square", loaded.loadPositionString("4k3/8/8/8/8/8/8/4K3 w -/- e8 1 1"));
+    check("accept own active square", loaded.loadPositionString("4k3/8/8/8/8/8/8/4K3 w -/- e1 1 1") &&
+                                      loaded.loadPositionString(before));
+    check("board unchanged after reject", loaded.getPositionString() == before);
+
+    // 6. 바이너리 레코드 왕복 (포지션 문자열로 비교)
+    check("load custom for packing", loaded.loadPositionString(custom));
+    packedPosition record{};
+    loaded.encodePacked(record);
+    bc_board unpacked;
+    check("decode packed record", unpacked.decodePacked(record));
+    check("packed round trip", unpacked.getPositionString() == custom);
+    board.encodePacked(record);
+    check("decode mid-turn record", unpacked.decodePacked(record));
+    check("packed mid-turn round trip", unpacked.getPositionString() == mid);
+    record.squares[0] = 0x1F; // 존재하지 않는 기물 코드
+    check("reject bad packed record", !unpacked.decodePacked(record) && unpacked.getPositionString() == mid);
+
+    return check.finish();
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <chess.hpp>
+#include <search.hpp>
+#include "test_check.hpp"
+
+// 리프 배치 탐색 테스트: 방문 수 합계, 루트 액션 합법성, 배치가 실제로 묶이는지, 스레드/겹침 설정과 무관한 결과, 로얄 잡기 발견
+namespace {
+
+const char* START = "r(0,1)n(0,1)b(0,1)q(0,1)k^b(0,1)n(0,1)r(0,1)/pppppppp/8/8/8/8/PPPPPPPP/R(0,1)N(0,1)B(0,1)Q(0,1)K^B(0,1)N(0,1)R(0,1) w QP/qp - 5 5";
+const char* DROP_START = "4k^3/8/8/8/8/8/8/4K^3 w QB2N2R2P8AGHWDLFCTM/qb2n2r2p8aghwdlfctm - 1 1";
+const char* ROYAL_CAPTURE = "k^7/8/8/8/8/8/8/R(0,1)3K^3 w -/- - 5 5"; // Ra1xa8로 흑 로얄 소멸
+
+// 로짓 0, 가치 0 (균등 사전 확률) + 호출 횟수 기록
+struct uniformEvaluator {
+    size_t calls = 0;
+    size_t positions = 0;
+    void operator()(const policyBatch& batch, policyWorkspace& out) {
+        calls++;
+        positions += batch.size();
+        out.logitStride = POLICY_ACTIONS;
+        out.logits.assign(batch.size() * POLICY_ACTIONS, 0.0f);
+        out.values.assign(batch.size(), 0.0f);
+    }
+};
+
+std::vector<bc_board> makeRoots(size_t count) {
+    std::vector<bc_board> roots(count);
+    for(size_t i = 0; i < count; ++i) roots[i].loadPositionString(i % 2 ? START : DROP_START);
+    return roots;
+}
+
+std::vector<const bc_board*> pointersOf(const std::vector<bc_board>& boards) {
+    std::vector<const bc_board*> out;
+    for(const auto& b : boards) out.push_back(&b);
+    return out;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 리프 배치 탐색 테스트 ===" << std::endl;
+    testChecker check;
+
+    const std::vector<bc_board> roots = makeRoots(6);
+
+    // 1. 방문 수 합계와 루트 액션 합법성
+    searchConfig config;
+    config.simulations = 96;
+    config.leavesPerTree = 8;
+    config.threads = 4;
+    batchedSearch search(config);
+    uniformEvaluator counter;
+    check("run", search.run(pointersOf(roots), std::ref(counter)));
+
+    bool visitsAddUp = true;
+    bool rootActionsLegal = true;
+    for(size_t t = 0; t < search.treeCount(); ++t) {
+        const searchResult r = search.result(t);
+        int total = 0;
+        for(const auto& v : r.visits) total += v.second;
+        // 루트 자신의 첫 평가 1회를 뺀 나머지가 자식 방문
+        visitsAddUp = visitsAddUp && r.rootVisits == config.simulations && total == r.rootVisits - 1;
+
+        std::vector<boardAction> legal;
+        roots[t].collectLegalActions(legal);
+        const colorType mover = roots[t].currentPlayerColor();
+        for(const auto& v : r.visits) {
+            rootActionsLegal = rootActionsLegal && std::any_of(legal.begin(), legal.end(), [&](const boardAction& a) { return policyIndex(a, mover) == v.first; });
+        }
+        bc_board copy;
+        copy.loadPositionString(roots[t].getPositionString());
+        rootActionsLegal = rootActionsLegal && copy.applyAction(r.best) == actionResult::OK;
+    }
+    check("root visits add up", visitsAddUp);
+    check("root actions are legal", rootActionsLegal);
+
+    // 2. 리프가 실제로 배치로 묶인다 (평가기 호출 수 << 리프 수)
+    const searchStats& stats = search.stats();
+    std::cout << "  batches: " << stats.batches << ", leaves: " << stats.leaves << ", largest: " << stats.largestBatch
+              << ", terminal: " << stats.terminalLeaves << std::endl;
+    check("evaluator called once per batch", counter.calls == stats.batches && counter.positions == stats.leaves);
+    check("leaves are batched", stats.largestBatch > 1 && stats.batches * 4 <= stats.leaves);
+
+    // 3. 스레드 수 / 그룹 겹침과 무관하게 같은 결과
+    bool deterministic = true;
+    for(unsigned threads : {1u, 3u}) {
+        for(bool overlap : {false, true}) {
+            searchConfig other = config;
+            other.threads = threads;
+            other.overlap = overlap;
+            batchedSearch again(other);
+            uniformEvaluator e;
+            again.run(pointersOf(roots), std::ref(e));
+            for(size_t t = 0; t < roots.size(); ++t) {
+                deterministic = deterministic && again.result(t).visits == search.result(t).visits;
+            }
+        }
+    }
+    check("results independent of threads and overlap", deterministic);
+
+    // 4. 로얄 피스를 잡는 수를 찾는다
+    {
+        bc_board capture;
+        capture.loadPositionString(ROYAL_CAPTURE);
+        searchConfig cfg;
+        cfg.simulations = 400;
+        cfg.threads = 2;
+        batchedSearch finder(cfg);
+        uniformEvaluator e;
+        finder.run({&capture}, std::ref(e));
+        const searchResult r = finder.result(0);
+        check("finds royal capture", r.best.type == actionType::MOVE && r.best.fromSquare == squareOf(0, 0) && r.best.toSquare == squareOf(0, 7));
+        check("winning root value", r.value > 0.5f);
+    }
+
+    // 5. 평가기 출력 크기가 틀리면 중단
+    {
+        batchedSearch broken(config);
+        const bool ok = broken.run(pointersOf(roots), [](const policyBatch&, policyWorkspace& out) {
+            out.logitStride = POLICY_ACTIONS;
+            out.logits.clear();
+            out.values.clear();
+        });
+        check("malformed evaluator output rejected", !ok);
+    }
+
+    // 6. 정책/가치 네트워크를 평가기로
+    {
+        policyNetwork net;
+        net.randomize(11, 32, 1);
+        batchedSearch withNet(config);
+        const bool ok = withNet.run(pointersOf(roots), networkEvaluator(net));
+        bool legal = ok;
+        for(size_t t = 0; t < roots.size() && legal; ++t) {
+            bc_board copy;
+            copy.loadPositionString(roots[t].getPositionString());
+            legal = copy.applyAction(withNet.result(t).best) == actionResult::OK;
+        }
+        check("network evaluator search", legal);
+        std::cout << "  network: " << withNet.stats().leaves << " leaves in " << withNet.stats().totalSeconds << " s ("
+                  << withNet.stats().evaluatorSeconds << " s evaluating)" << std::endl;
+    }
+
+    return check.finish();
+}
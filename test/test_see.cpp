@@ -0,0 +1,55 @@
+#include <iostream>
+#include <chess.hpp>
+#include "test_check.hpp"
+
+// 정적 교환 평가 테스트: 스턴/이동 스택 이전, 로얄 스턴 페널티, 뒤에 숨은 기물(x-ray)을 반영해야 한다
+int main() {
+    std::cout << "=== 정적 교환 평가 테스트 ===" << std::endl;
+    testChecker check;
+
+    bc_board board;
+    constexpr int P = SEE_PIECE_SCALE;
+
+    // 1. 폰이 지키는 폰을 룩으로 잡음: 폰 - 룩
+    board.loadPositionString("k^7/8/2p(0,1)5/3p4/8/8/8/3R(0,1)2K^1 w -/- - 5 5");
+    int see = board.staticExchange(3, 0, 3, 4);
+    std::cout << "  RxP defended: " << see << std::endl;
+    check("defended pawn loses the rook", see == 1 * P - 5 * P);
+    check("threshold query", !board.staticExchangeAtLeast(3, 0, 3, 4, 0));
+
+    // 2. 스턴 4인 퀸을 공짜로 잡음: 퀸 가치 - 이어받는 스턴 비용
+    board.loadPositionString("k^7/8/8/3q(4,0)4/8/8/8/3R(0,1)2K^1 w -/- - 5 5");
+    see = board.staticExchange(3, 0, 3, 4);
+    check("stunned queen costs its stun", see == 9 * P - 4 * SEE_STUN_COST);
+
+    // 3. 스턴 8인 폰은 잡으면 오히려 손해 (8턴 묶임)
+    board.loadPositionString("k^7/8/8/3p(8,0)4/8/4N(0,1)3/8/6K^1 w -/- - 5 5");
+    see = board.staticExchange(4, 2, 3, 4);
+    std::cout << "  NxP(stun 8): " << see << std::endl;
+    check("stun-poisoned capture is negative", see < 0);
+
+    // 4. 이어받는 이동 스택은 이득
+    board.loadPositionString("k^7/8/8/3p(0,3)4/8/4N(0,1)3/8/6K^1 w -/- - 5 5");
+    check("move stacks are inherited", board.staticExchange(4, 2, 3, 4) == 1 * P + 3 * SEE_MOVE_STACK_VALUE);
+
+    // 5. 로얄 피스를 잡으면 상대 전체가 스턴되어 퀸이 되잡지 못함
+    board.loadPositionString("8/8/3q(0,1)4/3k^4/8/8/8/3R(0,1)2K^1 w -/- - 5 5");
+    see = board.staticExchange(3, 0, 3, 4);
+    check("royal capture ends the exchange", see == 4 * P + SEE_STUN_COST * SEE_ROYAL_STUN * 2);
+
+    // 6. x-ray: d2 룩이 잡고 d8 룩이 되잡으면 d1 룩이 다시 잡는다 -> 흑은 되잡지 않는 편이 낫다
+    board.loadPositionString("k^2r(0,1)4/8/8/3n4/8/8/3R(0,1)4/3R(0,1)2K^1 w -/- - 5 5");
+    see = board.staticExchange(3, 1, 3, 4);
+    std::cout << "  RxN with battery: " << see << std::endl;
+    check("x-ray recapture counted", see == 3 * P);
+    board.loadPositionString("k^2r(0,1)4/8/8/3n4/8/8/3R(0,1)4/6K^1 w -/- - 5 5");
+    check("without battery the rook is lost", board.staticExchange(3, 1, 3, 4) == 3 * P - 5 * P);
+
+    // 7. 스턴 중이거나 이동 스택이 없는 기물은 되잡지 못함
+    board.loadPositionString("k^7/8/2p(1,1)5/3p4/8/8/8/3R(0,1)2K^1 w -/- - 5 5");
+    check("stunned defender ignored", board.staticExchange(3, 0, 3, 4) == 1 * P);
+    board.loadPositionString("k^7/8/2p5/3p4/8/8/8/3R(0,1)2K^1 w -/- - 5 5");
+    check("defender without move stack ignored", board.staticExchange(3, 0, 3, 4) == 1 * P);
+
+    return check.finish();
+}
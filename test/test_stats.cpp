@@ -0,0 +1,117 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <chess.hpp>
+#include <threadpool.hpp>
+#include "test_check.hpp"
+
+// 계측 카운터 테스트 (BC_ENABLE_STATS=1로 빌드): 액션/캡처/스턴 틱/재계산/지연 생성/패턴별 이동/할당/메서드 시간,
+// 거절된 액션은 세지 않음, 여러 스레드 합산, 초기화
+namespace {
+
+const char* ROOK_TAKES = "4k^3/8/8/8/p7/8/8/R(0,2)3K^3 w -/- - 5 5";
+const char* STUNNED_ROOK = "4k^3/8/8/8/8/8/8/R(2,0)3K^3 w -/- - 5 5";
+
+uint64_t total(const std::array<uint64_t, PATTERN_KIND_COUNT>& counts) {
+    uint64_t sum = 0;
+    for(uint64_t c : counts) sum += c;
+    return sum;
+}
+
+int patternIndex(moveType m, threatType t) {
+    return static_cast<int>(m) * THREAT_TYPE_COUNT + static_cast<int>(t);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 계측 카운터 테스트 ===" << std::endl;
+    testChecker check;
+
+    check("enabled in this build", ENGINE_STATS_ENABLED);
+    check("method name", std::strcmp(boardMethodName(boardMethod::MOVE_PIECE), "movePiece") == 0);
+    check("pattern name", std::strcmp(patternKindName(patternIndex(moveType::RAY_FINITE, threatType::TAKEMOVE)), "RAY_FINITE/TAKEMOVE") == 0);
+
+    // 1. 이동 + 캡처
+    bc_board board;
+    board.loadPositionString(ROOK_TAKES);
+    resetEngineStats();
+    check("move accepted", board.movePiece(0, 0, 0, 3) == actionResult::OK);
+    engineStats s = readEngineStats();
+    check("one action", s.actions == 1);
+    check("one capture", s.captures == 1);
+    check("recomputed once", s.legalMoveRecomputes == 1 && s.piecesRegenerated >= 1);
+    check("movePiece timed", s.methodCalls[static_cast<size_t>(boardMethod::MOVE_PIECE)] == 1 &&
+                             s.methodNanos[static_cast<size_t>(boardMethod::MOVE_PIECE)] > 0);
+    check("pieces per action", s.piecesPerAction() == static_cast<double>(s.piecesRegenerated));
+
+    // 2. 거절된 액션은 액션으로 세지 않는다 (호출/시간은 센다)
+    check("move rejected", board.movePiece(0, 3, 7, 7) != actionResult::OK);
+    s = readEngineStats();
+    check("rejected not counted", s.actions == 1 && s.methodCalls[static_cast<size_t>(boardMethod::MOVE_PIECE)] == 2);
+
+    // 3. 턴 종료: applyAction -> nextTurn (포함 시간이라 둘 다 센다)
+    boardAction end;
+    end.type = actionType::END_TURN;
+    check("end turn", board.applyAction(end) == actionResult::OK);
+    s = readEngineStats();
+    check("end turn counted", s.actions == 2 && s.methodCalls[static_cast<size_t>(boardMethod::APPLY_ACTION)] == 1 &&
+                              s.methodCalls[static_cast<size_t>(boardMethod::NEXT_TURN)] == 1);
+
+    // 4. 스턴 틱
+    board.loadPositionString(STUNNED_ROOK);
+    resetEngineStats();
+    board.nextTurn();
+    check("stun tick", readEngineStats().stunTicks == 1);
+
+    // 5. 패턴별 생성 이동: 룩은 RAY_INFINITE/TAKEMOVE, 킹은 RAY_FINITE/TAKEMOVE
+    //    합법 이동 목록은 조회할 때 만들어지므로 재계산만으로는 세지 않는다
+    board.loadPositionString(ROOK_TAKES);
+    resetEngineStats();
+    board.updateAllLegalMoves();
+    s = readEngineStats();
+    check("lists not built by recompute", s.legalMoveLists == 0 && total(s.movesByPattern) == 0);
+    const std::pair<int, int> squares[] = {{0, 0}, {0, 3}, {4, 7}, {4, 0}};
+    for(const auto& [f, r] : squares) board.getPiece(f, r)->getLegalMoves();
+    board.getPiece(0, 0)->getLegalMoves(); // 두 번째 조회는 캐시
+    s = readEngineStats();
+    check("lists built on query", s.legalMoveLists == 4);
+    check("moves by pattern", s.movesByPattern[static_cast<size_t>(patternIndex(moveType::RAY_INFINITE, threatType::TAKEMOVE))] > 0 &&
+                              s.movesByPattern[static_cast<size_t>(patternIndex(moveType::RAY_FINITE, threatType::TAKEMOVE))] > 0);
+    check("full recompute counted", s.legalMoveRecomputes == 1 && s.piecesRegenerated == 4);
+
+    // 6. 할당
+    resetEngineStats();
+    auto block = std::make_unique<std::vector<int>>(100);
+    check("allocations counted", readEngineStats().allocations >= 2 && block->size() == 100);
+
+    // 7. 여러 스레드 합산
+    {
+        threadPool pool(4);
+        std::vector<std::unique_ptr<bc_board>> boards;
+        for(int i = 0; i < 8; ++i) {
+            boards.push_back(std::make_unique<bc_board>());
+            boards.back()->loadPositionString(ROOK_TAKES);
+        }
+        resetEngineStats();
+        pool.parallelFor(0, boards.size(), 1, [&](size_t b, size_t e) {
+            for(size_t i = b; i < e; ++i) {
+                for(int k = 0; k < 100; ++k) boards[i]->updateAllLegalMoves();
+            }
+        });
+        s = readEngineStats();
+        check("threads summed", s.legalMoveRecomputes == 800 && s.piecesRegenerated == 3200 &&
+                                s.methodCalls[static_cast<size_t>(boardMethod::UPDATE_ALL_LEGAL_MOVES)] == 800);
+    }
+
+    // 8. 초기화
+    resetEngineStats();
+    s = readEngineStats();
+    check("reset", s.actions == 0 && s.legalMoveRecomputes == 0 && total(s.movesByPattern) == 0 &&
+                   s.methodCalls[static_cast<size_t>(boardMethod::UPDATE_ALL_LEGAL_MOVES)] == 0);
+
+    return check.finish();
+}
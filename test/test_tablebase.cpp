@@ -0,0 +1,182 @@
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chess.hpp>
+#include <tablebase.hpp>
+#include <threadpool.hpp>
+#include "test_check.hpp"
+
+// 테이블베이스 테스트: 인덱스 왕복, 후속 그래프 풀이(승/패 거리, 결정성), 실제 로얄 둘 표 빌드와 즉시 승리 판정,
+// 압축 파일 mmap 조회 왕복, 손상 파일 거절, 탐색에서의 조회
+namespace {
+
+// 흑 킹이 백 킹 옆: 움직일 수 있는 쪽이 이번 턴에 잡는다
+const char* WHITE_CAPTURES = "8/8/8/8/8/8/4k^3/4K^(0,1)3 w -/- - 5 5";
+const char* WHITE_STUNNED = "8/8/8/8/8/8/4k^3/4K^(1,1)3 w -/- - 5 5";
+const char* FAR_APART = "7k^(0,1)/8/8/8/8/8/8/K^(0,1)7 w -/- - 5 5";
+const char* WITH_ROOK = "7k^(0,1)/8/8/8/8/8/8/K^(0,1)R(0,1)6 w -/- - 5 5";
+const char* ROOK_IN_POCKET = "7k^(0,1)/8/8/8/8/8/8/K^(0,1)7 w R/- - 5 5";
+
+uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+bool indexOfString(const tablebaseIndexer& indexer, const char* text, uint64_t& index) {
+    bc_board board;
+    if(!board.loadPositionString(text)) return false;
+    packedPosition packed;
+    board.encodePacked(packed);
+    return indexer.indexOf(packed, index);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 테이블베이스 테스트 ===" << std::endl;
+    testChecker check;
+
+    // 1. 서명
+    tablebaseSignature rook;
+    rook.stunHorizon = 1;
+    rook.moveHorizon = 1;
+    check("signature letters", tablebaseSignature::fromLetters("R", "K", rook) && rook.name() == "K:R s1m1");
+    tablebaseSignature bad;
+    check("reject royal extras", !tablebaseSignature::fromLetters("K", "K", bad));
+    check("reject royals without king", !tablebaseSignature::fromLetters("R", "Q", bad));
+
+    // 2. 인덱스 왕복: 유효 인덱스 -> 포지션 -> bc_board -> 인덱스
+    {
+        const tablebaseIndexer indexer(rook);
+        uint64_t rng = 11;
+        int valid = 0;
+        bool roundTrip = true;
+        packedPosition p, q;
+        bc_board board;
+        for(int i = 0; i < 4000; ++i) {
+            const uint64_t index = nextRandom(rng) % indexer.size();
+            if(!indexer.positionOf(index, p)) continue;
+            valid++;
+            uint64_t back = 0;
+            board.decodePacked(p);
+            board.encodePacked(q);
+            roundTrip = roundTrip && indexer.indexOf(q, back) && back == index;
+        }
+        check("index round trip", valid > 1000 && roundTrip);
+
+        uint64_t onBoard = 0, inPocket = 0;
+        check("rook on board indexed", indexOfString(indexer, WITH_ROOK, onBoard));
+        check("rook in pocket indexed", indexOfString(indexer, ROOK_IN_POCKET, inPocket) && inPocket != onBoard);
+        uint64_t none = 0;
+        check("other material rejected", !indexOfString(indexer, FAR_APART, none));
+        check("mid-turn rejected", !indexOfString(indexer, "7k^(0,1)/8/8/8/8/8/8/K^(0,1)R(0,1)6 w -/- a1 5 5", none));
+    }
+
+    // 3. 후속 그래프 풀이
+    threadPool pool(4);
+    {
+        retrogradeGraph g;
+        // 0: 즉시 승, 1 -> {0}, 2 -> {1, 3}, 3 -> {3}, 4 -> {0, 2}, 5 -> {0} + 출구, 6: 무효
+        const std::vector<std::vector<uint32_t>> edges = {{}, {0}, {1, 3}, {3}, {0, 2}, {0}, {}};
+        g.flags = {RETRO_VALID | RETRO_WIN_NOW, RETRO_VALID, RETRO_VALID, RETRO_VALID, RETRO_VALID, RETRO_VALID | RETRO_EXIT, 0};
+        g.offsets.push_back(0);
+        for(const auto& e : edges) {
+            g.successors.insert(g.successors.end(), e.begin(), e.end());
+            g.offsets.push_back(g.successors.size());
+        }
+        std::vector<int16_t> values;
+        const int passes = solveRetrograde(g, pool, values);
+        const std::vector<int16_t> expected = {1, -2, 3, 0, -4, 0, TABLEBASE_INVALID};
+        check("retrograde distances", values == expected && passes == 4);
+        threadPool single(1);
+        std::vector<int16_t> again;
+        solveRetrograde(g, single, again);
+        check("retrograde independent of threads", again == values);
+    }
+
+    // 4. 로얄 둘 표 빌드
+    tablebaseSignature kings;
+    kings.stunHorizon = 1;
+    kings.moveHorizon = 1;
+    tablebaseSignature::fromLetters("", "K", kings);
+    std::vector<int16_t> values;
+    tablebaseBuildStats stats;
+    check("build", buildTablebase(kings, pool, values, stats));
+    std::cout << "  indices: " << stats.indices << ", positions: " << stats.positions << " (win " << stats.wins
+              << ", loss " << stats.losses << "), passes: " << stats.passes << ", " << stats.seconds << " s, "
+              << static_cast<long long>(stats.positions / (stats.seconds > 0.0 ? stats.seconds : 1e-9)) << " positions/sec" << std::endl;
+    check("positions counted", stats.positions == stats.wins + stats.losses + stats.draws && stats.wins > 0 && stats.draws > 0);
+    // 혼자 남은 킹 둘: 상대 로얄을 스턴할 수 있어 패배는 증명되지 않는다 (스레드 수와 무관한 결과는 3에서 확인)
+    check("kings alone never lost", stats.losses == 0);
+
+    // 5. 저장 -> mmap 조회
+    const std::string path = "bc_test_tablebase.bctb";
+    std::remove(path.c_str());
+    check("save", saveTablebase(path, kings, values));
+    tablebase table;
+    check("open", table.open(path) && table.signature() == kings && table.size() == values.size());
+    std::cout << "  file: " << table.fileSize() << " bytes for " << values.size() << " indices" << std::endl;
+    check("compressed", table.fileSize() < values.size() / 2);
+    bool same = true;
+    for(uint64_t i = 0; i < values.size(); ++i) {
+        if(values[i] != TABLEBASE_INVALID && table.valueAt(i) != values[i]) same = false;
+    }
+    check("values round trip", same);
+
+    {
+        bc_board board;
+        int value = 0;
+        board.loadPositionString(WHITE_CAPTURES);
+        check("probe immediate win", table.probe(board, value) && value == 1);
+        board.loadPositionString(WHITE_STUNNED);
+        check("probe stunned king", table.probe(board, value) && value != 1);
+        board.loadPositionString(FAR_APART);
+        check("probe far apart", table.probe(board, value) && value == 0);
+        board.loadPositionString(WITH_ROOK);
+        check("probe outside domain", !table.probe(board, value));
+        // 지평선보다 큰 스택은 포화시켜 조회
+        board.loadPositionString("8/8/8/8/8/8/4k^3/4K^(0,3)3 w -/- - 5 5");
+        check("probe clamps stacks", table.probe(board, value) && value == 1);
+    }
+
+    // 6. 탐색에서 조회
+    {
+        tablebaseSet set;
+        check("set add", set.add(path) && set.size() == 1);
+        bc_board board;
+        board.loadPositionString(WHITE_CAPTURES);
+        ismctsConfig cfg;
+        cfg.iterations = 200;
+        cfg.rolloutActions = 8;
+        cfg.tables = &set;
+        const ismctsResult r = informationSetSearch(board, cfg, &pool);
+        check("search with tables", r.best.type == actionType::MOVE && r.best.toSquare == squareOf(4, 1));
+    }
+    table.close();
+
+    // 7. 손상 파일 거절
+    {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        std::vector<char> bytes;
+        for(int c = std::fgetc(f); c != EOF; c = std::fgetc(f)) bytes.push_back(static_cast<char>(c));
+        std::fclose(f);
+
+        f = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size() - 1, f);
+        std::fclose(f);
+        check("reject truncated", !table.open(path) && !table.isOpen());
+
+        bytes[8] = 20; // 스턴 지평선 범위 밖
+        f = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), f);
+        std::fclose(f);
+        check("reject bad header", !table.open(path));
+    }
+    std::remove(path.c_str());
+
+    return check.finish();
+}
@@ -0,0 +1,44 @@
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <threadpool.hpp>
+#include "test_check.hpp"
+
+// 작업 훔치기 스레드 풀 테스트: 작업 안에서 추가 제출한 작업까지 모두 끝난 뒤 wait()가 돌아와야 한다
+int main() {
+    std::cout << "=== 스레드 풀 테스트 ===" << std::endl;
+    testChecker check;
+
+    threadPool pool(4);
+    check("worker count", pool.size() == 4);
+
+    // 1. parallelFor: 모든 인덱스를 정확히 한 번씩
+    std::vector<std::atomic<int>> hits(10000);
+    pool.parallelFor(0, hits.size(), 37, [&](size_t b, size_t e) {
+        for(size_t i = b; i < e; ++i) hits[i].fetch_add(1);
+    });
+    bool once = true;
+    for(const auto& h : hits) once = once && h.load() == 1;
+    check("parallelFor covers each index once", once);
+
+    // 2. 작업 안에서 다시 제출 (자기 큐 -> 다른 워커가 훔쳐 감)
+    std::atomic<int> leaves{0};
+    for(int i = 0; i < 8; ++i) {
+        pool.submit([&] {
+            for(int j = 0; j < 100; ++j) pool.submit([&] { leaves.fetch_add(1); });
+        });
+    }
+    pool.wait();
+    check("nested submissions finish before wait returns", leaves.load() == 800);
+
+    // 3. 재사용
+    std::atomic<long long> sum{0};
+    pool.parallelFor(1, 1001, 10, [&](size_t b, size_t e) {
+        long long local = 0;
+        for(size_t i = b; i < e; ++i) local += static_cast<long long>(i);
+        sum.fetch_add(local);
+    });
+    check("pool reusable", sum.load() == 500500);
+
+    return check.finish();
+}
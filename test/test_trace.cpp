@@ -0,0 +1,117 @@
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chess.hpp>
+#include <threadpool.hpp>
+#include "test_check.hpp"
+
+// 트레이스 테스트 (BC_ENABLE_TRACE=1로 빌드): 기록 전/후 구간은 버림, 액션/재계산/패턴 구간,
+// 스레드별 버퍼, 링 버퍼 덮어쓰기, Chrome JSON 형식, 파일 쓰기
+namespace {
+
+const char* ROOK_TAKES = "4k^3/8/8/8/p7/8/8/R(0,2)3K^3 w -/- - 5 5";
+
+bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t n = 0;
+    for(size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) n++;
+    return n;
+}
+
+// 문자열 밖의 괄호 짝
+bool balanced(const std::string& json) {
+    int depth = 0;
+    bool inString = false;
+    for(size_t i = 0; i < json.size(); ++i) {
+        const char c = json[i];
+        if(inString) {
+            if(c == '\\') i++;
+            else if(c == '"') inString = false;
+            continue;
+        }
+        if(c == '"') inString = true;
+        else if(c == '{' || c == '[') depth++;
+        else if(c == '}' || c == ']') depth--;
+        if(depth < 0) return false;
+    }
+    return depth == 0 && !inString;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 트레이스 테스트 ===" << std::endl;
+    testChecker check;
+
+    check("enabled in this build", ENGINE_TRACE_ENABLED);
+
+    // 1. 기록 전에는 아무것도 남지 않는다
+    bc_board board;
+    board.loadPositionString(ROOK_TAKES);
+    check("not tracing before start", !isTracing());
+
+    // 2. 액션 하나: movePiece 안에 재계산, 그 안에 패턴 구간
+    startTrace();
+    setTraceThreadName("main \"ui\"");
+    check("tracing", isTracing());
+    check("move", board.movePiece(0, 0, 0, 3) == actionResult::OK);
+    stopTrace();
+    board.nextTurn(); // 멈춘 뒤는 기록하지 않는다
+    const traceSummary one = summarizeTrace();
+    check("events recorded", one.events >= 3 && one.dropped == 0 && one.threads == 1);
+    const std::string json = traceJson();
+    check("json framing", json.rfind("{\"traceEvents\":[", 0) == 0 && balanced(json));
+    check("method event", contains(json, "\"name\":\"movePiece\",\"cat\":\"board\",\"ph\":\"X\""));
+    check("regeneration event", contains(json, "\"name\":\"refreshLegalMoves\""));
+    check("pattern event", contains(json, "\"cat\":\"pattern\""));
+    check("stopped events dropped", !contains(json, "\"name\":\"nextTurn\""));
+    check("thread name escaped", contains(json, "main \\\"ui\\\""));
+
+    // 3. 여러 스레드: 워커마다 버퍼 하나
+    {
+        threadPool pool(3);
+        std::vector<std::unique_ptr<bc_board>> boards;
+        for(int i = 0; i < 6; ++i) {
+            boards.push_back(std::make_unique<bc_board>());
+            boards.back()->loadPositionString(ROOK_TAKES);
+        }
+        startTrace();
+        pool.parallelFor(0, boards.size(), 1, [&](size_t b, size_t e) {
+            for(size_t i = b; i < e; ++i) boards[i]->updateAllLegalMoves();
+        });
+        const std::string threaded = traceJson();
+        check("worker threads named", contains(threaded, "worker "));
+        check("one update per board", countOf(threaded, "\"name\":\"updateAllLegalMoves\"") == 6);
+        check("previous trace cleared", !contains(threaded, "\"name\":\"movePiece\""));
+        check("threaded json balanced", balanced(threaded));
+    }
+
+    // 4. 링 버퍼: 가득 차면 오래된 것부터 덮어쓴다
+    startTrace(8);
+    for(int i = 0; i < 50; ++i) board.updateAllLegalMoves();
+    stopTrace();
+    const traceSummary ring = summarizeTrace();
+    check("ring keeps capacity", ring.events == 8 && ring.dropped > 0);
+    const std::string wrapped = traceJson();
+    check("dropped reported", contains(wrapped, "\"dropped\":" + std::to_string(ring.dropped)));
+    check("newest kept", contains(wrapped, "\"name\":\"updateAllLegalMoves\""));
+
+    // 5. 파일
+    const std::string path = "bc_test_trace.json";
+    check("write trace", writeTrace(path));
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    std::string written;
+    if(f != nullptr) {
+        for(int c = std::fgetc(f); c != EOF; c = std::fgetc(f)) written.push_back(static_cast<char>(c));
+        std::fclose(f);
+    }
+    check("file matches", written == wrapped);
+    std::remove(path.c_str());
+
+    return check.finish();
+}
@@ -9,6 +9,9 @@
 #       "black": {"K":1, "Q":1, "B":2, "N":2, "R":2, "P":8},
 #   }
 # }
+#
+# 또는 엔진 포지션 문자열 (src/position.cpp 참고, Board.position_string()으로 내보낸 값 그대로 사용 가능):
+#   "4k^(0,1)3/8/8/8/8/8/8/4K^(0,1)3 w KQB2N2R2P8/kqb2n2r2p8"
 
 POSITIONS = {
     # 이동 스택 테스트 (기본: 백선)
@@ -111,13 +114,13 @@ POSITIONS = {
     "royal_succession_test": {
         "turn": "white",
         "pieces": [
-            {"type": "K", "color": "white", "file": 4, "rank": 4, "stun": 1, "move_stack": 0},  # 체크 상태의 로얄 피스
+            {"type": "K", "color": "white", "file": 4, "rank": 4, "stun": 1, "move_stack": 0},  # 체크메이트된 로얄 피스 (스턴)
             {"type": "K", "color": "black", "file": 4, "rank": 7, "stun": 0, "move_stack": 1},
-            {"type": "Q", "color": "white", "file": 3, "rank": 3, "stun": 0, "move_stack": 2},  # 새 로얄 후보
-            {"type": "R", "color": "white", "file": 5, "rank": 3, "stun": 0, "move_stack": 1},
-            {"type": "N", "color": "white", "file": 6, "rank": 4, "stun": 0, "move_stack": 1},
-            {"type": "R", "color": "black", "file": 4, "rank": 5, "stun": 0, "move_stack": 1},  # 흑 룩이 백 킹 공격
-            {"type": "Q", "color": "black", "file": 3, "rank": 6, "stun": 0, "move_stack": 1},
+            {"type": "Q", "color": "white", "file": 3, "rank": 3, "stun": 0, "move_stack": 0},  # 새 로얄 후보
+            {"type": "R", "color": "white", "file": 5, "rank": 3, "stun": 0, "move_stack": 0},
+            {"type": "N", "color": "white", "file": 6, "rank": 4, "stun": 0, "move_stack": 0},
+            {"type": "R", "color": "black", "file": 4, "rank": 5, "stun": 0, "move_stack": 1},  # 흑 룩과 퀸이 붙어서 백 킹 공격
+            {"type": "Q", "color": "black", "file": 3, "rank": 5, "stun": 0, "move_stack": 1},  # (스턴은 하나만 막음)
         ],
         "pockets": {
             "white": {"K":1, "Q":0, "B":2, "N":2, "R":1, "P":8},
@@ -146,6 +149,8 @@ def get_position(name, turn_override=None):
     pos = POSITIONS.get(base_name)
     if not pos:
         return {}
+    if isinstance(pos, str):
+        return pos  # 포지션 문자열은 차례를 직접 포함하므로 그대로 반환
     data = _copy_position(pos)
     if turn_override:
         data["turn"] = turn_override
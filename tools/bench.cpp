@@ -0,0 +1,445 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <chess.hpp>
+
+/* bc_bench: 엔진 핫 패스 마이크로벤치마크.
+
+     bc_bench [-f 이름 필터] [-s 표본 수] [-t 표본당 ms] [-o 기준선.json] [-c 비교할 기준선.json]
+
+   벤치마크마다 준비(시간 재지 않음) -> 배치 실행(시간 잼)을 표본 시간이 찰 때까지 반복해 표본 하나를 만들고,
+   표본별 ns/op의 평균/표준편차/최소/중앙값과 op당 할당 횟수(전역 operator new 교체로 셈)를 출력한다.
+   -o는 같은 값을 JSON으로 쓰고 (벤치마크 하나당 한 줄), -c는 이전 기준선과 평균 ns/op를 비교한다.
+   포지션은 test_positions.py와 같은 배치를 쓴다. 최적화 빌드(-DCMAKE_BUILD_TYPE=Release)에서 잴 것.
+*/
+
+#if BC_ENABLE_STATS
+// 계측 빌드는 stats.cpp가 이미 전역 operator new를 바꿔 할당을 센다
+namespace {
+uint64_t allocationCount() { return readEngineStats().allocations; }
+} // namespace
+#else
+namespace {
+
+uint64_t allocations = 0; // 단일 스레드 도구라 원자 연산 없이 센다
+uint64_t allocationCount() { return allocations; }
+
+} // namespace
+
+// GCC는 표준 할당자 안에 인라인된 operator delete가 free를 부르는 것을 new/free 짝 오류로 잘못 본다.
+// 여기 정의한 operator new도 malloc으로 잡으므로 짝은 맞다: 이 블록에서만 경고를 끈다.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(std::size_t size) {
+    allocations++;
+    if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+namespace {
+
+volatile uint64_t benchSink = 0; // 결과를 버리지 않게 흘려 보낼 곳
+uint64_t rejectedActions = 0;     // 사이클 벤치마크가 거절당하면 재는 대상이 달라진 것이다
+
+void expectOk(actionResult r) {
+    if(r != actionResult::OK) rejectedActions++;
+}
+
+using pieceSetup = std::vector<std::tuple<pieceType, colorType, int, int, int, int>>; // (type, color, file, rank, stun, moveStack)
+
+struct layout {
+    const char* name;
+    colorType turn;
+    pieceSetup pieces;
+    bool hasPockets;
+    std::array<int, POCKET_SIZE> whitePocket;
+    std::array<int, POCKET_SIZE> blackPocket;
+};
+
+constexpr colorType W = colorType::WHITE;
+constexpr colorType B = colorType::BLACK;
+constexpr pieceType K = pieceType::KING, Q = pieceType::QUEEN, R = pieceType::ROOK, BI = pieceType::BISHOP,
+                    N = pieceType::KNIGHT, P = pieceType::PWAN;
+
+// test_positions.py의 POSITIONS
+const std::vector<layout>& testLayouts() {
+    static const std::vector<layout> layouts = {
+        {"move_stack_test", W, {{K, W, 4, 0, 0, 3}, {K, B, 4, 7, 0, 3}, {Q, W, 3, 0, 0, 5}, {Q, B, 3, 7, 0, 5}}, false, {}, {}},
+        {"stun_test", W,
+         {{K, W, 4, 0, 0, 1}, {K, B, 4, 7, 0, 1}, {R, W, 0, 0, 3, 0}, {R, B, 0, 7, 3, 0}, {N, W, 1, 0, 1, 2}, {N, B, 1, 7, 1, 2}},
+         false, {}, {}},
+        {"promotion_test", B, {{K, W, 4, 0, 0, 1}, {K, B, 4, 7, 0, 1}, {P, W, 0, 6, 0, 1}, {P, B, 7, 1, 0, 1}},
+         true, {1, 1, 2, 2, 2, 0}, {1, 1, 2, 2, 2, 0}},
+        {"complex_test", W,
+         {{K, W, 4, 0, 0, 2}, {K, B, 4, 7, 0, 2}, {Q, W, 3, 3, 1, 3}, {R, W, 0, 0, 0, 2}, {BI, W, 5, 2, 2, 0},
+          {N, W, 6, 2, 0, 1}, {Q, B, 3, 4, 1, 3}, {R, B, 7, 7, 0, 2}, {BI, B, 2, 5, 2, 0}, {N, B, 1, 5, 0, 1}},
+         false, {}, {}},
+        {"royal_check_test", W,
+         {{K, W, 4, 3, 0, 1}, {K, B, 4, 7, 0, 1}, {R, B, 4, 5, 0, 1}, {Q, W, 2, 2, 0, 2}, {N, W, 6, 2, 0, 2},
+          {Q, B, 3, 6, 0, 2}, {BI, B, 5, 5, 0, 1}},
+         true, {1, 0, 1, 1, 2, 8}, {1, 1, 2, 2, 1, 8}},
+        {"royal_disguise_test", W,
+         {{K, W, 4, 4, 0, 1}, {K, B, 4, 7, 0, 1}, {Q, W, 5, 4, 0, 2}, {R, W, 3, 4, 0, 1}, {BI, W, 2, 3, 0, 1},
+          {N, W, 6, 3, 0, 1}, {Q, B, 4, 6, 0, 1}, {R, B, 6, 6, 0, 1}},
+         true, {1, 0, 1, 1, 1, 8}, {1, 1, 2, 2, 1, 8}},
+        {"royal_succession_test", W,
+         {{K, W, 4, 4, 1, 0}, {K, B, 4, 7, 0, 1}, {Q, W, 3, 3, 0, 0}, {R, W, 5, 3, 0, 0}, {N, W, 6, 4, 0, 0},
+          {R, B, 4, 5, 0, 1}, {Q, B, 3, 5, 0, 1}},
+         true, {1, 0, 2, 2, 1, 8}, {1, 1, 2, 2, 1, 8}},
+    };
+    return layouts;
+}
+
+const layout& layoutNamed(const char* name) {
+    for(const auto& l : testLayouts()) {
+        if(std::string(l.name) == name) return l;
+    }
+    return testLayouts().front();
+}
+
+void setupLayout(bc_board& board, const layout& l) {
+    board.setupPosition(l.pieces, l.turn, l.hasPockets ? &l.whitePocket : nullptr, l.hasPockets ? &l.blackPocket : nullptr);
+}
+
+// 32기물이 모두 놓인 조밀한 보드
+const char* DENSE = "rnbqk^bnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQK^BNR w -/- - 5 5";
+// 빈 보드에 착수만 반복 (포켓 넉넉히)
+const char* EMPTY_DROPS = "8/8/8/8/8/8/8/8 w N40/n40 - 1 1";
+// 이동 스택이 큰 룩이 같은 턴에 왕복
+const char* SHUTTLE = "4k^3/8/8/8/8/8/8/R(0,100000)3K^3 w -/- - 5 5";
+// 룩이 a열, 8랭크의 흑 폰을 차례로 잡는다
+const char* CAPTURE_CHAIN = "pppppppp/p7/p7/p7/p7/p7/p7/R(0,64)3K^3 w -/- - 5 5";
+constexpr int CAPTURE_CHAIN_LENGTH = 14;
+
+struct benchCase {
+    std::string name;
+    int batch;                      // body 한 번에 도는 op 수
+    std::function<void()> prepare;  // 배치 전 상태 복원 (시간/할당 제외)
+    std::function<void(int)> body;  // op batch개
+};
+
+struct benchResult {
+    std::string name;
+    uint64_t ops = 0;
+    double mean = 0.0, stddev = 0.0, minimum = 0.0, median = 0.0; // ns/op
+    double allocsPerOp = 0.0;
+};
+
+benchResult measure(const benchCase& c, int samples, double sampleMs) {
+    using clock = std::chrono::steady_clock;
+    std::vector<double> perSample;
+    uint64_t totalOps = 0, totalAllocs = 0;
+    for(int s = -1; s < samples; ++s) { // s = -1: 워밍업 (버린다)
+        double ns = 0.0;
+        uint64_t ops = 0, allocs = 0;
+        while(ns < sampleMs * 1e6) {
+            c.prepare();
+            const uint64_t allocsBefore = allocationCount();
+            const auto t0 = clock::now();
+            c.body(c.batch);
+            const auto t1 = clock::now();
+            allocs += allocationCount() - allocsBefore;
+            ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            ops += static_cast<uint64_t>(c.batch);
+        }
+        if(s < 0) continue;
+        perSample.push_back(ns / static_cast<double>(ops));
+        totalOps += ops;
+        totalAllocs += allocs;
+    }
+
+    benchResult r;
+    r.name = c.name;
+    r.ops = totalOps;
+    r.allocsPerOp = static_cast<double>(totalAllocs) / static_cast<double>(totalOps);
+    for(double v : perSample) r.mean += v;
+    r.mean /= static_cast<double>(perSample.size());
+    double var = 0.0;
+    for(double v : perSample) var += (v - r.mean) * (v - r.mean);
+    r.stddev = perSample.size() > 1 ? std::sqrt(var / static_cast<double>(perSample.size() - 1)) : 0.0;
+    std::sort(perSample.begin(), perSample.end());
+    r.minimum = perSample.front();
+    const size_t mid = perSample.size() / 2;
+    r.median = (perSample.size() % 2) ? perSample[mid] : 0.5 * (perSample[mid - 1] + perSample[mid]);
+    return r;
+}
+
+// 벤치마크 목록. 보드는 벤치마크마다 따로 두고 목록이 살아 있는 동안 유지한다
+struct benchSuite {
+    std::vector<std::unique_ptr<bc_board>> boards;
+    std::vector<PGN> pgns;
+    std::vector<PGN> moveBuffer;
+    std::vector<std::string> tokens;
+    std::vector<benchCase> cases;
+
+    bc_board& newBoard() {
+        boards.push_back(std::make_unique<bc_board>());
+        return *boards.back();
+    }
+
+    void add(std::string name, int batch, std::function<void()> prepare, std::function<void(int)> body) {
+        cases.push_back({std::move(name), batch, std::move(prepare), std::move(body)});
+    }
+
+    benchSuite() {
+        const auto nothing = [] {};
+
+        // legalMoveChunk::calculateMoves: complex_test 배치의 e4에 각 타입 기물을 둔다
+        for(int t = 0; t < PIECE_TYPE_COUNT; ++t) {
+            const pieceType type = static_cast<pieceType>(t);
+            bc_board& board = newBoard();
+            const layout& base = layoutNamed("complex_test");
+            pieceSetup pieces = base.pieces;
+            pieces.emplace_back(type, W, 4, 3, 0, 1);
+            board.setupPosition(pieces, W);
+            piece* p = board.getPiece(4, 3);
+            add(std::string("calculateMoves/") + pieceSymbol(type), 256, nothing, [this, &board, p](int n) {
+                uint64_t attacks = 0, scanned = 0;
+                for(int i = 0; i < n; ++i) {
+                    moveBuffer.clear();
+                    for(const auto& chunk : p->getMovePatterns()) {
+                        chunk.calculateMoves(p->getFile(), p->getRank(), p->getPieceType(), p->getColor(), &board, moveBuffer, attacks, scanned);
+                    }
+                }
+                benchSink = benchSink + moveBuffer.size() + attacks;
+            });
+        }
+
+        // updateAllLegalMoves
+        {
+            bc_board& sparse = newBoard();
+            setupLayout(sparse, layoutNamed("move_stack_test"));
+            add("updateAllLegalMoves/sparse", 64, nothing, [&sparse](int n) {
+                for(int i = 0; i < n; ++i) sparse.updateAllLegalMoves();
+            });
+            bc_board& complex = newBoard();
+            setupLayout(complex, layoutNamed("complex_test"));
+            add("updateAllLegalMoves/complex", 64, nothing, [&complex](int n) {
+                for(int i = 0; i < n; ++i) complex.updateAllLegalMoves();
+            });
+            bc_board& dense = newBoard();
+            dense.loadPositionString(DENSE);
+            add("updateAllLegalMoves/dense", 64, nothing, [&dense](int n) {
+                for(int i = 0; i < n; ++i) dense.updateAllLegalMoves();
+            });
+        }
+
+        // placePiece/movePiece/캡처: 배치마다 시작 포지션으로 되돌린다 (복원은 재지 않음)
+        {
+            bc_board& drops = newBoard();
+            add("cycle/placePiece+nextTurn", 32, [&drops] { drops.loadPositionString(EMPTY_DROPS); }, [&drops](int n) {
+                for(int i = 0; i < n; ++i) {
+                    const colorType side = (i % 2 == 0) ? W : B;
+                    expectOk(drops.placePiece(N, side, i % 8, 2 + i / 8));
+                    drops.nextTurn();
+                }
+            });
+            bc_board& shuttle = newBoard();
+            add("cycle/movePiece", 256, [&shuttle] { shuttle.loadPositionString(SHUTTLE); }, [&shuttle](int n) {
+                for(int i = 0; i < n; ++i) {
+                    const bool up = (i % 2 == 0);
+                    expectOk(shuttle.movePiece(0, up ? 0 : 3, 0, up ? 3 : 0));
+                }
+            });
+            bc_board& chain = newBoard();
+            add("cycle/capture", CAPTURE_CHAIN_LENGTH, [&chain] { chain.loadPositionString(CAPTURE_CHAIN); }, [&chain](int n) {
+                for(int i = 0; i < n; ++i) {
+                    const int fromFile = (i < 7) ? 0 : i - 7;
+                    const int fromRank = (i < 7) ? i : 7;
+                    const int toFile = (i < 6) ? 0 : i - 6;
+                    const int toRank = (i < 6) ? i + 1 : 7;
+                    expectOk(chain.movePiece(fromFile, fromRank, toFile, toRank));
+                }
+            });
+        }
+
+        // isRoyalPieceInCheck
+        {
+            bc_board& check = newBoard();
+            setupLayout(check, layoutNamed("royal_check_test"));
+            add("isRoyalPieceInCheck", 1024, nothing, [&check](int n) {
+                uint64_t hits = 0;
+                for(int i = 0; i < n; ++i) hits += check.isRoyalPieceInCheck((i & 1) ? B : W) ? 1 : 0;
+                benchSink = benchSink + hits;
+            });
+        }
+
+        // getBoardAsFEN
+        {
+            bc_board& dense = newBoard();
+            dense.loadPositionString(DENSE);
+            add("getBoardAsFEN/dense", 64, nothing, [&dense](int n) {
+                for(int i = 0; i < n; ++i) benchSink = benchSink + dense.getBoardAsFEN().size();
+            });
+        }
+
+        // PGN::toString / fromString
+        {
+            tokens = {"e4", "Nf3", "exd5", "Q@d4", "H@c3", "f1=Q", "Rxa8", "Kxe2", "M@h1", "suc e5"};
+            for(const auto& t : tokens) pgns.push_back(PGN::fromString(t, W));
+            add("PGN::toString", 256, nothing, [this](int n) {
+                for(int i = 0; i < n; ++i) benchSink = benchSink + pgns[static_cast<size_t>(i) % pgns.size()].toString().size();
+            });
+            add("PGN::fromString", 256, nothing, [this](int n) {
+                for(int i = 0; i < n; ++i) {
+                    benchSink = benchSink + static_cast<uint64_t>(PGN::fromString(tokens[static_cast<size_t>(i) % tokens.size()], W).endFile);
+                }
+            });
+        }
+
+        // setupPosition: test_positions.py 배치마다
+        for(const auto& l : testLayouts()) {
+            bc_board& board = newBoard();
+            add(std::string("setupPosition/") + l.name, 16, nothing, [&board, &l](int n) {
+                for(int i = 0; i < n; ++i) setupLayout(board, l);
+            });
+        }
+    }
+};
+
+std::string compilerName() {
+#if defined(__clang__)
+    return "clang " + std::to_string(__clang_major__) + "." + std::to_string(__clang_minor__);
+#elif defined(__GNUC__)
+    return "gcc " + std::to_string(__GNUC__) + "." + std::to_string(__GNUC_MINOR__);
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+bool optimizedBuild() {
+#if defined(__OPTIMIZE__) || (defined(_MSC_VER) && defined(NDEBUG))
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool writeJson(const std::string& path, const std::vector<benchResult>& results, int samples, double sampleMs) {
+    std::ofstream out(path);
+    if(!out) return false;
+    out << std::setprecision(6);
+    out << "{\n  \"tool\": \"bc_bench\",\n  \"version\": 1,\n  \"compiler\": \"" << compilerName() << "\",\n"
+        << "  \"optimized\": " << (optimizedBuild() ? "true" : "false") << ",\n"
+        << "  \"samples\": " << samples << ",\n  \"sample_ms\": " << sampleMs << ",\n  \"benchmarks\": [\n";
+    for(size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"ops\": " << r.ops << ", \"ns_per_op\": " << r.mean
+            << ", \"stddev\": " << r.stddev << ", \"min\": " << r.minimum << ", \"median\": " << r.median
+            << ", \"allocs_per_op\": " << r.allocsPerOp << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// writeJson이 쓴 기준선에서 이름 -> 평균 ns/op (벤치마크 하나당 한 줄이라 줄 단위로 읽는다)
+bool readBaseline(const std::string& path, std::map<std::string, double>& out) {
+    std::ifstream in(path);
+    if(!in) return false;
+    std::string line;
+    while(std::getline(in, line)) {
+        const size_t name = line.find("\"name\": \"");
+        const size_t ns = line.find("\"ns_per_op\": ");
+        if(name == std::string::npos || ns == std::string::npos) continue;
+        const size_t nameStart = name + 9;
+        const size_t nameEnd = line.find('"', nameStart);
+        if(nameEnd == std::string::npos) continue;
+        out[line.substr(nameStart, nameEnd - nameStart)] = std::strtod(line.c_str() + ns + 13, nullptr);
+    }
+    return true;
+}
+
+void usage() {
+    std::cerr << "usage: bc_bench [-f filter] [-s samples] [-t sample_ms] [-o baseline.json] [-c compare.json]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string filter, output, compare;
+    int samples = 10;
+    double sampleMs = 50.0;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if(arg == "-f" && hasValue) {
+            filter = argv[++i];
+        } else if(arg == "-s" && hasValue) {
+            samples = std::max(2, std::atoi(argv[++i]));
+        } else if(arg == "-t" && hasValue) {
+            sampleMs = std::max(1.0, std::atof(argv[++i]));
+        } else if(arg == "-o" && hasValue) {
+            output = argv[++i];
+        } else if(arg == "-c" && hasValue) {
+            compare = argv[++i];
+        } else {
+            usage();
+            return (arg == "-h" || arg == "--help") ? 0 : 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if(!compare.empty() && !readBaseline(compare, baseline)) {
+        std::cerr << compare << ": cannot read" << std::endl;
+        return 1;
+    }
+    if(!optimizedBuild()) std::cerr << "warning: unoptimized build, numbers are not comparable to a release baseline" << std::endl;
+
+    benchSuite suite;
+    std::vector<benchResult> results;
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "ns/op" << std::setw(9) << "cv%"
+              << std::setw(12) << "min" << std::setw(12) << "allocs/op";
+    if(!baseline.empty()) std::cout << std::setw(10) << "vs base";
+    std::cout << std::endl;
+    for(const auto& c : suite.cases) {
+        if(!filter.empty() && c.name.find(filter) == std::string::npos) continue;
+        const benchResult r = measure(c, samples, sampleMs);
+        results.push_back(r);
+        std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed << std::setprecision(1) << std::setw(12) << r.mean
+                  << std::setw(9) << (r.mean > 0.0 ? 100.0 * r.stddev / r.mean : 0.0) << std::setw(12) << r.minimum
+                  << std::setprecision(2) << std::setw(12) << r.allocsPerOp;
+        const auto base = baseline.find(r.name);
+        if(base != baseline.end() && base->second > 0.0) {
+            std::cout << std::showpos << std::setprecision(1) << std::setw(9) << 100.0 * (r.mean / base->second - 1.0) << "%" << std::noshowpos;
+        }
+        std::cout << std::endl;
+    }
+
+    if(rejectedActions > 0) {
+        std::cerr << rejectedActions << " actions rejected in cycle benchmarks" << std::endl;
+        return 1;
+    }
+    if(!output.empty() && !writeJson(output, results, samples, sampleMs)) {
+        std::cerr << output << ": cannot write" << std::endl;
+        return 1;
+    }
+    return 0;
+}
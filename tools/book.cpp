@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <book.hpp>
+#include <chess.hpp>
+#include <threadpool.hpp>
+
+/* bc_book: 착수 단계 오프닝 북을 만든다 (book.hpp).
+
+     bc_book [-j 스레드 수] [-d 단계] [-w 펼칠 수] [-m 저장할 수] [-n 반복 수] [-r 롤아웃 길이] [-s 시드]
+             -o <출력.bcob> ["<포지션 문자열>"]
+
+   포지션 문자열이 없으면 기본 시작 포지션(빈 보드, 기본 포켓)에서 시작한다.
+   단계마다 포지션을 스레드에 나눠 정보 집합 탐색으로 분석하고, 끝에 분석한 포지션 수와 시간을 출력한다.
+*/
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: bc_book [-j threads] [-d depth] [-w width] [-m moves] [-n iterations] [-r rollout] [-s seed]"
+                 " -o <out.bcob> [\"position\"]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    bookBuildConfig config;
+    std::string output;
+    std::string position;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if(arg == "-j" && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if(arg == "-d" && hasValue) {
+            config.depth = std::atoi(argv[++i]);
+        } else if(arg == "-w" && hasValue) {
+            config.width = std::atoi(argv[++i]);
+        } else if(arg == "-m" && hasValue) {
+            config.movesPerEntry = std::atoi(argv[++i]);
+        } else if(arg == "-n" && hasValue) {
+            config.analysis.iterations = std::atoi(argv[++i]);
+        } else if(arg == "-r" && hasValue) {
+            config.analysis.rolloutActions = std::atoi(argv[++i]);
+        } else if(arg == "-s" && hasValue) {
+            config.analysis.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if(arg == "-o" && hasValue) {
+            output = argv[++i];
+        } else if(arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            position = arg;
+        }
+    }
+    if(output.empty()) {
+        usage();
+        return 2;
+    }
+
+    bc_board start;
+    if(!position.empty() && !start.loadPositionString(position)) {
+        std::cerr << "invalid position: " << position << std::endl;
+        return 2;
+    }
+
+    threadPool pool(threads);
+    openingBookWriter writer;
+    const bookBuildStats stats = buildOpeningBook(start, config, pool, writer);
+    const size_t entries = writer.size();
+    if(!writer.save(output)) {
+        std::cerr << output << ": cannot write" << std::endl;
+        return 1;
+    }
+
+    const double safeSeconds = stats.seconds > 0.0 ? stats.seconds : 1e-9;
+    std::cout << "positions: " << stats.positions << ", entries: " << entries << ", threads: " << pool.size() << std::endl;
+    std::cout << "time: " << stats.seconds << " s, " << (stats.positions / safeSeconds) << " positions/sec, "
+              << (stats.iterations / safeSeconds) << " iterations/sec" << std::endl;
+    return 0;
+}
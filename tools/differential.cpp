@@ -0,0 +1,464 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <chess.hpp>
+#include <book.hpp>
+#include <threadpool.hpp>
+
+/* bc_differential: 규칙 기준 구현과 최적화 경로를 무작위 포지션에서 비교한다.
+
+     bc_differential [-n 포지션 수] [-s 시드] [-p 게임당 수] [-j 스레드 수] [-q]
+
+   무작위 포지션 문자열(16종 기물, 로얄/스턴/이동 스택, 16종 포켓)에서 시작해 bc_board로 무작위 게임을 두고,
+   거쳐 간 포지션마다 다음을 비교한다.
+     생성기   legalMoveChunk::calculateMoves (보드 기반, 기준) vs forEachTarget/attackMask (비트보드)
+     액션     액션마다 증분 재계산(refreshLegalMoves)한 보드 vs 결과 포지션을 새로 불러와 전체 재계산한 보드:
+              포지션 문자열, positionHash, 공격 맵/로얄 마스크, 평가값, 합법 액션 집합
+     기록     게임 내내 증분으로만 갱신한 보드 vs 같은 포지션을 새로 불러온 보드
+     묶음     게임의 액션을 하나씩 적용한 보드 vs 시작 포지션에 applyActions 한 번으로 적용한 보드
+   불일치가 나오면 기물/스택/변장/포켓을 하나씩 지워 가며 여전히 불일치하는 가장 작은 포지션으로 줄여 출력한다.
+   불일치가 하나라도 있으면 종료 코드 1.
+*/
+
+namespace {
+
+constexpr size_t ACTIONS_PER_POSITION = 32; // 포지션마다 증분/전체 비교할 액션 수 상한
+constexpr size_t MAX_REPORTS = 4;           // 줄여서 보고할 불일치 수 (줄이기는 느리다)
+
+struct scratchBoards {
+    bc_board reference;
+    bc_board incremental;
+    bc_board full;
+    std::vector<boardAction> actions;
+    std::vector<boardAction> other;
+    std::vector<PGN> moves;
+};
+
+std::string squareName(int square) {
+    if(square < 0) return "-";
+    return std::string{char('a' + squareFile(square)), char('1' + squareRank(square))};
+}
+
+std::string describe(const boardAction& a) {
+    switch(a.type) {
+        case actionType::DROP:       return std::string(1, pieceSymbol(a.pT)) + "@" + squareName(a.toSquare);
+        case actionType::MOVE:       return squareName(a.fromSquare) + (a.take ? "x" : "-") + squareName(a.toSquare);
+        case actionType::STUN:       return "stun " + squareName(a.fromSquare) + " +" + std::to_string(a.stunDelta);
+        case actionType::PROMOTE:    return squareName(a.fromSquare) + "=" + std::string(1, pieceSymbol(a.pT));
+        case actionType::DISGUISE:   return "disguise " + squareName(a.fromSquare) + " as " + std::string(1, pieceSymbol(a.pT));
+        case actionType::SUCCESSION: return "suc " + squareName(a.fromSquare);
+        default:                     return "end";
+    }
+}
+
+// 액션 비교 키 (모든 필드)
+uint64_t actionKey(const boardAction& a) {
+    return (uint64_t(static_cast<uint8_t>(a.type)) << 48) | (uint64_t(static_cast<uint8_t>(static_cast<int>(a.pT) + 1)) << 40) |
+           (uint64_t(static_cast<uint8_t>(a.fromSquare + 1)) << 32) | (uint64_t(static_cast<uint8_t>(a.toSquare + 1)) << 24) |
+           (uint64_t(static_cast<uint8_t>(a.jumpedSquare + 1)) << 16) | (uint64_t(a.take) << 8) | uint64_t(static_cast<uint8_t>(a.stunDelta));
+}
+
+boardAction keyAction(uint64_t key) {
+    boardAction a;
+    a.type = static_cast<actionType>((key >> 48) & 0xFF);
+    a.pT = static_cast<pieceType>(static_cast<int>((key >> 40) & 0xFF) - 1);
+    a.fromSquare = static_cast<int8_t>(static_cast<int>((key >> 32) & 0xFF) - 1);
+    a.toSquare = static_cast<int8_t>(static_cast<int>((key >> 24) & 0xFF) - 1);
+    a.take = ((key >> 8) & 1) != 0;
+    a.stunDelta = static_cast<int8_t>(key & 0xFF);
+    return a;
+}
+
+std::vector<uint64_t> actionKeys(const std::vector<boardAction>& actions) {
+    std::vector<uint64_t> keys;
+    keys.reserve(actions.size());
+    for(const auto& a : actions) keys.push_back(actionKey(a));
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// ---------------------------------------------------------------- 비교
+
+// 한쪽에만 있는 첫 액션
+std::string compareActionSets(const bc_board& got, const bc_board& want, scratchBoards& s) {
+    got.collectLegalActions(s.actions);
+    want.collectLegalActions(s.other);
+    const std::vector<uint64_t> a = actionKeys(s.actions);
+    const std::vector<uint64_t> b = actionKeys(s.other);
+    if(a == b) return {};
+    std::vector<uint64_t> onlyA;
+    std::vector<uint64_t> onlyB;
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(onlyA));
+    std::set_difference(b.begin(), b.end(), a.begin(), a.end(), std::back_inserter(onlyB));
+    if(!onlyA.empty()) return "extra action " + describe(keyAction(onlyA.front()));
+    if(!onlyB.empty()) return "missing action " + describe(keyAction(onlyB.front()));
+    return "duplicate actions";
+}
+
+// got(증분 경로)과 want(새로 불러와 전체 재계산)의 관찰 가능한 상태
+std::string compareBoards(const bc_board& got, const bc_board& want, scratchBoards& s) {
+    if(got.getPositionString() != want.getPositionString()) return "position string " + want.getPositionString();
+    if(positionHash(got) != positionHash(want)) return "position hash";
+    for(colorType c : {colorType::WHITE, colorType::BLACK}) {
+        const char* side = (c == colorType::WHITE) ? "white" : "black";
+        if(got.getAttackMap(c) != want.getAttackMap(c)) return std::string(side) + " attack map";
+        if(got.getRoyalMask(c) != want.getRoyalMask(c)) return std::string(side) + " royal mask";
+    }
+    if(got.evaluate(colorType::WHITE) != want.evaluate(colorType::WHITE)) return "evaluation";
+    return compareActionSets(got, want, s);
+}
+
+// 패턴 하나: 보드 기반 생성 vs 비트보드 생성
+std::string compareGenerators(const bc_board& board, scratchBoards& s) {
+    uint64_t occupied[2] = {0, 0};
+    for(int sq = 0; sq < 64; ++sq) {
+        const piece* p = board.getPiece(squareFile(sq), squareRank(sq));
+        if(p != nullptr) occupied[p->getColor() == colorType::WHITE ? 0 : 1] |= uint64_t(1) << sq;
+    }
+    std::vector<std::pair<int, uint64_t>> want;
+    std::vector<std::pair<int, uint64_t>> got;
+
+    for(int sq = 0; sq < 64; ++sq) {
+        const int f = squareFile(sq);
+        const int r = squareRank(sq);
+        piece* p = board.getPiece(f, r);
+        if(p == nullptr) continue;
+        const int side = p->getColor() == colorType::WHITE ? 0 : 1;
+        const uint64_t own = occupied[side];
+        const uint64_t enemy = occupied[1 - side];
+
+        for(const auto& chunk : p->getMovePatterns()) {
+            s.moves.clear();
+            uint64_t attacks = 0;
+            uint64_t scanned = 0;
+            chunk.calculateMoves(f, r, p->getPieceType(), p->getColor(), const_cast<bc_board*>(&board), s.moves, attacks, scanned);
+            want.clear();
+            for(const PGN& m : s.moves) {
+                uint64_t captured = m.take ? uint64_t(1) << squareOf(m.endFile, m.endRank) : 0;
+                if(m.captureJumped) captured |= uint64_t(1) << squareOf(m.jumpedFile, m.jumpedRank);
+                want.emplace_back(squareOf(m.endFile, m.endRank), captured);
+            }
+            got.clear();
+            chunk.forEachTarget(f, r, own, enemy, [&](int to, uint64_t captured) { got.emplace_back(to, captured); });
+            std::sort(want.begin(), want.end());
+            std::sort(got.begin(), got.end());
+
+            uint64_t maskScanned = 0;
+            const uint64_t mask = chunk.attackMask(f, r, own, enemy, maskScanned);
+            const std::string where = std::string(1, pieceSymbol(p->getPieceType())) + squareName(sq) + " " +
+                                      patternKindName(patternKind(chunk.getMoveType(), chunk.getThreatType())) + ": ";
+            if(want != got) return where + "forEachTarget differs from calculateMoves";
+            if(mask != attacks) return where + "attackMask differs from calculateMoves attacks";
+            if(maskScanned != scanned) return where + "attackMask scanned squares differ";
+        }
+    }
+    return {};
+}
+
+// 포지션 하나의 모든 비교. 빈 문자열이면 일치 (불러올 수 없는 포지션도 일치로 본다: 줄이기 후보용)
+std::string checkPosition(const std::string& position, scratchBoards& s) {
+    if(!s.reference.loadPositionString(position)) return {};
+    std::string diff = compareGenerators(s.reference, s);
+    if(!diff.empty()) return "generator " + diff;
+
+    std::vector<boardAction> actions;
+    s.reference.collectLegalActions(actions);
+    // 액션이 많으면 포지션 해시로 정한 간격으로 고른다 (같은 포지션은 항상 같은 액션을 검사)
+    const size_t stride = (actions.size() + ACTIONS_PER_POSITION - 1) / ACTIONS_PER_POSITION;
+    const size_t first = stride > 1 ? static_cast<size_t>(positionHash(s.reference) % stride) : 0;
+    for(size_t i = first; i < actions.size(); i += std::max<size_t>(stride, 1)) {
+        const boardAction& a = actions[i];
+        s.incremental.loadPositionString(position);
+        const actionResult res = s.incremental.applyAction(a);
+        if(res != actionResult::OK) return "listed action " + describe(a) + " rejected (" + std::to_string(static_cast<int>(res)) + ")";
+        const std::string after = s.incremental.getPositionString();
+        if(!s.full.loadPositionString(after)) return "after " + describe(a) + ": position string does not load: " + after;
+        diff = compareBoards(s.incremental, s.full, s);
+        if(!diff.empty()) return "after " + describe(a) + ": " + diff;
+    }
+    return {};
+}
+
+// ---------------------------------------------------------------- 줄이기
+
+std::vector<std::string> splitFields(const std::string& position) {
+    std::vector<std::string> fields;
+    size_t pos = 0;
+    while(pos < position.size()) {
+        const size_t end = std::min(position.find(' ', pos), position.size());
+        if(end > pos) fields.push_back(position.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    return fields;
+}
+
+std::string joinFields(const std::vector<std::string>& fields) {
+    std::string out;
+    for(const auto& f : fields) {
+        if(!out.empty()) out += ' ';
+        out += f;
+    }
+    return out;
+}
+
+// 한 단계 더 작은 포지션 후보들: 기물 하나 제거, 포켓 비우기, 스택/변장 표시 하나 제거
+std::vector<std::string> shrinkCandidates(const std::string& position, scratchBoards& s) {
+    std::vector<std::string> out;
+    if(!s.reference.loadPositionString(position)) return out;
+    for(int sq = 0; sq < 64; ++sq) {
+        if(s.reference.getPiece(squareFile(sq), squareRank(sq)) == nullptr) continue;
+        s.incremental.loadPositionString(position);
+        if(s.incremental.removePiece(squareFile(sq), squareRank(sq)) == actionResult::OK) out.push_back(s.incremental.getPositionString());
+    }
+
+    std::vector<std::string> fields = splitFields(position);
+    if(fields.size() >= 3) {
+        const std::string pockets = fields[2];
+        const size_t slash = pockets.find('/');
+        for(const std::string& p : {std::string("-/-"), "-" + pockets.substr(slash), pockets.substr(0, slash) + "/-"}) {
+            if(p == pockets) continue;
+            fields[2] = p;
+            out.push_back(joinFields(fields));
+        }
+        fields[2] = pockets;
+    }
+
+    const std::string placement = fields.empty() ? std::string() : fields[0];
+    for(size_t i = 0; i < placement.size(); ++i) {
+        size_t end = std::string::npos;
+        if(placement[i] == '(') end = placement.find(')', i);
+        else if(placement[i] == '=' && i + 1 < placement.size()) end = i + 1;
+        if(end == std::string::npos) continue;
+        fields[0] = placement.substr(0, i) + placement.substr(end + 1);
+        out.push_back(joinFields(fields));
+    }
+    return out;
+}
+
+// 불일치가 유지되는 동안 후보 중 처음 불일치하는 것으로 바꾼다
+std::string shrinkPosition(std::string position, std::string& diff, scratchBoards& s) {
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(const std::string& candidate : shrinkCandidates(position, s)) {
+            std::string d = checkPosition(candidate, s);
+            if(d.empty()) continue;
+            position = candidate;
+            diff = std::move(d);
+            changed = true;
+            break;
+        }
+    }
+    return position;
+}
+
+// ---------------------------------------------------------------- 무작위 포지션
+
+std::string randomPosition(std::mt19937_64& rng) {
+    auto roll = [&](int n) { return static_cast<int>(rng() % static_cast<uint64_t>(n)); };
+    std::string cells[64];
+
+    auto place = [&](bool white, pieceType type, bool royal) {
+        for(int attempt = 0; attempt < 64; ++attempt) {
+            const int sq = roll(64);
+            if(!cells[sq].empty()) continue;
+            // 폰은 자기 쪽 끝 랭크 밖에만 (불러오기가 거절하는 배치는 만들지 않는다)
+            if(type == pieceType::PWAN && (squareRank(sq) == 0 || squareRank(sq) == 7)) continue;
+            const char symbol = pieceSymbol(type);
+            std::string text(1, white ? symbol : char(symbol - 'A' + 'a'));
+            if(royal) text += '^';
+            if(royal && type != pieceType::KING && roll(4) == 0) {
+                pieceType as = static_cast<pieceType>(1 + roll(PIECE_TYPE_COUNT - 1));
+                if(as == pieceType::PWAN) as = pieceType::QUEEN;
+                text += '=';
+                text += white ? pieceSymbol(as) : char(pieceSymbol(as) - 'A' + 'a');
+            }
+            if(roll(3) == 0) text += "(" + std::to_string(roll(4)) + "," + std::to_string(roll(4)) + ")";
+            cells[sq] = text;
+            return;
+        }
+    };
+
+    for(bool white : {true, false}) {
+        place(white, roll(3) == 0 ? static_cast<pieceType>(roll(PIECE_TYPE_COUNT)) : pieceType::KING, true);
+        if(roll(4) == 0) place(white, pieceType::PWAN, false);
+        const int extras = roll(10);
+        for(int i = 0; i < extras; ++i) place(white, static_cast<pieceType>(roll(PIECE_TYPE_COUNT)), false);
+    }
+
+    std::string out;
+    for(int rank = 7; rank >= 0; --rank) {
+        int empty = 0;
+        for(int file = 0; file < 8; ++file) {
+            const std::string& c = cells[squareOf(file, rank)];
+            if(c.empty()) {
+                empty++;
+                continue;
+            }
+            if(empty > 0) out += char('0' + empty);
+            empty = 0;
+            out += c;
+        }
+        if(empty > 0) out += char('0' + empty);
+        if(rank > 0) out += '/';
+    }
+    out += roll(2) == 0 ? " w " : " b ";
+    for(int side = 0; side < 2; ++side) {
+        bool any = false;
+        for(int i = 0; i < PIECE_TYPE_COUNT; ++i) {
+            if(roll(4) != 0) continue;
+            const char symbol = pieceSymbol(static_cast<pieceType>(i));
+            out += side == 0 ? symbol : char(symbol - 'A' + 'a');
+            out += std::to_string(1 + roll(3));
+            any = true;
+        }
+        if(!any) out += '-';
+        if(side == 0) out += '/';
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------- 실행
+
+struct failure {
+    std::string origin;   // 처음 불일치가 난 포지션
+    std::string minimal;  // 줄인 포지션
+    std::string detail;
+};
+
+struct runTotals {
+    std::atomic<size_t> positions{0};
+    std::atomic<size_t> actions{0};
+    std::mutex lock;
+    std::vector<failure> failures;
+
+    bool full() {
+        std::lock_guard<std::mutex> guard(lock);
+        return failures.size() >= MAX_REPORTS;
+    }
+    void report(failure f) {
+        std::lock_guard<std::mutex> guard(lock);
+        if(failures.size() < MAX_REPORTS) failures.push_back(std::move(f));
+    }
+};
+
+void playGame(uint64_t seed, size_t plies, runTotals& totals) {
+    scratchBoards s;
+    bc_board live;
+    bc_board fresh;
+    std::mt19937_64 rng(seed);
+    std::string start;
+    for(int attempt = 0; attempt < 16 && start.empty(); ++attempt) {
+        start = randomPosition(rng);
+        if(!live.loadPositionString(start)) start.clear();
+    }
+    if(start.empty()) return;
+
+    std::vector<boardAction> actions;
+    std::vector<boardAction> played;
+    std::string history;
+    for(size_t ply = 0; ply < plies; ++ply) {
+        const std::string position = live.getPositionString();
+        std::string diff = checkPosition(position, s);
+        totals.positions.fetch_add(1, std::memory_order_relaxed);
+        if(!diff.empty()) {
+            if(totals.full()) return;
+            const std::string minimal = shrinkPosition(position, diff, s);
+            totals.report({position, minimal, diff});
+            return;
+        }
+        // 게임 내내 증분으로만 갱신한 보드도 새로 불러온 보드와 같아야 한다 (기록 의존이라 줄이지 않는다)
+        fresh.loadPositionString(position);
+        diff = compareBoards(live, fresh, s);
+        if(!diff.empty()) {
+            totals.report({start, position, "history after [" + history + "]: " + diff});
+            return;
+        }
+
+        live.collectLegalActions(actions);
+        const boardAction& a = actions[static_cast<size_t>(rng() % actions.size())];
+        if(live.applyAction(a) != actionResult::OK) {
+            totals.report({start, position, "history: listed action " + describe(a) + " rejected"});
+            return;
+        }
+        totals.actions.fetch_add(1, std::memory_order_relaxed);
+        played.push_back(a);
+        if(!history.empty()) history += ' ';
+        history += describe(a);
+    }
+
+    // 같은 액션을 applyActions 한 번으로 적용한 보드 (재계산은 끝에서 한 번)
+    bc_board batched;
+    batched.loadPositionString(start);
+    const actionBatchReport report = batched.applyActions(played);
+    if(report.result != actionResult::OK || report.firstInvalid != played.size()) {
+        totals.report({start, live.getPositionString(), "batch: action " + std::to_string(report.firstInvalid) + " rejected (" +
+                                                        std::to_string(static_cast<int>(report.result)) + ")"});
+        return;
+    }
+    const std::string diff = compareBoards(batched, live, s);
+    if(!diff.empty()) totals.report({start, live.getPositionString(), "batch [" + history + "]: " + diff});
+}
+
+void usage() {
+    std::cerr << "usage: bc_differential [-n positions] [-s seed] [-p plies_per_game] [-j threads] [-q]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t positions = 100000;
+    uint64_t seed = 1;
+    size_t plies = 40;
+    unsigned threads = 0;
+    bool quiet = false;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if(arg == "-n" && i + 1 < argc) {
+            positions = std::strtoull(argv[++i], nullptr, 10);
+        } else if(arg == "-s" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if(arg == "-p" && i + 1 < argc) {
+            plies = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if(arg == "-j" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if(arg == "-q") {
+            quiet = true;
+        } else {
+            usage();
+            return (arg == "-h" || arg == "--help") ? 0 : 2;
+        }
+    }
+
+    const size_t games = (positions + plies - 1) / plies;
+    runTotals totals;
+    threadPool pool(threads);
+    const auto started = std::chrono::steady_clock::now();
+    pool.parallelFor(0, games, 1, [&](size_t begin, size_t end) {
+        for(size_t g = begin; g < end && !totals.full(); ++g) playGame(seed * 0x9E3779B97F4A7C15ull + g, plies, totals);
+    });
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    for(const failure& f : totals.failures) {
+        std::cout << "[FAIL] " << f.detail << "\n  minimal: " << f.minimal << "\n  from:    " << f.origin << std::endl;
+    }
+    const size_t checked = totals.positions.load();
+    if(!quiet || !totals.failures.empty()) {
+        std::cout << checked << " positions, " << totals.actions.load() << " game actions in " << seconds << " s ("
+                  << (seconds > 0 ? static_cast<double>(checked) / seconds : 0.0) << " positions/sec, " << pool.size() << " threads)" << std::endl;
+    }
+    if(!totals.failures.empty()) {
+        std::cout << totals.failures.size() << " mismatch(es)" << std::endl;
+        return 1;
+    }
+    std::cout << "모든 포지션 일치" << std::endl;
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chess.hpp>
+#include <gamerecord.hpp>
+#include <mappedfile.hpp>
+#include <threadpool.hpp>
+
+/* bc_replay: 게임 아카이브 전체를 bc_board로 다시 두어 모든 액션이 합법인지 검증한다.
+
+     bc_replay [-j 스레드 수] [-q] <아카이브>...
+
+   아카이브 형식은 파일 앞부분으로 판별한다.
+     .bcgr (gamerecord.hpp)  "BCGR" 매직으로 시작하는 바이너리 기록
+     텍스트 기보             빈 줄로 게임을 구분. [Position "<포지션 문자열>"] 태그가 있으면 그 포지션에서 시작,
+                            없으면 기본 시작 포지션. 나머지는 replayNotation 문법
+   게임마다 첫 불일치(거절된 액션)를 보고하고, 끝에 games/sec, actions/sec를 출력한다.
+   불일치가 하나라도 있으면 종료 코드 1.
+*/
+
+namespace {
+
+constexpr size_t GAMES_PER_TASK = 64;
+
+struct divergence {
+    size_t fileIndex;
+    size_t gameIndex;
+    size_t actionIndex;
+    actionResult result;
+    std::string detail;
+};
+
+struct replayTotals {
+    std::atomic<size_t> games{0};
+    std::atomic<size_t> actions{0};
+    std::mutex lock;
+    std::vector<divergence> divergences;
+
+    void report(std::vector<divergence>& local, size_t gameCount, size_t actionCount) {
+        games.fetch_add(gameCount, std::memory_order_relaxed);
+        actions.fetch_add(actionCount, std::memory_order_relaxed);
+        if(local.empty()) return;
+        std::lock_guard<std::mutex> guard(lock);
+        for(auto& d : local) divergences.push_back(std::move(d));
+        local.clear();
+    }
+};
+
+const char* actionTypeName(actionType t) {
+    switch(t) {
+        case actionType::DROP:       return "drop";
+        case actionType::MOVE:       return "move";
+        case actionType::STUN:       return "stun";
+        case actionType::PROMOTE:    return "promote";
+        case actionType::DISGUISE:   return "disguise";
+        case actionType::SUCCESSION: return "succession";
+        default:                     return "end_turn";
+    }
+}
+
+std::string squareName(int square) {
+    if(square < 0) return "-";
+    return std::string{char('a' + squareFile(square)), char('1' + squareRank(square))};
+}
+
+// ---------------------------------------------------------------- .bcgr
+
+void replayBinary(size_t fileIndex, const gameRecordReader& reader, const std::vector<size_t>& offsets,
+                  size_t begin, size_t end, replayTotals& totals) {
+    bc_board board;
+    gameRecordView view;
+    boardAction action;
+    std::vector<boardAction> actions;
+    std::vector<divergence> local;
+    size_t actionCount = 0;
+
+    for(size_t g = begin; g < end; ++g) {
+        if(!reader.readGameAt(offsets[g], view) || !view.loadInitial(board)) {
+            local.push_back({fileIndex, g, 0, actionResult::INVALID_POSITION, "corrupt game header"});
+            continue;
+        }
+        // 게임 하나의 액션을 모아 한 번에 적용 (합법수 재계산은 끝에서 한 번)
+        actions.clear();
+        while(view.nextAction(action)) actions.push_back(action);
+        const actionBatchReport report = board.applyActions(actions);
+        const size_t index = report.firstInvalid;
+        const bool diverged = report.result != actionResult::OK;
+        if(diverged) {
+            const boardAction& bad = actions[index];
+            local.push_back({fileIndex, g, index, report.result,
+                             std::string(actionTypeName(bad.type)) + " " + squareName(bad.fromSquare) +
+                             " -> " + squareName(bad.toSquare)});
+        }
+        if(!diverged && index != view.actionCount()) {
+            local.push_back({fileIndex, g, index, actionResult::INVALID_NOTATION, "truncated action stream"});
+        }
+        actionCount += index;
+    }
+    totals.report(local, end - begin, actionCount);
+}
+
+// ---------------------------------------------------------------- 텍스트
+
+// 빈 줄로 구분된 게임 구간들
+std::vector<std::string_view> splitTextGames(std::string_view text) {
+    std::vector<std::string_view> games;
+    size_t pos = 0;
+    size_t start = std::string_view::npos;
+    while(pos <= text.size()) {
+        size_t eol = text.find('\n', pos);
+        if(eol == std::string_view::npos) eol = text.size();
+        std::string_view line = text.substr(pos, eol - pos);
+        const bool blank = line.find_first_not_of(" \t\r") == std::string_view::npos;
+        if(blank) {
+            if(start != std::string_view::npos) {
+                games.push_back(text.substr(start, pos - start));
+                start = std::string_view::npos;
+            }
+        } else if(start == std::string_view::npos) {
+            start = pos;
+        }
+        pos = eol + 1;
+    }
+    if(start != std::string_view::npos) games.push_back(text.substr(start));
+    return games;
+}
+
+// [Position "..."] 태그 값 (없으면 빈 view)
+std::string_view positionTag(std::string_view game) {
+    constexpr std::string_view tag = "[Position \"";
+    const size_t at = game.find(tag);
+    if(at == std::string_view::npos) return {};
+    const size_t begin = at + tag.size();
+    const size_t end = game.find('"', begin);
+    if(end == std::string_view::npos) return {};
+    return game.substr(begin, end - begin);
+}
+
+void replayText(size_t fileIndex, const std::vector<std::string_view>& games,
+                size_t begin, size_t end, replayTotals& totals) {
+    bc_board board;
+    std::vector<divergence> local;
+    size_t actionCount = 0;
+
+    for(size_t g = begin; g < end; ++g) {
+        const std::string_view game = games[g];
+        const std::string_view start = positionTag(game);
+        if(start.empty()) {
+            board.initializeBoard();
+        } else if(!board.loadPositionString(start)) {
+            local.push_back({fileIndex, g, 0, actionResult::INVALID_POSITION, "bad [Position] tag"});
+            continue;
+        }
+        const replayReport report = board.replayNotation(game);
+        actionCount += report.actionsApplied;
+        if(report.result != actionResult::OK) {
+            local.push_back({fileIndex, g, report.actionsApplied, report.result,
+                             "'" + std::string(game.substr(report.errorOffset, report.errorLength)) + "'"});
+        }
+    }
+    totals.report(local, end - begin, actionCount);
+}
+
+void usage() {
+    std::cerr << "usage: bc_replay [-j threads] [-q] <archive>..." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    bool quiet = false;
+    std::vector<std::string> paths;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if(arg == "-j" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if(arg == "-q") {
+            quiet = true;
+        } else if(arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if(paths.empty()) {
+        usage();
+        return 2;
+    }
+
+    // 파일별 상태는 풀이 도는 동안 살아 있어야 한다
+    std::vector<gameRecordReader> readers(paths.size());
+    std::vector<std::vector<size_t>> offsets(paths.size());
+    std::vector<mappedFile> texts(paths.size());
+    std::vector<std::vector<std::string_view>> textGames(paths.size());
+
+    replayTotals totals;
+    threadPool pool(threads);
+    const auto started = std::chrono::steady_clock::now();
+    int exitCode = 0;
+
+    for(size_t f = 0; f < paths.size(); ++f) {
+        if(readers[f].open(paths[f])) {
+            gameRecordView view;
+            for(size_t at = readers[f].position(); readers[f].nextGame(view); at = readers[f].position()) {
+                offsets[f].push_back(at);
+            }
+            if(readers[f].isCorrupt()) {
+                std::cerr << paths[f] << ": corrupt record after game " << offsets[f].size() << std::endl;
+                exitCode = 1;
+            }
+            const size_t count = offsets[f].size();
+            for(size_t b = 0; b < count; b += GAMES_PER_TASK) {
+                const size_t e = std::min(count, b + GAMES_PER_TASK);
+                pool.submit([f, b, e, &readers, &offsets, &totals] { replayBinary(f, readers[f], offsets[f], b, e, totals); });
+            }
+        } else if(texts[f].open(paths[f])) {
+            const std::string_view text(reinterpret_cast<const char*>(texts[f].data()), texts[f].size());
+            textGames[f] = splitTextGames(text);
+            const size_t count = textGames[f].size();
+            for(size_t b = 0; b < count; b += GAMES_PER_TASK) {
+                const size_t e = std::min(count, b + GAMES_PER_TASK);
+                pool.submit([f, b, e, &textGames, &totals] { replayText(f, textGames[f], b, e, totals); });
+            }
+        } else {
+            std::cerr << paths[f] << ": cannot open" << std::endl;
+            exitCode = 1;
+        }
+    }
+    pool.wait();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    auto& found = totals.divergences;
+    std::sort(found.begin(), found.end(), [](const divergence& a, const divergence& b) {
+        return a.fileIndex != b.fileIndex ? a.fileIndex < b.fileIndex : a.gameIndex < b.gameIndex;
+    });
+    if(!quiet) {
+        for(const divergence& d : found) {
+            std::cout << paths[d.fileIndex] << ": game " << d.gameIndex << " action " << d.actionIndex
+                      << ": " << actionResultName(d.result) << " " << d.detail << std::endl;
+        }
+    }
+
+    const size_t games = totals.games.load();
+    const size_t actions = totals.actions.load();
+    const double safeSeconds = seconds > 0.0 ? seconds : 1e-9;
+    std::cout << "games: " << games << ", actions: " << actions << ", divergent games: " << found.size()
+              << ", threads: " << pool.size() << std::endl;
+    std::cout << "time: " << seconds << " s, " << (games / safeSeconds) << " games/sec, "
+              << (actions / safeSeconds) << " actions/sec" << std::endl;
+
+    if(!found.empty()) exitCode = 1;
+    return exitCode;
+}
@@ -0,0 +1,78 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tablebase.hpp>
+#include <threadpool.hpp>
+
+/* bc_tablebase: 소수 기물 엔드게임 테이블베이스를 만든다 (tablebase.hpp).
+
+     bc_tablebase [-j 스레드 수] [-s 스턴 지평선] [-m 이동 지평선] [-r 로얄 타입 글자] -o <출력.bctb> [extras 글자]
+
+   예) bc_tablebase -s 1 -m 1 -o k-k.bctb          로얄 둘만
+       bc_tablebase -s 2 -m 2 -o k-r.bctb R        로얄 둘 + 룩 하나 (어느 편/포켓이든)
+   인덱스 공간 크기, 승/패/무 포지션 수, 풀이 단계 수, 시간과 압축 크기를 출력한다.
+*/
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: bc_tablebase [-j threads] [-s stun] [-m move] [-r royals] -o <out.bctb> [extras]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    std::string output;
+    std::string extras;
+    std::string royals = "K";
+    tablebaseSignature signature;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if(arg == "-j" && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if(arg == "-s" && hasValue) {
+            signature.stunHorizon = std::atoi(argv[++i]);
+        } else if(arg == "-m" && hasValue) {
+            signature.moveHorizon = std::atoi(argv[++i]);
+        } else if(arg == "-r" && hasValue) {
+            royals = argv[++i];
+        } else if(arg == "-o" && hasValue) {
+            output = argv[++i];
+        } else if(arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            extras = arg;
+        }
+    }
+    if(output.empty() || !tablebaseSignature::fromLetters(extras, royals, signature)) {
+        usage();
+        return 2;
+    }
+
+    threadPool pool(threads);
+    std::vector<int16_t> values;
+    tablebaseBuildStats stats;
+    std::cout << "table: " << signature.name() << ", indices: " << tablebaseIndexer(signature).size() << std::endl;
+    if(!buildTablebase(signature, pool, values, stats)) {
+        std::cerr << "index space too large or invalid horizon" << std::endl;
+        return 1;
+    }
+    if(!saveTablebase(output, signature, values)) {
+        std::cerr << output << ": cannot write" << std::endl;
+        return 1;
+    }
+    tablebase written;
+    const size_t bytes = written.open(output) ? written.fileSize() : 0;
+
+    const double safeSeconds = stats.seconds > 0.0 ? stats.seconds : 1e-9;
+    std::cout << "positions: " << stats.positions << " (win " << stats.wins << ", loss " << stats.losses
+              << ", draw/unproven " << stats.draws << "), edges: " << stats.edges << ", passes: " << stats.passes
+              << ", threads: " << pool.size() << std::endl;
+    std::cout << "time: " << stats.seconds << " s, " << (stats.positions / safeSeconds) << " positions/sec, "
+              << "file: " << bytes << " bytes (" << (stats.indices > 0 ? 8.0 * bytes / stats.indices : 0.0) << " bits/index)" << std::endl;
+    return 0;
+}